@@ -0,0 +1,85 @@
+// stl::copy_if / remove_if 在连续区间上的基准测试，元素为 int、double 与 short，n = 1M
+//   * 谓词为 x < limit，元素在 [0, 100) 内均匀分布，保留的比例分别为 1%、50%、99%
+//   * 以带分支的逐个处理的循环为参照，另外列出 std 中对应的算法
+// 保留的比例接近 50% 时分支难以预测，无分支的压缩收益最大
+
+#include <algorithm>
+
+#include "algo.h"
+#include "vector.h"
+#include "bench_util.h"
+
+template<class T, class Pred>
+__attribute__((noinline)) T *scalar_copy_if(const T *first, const T *last, T *result, Pred pred) {
+    for (; first != last; ++first) {
+        if (pred(*first)) *result++ = *first;
+    }
+    return result;
+}
+
+template<class T, class Pred>
+__attribute__((noinline)) T *scalar_remove_if(T *first, T *last, Pred pred) {
+    T *out = first;
+    for (; first != last; ++first) {
+        if (!pred(*first)) *out++ = *first;
+    }
+    return out;
+}
+
+template<class T>
+void run(const char *type, size_t n) {
+    const size_t rounds = 20;
+    stl::vector<T> a, out(n), work(n);
+    a.reserve(n);
+    bench::rng rng;
+    for (size_t i = 0; i < n; ++i) a.push_back(static_cast<T>(rng.below(100)));
+    const T *first = a.begin(), *last = a.end();
+
+    const int limits[] = {1, 50, 99};
+    for (int limit : limits) {
+        const T bound = static_cast<T>(limit);
+        auto pred = [bound](T x) { return x < bound; };
+
+        char title[64];
+        std::snprintf(title, sizeof(title), "%s, n = %zu, %d%% selected (x%zu)", type, n, limit, rounds);
+        bench::print_header(title);
+
+        const double copy0 = bench::measure_rounds_ms(rounds, [&] {
+            bench::do_not_optimize(scalar_copy_if(first, last, out.begin(), pred));
+        });
+        const double copy1 = bench::measure_rounds_ms(rounds, [&] {
+            bench::do_not_optimize(std::copy_if(first, last, out.begin(), pred));
+        });
+        const double copy2 = bench::measure_rounds_ms(rounds, [&] {
+            bench::do_not_optimize(stl::copy_if(first, last, out.begin(), pred));
+        });
+        bench::print_row("scalar copy_if", n * rounds, copy0);
+        bench::print_row("std::copy_if", n * rounds, copy1, copy0);
+        bench::print_row("stl::copy_if", n * rounds, copy2, copy0);
+
+        // remove_if 会修改区间，每轮先恢复输入，拷贝的耗时包含在内
+        const double remove0 = bench::measure_rounds_ms(rounds, [&] {
+            std::copy(first, last, work.begin());
+            bench::do_not_optimize(scalar_remove_if(work.begin(), work.end(), pred));
+        });
+        const double remove1 = bench::measure_rounds_ms(rounds, [&] {
+            std::copy(first, last, work.begin());
+            bench::do_not_optimize(std::remove_if(work.begin(), work.end(), pred));
+        });
+        const double remove2 = bench::measure_rounds_ms(rounds, [&] {
+            std::copy(first, last, work.begin());
+            bench::do_not_optimize(stl::remove_if(work.begin(), work.end(), pred));
+        });
+        bench::print_row("scalar remove_if", n * rounds, remove0);
+        bench::print_row("std::remove_if", n * rounds, remove1, remove0);
+        bench::print_row("stl::remove_if", n * rounds, remove2, remove0);
+    }
+}
+
+int main() {
+    const size_t n = 1000000;
+    run<int>("int", n);
+    run<double>("double", n);
+    run<short>("short", n);
+    return 0;
+}
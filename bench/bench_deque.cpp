@@ -0,0 +1,86 @@
+// deque 随机访问的基准测试：在有序的 deque 上做二分查找
+//   * 迭代器版本：stl::lower_bound(d.begin(), d.end(), key)，每一步都要做迭代器的 += 运算
+//   * 下标版本：在下标上二分，通过 at_index 直接定位缓冲区和偏移
+// 分别测试缓冲区大小为2的幂(uint32_t)和不是2的幂(12字节的结构体)两种情况
+// 以 -DDEQUE_BUF_POW2=1 编译时，Key12 的缓冲区大小也会取为2的幂，可以对比两次运行的结果
+
+#include <cstdint>
+
+#include "deque.h"
+#include "vector.h"
+#include "algo.h"
+#include "bench_util.h"
+
+struct Key12 {
+    uint32_t key;
+    uint32_t pad[2];
+
+    bool operator<(const Key12 &rhs) const { return key < rhs.key; }
+};
+
+template<class T>
+uint32_t key_of(const T &value) { return static_cast<uint32_t>(value); }
+
+template<>
+uint32_t key_of<Key12>(const Key12 &value) { return value.key; }
+
+template<class T>
+T make_value(uint32_t key) { return static_cast<T>(key); }
+
+template<>
+Key12 make_value<Key12>(uint32_t key) { return Key12{key, {0, 0}}; }
+
+// 在下标上二分，返回第一个不小于key的位置
+template<class T>
+size_t index_lower_bound(const stl::deque<T> &d, uint32_t key) {
+    size_t first = 0, len = d.size();
+    while (len > 0) {
+        const size_t half = len >> 1;
+        if (key_of(d.at_index(first + half)) < key) {
+            first += half + 1;
+            len -= half + 1;
+        } else {
+            len = half;
+        }
+    }
+    return first;
+}
+
+template<class T>
+void bench_binary_search(const char *type_name, size_t n, const stl::vector<uint32_t> &queries) {
+    stl::deque<T> d;
+    for (size_t i = 0; i < n; ++i) d.push_back(make_value<T>(static_cast<uint32_t>(2 * i)));
+
+    const double iter_ms = bench::measure_ms([&] {
+        size_t sum = 0;
+        for (auto q : queries)
+            sum += stl::lower_bound(d.begin(), d.end(), make_value<T>(q)) - d.begin();
+        bench::do_not_optimize(sum);
+    });
+    const double index_ms = bench::measure_ms([&] {
+        size_t sum = 0;
+        for (auto q : queries)
+            sum += index_lower_bound(d, q);
+        bench::do_not_optimize(sum);
+    });
+
+    std::printf("%-10s buffer_size=%-5zu pow2=%d\n", type_name, stl::deque<T>::buffer_size + 0,
+                stl::deque_buf_size<T>::is_pow2 ? 1 : 0);
+    bench::print_row("  lower_bound(iterator)", n, iter_ms);
+    bench::print_row("  lower_bound(at_index)", n, index_ms, iter_ms);
+}
+
+int main() {
+    const size_t query_count = 1 << 20;
+    bench::print_header("binary search over stl::deque, 2^20 queries");
+    for (size_t n = 1 << 10; n <= (1 << 22); n <<= 2) {
+        bench::rng rng;
+        stl::vector<uint32_t> queries;
+        queries.reserve(query_count);
+        for (size_t i = 0; i < query_count; ++i)
+            queries.push_back(static_cast<uint32_t>(rng.below(2 * n)));
+        bench_binary_search<uint32_t>("uint32_t", n, queries);
+        bench_binary_search<Key12>("Key12", n, queries);
+    }
+    return 0;
+}
@@ -0,0 +1,122 @@
+// 执行策略版本算法的扩展性测试：线程数从 1 翻倍增长到 hardware_concurrency
+// 每一行的倍数是相对于不带执行策略的顺序版本的加速比
+// 用法：bench_execution [元素个数] [最大线程数]，默认 2^24 个 uint32_t、hardware_concurrency 个线程
+
+#include <cstdlib>
+#include <thread>
+
+#include "deque.h"
+#include "execution.h"
+#include "vector.h"
+#include "bench_util.h"
+
+static size_t max_threads = 1;
+
+// 先测顺序版本，再测 par(1), par(2), par(4), ...
+template<class Seq, class Par>
+static void run(const char *title, size_t n, Seq seq, Par par) {
+    char name[64];
+    bench::print_header(title);
+    const double seq_ms = bench::measure_ms(seq);
+    bench::print_row("sequential", n, seq_ms);
+    for (size_t t = 1; t <= max_threads; t *= 2) {
+        const double ms = bench::measure_ms([&] { par(stl::execution::par(t)); });
+        std::snprintf(name, sizeof(name), "execution::par threads=%zu", t);
+        bench::print_row(name, n, ms, seq_ms);
+    }
+}
+
+// 一个稍重的逐元素操作，计算量大于访存，能看出多线程的扩展性
+static uint32_t mix(uint32_t x) {
+    x ^= x >> 16;
+    x *= 0x7feb352dU;
+    x ^= x >> 15;
+    x *= 0x846ca68bU;
+    return x ^ (x >> 16);
+}
+
+int main(int argc, char *argv[]) {
+    const size_t n = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : (1u << 24);
+    max_threads = argc > 2 ? static_cast<size_t>(std::strtoull(argv[2], nullptr, 10))
+                           : std::thread::hardware_concurrency();
+    if (max_threads == 0) max_threads = 1;
+
+    bench::rng rng;
+    stl::vector<uint32_t> input;
+    input.reserve(n);
+    for (size_t i = 0; i < n; ++i) input.push_back(static_cast<uint32_t>(rng.next()));
+    stl::vector<uint32_t> v = input, out(n);
+    uint32_t *first = v.data(), *last = v.data() + n;
+    const uint32_t *in_first = input.data(), *in_last = input.data() + n;
+
+    run("for_each, x = mix(x)", n,
+        [&] { stl::for_each(first, last, [](uint32_t &x) { x = mix(x); }); },
+        [&](stl::execution::parallel_policy p) {
+            stl::for_each(p, first, last, [](uint32_t &x) { x = mix(x); });
+        });
+
+    run("transform, out = x * 3 + 1", n,
+        [&] { stl::transform(in_first, in_last, out.data(), [](uint32_t x) { return x * 3 + 1; }); },
+        [&](stl::execution::parallel_policy p) {
+            stl::transform(p, in_first, in_last, out.data(), [](uint32_t x) { return x * 3 + 1; });
+        });
+
+    auto odd_mix = [](uint32_t x) { return (mix(x) & 1) != 0; };
+    run("count_if, mix(x) is odd", n,
+        [&] { bench::do_not_optimize(stl::count_if(in_first, in_last, odd_mix)); },
+        [&](stl::execution::parallel_policy p) {
+            bench::do_not_optimize(stl::count_if(p, in_first, in_last, odd_mix));
+        });
+
+    // 唯一的匹配在末尾，需要扫描整个区间
+    v = input;
+    v[n - 1] = 0;
+    for (size_t i = 0; i + 1 < n; ++i) v[i] |= 1;
+    first = v.data();
+    last = v.data() + n;
+    auto is_zero = [](uint32_t x) { return x == 0; };
+    run("find_if, only match at the end", n,
+        [&] { bench::do_not_optimize(stl::find_if(first, last, is_zero)); },
+        [&](stl::execution::parallel_policy p) { bench::do_not_optimize(stl::find_if(p, first, last, is_zero)); });
+
+    // 匹配在区间的四分之一处，后面的线程应该提前结束
+    v[n / 4] = 0;
+    run("find_if, first match at n / 4", n,
+        [&] { bench::do_not_optimize(stl::find_if(first, last, is_zero)); },
+        [&](stl::execution::parallel_policy p) { bench::do_not_optimize(stl::find_if(p, first, last, is_zero)); });
+    run("any_of, match at n / 4", n,
+        [&] { bench::do_not_optimize(stl::any_of(first, last, is_zero)); },
+        [&](stl::execution::parallel_policy p) { bench::do_not_optimize(stl::any_of(p, first, last, is_zero)); });
+
+    v = input;
+    run("replace_if, x < 2^31 -> 0", n,
+        [&] { stl::replace_if(first, last, [](uint32_t x) { return x < 0x80000000U; }, 0U); },
+        [&](stl::execution::parallel_policy p) {
+            stl::replace_if(p, first, last, [](uint32_t x) { return x < 0x80000000U; }, 0U);
+        });
+
+    run("generate, constant", n,
+        [&] { stl::generate(first, last, [] { return 7U; }); },
+        [&](stl::execution::parallel_policy p) { stl::generate(p, first, last, [] { return 7U; }); });
+
+    run("min_element", n,
+        [&] { bench::do_not_optimize(stl::min_element(in_first, in_last)); },
+        [&](stl::execution::parallel_policy p) { bench::do_not_optimize(stl::min_element(p, in_first, in_last)); });
+    run("max_element", n,
+        [&] { bench::do_not_optimize(stl::max_element(in_first, in_last)); },
+        [&](stl::execution::parallel_policy p) { bench::do_not_optimize(stl::max_element(p, in_first, in_last)); });
+
+    // deque：按缓冲区切块，块内用指针处理
+    stl::deque<uint32_t> d(in_first, in_last);
+    run("deque count_if, x is odd", n,
+        [&] { bench::do_not_optimize(stl::count_if(d.begin(), d.end(), [](uint32_t x) { return (x & 1) != 0; })); },
+        [&](stl::execution::parallel_policy p) {
+            bench::do_not_optimize(stl::count_if(p, d.begin(), d.end(), [](uint32_t x) { return (x & 1) != 0; }));
+        });
+    run("deque for_each, x = mix(x)", n,
+        [&] { stl::for_each(d.begin(), d.end(), [](uint32_t &x) { x = mix(x); }); },
+        [&](stl::execution::parallel_policy p) {
+            stl::for_each(p, d.begin(), d.end(), [](uint32_t &x) { x = mix(x); });
+        });
+    return 0;
+}
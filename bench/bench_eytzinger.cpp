@@ -0,0 +1,60 @@
+// stl::eytzinger_index 与有序数组上二分查找的对比，uint32_t 键，表长从 1K 开始每次乘 8
+//   * std::lower_bound
+//   * stl::lower_bound：无分支 + 预取
+//   * stl::eytzinger_index::lower_bound
+// 默认最大表长 2^27(有序数组与索引共 1 GB)，可用参数指定：bench_eytzinger [max_n]，
+// 表长 2^30 时需要约 8 GB 内存
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "algo.h"
+#include "eytzinger_index.h"
+#include "vector.h"
+#include "bench_util.h"
+
+int main(int argc, char **argv) {
+    const size_t max_n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : (size_t(1) << 27);
+    const size_t queries = 1000000;
+    bench::rng rng;
+    stl::vector<uint32_t> q;
+    q.reserve(queries);
+    stl::vector<size_t> out(queries);
+
+    for (size_t n = 1 << 10; n <= max_n; n <<= 3) {
+        stl::vector<uint32_t> table;
+        table.reserve(n);
+        // 奇数的表，查找的值一半命中
+        for (size_t i = 0; i < n; ++i) table.push_back(static_cast<uint32_t>(2 * i + 1));
+        q.clear();
+        for (size_t i = 0; i < queries; ++i) q.push_back(static_cast<uint32_t>(rng.below(2 * n + 2)));
+        const uint32_t *first = table.begin(), *last = table.end();
+
+        char title[64];
+        std::snprintf(title, sizeof(title), "n = %zu (%zu KB)", n, n * sizeof(uint32_t) >> 10);
+        bench::print_header(title);
+
+        bench::timer t;
+        stl::eytzinger_index<uint32_t> index(first, last);
+        const double build_ms = t.elapsed_ms();
+
+        const double std_ms = bench::measure_ms([&] {
+            for (size_t i = 0; i < queries; ++i) out[i] = std::lower_bound(first, last, q[i]) - first;
+            bench::do_not_optimize(out[0]);
+        });
+        const double stl_ms = bench::measure_ms([&] {
+            for (size_t i = 0; i < queries; ++i) out[i] = stl::lower_bound(first, last, q[i]) - first;
+            bench::do_not_optimize(out[0]);
+        });
+        const double eytzinger_ms = bench::measure_ms([&] {
+            for (size_t i = 0; i < queries; ++i) out[i] = index.lower_bound(q[i]);
+            bench::do_not_optimize(out[0]);
+        });
+
+        bench::print_row("std::lower_bound", queries, std_ms);
+        bench::print_row("stl::lower_bound", queries, stl_ms, std_ms);
+        bench::print_row("eytzinger_index::lower_bound", queries, eytzinger_ms, std_ms);
+        bench::print_row("eytzinger_index build", n, build_ms);
+    }
+    return 0;
+}
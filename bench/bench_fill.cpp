@@ -0,0 +1,56 @@
+// stl::fill_n 在连续区间上的基准测试，元素为 int、double 与 12 字节的结构体
+//   * 值的各个字节不同，不能直接用 memset
+//   * 以逐个赋值的循环为参照，另外列出 std::fill_n
+
+#include <algorithm>
+
+#include "algobase.h"
+#include "vector.h"
+#include "bench_util.h"
+
+struct triple {
+    int x, y, z;
+};
+
+// 逐个赋值的参照版本，noinline 防止编译器把它与调用处一起优化
+template<class T>
+__attribute__((noinline)) T *scalar_fill_n(T *first, size_t n, const T &value) {
+    for (; n > 0; --n, ++first) {
+        *first = value;
+        bench::do_not_optimize(first);
+    }
+    return first;
+}
+
+template<class T>
+void run(const char *type, size_t n, const T &value) {
+    const size_t total = 200000000 / sizeof(T);     // 每次测量共写入的元素个数
+    const size_t rounds = total / n;
+    stl::vector<T> a(n);
+    T *first = a.begin();
+
+    char title[64];
+    std::snprintf(title, sizeof(title), "%s, n = %zu (x%zu)", type, n, rounds);
+    bench::print_header(title);
+
+    const double fill0 = bench::measure_rounds_ms(rounds, [&] {
+        bench::do_not_optimize(scalar_fill_n(first, n, value));
+    });
+    const double fill1 = bench::measure_rounds_ms(rounds, [&] {
+        bench::do_not_optimize(std::fill_n(first, n, value));
+    });
+    const double fill2 = bench::measure_rounds_ms(rounds, [&] {
+        bench::do_not_optimize(stl::fill_n(first, n, value));
+    });
+    bench::print_row("scalar fill_n", total, fill0);
+    bench::print_row("std::fill_n", total, fill1, fill0);
+    bench::print_row("stl::fill_n", total, fill2, fill0);
+}
+
+int main() {
+    const size_t sizes[] = {16, 256, 4096, 1000000};
+    for (size_t n : sizes) run<int>("int", n, 0x01020304);
+    for (size_t n : sizes) run<double>("double", n, 1.5);
+    for (size_t n : sizes) run<triple>("12-byte struct", n, triple{1, 2, 3});
+    return 0;
+}
@@ -0,0 +1,109 @@
+// stl::find / count / mismatch / equal / find_if 在 stl::vector<int> 与 stl::vector<char> 上的基准测试
+//   * find、mismatch 的目标位于末尾，需要扫描整个区间
+//   * 每组以逐个比较的循环为参照，另外列出 std 中对应的算法
+
+#include <algorithm>
+
+#include "algo.h"
+#include "vector.h"
+#include "bench_util.h"
+
+// 逐个比较的参照版本，noinline 防止编译器把它与调用处一起优化
+template<class T>
+__attribute__((noinline)) const T *scalar_find(const T *first, const T *last, T value) {
+    for (; first != last; ++first) if (*first == value) return first;
+    return first;
+}
+
+template<class T>
+__attribute__((noinline)) size_t scalar_count(const T *first, const T *last, T value) {
+    size_t n = 0;
+    for (; first != last; ++first) if (*first == value) ++n;
+    return n;
+}
+
+template<class T>
+__attribute__((noinline)) const T *scalar_mismatch(const T *first1, const T *last1, const T *first2) {
+    while (first1 != last1 && *first1 == *first2) ++first1, ++first2;
+    return first1;
+}
+
+template<class T>
+void run(const char *type, size_t n) {
+    const size_t total = 100000000;     // 每次测量共处理的元素个数
+    const size_t rounds = total / n;
+    stl::vector<T> a, b;
+    a.reserve(n);
+    bench::rng rng;
+    // 值在 [1, 100) 内，0 不会出现；末尾放一个 0 作为 find 的目标
+    for (size_t i = 0; i < n; ++i) a.push_back(static_cast<T>(1 + rng.below(99)));
+    a[n - 1] = 0;
+    b = a;
+    b[n - 1] = 1;
+    const T *first = a.begin(), *last = a.end();
+
+    char title[64];
+    std::snprintf(title, sizeof(title), "%s, n = %zu (x%zu)", type, n, rounds);
+    bench::print_header(title);
+
+    const double find0 = bench::measure_rounds_ms(rounds, [&] {
+        bench::do_not_optimize(scalar_find(first, last, T(0)));
+    });
+    const double find1 = bench::measure_rounds_ms(rounds, [&] {
+        bench::do_not_optimize(std::find(first, last, T(0)));
+    });
+    const double find2 = bench::measure_rounds_ms(rounds, [&] {
+        bench::do_not_optimize(stl::find(first, last, T(0)));
+    });
+    bench::print_row("scalar find", total, find0);
+    bench::print_row("std::find", total, find1, find0);
+    bench::print_row("stl::find", total, find2, find0);
+
+    const double count0 = bench::measure_rounds_ms(rounds, [&] {
+        bench::do_not_optimize(scalar_count(first, last, T(7)));
+    });
+    const double count1 = bench::measure_rounds_ms(rounds, [&] {
+        bench::do_not_optimize(std::count(first, last, T(7)));
+    });
+    const double count2 = bench::measure_rounds_ms(rounds, [&] {
+        bench::do_not_optimize(stl::count(first, last, T(7)));
+    });
+    bench::print_row("scalar count", total, count0);
+    bench::print_row("std::count", total, count1, count0);
+    bench::print_row("stl::count", total, count2, count0);
+
+    const T *second = b.begin();
+    const double mis0 = bench::measure_rounds_ms(rounds, [&] {
+        bench::do_not_optimize(scalar_mismatch(first, last, second));
+    });
+    const double mis1 = bench::measure_rounds_ms(rounds, [&] {
+        bench::do_not_optimize(std::mismatch(first, last, second));
+    });
+    const double mis2 = bench::measure_rounds_ms(rounds, [&] {
+        bench::do_not_optimize(stl::mismatch(first, last, second));
+    });
+    const double eq2 = bench::measure_rounds_ms(rounds, [&] {
+        bench::do_not_optimize(stl::equal(first, last, second));
+    });
+    bench::print_row("scalar mismatch", total, mis0);
+    bench::print_row("std::mismatch", total, mis1, mis0);
+    bench::print_row("stl::mismatch", total, mis2, mis0);
+    bench::print_row("stl::equal", total, eq2, mis0);
+
+    // 任意谓词无法向量化，只有循环展开
+    const double if1 = bench::measure_rounds_ms(rounds, [&] {
+        bench::do_not_optimize(std::find_if(first, last, [](T x) { return x == 0; }));
+    });
+    const double if2 = bench::measure_rounds_ms(rounds, [&] {
+        bench::do_not_optimize(stl::find_if(first, last, [](T x) { return x == 0; }));
+    });
+    bench::print_row("std::find_if", total, if1, find0);
+    bench::print_row("stl::find_if", total, if2, find0);
+}
+
+int main() {
+    const size_t sizes[] = {16, 256, 4096, 1000000};
+    for (size_t n : sizes) run<int>("int", n);
+    for (size_t n : sizes) run<char>("char", n);
+    return 0;
+}
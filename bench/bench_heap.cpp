@@ -0,0 +1,154 @@
+// 二叉堆与 d 叉堆的基准测试，堆的大小 m 分别在 L1、L2 缓存内与超过末级缓存
+//   * hold：大小为 m 的堆上反复弹出堆顶、再压入一个比它大的随机值(事件模拟、Dijkstra 中常见的用法)
+//   * fill / drain：逐个压入 m 个随机值，再全部弹出
+//   * make_heap：Floyd 建堆
+//   * std::string 元素，调整堆时只移动元素
+// 每组以 stl 的二叉堆为参照，std 的二叉堆作为对照
+// 用法：bench_heap [hold 的操作次数]，默认 2^22 次
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "heap_algo.h"
+#include "vector.h"
+#include "bench_util.h"
+
+// 堆的三种实现，统一成 push / pop / make 三个操作
+struct std_heap {
+    static const char *name() { return "std binary heap"; }
+
+    template<class T>
+    static void push(T *first, T *last) { std::push_heap(first, last); }
+
+    template<class T>
+    static void pop(T *first, T *last) { std::pop_heap(first, last); }
+
+    template<class T>
+    static void make(T *first, T *last) { std::make_heap(first, last); }
+};
+
+struct stl_heap {
+    static const char *name() { return "stl binary heap"; }
+
+    template<class T>
+    static void push(T *first, T *last) { stl::push_heap(first, last); }
+
+    template<class T>
+    static void pop(T *first, T *last) { stl::pop_heap(first, last); }
+
+    template<class T>
+    static void make(T *first, T *last) { stl::make_heap(first, last); }
+};
+
+template<size_t D>
+struct stl_dary_heap {
+    static const char *name() { return D == 4 ? "stl 4-ary heap" : "stl 8-ary heap"; }
+
+    template<class T>
+    static void push(T *first, T *last) { stl::push_dary_heap<D>(first, last); }
+
+    template<class T>
+    static void pop(T *first, T *last) { stl::pop_dary_heap<D>(first, last); }
+
+    template<class T>
+    static void make(T *first, T *last) { stl::make_dary_heap<D>(first, last); }
+};
+
+// 大顶堆中存放取反的时间，堆顶是最早的事件，弹出后压入一个更晚的事件
+template<class Heap>
+__attribute__((noinline)) uint64_t hold(stl::vector<uint64_t> &heap, const stl::vector<uint64_t> &delays) {
+    uint64_t *first = heap.begin(), *last = heap.end();
+    for (uint64_t delay : delays) {
+        Heap::pop(first, last);
+        last[-1] -= delay;
+        Heap::push(first, last);
+    }
+    return first[0];
+}
+
+template<class Heap, class T>
+__attribute__((noinline)) void fill_drain(T *first, const stl::vector<T> &input) {
+    const size_t m = input.size();
+    for (size_t i = 0; i < m; ++i) {
+        first[i] = input[i];
+        Heap::push(first, first + i + 1);
+    }
+    for (size_t i = m; i > 1; --i) Heap::pop(first, first + i);
+}
+
+template<class Heap>
+static void run_integers(size_t m, size_t ops, double &base_hold, double &base_fill, double &base_make) {
+    bench::rng rng;
+    stl::vector<uint64_t> input(m), delays(ops), heap;
+    for (auto &x : input) x = rng.next() >> 8;
+    for (auto &x : delays) x = rng.below(m) + 1;
+    const bool baseline = base_hold == 0;
+    char name[64];
+
+    const double hold_ms = bench::measure_ms([&] {
+        heap = input;
+        Heap::make(heap.begin(), heap.end());
+        bench::do_not_optimize(hold<Heap>(heap, delays));
+    });
+    std::snprintf(name, sizeof(name), "%s hold", Heap::name());
+    if (baseline) base_hold = hold_ms;
+    bench::print_row(name, ops, hold_ms, base_hold);
+
+    const double fill_ms = bench::measure_ms([&] {
+        fill_drain<Heap>(heap.begin(), input);
+        bench::do_not_optimize(heap[0]);
+    });
+    std::snprintf(name, sizeof(name), "%s fill / drain", Heap::name());
+    if (baseline) base_fill = fill_ms;
+    bench::print_row(name, m, fill_ms, base_fill);
+
+    const double make_ms = bench::measure_ms([&] {
+        heap = input;
+        Heap::make(heap.begin(), heap.end());
+        bench::do_not_optimize(heap[0]);
+    });
+    std::snprintf(name, sizeof(name), "%s make_heap", Heap::name());
+    if (baseline) base_make = make_ms;
+    bench::print_row(name, m, make_ms, base_make);
+}
+
+template<class Heap>
+static void run_strings(const stl::vector<std::string> &input, double &base) {
+    std::vector<std::string> heap(input.size());
+    const double ms = bench::measure_ms([&] {
+        fill_drain<Heap>(heap.data(), input);
+        bench::do_not_optimize(heap[0]);
+    });
+    char name[64];
+    std::snprintf(name, sizeof(name), "%s fill / drain", Heap::name());
+    if (base == 0) base = ms;
+    bench::print_row(name, input.size(), ms, base);
+}
+
+int main(int argc, char *argv[]) {
+    const size_t ops = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : (size_t(1) << 22);
+    const size_t sizes[] = {size_t(1) << 10, size_t(1) << 16, size_t(1) << 22};
+    for (size_t m : sizes) {
+        char title[64];
+        std::snprintf(title, sizeof(title), "m = %zu uint64_t", m);
+        bench::print_header(title);
+        double base_hold = 0, base_fill = 0, base_make = 0;
+        run_integers<stl_heap>(m, ops, base_hold, base_fill, base_make);
+        run_integers<std_heap>(m, ops, base_hold, base_fill, base_make);
+        run_integers<stl_dary_heap<4>>(m, ops, base_hold, base_fill, base_make);
+        run_integers<stl_dary_heap<8>>(m, ops, base_hold, base_fill, base_make);
+    }
+
+    bench::rng rng;
+    stl::vector<std::string> input(size_t(1) << 16);
+    for (auto &s : input) s = "key-" + std::to_string(rng.below(1000000000)) + "-padding-padding";
+    bench::print_header("m = 65536 std::string");
+    double base = 0;
+    run_strings<stl_heap>(input, base);
+    run_strings<std_heap>(input, base);
+    run_strings<stl_dary_heap<4>>(input, base);
+    run_strings<stl_dary_heap<8>>(input, base);
+    return 0;
+}
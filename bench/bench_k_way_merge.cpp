@@ -0,0 +1,170 @@
+// k 路有序序列合并的基准测试：总共 n 个元素平均分到 k 路，k 从 2 增长到 1024
+//   * 以逐个调用 stl::set_union 累加到结果上的做法为参照，第 i 次调用要重新拷贝前 i 路的结果，共 O(nk) 次拷贝
+//   * 两两合并：每轮把相邻的两路合并成一路，共 log2 k 轮，每个元素拷贝 log2 k 次
+//   * std::priority_queue 上的二叉堆合并
+//   * stl::k_way_merge(败者树)、stl::k_way_merge_unique 与 stl::multi_set_union，每个元素只拷贝一次
+//   * 交集：逐个调用 stl::set_intersection 与一次处理所有路的 stl::multi_set_intersection
+//   * std::string 元素(n / 16 个)，拷贝与比较的代价都更高
+// 用法：bench_k_way_merge [元素总数]
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <queue>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "multiway_merge.h"
+#include "vector.h"
+#include "bench_util.h"
+
+// 逐个调用 set_union，结果在两块缓冲区之间交替
+template<class T>
+__attribute__((noinline)) size_t chained_union(const std::vector<stl::pair<const T *, const T *>> &runs,
+                                               T *buf1, T *buf2) {
+    const T *first = runs[0].first, *last = runs[0].second;
+    T *out = buf1;
+    for (size_t i = 1; i < runs.size(); ++i) {
+        T *end = stl::set_union(first, last, runs[i].first, runs[i].second, out);
+        first = out, last = end;
+        out = out == buf1 ? buf2 : buf1;
+    }
+    return static_cast<size_t>(last - first);
+}
+
+// 两两合并，每轮的结果写到另一块缓冲区
+template<class T>
+__attribute__((noinline)) size_t pairwise_merge(const std::vector<stl::pair<const T *, const T *>> &runs,
+                                                T *buf1, T *buf2) {
+    std::vector<stl::pair<const T *, const T *>> cur(runs), next;
+    T *out = buf1;
+    while (cur.size() > 1) {
+        next.clear();
+        T *p = out;
+        for (size_t i = 0; i + 1 < cur.size(); i += 2) {
+            T *end = std::merge(cur[i].first, cur[i].second, cur[i + 1].first, cur[i + 1].second, p);
+            next.push_back(stl::pair<const T *, const T *>(p, end));
+            p = end;
+        }
+        if (cur.size() % 2) next.push_back(cur.back());
+        cur.swap(next);
+        out = out == buf1 ? buf2 : buf1;
+    }
+    return cur.empty() ? 0 : static_cast<size_t>(cur[0].second - cur[0].first);
+}
+
+typedef stl::pair<const uint32_t *, const uint32_t *> run_type;
+
+// 二叉堆合并
+__attribute__((noinline)) uint32_t *heap_merge(const std::vector<run_type> &runs, uint32_t *result) {
+    typedef std::pair<uint32_t, size_t> entry;
+    std::priority_queue<entry, std::vector<entry>, std::greater<entry>> heap;
+    std::vector<run_type> cur(runs);
+    for (size_t i = 0; i < cur.size(); ++i) {
+        if (cur[i].first != cur[i].second) heap.push(entry(*cur[i].first, i));
+    }
+    while (!heap.empty()) {
+        const size_t i = heap.top().second;
+        heap.pop();
+        *result++ = *cur[i].first++;
+        if (cur[i].first != cur[i].second) heap.push(entry(*cur[i].first, i));
+    }
+    return result;
+}
+
+// 逐个求交集
+__attribute__((noinline)) size_t chained_intersection(const std::vector<run_type> &runs,
+                                                      uint32_t *buf1, uint32_t *buf2) {
+    const uint32_t *first = runs[0].first, *last = runs[0].second;
+    uint32_t *out = buf1;
+    for (size_t i = 1; i < runs.size(); ++i) {
+        uint32_t *end = stl::set_intersection(first, last, runs[i].first, runs[i].second, out);
+        first = out, last = end;
+        out = out == buf1 ? buf2 : buf1;
+    }
+    return static_cast<size_t>(last - first);
+}
+
+// 把 data 平均分成 k 路，各自排序
+template<class T>
+std::vector<stl::pair<const T *, const T *>> make_runs(T *data, size_t n, size_t k) {
+    std::vector<stl::pair<const T *, const T *>> runs;
+    for (size_t i = 0; i < k; ++i) {
+        T *f = data + n * i / k, *l = data + n * (i + 1) / k;
+        std::sort(f, l);
+        runs.push_back(stl::pair<const T *, const T *>(f, l));
+    }
+    return runs;
+}
+
+static void run_integers(size_t n) {
+    bench::rng rng;
+    stl::vector<uint32_t> data(n), out(n), tmp(n);
+    for (size_t k = 2; k <= 1024 && k <= n; k *= 2) {
+        // 元素取自 [0, 4n)，每一路都覆盖整个范围
+        for (size_t i = 0; i < n; ++i) data[i] = static_cast<uint32_t>(rng.below(4 * n));
+        const std::vector<run_type> runs = make_runs(data.begin(), n, k);
+        char title[64];
+        std::snprintf(title, sizeof(title), "k = %zu, %zu uint32_t", k, n);
+        bench::print_header(title);
+
+        const double t0 = bench::measure_ms([&] {
+            bench::do_not_optimize(chained_union(runs, out.begin(), tmp.begin()));
+        });
+        bench::print_row("chained stl::set_union", n, t0);
+        bench::print_row("pairwise std::merge", n, bench::measure_ms([&] {
+            bench::do_not_optimize(pairwise_merge(runs, out.begin(), tmp.begin()));
+        }), t0);
+        bench::print_row("std::priority_queue merge", n, bench::measure_ms([&] {
+            bench::do_not_optimize(heap_merge(runs, out.begin()));
+        }), t0);
+        bench::print_row("stl::k_way_merge", n, bench::measure_ms([&] {
+            bench::do_not_optimize(stl::k_way_merge(runs.begin(), runs.end(), out.begin()));
+        }), t0);
+        bench::print_row("stl::k_way_merge_unique", n, bench::measure_ms([&] {
+            bench::do_not_optimize(stl::k_way_merge_unique(runs.begin(), runs.end(), out.begin()));
+        }), t0);
+        bench::print_row("stl::multi_set_union", n, bench::measure_ms([&] {
+            bench::do_not_optimize(stl::multi_set_union(runs.begin(), runs.end(), out.begin()));
+        }), t0);
+
+        const double t1 = bench::measure_ms([&] {
+            bench::do_not_optimize(chained_intersection(runs, out.begin(), tmp.begin()));
+        });
+        bench::print_row("chained stl::set_intersection", n, t1);
+        bench::print_row("stl::multi_set_intersection", n, bench::measure_ms([&] {
+            bench::do_not_optimize(stl::multi_set_intersection(runs.begin(), runs.end(), out.begin()));
+        }), t1);
+    }
+}
+
+static void run_strings(size_t n) {
+    bench::rng rng;
+    std::vector<std::string> data(n), out(n), tmp(n);
+    for (size_t k = 4; k <= 1024 && k <= n; k *= 4) {
+        for (size_t i = 0; i < n; ++i) data[i] = "key-" + std::to_string(rng.below(1000000000)) + "-padding-padding";
+        const auto runs = make_runs(data.data(), n, k);
+        char title[64];
+        std::snprintf(title, sizeof(title), "k = %zu, %zu std::string", k, n);
+        bench::print_header(title);
+
+        const double t0 = bench::measure_ms([&] {
+            bench::do_not_optimize(chained_union(runs, out.data(), tmp.data()));
+        });
+        bench::print_row("chained stl::set_union", n, t0);
+        bench::print_row("pairwise std::merge", n, bench::measure_ms([&] {
+            bench::do_not_optimize(pairwise_merge(runs, out.data(), tmp.data()));
+        }), t0);
+        bench::print_row("stl::k_way_merge", n, bench::measure_ms([&] {
+            bench::do_not_optimize(stl::k_way_merge(runs.begin(), runs.end(), out.data()));
+        }), t0);
+    }
+}
+
+int main(int argc, char *argv[]) {
+    const size_t n = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : (size_t(1) << 20);
+    run_integers(n);
+    run_strings(n / 16);
+    return 0;
+}
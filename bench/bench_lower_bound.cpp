@@ -0,0 +1,76 @@
+// 有序 stl::vector<uint64_t> 上的随机查找，表的大小从放得进 L1 到远超 L3
+//   * 带分支的二分查找(原来的 lower_bound)作为参照
+//   * std::lower_bound
+//   * stl::lower_bound：无分支 + 预取
+//   * stl::lower_bound_batch：一批查找逐层同步推进
+// 可用参数指定最大的表长：bench_lower_bound [max_n]
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "algo.h"
+#include "vector.h"
+#include "bench_util.h"
+
+// 带分支的二分查找
+__attribute__((noinline)) const uint64_t *branchy_lower_bound(const uint64_t *first, const uint64_t *last,
+                                                              uint64_t value) {
+    auto len = last - first;
+    while (len > 0) {
+        const auto half = len >> 1;
+        const uint64_t *middle = first + half;
+        if (*middle < value) {
+            first = middle + 1;
+            len = len - half - 1;
+        } else {
+            len = half;
+        }
+    }
+    return first;
+}
+
+int main(int argc, char **argv) {
+    const size_t max_n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : (size_t(1) << 26);
+    const size_t queries = 1000000;
+    bench::rng rng;
+    stl::vector<uint64_t> q;
+    q.reserve(queries);
+    stl::vector<const uint64_t *> out(queries);
+
+    for (size_t n = 1 << 10; n <= max_n; n <<= 3) {
+        // 偶数的表，查找的值一半命中
+        stl::vector<uint64_t> table;
+        table.reserve(n);
+        for (size_t i = 0; i < n; ++i) table.push_back(2 * i);
+        q.clear();
+        for (size_t i = 0; i < queries; ++i) q.push_back(rng.below(2 * n));
+        const uint64_t *first = table.begin(), *last = table.end();
+
+        char title[64];
+        std::snprintf(title, sizeof(title), "n = %zu (%zu KB)", n, n * sizeof(uint64_t) >> 10);
+        bench::print_header(title);
+
+        const double branchy = bench::measure_ms([&] {
+            for (size_t i = 0; i < queries; ++i) out[i] = branchy_lower_bound(first, last, q[i]);
+            bench::do_not_optimize(out[0]);
+        });
+        const double std_ms = bench::measure_ms([&] {
+            for (size_t i = 0; i < queries; ++i) out[i] = std::lower_bound(first, last, q[i]);
+            bench::do_not_optimize(out[0]);
+        });
+        const double stl_ms = bench::measure_ms([&] {
+            for (size_t i = 0; i < queries; ++i) out[i] = stl::lower_bound(first, last, q[i]);
+            bench::do_not_optimize(out[0]);
+        });
+        const double batch_ms = bench::measure_ms([&] {
+            stl::lower_bound_batch(first, last, q.begin(), q.end(), out.begin());
+            bench::do_not_optimize(out[0]);
+        });
+
+        bench::print_row("branchy binary search", queries, branchy);
+        bench::print_row("std::lower_bound", queries, std_ms, branchy);
+        bench::print_row("stl::lower_bound", queries, stl_ms, branchy);
+        bench::print_row("stl::lower_bound_batch", queries, batch_ms, branchy);
+    }
+    return 0;
+}
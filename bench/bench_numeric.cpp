@@ -0,0 +1,135 @@
+// 数值算法的基准测试：逐个计算的循环、顺序版本(指针上向量化)、执行策略版本(线程数从 1 翻倍增长到 hardware_concurrency)
+// 每一行的倍数是相对于逐个计算的循环的加速比
+// 用法：bench_numeric [元素个数] [最大线程数]，默认 2^24 个元素、hardware_concurrency 个线程
+
+#include <cstdlib>
+#include <thread>
+
+#include "numeric.h"
+#include "vector.h"
+#include "bench_util.h"
+
+static size_t max_threads = 1;
+
+template<class Loop, class Seq, class Par>
+static void run(const char *title, size_t n, Loop loop, Seq seq, Par par) {
+    char name[64];
+    bench::print_header(title);
+    const double loop_ms = bench::measure_ms(loop);
+    bench::print_row("scalar loop", n, loop_ms);
+    bench::print_row("sequential", n, bench::measure_ms(seq), loop_ms);
+    for (size_t t = 1; t <= max_threads; t *= 2) {
+        const double ms = bench::measure_ms([&] { par(stl::execution::par(t)); });
+        std::snprintf(name, sizeof(name), "execution::par threads=%zu", t);
+        bench::print_row(name, n, ms, loop_ms);
+    }
+}
+
+// 阻止编译器把逐个计算的循环向量化，作为比较的基准
+template<class T>
+static T opaque(T x) {
+    bench::do_not_optimize(x);
+    return x;
+}
+
+int main(int argc, char *argv[]) {
+    const size_t n = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : (1u << 24);
+    max_threads = argc > 2 ? static_cast<size_t>(std::strtoull(argv[2], nullptr, 10))
+                           : std::thread::hardware_concurrency();
+    if (max_threads == 0) max_threads = 1;
+
+    bench::rng rng;
+    stl::vector<uint32_t> u(n), u_out(n);
+    stl::vector<float> f(n), g(n), f_out(n);
+    stl::vector<double> d(n), e(n);
+    for (size_t i = 0; i < n; ++i) {
+        u[i] = static_cast<uint32_t>(rng.next());
+        f[i] = static_cast<float>(rng.below(1000)) / 1000.0f;
+        g[i] = static_cast<float>(rng.below(1000)) / 1000.0f;
+        d[i] = static_cast<double>(rng.below(1000)) / 1000.0;
+        e[i] = static_cast<double>(rng.below(1000)) / 1000.0;
+    }
+    const uint32_t *uf = u.data(), *ul = u.data() + n;
+    const float *ff = f.data(), *fl = f.data() + n;
+    const double *df = d.data(), *dl = d.data() + n;
+
+    run("reduce uint32_t", n,
+        [&] {
+            uint32_t s = 0;
+            for (size_t i = 0; i < n; ++i) s = opaque(s + uf[i]);
+            bench::do_not_optimize(s);
+        },
+        [&] { bench::do_not_optimize(stl::reduce(uf, ul, 0U)); },
+        [&](stl::execution::parallel_policy p) { bench::do_not_optimize(stl::reduce(p, uf, ul, 0U)); });
+
+    run("reduce float", n,
+        [&] { bench::do_not_optimize(stl::accumulate(ff, fl, 0.0f)); },
+        [&] { bench::do_not_optimize(stl::reduce(ff, fl, 0.0f)); },
+        [&](stl::execution::parallel_policy p) { bench::do_not_optimize(stl::reduce(p, ff, fl, 0.0f)); });
+
+    run("transform_reduce (dot) float", n,
+        [&] {
+            float s = 0;
+            for (size_t i = 0; i < n; ++i) s += ff[i] * g[i];
+            bench::do_not_optimize(s);
+        },
+        [&] { bench::do_not_optimize(stl::transform_reduce(ff, fl, g.data(), 0.0f)); },
+        [&](stl::execution::parallel_policy p) {
+            bench::do_not_optimize(stl::transform_reduce(p, ff, fl, g.data(), 0.0f));
+        });
+
+    run("transform_reduce (dot) double", n,
+        [&] {
+            double s = 0;
+            for (size_t i = 0; i < n; ++i) s += df[i] * e[i];
+            bench::do_not_optimize(s);
+        },
+        [&] { bench::do_not_optimize(stl::transform_reduce(df, dl, e.data(), 0.0)); },
+        [&](stl::execution::parallel_policy p) {
+            bench::do_not_optimize(stl::transform_reduce(p, df, dl, e.data(), 0.0));
+        });
+
+    run("inclusive_scan uint32_t", n,
+        [&] {
+            uint32_t s = 0;
+            for (size_t i = 0; i < n; ++i) u_out[i] = s = opaque(s + uf[i]);
+        },
+        [&] { stl::inclusive_scan(uf, ul, u_out.data()); },
+        [&](stl::execution::parallel_policy p) { stl::inclusive_scan(p, uf, ul, u_out.data()); });
+
+    run("exclusive_scan float", n,
+        [&] {
+            float s = 0;
+            for (size_t i = 0; i < n; ++i) {
+                f_out[i] = s;
+                s = opaque(s + ff[i]);
+            }
+        },
+        [&] { stl::exclusive_scan(ff, fl, f_out.data(), 0.0f); },
+        [&](stl::execution::parallel_policy p) { stl::exclusive_scan(p, ff, fl, f_out.data(), 0.0f); });
+
+    // 256 个桶：相邻元素常落在同一个桶中时，4 组计数的作用最明显
+    stl::vector<uint8_t> bytes(n);
+    for (size_t i = 0; i < n; ++i) bytes[i] = static_cast<uint8_t>(rng.below(4) == 0 ? rng.next() : 7);
+    const uint8_t *bf = bytes.data(), *bl = bytes.data() + n;
+    run("histogram uint8_t, 256 bins, skewed", n,
+        [&] {
+            stl::vector<size_t> h(256, 0);
+            for (size_t i = 0; i < n; ++i) ++h[bf[i]];
+            bench::do_not_optimize(h[7]);
+        },
+        [&] { bench::do_not_optimize(stl::histogram(bf, bl, 256)[7]); },
+        [&](stl::execution::parallel_policy p) { bench::do_not_optimize(stl::histogram(p, bf, bl, 256)[7]); });
+
+    run("histogram uint32_t, 65536 bins", n,
+        [&] {
+            stl::vector<size_t> h(65536, 0);
+            for (size_t i = 0; i < n; ++i) ++h[uf[i] >> 16];
+            bench::do_not_optimize(h[0]);
+        },
+        [&] { bench::do_not_optimize(stl::histogram(uf, ul, 65536, [](uint32_t x) { return x >> 16; })[0]); },
+        [&](stl::execution::parallel_policy p) {
+            bench::do_not_optimize(stl::histogram(p, uf, ul, 65536, [](uint32_t x) { return x >> 16; })[0]);
+        });
+    return 0;
+}
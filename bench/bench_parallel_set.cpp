@@ -0,0 +1,61 @@
+// stl::parallel_set_union / stl::parallel_set_intersection 的扩展性测试：线程数从 1 翻倍增长到 hardware_concurrency
+// 两个有序 uint32_t 序列各 n 个元素，取自 [0, 2n)，交集约占四成
+// parallel 行为 stl::parallel_set_union (或 stl::parallel_set_intersection)，倍数是相对于单线程 stl::set_union
+// (或 stl::set_intersection) 的加速比。每段都要先统计再写出，单核机器上多线程的行只反映两遍处理的开销
+// 用法：bench_parallel_set [每个序列的元素个数] [最大线程数]，默认 2^24 个、hardware_concurrency 个线程
+
+#include <cstdlib>
+#include <thread>
+
+#include "parallel_algo.h"
+#include "vector.h"
+#include "bench_util.h"
+
+static stl::vector<uint32_t> sorted_input(size_t n, bench::rng &rng) {
+    stl::vector<uint32_t> v;
+    v.reserve(n);
+    for (size_t i = 0; i < n; ++i) v.push_back(static_cast<uint32_t>(rng.below(2 * n)));
+    stl::sort(v.begin(), v.end());
+    return v;
+}
+
+int main(int argc, char *argv[]) {
+    const size_t n = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : (1u << 24);
+    size_t max_threads = argc > 2 ? static_cast<size_t>(std::strtoull(argv[2], nullptr, 10))
+                                  : std::thread::hardware_concurrency();
+    if (max_threads == 0) max_threads = 1;
+
+    bench::rng rng;
+    const stl::vector<uint32_t> a = sorted_input(n, rng), b = sorted_input(n, rng);
+    const uint32_t *af = a.begin(), *al = a.end(), *bf = b.begin(), *bl = b.end();
+    stl::vector<uint32_t> out(2 * n);
+    char name[64];
+
+    bench::print_header("set_union, two sorted uint32_t sequences");
+    const double union_ms = bench::measure_ms([&] {
+        bench::do_not_optimize(stl::set_union(af, al, bf, bl, out.begin()));
+    });
+    bench::print_row("stl::set_union", 2 * n, union_ms);
+    for (size_t t = 1; t <= max_threads; t *= 2) {
+        const double ms = bench::measure_ms([&] {
+            bench::do_not_optimize(stl::parallel_set_union(af, al, bf, bl, out.begin(), stl::transparent_less(), t));
+        });
+        std::snprintf(name, sizeof(name), "parallel threads=%zu", t);
+        bench::print_row(name, 2 * n, ms, union_ms);
+    }
+
+    bench::print_header("set_intersection, two sorted uint32_t sequences");
+    const double inter_ms = bench::measure_ms([&] {
+        bench::do_not_optimize(stl::set_intersection(af, al, bf, bl, out.begin()));
+    });
+    bench::print_row("stl::set_intersection", 2 * n, inter_ms);
+    for (size_t t = 1; t <= max_threads; t *= 2) {
+        const double ms = bench::measure_ms([&] {
+            bench::do_not_optimize(
+                    stl::parallel_set_intersection(af, al, bf, bl, out.begin(), stl::transparent_less(), t));
+        });
+        std::snprintf(name, sizeof(name), "parallel threads=%zu", t);
+        bench::print_row(name, 2 * n, ms, inter_ms);
+    }
+    return 0;
+}
@@ -0,0 +1,64 @@
+// stl::parallel_sort / stl::parallel_merge 的扩展性测试：线程数从 1 翻倍增长到 hardware_concurrency
+// 每一行的倍数是相对于单线程 stl::sort (或 stl::merge) 的加速比
+// 用法：bench_parallel_sort [元素个数] [最大线程数]，默认 2^24 个 uint32_t、hardware_concurrency 个线程
+
+#include <cstdlib>
+#include <thread>
+
+#include "parallel_algo.h"
+#include "vector.h"
+#include "bench_util.h"
+
+int main(int argc, char *argv[]) {
+    const size_t n = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : (1u << 24);
+    size_t max_threads = argc > 2 ? static_cast<size_t>(std::strtoull(argv[2], nullptr, 10))
+                                  : std::thread::hardware_concurrency();
+    if (max_threads == 0) max_threads = 1;
+
+    bench::rng rng;
+    stl::vector<uint32_t> input;
+    input.reserve(n);
+    for (size_t i = 0; i < n; ++i) input.push_back(static_cast<uint32_t>(rng.next()));
+    stl::vector<uint32_t> v;
+    char name[64];
+
+    bench::print_header("sort, random uint32_t");
+    const double seq_ms = bench::measure_ms([&] {
+        v = input;
+        stl::sort(v.begin(), v.end());
+        bench::do_not_optimize(v[0]);
+    });
+    bench::print_row("stl::sort", n, seq_ms);
+    for (size_t t = 1; t <= max_threads; t *= 2) {
+        const double ms = bench::measure_ms([&] {
+            v = input;
+            stl::parallel_sort(v.begin(), v.end(), stl::less<uint32_t>(), t);
+            bench::do_not_optimize(v[0]);
+        });
+        std::snprintf(name, sizeof(name), "stl::parallel_sort threads=%zu", t);
+        bench::print_row(name, n, ms, seq_ms);
+    }
+
+    // 两个各占一半的有序序列
+    const size_t half = n / 2;
+    stl::sort(input.begin(), input.begin() + half);
+    stl::sort(input.begin() + half, input.end());
+    stl::vector<uint32_t> out(n);
+
+    bench::print_header("merge, two sorted halves");
+    const double merge_ms = bench::measure_ms([&] {
+        stl::merge(input.begin(), input.begin() + half, input.begin() + half, input.end(), out.begin());
+        bench::do_not_optimize(out[0]);
+    });
+    bench::print_row("stl::merge", n, merge_ms);
+    for (size_t t = 1; t <= max_threads; t *= 2) {
+        const double ms = bench::measure_ms([&] {
+            stl::parallel_merge(input.begin(), input.begin() + half, input.begin() + half, input.end(),
+                                out.begin(), stl::less<uint32_t>(), t);
+            bench::do_not_optimize(out[0]);
+        });
+        std::snprintf(name, sizeof(name), "stl::parallel_merge threads=%zu", t);
+        bench::print_row(name, n, ms, merge_ms);
+    }
+    return 0;
+}
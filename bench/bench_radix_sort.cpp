@@ -0,0 +1,78 @@
+// stl::radix_sort 与比较排序 stl::sort 的对比
+//   * uint32_t / uint64_t / float 随机键
+//   * uint64_t 小范围键：高位字节全部相同，对应的趟数被跳过
+//   * 按整数字段排序的 16 字节记录
+//   * 随机字符串(MSD)
+
+#include <string>
+
+#include "algo.h"
+#include "radix_sort.h"
+#include "vector.h"
+#include "bench_util.h"
+
+struct record {
+    uint64_t key;
+    uint64_t payload;
+};
+
+template<class T, class Gen>
+stl::vector<T> make_input(size_t n, Gen gen) {
+    stl::vector<T> v;
+    v.reserve(n);
+    for (size_t i = 0; i < n; ++i) v.push_back(gen());
+    return v;
+}
+
+// 分别用 stl::sort 和 stl::radix_sort 排序 input 的副本
+template<class T, class Less, class KeyFn>
+void run(const char *title, const stl::vector<T> &input, Less less, KeyFn key_fn) {
+    char name[64];
+    stl::vector<T> v;
+    const double sort_ms = bench::measure_ms([&] {
+        v = input;
+        stl::sort(v.begin(), v.end(), less);
+        bench::do_not_optimize(v[0]);
+    });
+    const double radix_ms = bench::measure_ms([&] {
+        v = input;
+        stl::radix_sort(v.begin(), v.end(), key_fn);
+        bench::do_not_optimize(v[0]);
+    });
+    std::snprintf(name, sizeof(name), "stl::sort %s", title);
+    bench::print_row(name, input.size(), sort_ms);
+    std::snprintf(name, sizeof(name), "stl::radix_sort %s", title);
+    bench::print_row(name, input.size(), radix_ms, sort_ms);
+}
+
+int main() {
+    const size_t sizes[] = {1000, 100000, 10000000};
+    for (size_t n : sizes) {
+        bench::print_header("fixed-width keys");
+        bench::rng rng;
+        run("u32", make_input<uint32_t>(n, [&] { return static_cast<uint32_t>(rng.next()); }),
+            stl::less<uint32_t>(), stl::identity<uint32_t>());
+        run("u64", make_input<uint64_t>(n, [&] { return rng.next(); }),
+            stl::less<uint64_t>(), stl::identity<uint64_t>());
+        run("u64<65536", make_input<uint64_t>(n, [&] { return rng.below(65536); }),
+            stl::less<uint64_t>(), stl::identity<uint64_t>());
+        run("float", make_input<float>(n, [&] {
+                return static_cast<float>(static_cast<int64_t>(rng.next())) / 1e9f;
+            }), stl::less<float>(), stl::identity<float>());
+        run("record", make_input<record>(n, [&] { return record{rng.next(), 0}; }),
+            [](const record &a, const record &b) { return a.key < b.key; },
+            [](const record &r) { return r.key; });
+    }
+
+    const size_t string_sizes[] = {1000, 100000, 1000000};
+    for (size_t n : string_sizes) {
+        bench::print_header("strings");
+        bench::rng rng;
+        run("string", make_input<std::string>(n, [&] {
+            std::string s(8 + rng.below(16), ' ');
+            for (auto &c : s) c = static_cast<char>('a' + rng.below(26));
+            return s;
+        }), stl::less<std::string>(), stl::identity<std::string>());
+    }
+    return 0;
+}
@@ -0,0 +1,115 @@
+// reverse / reverse_copy 的基准测试，区间从 64 个元素每次扩大 4 倍，直到给定的字节数(默认 1GB)
+//   * 指针区间：以原来逐对 iter_swap 的实现为参照，另外列出 std::reverse 与元素大小为 1、2、4、8 字节的 stl::reverse
+//   * reverse_copy：逐个拷贝与向量化的版本，结果区间需要同样大的内存，最大只测到给定字节数的一半
+//   * stl::deque：按迭代器逐对交换与逐个缓冲区片段处理的版本
+// 小区间重复多次，使每个大小处理的元素总数大致相同
+// 用法：bench_reverse [最大字节数]
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "algo.h"
+#include "deque.h"
+#include "vector.h"
+#include "bench_util.h"
+
+// 原来的随机访问版本：逐对交换
+template<class RandomIter>
+__attribute__((noinline)) void pair_reverse(RandomIter first, RandomIter last) {
+    while (first < last) stl::iter_swap(first++, --last);
+}
+
+template<class BidirectionalIter, class OutputIter>
+__attribute__((noinline)) OutputIter loop_reverse_copy(BidirectionalIter first, BidirectionalIter last,
+                                                       OutputIter result) {
+    while (first != last) *result++ = *--last;
+    return result;
+}
+
+// 每个区间大小至少处理约 2^26 个元素
+static size_t repeat_for(size_t n) {
+    return n >= (size_t(1) << 26) ? 1 : (size_t(1) << 26) / n;
+}
+
+static void print_title(const char *what, size_t n, size_t reps) {
+    char title[96];
+    std::snprintf(title, sizeof(title), "%s, n = %zu, repeated %zu times", what, n, reps);
+    bench::print_header(title);
+}
+
+template<class T>
+void run_reverse(const char *what, size_t max_bytes) {
+    for (size_t n = 64; n * sizeof(T) <= max_bytes; n *= 4) {
+        stl::vector<T> a(n);
+        for (size_t i = 0; i < n; ++i) a[i] = static_cast<T>(i);
+        T *first = a.begin(), *last = a.begin() + n;
+        const size_t reps = repeat_for(n);
+        print_title(what, n, reps);
+        const double t0 = bench::measure_ms([&] {
+            for (size_t r = 0; r < reps; ++r) pair_reverse(first, last);
+            bench::do_not_optimize(a[0]);
+        });
+        const double t1 = bench::measure_ms([&] {
+            for (size_t r = 0; r < reps; ++r) std::reverse(first, last);
+            bench::do_not_optimize(a[0]);
+        });
+        const double t2 = bench::measure_ms([&] {
+            for (size_t r = 0; r < reps; ++r) stl::reverse(first, last);
+            bench::do_not_optimize(a[0]);
+        });
+        bench::print_row("old pairwise reverse", n, t0);
+        bench::print_row("std::reverse", n, t1, t0);
+        bench::print_row("stl::reverse", n, t2, t0);
+    }
+}
+
+static void run_reverse_copy(size_t max_bytes) {
+    for (size_t n = 64; n * sizeof(uint32_t) <= max_bytes / 2; n *= 4) {
+        stl::vector<uint32_t> a(n), out(n);
+        for (size_t i = 0; i < n; ++i) a[i] = static_cast<uint32_t>(i);
+        const uint32_t *first = a.begin(), *last = a.begin() + n;
+        const size_t reps = repeat_for(n);
+        print_title("reverse_copy uint32_t", n, reps);
+        const double t0 = bench::measure_ms([&] {
+            for (size_t r = 0; r < reps; ++r) loop_reverse_copy(first, last, out.begin());
+            bench::do_not_optimize(out[0]);
+        });
+        const double t1 = bench::measure_ms([&] {
+            for (size_t r = 0; r < reps; ++r) stl::reverse_copy(first, last, out.begin());
+            bench::do_not_optimize(out[0]);
+        });
+        bench::print_row("element-wise reverse_copy", n, t0);
+        bench::print_row("stl::reverse_copy", n, t1, t0);
+    }
+}
+
+static void run_deque(size_t max_bytes) {
+    for (size_t n = 64; n * sizeof(int) <= max_bytes; n *= 4) {
+        stl::deque<int> d;
+        for (size_t i = 0; i < n; ++i) d.push_back(static_cast<int>(i));
+        d.push_front(-1);   // 首元素不在缓冲区的开头，两端的片段错开
+        const size_t reps = repeat_for(n);
+        print_title("reverse stl::deque<int>", n, reps);
+        const double t0 = bench::measure_ms([&] {
+            for (size_t r = 0; r < reps; ++r) pair_reverse(d.begin(), d.end());
+            bench::do_not_optimize(d.front());
+        });
+        const double t1 = bench::measure_ms([&] {
+            for (size_t r = 0; r < reps; ++r) stl::reverse(d.begin(), d.end());
+            bench::do_not_optimize(d.front());
+        });
+        bench::print_row("old pairwise reverse", n, t0);
+        bench::print_row("stl::reverse (by buffer)", n, t1, t0);
+    }
+}
+
+int main(int argc, char *argv[]) {
+    const size_t max_bytes = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : (size_t(1) << 30);
+    run_reverse<uint8_t>("reverse uint8_t", max_bytes);
+    run_reverse<uint16_t>("reverse uint16_t", max_bytes);
+    run_reverse<uint32_t>("reverse uint32_t", max_bytes);
+    run_reverse<uint64_t>("reverse uint64_t", max_bytes);
+    run_reverse_copy(max_bytes);
+    run_deque(max_bytes);
+    return 0;
+}
@@ -0,0 +1,85 @@
+// stl::rotate 在指针区间上的基准测试，元素为 4、16、128 字节，区间约 32MB，左侧长度取若干值
+//   * 以原来逐个判断边界的 gcd juggling 实现为参照，另外列出 std::rotate
+//   * 左侧很短或很长时直接用栈上的缓冲区，其余情况 block swap，较短的一侧变短后也改用缓冲区
+// 用法：bench_rotate [区间字节数]
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "algo.h"
+#include "vector.h"
+#include "bench_util.h"
+
+template<size_t Size>
+struct blob {
+    uint32_t data[Size / 4];
+};
+
+// 原来的随机访问版本：默认构造 tmp，每一步都要判断是否越界
+template<class RandomIter>
+__attribute__((noinline)) RandomIter juggling_rotate(RandomIter first, RandomIter middle, RandomIter last) {
+    auto n = last - first;
+    auto l = middle - first;
+    auto r = n - l;
+    auto result = first + (last - middle);
+    if (l == r) {
+        std::swap_ranges(first, middle, middle);
+        return result;
+    }
+    auto cycle_times = stl::rgcd(n, l);
+    for (auto i = 0; i < cycle_times; ++i) {
+        auto tmp = *first;
+        auto p = first;
+        if (l < r) {
+            for (auto j = 0; j < r / cycle_times; ++j) {
+                if (p > first + r) {
+                    *p = *(p - r);
+                    p -= r;
+                }
+                *p = *(p + l);
+                p += l;
+            }
+        } else {
+            for (auto j = 0; j < l / cycle_times - 1; ++j) {
+                if (p < last - l) {
+                    *p = *(p + l);
+                    p += l;
+                }
+                *p = *(p - r);
+                p -= r;
+            }
+        }
+        *p = tmp;
+        ++first;
+    }
+    return result;
+}
+
+template<class T>
+void run(const char *type, size_t bytes) {
+    const size_t n = bytes / sizeof(T);
+    stl::vector<T> a(n);
+    for (size_t i = 0; i < n; ++i) a[i].data[0] = static_cast<uint32_t>(i);
+    T *first = a.begin(), *last = a.begin() + n;
+
+    const size_t shifts[] = {1, 100, n / 3, n / 2 - 1, n - 100};
+    for (size_t k : shifts) {
+        char title[96];
+        std::snprintf(title, sizeof(title), "%s, n = %zu, middle = first + %zu", type, n, k);
+        bench::print_header(title);
+        const double t0 = bench::measure_ms([&] { bench::do_not_optimize(juggling_rotate(first, first + k, last)); });
+        const double t1 = bench::measure_ms([&] { bench::do_not_optimize(std::rotate(first, first + k, last)); });
+        const double t2 = bench::measure_ms([&] { bench::do_not_optimize(stl::rotate(first, first + k, last)); });
+        bench::print_row("old juggling rotate", n, t0);
+        bench::print_row("std::rotate", n, t1, t0);
+        bench::print_row("stl::rotate", n, t2, t0);
+    }
+}
+
+int main(int argc, char *argv[]) {
+    const size_t bytes = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : (32u << 20);
+    run<blob<4>>("4-byte elements", bytes);
+    run<blob<16>>("16-byte elements", bytes);
+    run<blob<128>>("128-byte elements", bytes);
+    return 0;
+}
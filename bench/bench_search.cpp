@@ -0,0 +1,120 @@
+// 子序列查找的基准测试，在本地生成的两种语料上进行，约 32 MB
+//   * 文本：从一个小词表中随机取词组成的句子
+//   * 日志：时间戳、级别、模块名、请求编号组成的行
+// 每个模式都不在语料中出现(只在末尾放一次)，需要扫描整个语料。
+// 以逐个位置比较的 stl::search(..., comp) 为参照，另外列出 std::search 与 std::boyer_moore_horspool_searcher
+
+#include <algorithm>
+#include <functional>
+#include <string>
+
+#include "algo.h"
+#include "searcher.h"
+#include "bench_util.h"
+
+static const char *const kWords[] = {
+        "the", "of", "and", "to", "in", "is", "that", "for", "it", "as", "was", "with", "be", "by", "on",
+        "not", "he", "this", "are", "or", "his", "from", "at", "which", "but", "have", "an", "had", "they",
+        "you", "were", "their", "one", "all", "we", "can", "her", "has", "there", "been", "if", "more",
+        "when", "will", "would", "who", "so", "no", "memory", "allocator", "container", "iterator"};
+
+static std::string make_text(bench::rng &rng, size_t n) {
+    std::string s;
+    s.reserve(n + 64);
+    while (s.size() < n) {
+        s += kWords[rng.below(sizeof(kWords) / sizeof(kWords[0]))];
+        s += rng.below(12) == 0 ? ". " : " ";
+    }
+    return s;
+}
+
+static std::string make_log(bench::rng &rng, size_t n) {
+    static const char *const levels[] = {"INFO", "INFO", "INFO", "DEBUG", "WARN", "ERROR"};
+    static const char *const modules[] = {"http", "db", "cache", "scheduler", "auth"};
+    std::string s;
+    s.reserve(n + 128);
+    char line[128];
+    for (uint64_t t = 0; s.size() < n; ++t) {
+        std::snprintf(line, sizeof(line), "2023-10-18 12:%02u:%02u.%03u [%s] %s: request %llu done in %llu ms\n",
+                      unsigned(t / 60000 % 60), unsigned(t / 1000 % 60), unsigned(t % 1000),
+                      levels[rng.below(6)], modules[rng.below(5)],
+                      static_cast<unsigned long long>(rng.below(1000000)),
+                      static_cast<unsigned long long>(rng.below(500)));
+        s += line;
+    }
+    return s;
+}
+
+static void run(const char *corpus_name, const std::string &text, const std::string &pat) {
+    const std::string corpus = text + pat;      // 唯一的匹配位于末尾
+    const char *first = corpus.data(), *last = corpus.data() + corpus.size();
+    const char *pfirst = pat.data(), *plast = pat.data() + pat.size();
+    const size_t n = corpus.size();
+
+    char title[128];
+    std::snprintf(title, sizeof(title), "%s, pattern \"%s\" (m = %zu)", corpus_name, pat.c_str(), pat.size());
+    bench::print_header(title);
+
+    const double naive = bench::measure_ms([&] {
+        bench::do_not_optimize(stl::search(first, last, pfirst, plast, std::equal_to<char>()));
+    });
+    const double std_search = bench::measure_ms([&] {
+        bench::do_not_optimize(std::search(first, last, pfirst, plast));
+    });
+    const double std_bmh = bench::measure_ms([&] {
+        std::boyer_moore_horspool_searcher<const char *> searcher(pfirst, plast);
+        bench::do_not_optimize(std::search(first, last, searcher));
+    });
+    const double stl_search = bench::measure_ms([&] {
+        bench::do_not_optimize(stl::search(first, last, pfirst, plast));
+    });
+    const double bmh = bench::measure_ms([&] {
+        bench::do_not_optimize(stl::search(first, last, stl::boyer_moore_horspool_searcher<const char *>(pfirst, plast)));
+    });
+    const double two_way = bench::measure_ms([&] {
+        bench::do_not_optimize(stl::search(first, last, stl::two_way_searcher<const char *>(pfirst, plast)));
+    });
+    // 从后往前查找时把唯一的匹配放在开头
+    const std::string reversed = pat + text;
+    const char *rfirst = reversed.data(), *rlast = reversed.data() + reversed.size();
+    const double find_end = bench::measure_ms([&] {
+        bench::do_not_optimize(stl::find_end(rfirst, rlast, pfirst, plast));
+    });
+    const double std_find_end = bench::measure_ms([&] {
+        bench::do_not_optimize(std::find_end(rfirst, rlast, pfirst, plast));
+    });
+
+    bench::print_row("stl::search (naive, comp)", n, naive);
+    bench::print_row("std::search", n, std_search, naive);
+    bench::print_row("std::boyer_moore_horspool", n, std_bmh, naive);
+    bench::print_row("stl::search (simd filter)", n, stl_search, naive);
+    bench::print_row("stl::boyer_moore_horspool", n, bmh, naive);
+    bench::print_row("stl::two_way_searcher", n, two_way, naive);
+    bench::print_row("std::find_end", n, std_find_end, naive);
+    bench::print_row("stl::find_end", n, find_end, naive);
+}
+
+int main() {
+    const size_t n = 32 << 20;
+    bench::rng rng;
+    const std::string text = make_text(rng, n);
+    const std::string log = make_log(rng, n);
+
+    run("text", text, "then");
+    run("text", text, "container allocator memory");
+    run("text", text, "the memory of the allocator was not the iterator of the container that it had");
+    run("log", log, "[FATAL]");
+    run("log", log, "request 1000000 done");
+    run("log", log, "2023-10-18 12:59:59.999 [ERROR] scheduler: request 1000001");
+
+    // search_n：查找连续的空格
+    std::string spaced = text;
+    spaced += "        ";
+    const char *first = spaced.data(), *last = spaced.data() + spaced.size();
+    bench::print_header("search_n, 8 spaces");
+    const double std_n = bench::measure_ms([&] { bench::do_not_optimize(std::search_n(first, last, 8, ' ')); });
+    const double stl_n = bench::measure_ms([&] { bench::do_not_optimize(stl::search_n(first, last, 8, ' ')); });
+    bench::print_row("std::search_n", spaced.size(), std_n);
+    bench::print_row("stl::search_n", spaced.size(), stl_n, std_n);
+    return 0;
+}
@@ -0,0 +1,88 @@
+// 有序 uint32_t 列表(如倒排列表)求交集的基准测试：较长的列表固定为 n 个元素，较短的列表为 n / ratio 个，ratio 从 1 增长到 4096
+//   * 以原来逐个合并的实现为参照，另外列出 std::set_intersection
+//   * 分别强制使用逐个合并、分块比较与 galloping，用来确定 SET_GALLOP_RATIO
+//   * stl::set_intersection 与只计数的 stl::set_intersection_size
+// 用法：bench_set_intersection [较长列表的元素个数]
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "set_algo.h"
+#include "vector.h"
+#include "bench_util.h"
+
+// 原来的实现：逐个合并
+template<class InputIter1, class InputIter2, class OutputIter>
+__attribute__((noinline)) OutputIter old_set_intersection(InputIter1 first1, InputIter1 last1,
+                                                          InputIter2 first2, InputIter2 last2,
+                                                          OutputIter result) {
+    while (first1 != last1 && first2 != last2) {
+        if (*first1 < *first2) ++first1;
+        else if (*first1 > *first2) ++first2;
+        else {
+            *result = *first1;
+            ++first1, ++first2, ++result;
+        }
+    }
+    return result;
+}
+
+// 从 [0, universe) 中随机取 n 个不同的数，升序排列
+static stl::vector<uint32_t> posting_list(size_t n, uint32_t universe, bench::rng &rng) {
+    stl::vector<uint32_t> v(n);
+    for (size_t i = 0; i < n; ++i) v[i] = static_cast<uint32_t>(rng.below(universe));
+    std::sort(v.begin(), v.end());
+    v.erase(std::unique(v.begin(), v.end()), v.end());
+    return v;
+}
+
+int main(int argc, char *argv[]) {
+    const size_t n = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : (size_t(1) << 22);
+    const uint32_t universe = static_cast<uint32_t>(4 * n);
+    bench::rng rng;
+    const stl::vector<uint32_t> large = posting_list(n, universe, rng);
+    stl::vector<uint32_t> out(large.size());
+    const uint32_t *lf = large.begin(), *ll = large.end();
+
+    for (size_t ratio = 1; ratio <= 4096 && n / ratio > 0; ratio *= 4) {
+        const stl::vector<uint32_t> small = posting_list(n / ratio, universe, rng);
+        const uint32_t *sf = small.begin(), *sl = small.end();
+        char title[96];
+        std::snprintf(title, sizeof(title), "%zu x %zu uint32_t (ratio %zu)", small.size(), large.size(), ratio);
+        bench::print_header(title);
+        const size_t total = small.size() + large.size();
+
+        const double t0 = bench::measure_ms([&] {
+            bench::do_not_optimize(old_set_intersection(sf, sl, lf, ll, out.begin()));
+        });
+        bench::print_row("old set_intersection", total, t0);
+        bench::print_row("std::set_intersection", total, bench::measure_ms([&] {
+            bench::do_not_optimize(std::set_intersection(sf, sl, lf, ll, out.begin()));
+        }), t0);
+
+        stl::transparent_less comp;
+        bench::print_row("forced merge", total, bench::measure_ms([&] {
+            stl::set_output_sink<uint32_t *> sink{out.begin()};
+            stl::set_intersection_merge(sf, sl, lf, ll, sink, comp);
+            bench::do_not_optimize(sink.result);
+        }), t0);
+        bench::print_row("forced block compare", total, bench::measure_ms([&] {
+            stl::set_output_sink<uint32_t *> sink{out.begin()};
+            stl::simd_set_intersection(sf, sl, lf, ll, sink);
+            bench::do_not_optimize(sink.result);
+        }), t0);
+        bench::print_row("forced galloping", total, bench::measure_ms([&] {
+            stl::set_output_sink<uint32_t *> sink{out.begin()};
+            stl::set_intersection_gallop2(sf, sl, lf, ll, sink, comp);
+            bench::do_not_optimize(sink.result);
+        }), t0);
+
+        bench::print_row("stl::set_intersection", total, bench::measure_ms([&] {
+            bench::do_not_optimize(stl::set_intersection(sf, sl, lf, ll, out.begin()));
+        }), t0);
+        bench::print_row("stl::set_intersection_size", total, bench::measure_ms([&] {
+            bench::do_not_optimize(stl::set_intersection_size(sf, sl, lf, ll));
+        }), t0);
+    }
+    return 0;
+}
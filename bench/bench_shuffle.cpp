@@ -0,0 +1,154 @@
+// 随机重排与抽样的吞吐量测试
+//   * 随机数：rand() % n、std::uniform_int_distribution 与 bounded_rand 生成有界随机数的速度
+//   * shuffle：以原来 srand + rand() % n 的 random_shuffle 为参照，比较 std::shuffle 与各引擎下的 stl::shuffle，
+//     另外列出不预取、逐个生成位置的 Fisher-Yates，区间分别放得进缓存与远大于缓存
+//   * sample：前向迭代器的选择抽样、输入迭代器的蓄水池抽样与 std::sample
+//   * 执行策略版本的 shuffle，线程数从 1 翻倍增长到 hardware_concurrency
+// 用法：bench_shuffle [最大线程数]
+
+#include <algorithm>
+#include <cstdlib>
+#include <ctime>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "execution.h"
+#include "random.h"
+#include "vector.h"
+#include "bench_util.h"
+
+// 原来的 random_shuffle：每次调用都重新播种，rand() % n 有偏差
+template<class RandomIter>
+__attribute__((noinline)) void rand_shuffle(RandomIter first, RandomIter last) {
+    srand((unsigned) time(0));
+    for (auto i = first + 1; i != last; ++i) {
+        std::iter_swap(i, first + (rand() % (i - first + 1)));
+    }
+}
+
+// 不预取、逐个生成位置的 Fisher-Yates
+template<class T, class URBG>
+__attribute__((noinline)) void plain_shuffle(T *first, T *last, URBG &g) {
+    for (ptrdiff_t i = last - first - 1; i > 0; --i) {
+        std::swap(first[i], first[stl::bounded_rand(g, static_cast<uint64_t>(i) + 1)]);
+    }
+}
+
+// 只支持单遍读取的迭代器
+struct input_iter {
+    typedef stl::input_iterator_tag iterator_category;
+    typedef uint32_t value_type;
+    typedef ptrdiff_t difference_type;
+    typedef const uint32_t *pointer;
+    typedef const uint32_t &reference;
+
+    const uint32_t *p;
+
+    reference operator*() const { return *p; }
+
+    input_iter &operator++() {
+        ++p;
+        return *this;
+    }
+
+    bool operator!=(const input_iter &rhs) const { return p != rhs.p; }
+
+    bool operator==(const input_iter &rhs) const { return p == rhs.p; }
+};
+
+static void bench_bounded(size_t draws) {
+    bench::print_header("bounded random numbers in [0, i + 1)");
+    const double t0 = bench::measure_ms([&] {
+        uint64_t s = 0;
+        for (size_t i = 0; i < draws; ++i) s += static_cast<uint64_t>(rand()) % (i + 1);
+        bench::do_not_optimize(s);
+    });
+    bench::print_row("rand() % n", draws, t0);
+    std::mt19937_64 mt(1);
+    const double t1 = bench::measure_ms([&] {
+        uint64_t s = 0;
+        for (size_t i = 0; i < draws; ++i) s += std::uniform_int_distribution<uint64_t>(0, i)(mt);
+        bench::do_not_optimize(s);
+    });
+    bench::print_row("std::uniform_int_distribution", draws, t1, t0);
+    stl::wyrand wy(1);
+    const double t2 = bench::measure_ms([&] {
+        uint64_t s = 0;
+        for (size_t i = 0; i < draws; ++i) s += stl::bounded_rand(wy, i + 1);
+        bench::do_not_optimize(s);
+    });
+    bench::print_row("bounded_rand, wyrand", draws, t2, t0);
+    stl::xoshiro256pp xo(1);
+    const double t3 = bench::measure_ms([&] {
+        uint64_t s = 0;
+        for (size_t i = 0; i < draws; ++i) s += stl::bounded_rand(xo, i + 1);
+        bench::do_not_optimize(s);
+    });
+    bench::print_row("bounded_rand, xoshiro256++", draws, t3, t0);
+}
+
+static void bench_shuffle(size_t n) {
+    char title[64];
+    std::snprintf(title, sizeof(title), "shuffle, n = %zu uint32_t", n);
+    bench::print_header(title);
+    stl::vector<uint32_t> a(n);
+    for (size_t i = 0; i < n; ++i) a[i] = static_cast<uint32_t>(i);
+    uint32_t *first = a.begin(), *last = a.begin() + n;
+
+    const double t0 = bench::measure_ms([&] { rand_shuffle(first, last); });
+    bench::print_row("old random_shuffle (rand)", n, t0);
+    std::mt19937_64 mt(1);
+    bench::print_row("std::shuffle, mt19937_64", n, bench::measure_ms([&] { std::shuffle(first, last, mt); }), t0);
+    bench::print_row("stl::shuffle, mt19937_64", n, bench::measure_ms([&] { stl::shuffle(first, last, mt); }), t0);
+    stl::xoshiro256pp xo(1);
+    bench::print_row("stl::shuffle, xoshiro256++", n, bench::measure_ms([&] { stl::shuffle(first, last, xo); }), t0);
+    stl::wyrand wy(1);
+    bench::print_row("Fisher-Yates without prefetch", n, bench::measure_ms([&] { plain_shuffle(first, last, wy); }), t0);
+    bench::print_row("stl::shuffle, wyrand", n, bench::measure_ms([&] { stl::shuffle(first, last, wy); }), t0);
+}
+
+static void bench_sample(size_t n, size_t k) {
+    char title[64];
+    std::snprintf(title, sizeof(title), "sample %zu of %zu", k, n);
+    bench::print_header(title);
+    stl::vector<uint32_t> a(n), out(k);
+    for (size_t i = 0; i < n; ++i) a[i] = static_cast<uint32_t>(i);
+    const uint32_t *first = a.begin(), *last = a.begin() + n;
+    std::mt19937_64 mt(1);
+    const double t0 = bench::measure_ms([&] { std::sample(first, last, out.begin(), k, mt); });
+    bench::print_row("std::sample, mt19937_64", n, t0);
+    stl::wyrand wy(1);
+    bench::print_row("selection sampling, wyrand", n,
+                     bench::measure_ms([&] { stl::sample(first, last, out.begin(), k, wy); }), t0);
+    bench::print_row("reservoir sampling, wyrand", n, bench::measure_ms([&] {
+        stl::sample(input_iter{first}, input_iter{last}, out.begin(), k, wy);
+    }), t0);
+}
+
+int main(int argc, char *argv[]) {
+    size_t max_threads = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10))
+                                  : std::thread::hardware_concurrency();
+    if (max_threads == 0) max_threads = 1;
+
+    bench_bounded(size_t(1) << 24);
+    bench_shuffle(size_t(1) << 16);     // 放得进 L2
+    bench_shuffle(size_t(1) << 24);     // 64MB，远大于缓存
+    bench_sample(size_t(1) << 24, 1000);
+    bench_sample(size_t(1) << 24, size_t(1) << 20);
+
+    const size_t n = size_t(1) << 24;
+    bench::print_header("execution::par shuffle, n = 2^24 uint32_t");
+    stl::vector<uint32_t> a(n);
+    for (size_t i = 0; i < n; ++i) a[i] = static_cast<uint32_t>(i);
+    stl::wyrand wy(1);
+    const double seq_ms = bench::measure_ms([&] { stl::shuffle(a.begin(), a.end(), wy); });
+    bench::print_row("sequential", n, seq_ms);
+    char name[64];
+    for (size_t t = 1; t <= max_threads; t *= 2) {
+        const double ms = bench::measure_ms([&] { stl::shuffle(stl::execution::par(t), a.begin(), a.end(), wy); });
+        std::snprintf(name, sizeof(name), "execution::par threads=%zu", t);
+        bench::print_row(name, n, ms, seq_ms);
+    }
+    return 0;
+}
@@ -0,0 +1,75 @@
+// stl::sort 的基准测试，输入分布：随机、有序、逆序、风琴管(先升后降)、大量重复
+//   * stl::sort(less)      ：算术类型 + 默认比较，使用无分支的块划分
+//   * stl::sort(lambda)    ：自定义比较，使用普通的划分
+//   * std::sort            ：作为参照
+
+#include <algorithm>
+#include <functional>
+
+#include "algo.h"
+#include "vector.h"
+#include "bench_util.h"
+
+enum pattern {
+    kRandom, kSorted, kReversed, kOrganPipe, kManyDuplicates, kPatternCount
+};
+
+const char *pattern_name(int p) {
+    static const char *names[] = {"random", "sorted", "reversed", "organ-pipe", "many-duplicates"};
+    return names[p];
+}
+
+stl::vector<uint32_t> make_input(int p, size_t n) {
+    bench::rng rng;
+    stl::vector<uint32_t> v;
+    v.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        switch (p) {
+            case kRandom:
+                v.push_back(static_cast<uint32_t>(rng.next()));
+                break;
+            case kSorted:
+                v.push_back(static_cast<uint32_t>(i));
+                break;
+            case kReversed:
+                v.push_back(static_cast<uint32_t>(n - i));
+                break;
+            case kOrganPipe:
+                v.push_back(static_cast<uint32_t>(i < n / 2 ? i : n - i));
+                break;
+            default:
+                v.push_back(static_cast<uint32_t>(rng.below(16)));
+                break;
+        }
+    }
+    return v;
+}
+
+template<class Sort>
+double time_sort(const stl::vector<uint32_t> &input, Sort sort) {
+    stl::vector<uint32_t> v;
+    return bench::measure_ms([&] {
+        v = input;
+        sort(v.begin(), v.end());
+        bench::do_not_optimize(v[0]);
+    });
+}
+
+int main() {
+    const size_t sizes[] = {1000, 100000, 10000000};
+    for (int p = 0; p < kPatternCount; ++p) {
+        bench::print_header(pattern_name(p));
+        for (size_t n : sizes) {
+            const auto input = make_input(p, n);
+            const double std_ms = time_sort(input, [](uint32_t *f, uint32_t *l) { std::sort(f, l); });
+            const double less_ms = time_sort(input, [](uint32_t *f, uint32_t *l) { stl::sort(f, l); });
+            const double lambda_ms = time_sort(input, [](uint32_t *f, uint32_t *l) {
+                stl::sort(f, l, [](uint32_t a, uint32_t b) { return a < b; });
+            });
+            bench::print_row("std::sort", n, std_ms);
+            bench::print_row("stl::sort(less, branchless)", n, less_ms, std_ms);
+            bench::print_row("stl::sort(lambda)", n, lambda_ms, std_ms);
+        }
+    }
+    return 0;
+}
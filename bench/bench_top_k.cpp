@@ -0,0 +1,61 @@
+// top-k 选择的基准测试，n 个随机 uint32_t 中选出最小(或最大)的 k 个
+//   * k 远小于 n：partial_sort 走堆，top_k 累加器只需与门槛比较一次
+//   * k 约为 n / 2：partial_sort 改用 nth_element + sort
+// 每组以 std::partial_sort 为参照
+
+#include <algorithm>
+
+#include "algo.h"
+#include "top_k.h"
+#include "vector.h"
+#include "bench_util.h"
+
+int main() {
+    const size_t n = 10000000;
+    bench::rng rng;
+    stl::vector<uint32_t> input;
+    input.reserve(n);
+    for (size_t i = 0; i < n; ++i) input.push_back(static_cast<uint32_t>(rng.next()));
+
+    const size_t ks[] = {10, 1000, 10000, 100000, n / 2};
+    stl::vector<uint32_t> v;
+    for (size_t k : ks) {
+        char title[64];
+        std::snprintf(title, sizeof(title), "k = %zu", k);
+        bench::print_header(title);
+
+        const double std_ms = bench::measure_ms([&] {
+            v = input;
+            std::partial_sort(v.begin(), v.begin() + k, v.end());
+            bench::do_not_optimize(v[0]);
+        });
+        const double partial_ms = bench::measure_ms([&] {
+            v = input;
+            stl::partial_sort(v.begin(), v.begin() + k, v.end());
+            bench::do_not_optimize(v[0]);
+        });
+        const double nth_ms = bench::measure_ms([&] {
+            v = input;
+            stl::nth_element(v.begin(), v.begin() + k, v.end());
+            bench::do_not_optimize(v[0]);
+        });
+        const double std_nth_ms = bench::measure_ms([&] {
+            v = input;
+            std::nth_element(v.begin(), v.begin() + k, v.end());
+            bench::do_not_optimize(v[0]);
+        });
+        // 累加器不需要拷贝输入，也不修改输入
+        const double top_k_ms = bench::measure_ms([&] {
+            stl::top_k<uint32_t, stl::greater<uint32_t>> acc(k);
+            acc.push(input.begin(), input.end());
+            bench::do_not_optimize(acc.threshold());
+        });
+
+        bench::print_row("std::partial_sort", n, std_ms);
+        bench::print_row("stl::partial_sort", n, partial_ms, std_ms);
+        bench::print_row("std::nth_element (unsorted)", n, std_nth_ms, std_ms);
+        bench::print_row("stl::nth_element (unsorted)", n, nth_ms, std_ms);
+        bench::print_row("stl::top_k (unsorted)", n, top_k_ms, std_ms);
+    }
+    return 0;
+}
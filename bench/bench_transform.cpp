@@ -0,0 +1,108 @@
+// stl::transform 在连续区间上的基准测试，区间长度分别为 256、4096、1M
+//   * int -> int   : x * 3 + 1
+//   * int -> float : 类型转换
+//   * float, float -> float : a * b + 1
+//   * 原地变换 int : x ^ (x >> 3)
+// 以逐个处理的循环为参照，另外列出 std::transform。-O2 与 -O3 下的结果可能差别很大，
+// 编译器在 -O2 下通常不为需要运行时重叠检查的循环做向量化
+
+#include <algorithm>
+
+#include "algo.h"
+#include "vector.h"
+#include "bench_util.h"
+
+template<class T, class U, class Op>
+__attribute__((noinline)) U *scalar_transform(const T *first, const T *last, U *result, Op op) {
+    for (; first != last; ++first, ++result) *result = op(*first);
+    return result;
+}
+
+template<class T1, class T2, class U, class Op>
+__attribute__((noinline)) U *scalar_transform(const T1 *first1, const T1 *last1, const T2 *first2, U *result, Op op) {
+    for (; first1 != last1; ++first1, ++first2, ++result) *result = op(*first1, *first2);
+    return result;
+}
+
+void run(size_t n) {
+    const size_t total = 100000000;
+    const size_t rounds = total / n;
+    stl::vector<int> a(n), c(n);
+    stl::vector<float> x(n), y(n), z(n);
+    bench::rng rng;
+    for (size_t i = 0; i < n; ++i) {
+        a[i] = static_cast<int>(rng.below(1000));
+        x[i] = static_cast<float>(rng.below(1000)) / 7;
+        y[i] = static_cast<float>(rng.below(1000)) / 3;
+    }
+    const int *first = a.begin(), *last = a.end();
+    int *out = c.begin();
+    float *fout = z.begin();
+
+    char title[64];
+    std::snprintf(title, sizeof(title), "n = %zu (x%zu)", n, rounds);
+    bench::print_header(title);
+
+    auto affine = [](int v) { return v * 3 + 1; };
+    const double t0 = bench::measure_rounds_ms(rounds, [&] {
+        bench::do_not_optimize(scalar_transform(first, last, out, affine));
+    });
+    const double t1 = bench::measure_rounds_ms(rounds, [&] {
+        bench::do_not_optimize(std::transform(first, last, out, affine));
+    });
+    const double t2 = bench::measure_rounds_ms(rounds, [&] {
+        bench::do_not_optimize(stl::transform(first, last, out, affine));
+    });
+    bench::print_row("scalar int -> int", total, t0);
+    bench::print_row("std::transform int -> int", total, t1, t0);
+    bench::print_row("stl::transform int -> int", total, t2, t0);
+
+    auto to_float = [](int v) { return static_cast<float>(v); };
+    const double f0 = bench::measure_rounds_ms(rounds, [&] {
+        bench::do_not_optimize(scalar_transform(first, last, fout, to_float));
+    });
+    const double f1 = bench::measure_rounds_ms(rounds, [&] {
+        bench::do_not_optimize(std::transform(first, last, fout, to_float));
+    });
+    const double f2 = bench::measure_rounds_ms(rounds, [&] {
+        bench::do_not_optimize(stl::transform(first, last, fout, to_float));
+    });
+    bench::print_row("scalar int -> float", total, f0);
+    bench::print_row("std::transform int -> float", total, f1, f0);
+    bench::print_row("stl::transform int -> float", total, f2, f0);
+
+    const float *xf = x.begin(), *xl = x.end(), *yf = y.begin();
+    auto fma = [](float u, float v) { return u * v + 1.0f; };
+    const double b0 = bench::measure_rounds_ms(rounds, [&] {
+        bench::do_not_optimize(scalar_transform(xf, xl, yf, fout, fma));
+    });
+    const double b1 = bench::measure_rounds_ms(rounds, [&] {
+        bench::do_not_optimize(std::transform(xf, xl, yf, fout, fma));
+    });
+    const double b2 = bench::measure_rounds_ms(rounds, [&] {
+        bench::do_not_optimize(stl::transform(xf, xl, yf, fout, fma));
+    });
+    bench::print_row("scalar binary float", total, b0);
+    bench::print_row("std::transform binary float", total, b1, b0);
+    bench::print_row("stl::transform binary float", total, b2, b0);
+
+    auto mix = [](int v) { return v ^ (v >> 3); };
+    const double i0 = bench::measure_rounds_ms(rounds, [&] {
+        bench::do_not_optimize(scalar_transform(out, out + n, out, mix));
+    });
+    const double i1 = bench::measure_rounds_ms(rounds, [&] {
+        bench::do_not_optimize(std::transform(out, out + n, out, mix));
+    });
+    const double i2 = bench::measure_rounds_ms(rounds, [&] {
+        bench::do_not_optimize(stl::transform(out, out + n, out, mix));
+    });
+    bench::print_row("scalar in place", total, i0);
+    bench::print_row("std::transform in place", total, i1, i0);
+    bench::print_row("stl::transform in place", total, i2, i0);
+}
+
+int main() {
+    const size_t sizes[] = {256, 4096, 1000000};
+    for (size_t n : sizes) run(n);
+    return 0;
+}
@@ -0,0 +1,94 @@
+#ifndef MYCPPSTL_BENCH_UTIL_H
+#define MYCPPSTL_BENCH_UTIL_H
+
+// 基准测试使用的一些小工具：计时、防止编译器优化掉结果、可复现的伪随机数
+// 基准测试应当以 Release 模式编译：cmake -DCMAKE_BUILD_TYPE=Release
+
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <cstddef>
+
+namespace bench {
+
+    // 计时器
+    class timer {
+    public:
+        timer() : start_(std::chrono::steady_clock::now()) {}
+
+        void reset() { start_ = std::chrono::steady_clock::now(); }
+
+        double elapsed_ms() const {
+            return std::chrono::duration<double, std::milli>(
+                    std::chrono::steady_clock::now() - start_).count();
+        }
+
+    private:
+        std::chrono::steady_clock::time_point start_;
+    };
+
+    // 阻止编译器把只用于计时的计算当作死代码删除
+    template<class T>
+    inline void do_not_optimize(const T &value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const T *sink;
+        sink = &value;
+#endif
+    }
+
+    // 重复执行repeat次，取最短的一次耗时(ms)，减少调度等噪声的影响
+    template<class Func>
+    double measure_ms(Func f, int repeat = 3) {
+        double best = 0;
+        for (int i = 0; i < repeat; ++i) {
+            timer t;
+            f();
+            const double ms = t.elapsed_ms();
+            if (i == 0 || ms < best) best = ms;
+        }
+        return best;
+    }
+
+    // 每次测量把 f 重复执行 rounds 轮，使小区间的耗时也能被计时，返回 rounds 轮的总耗时中最短的一次(ms)
+    template<class Func>
+    double measure_rounds_ms(size_t rounds, Func f, int repeat = 3) {
+        return measure_ms([&] {
+            for (size_t r = 0; r < rounds; ++r) f();
+        }, repeat);
+    }
+
+    // xorshift64*，固定种子保证每次运行的输入相同
+    class rng {
+    public:
+        explicit rng(uint64_t seed = 0x9E3779B97F4A7C15ull) : state_(seed ? seed : 1) {}
+
+        uint64_t next() {
+            state_ ^= state_ >> 12;
+            state_ ^= state_ << 25;
+            state_ ^= state_ >> 27;
+            return state_ * 0x2545F4914F6CDD1Dull;
+        }
+
+        // [0, n)内的随机数，仅用于生成测试数据，不追求无偏
+        uint64_t below(uint64_t n) { return next() % n; }
+
+    private:
+        uint64_t state_;
+    };
+
+    inline void print_header(const char *title) {
+        std::printf("\n== %s ==\n", title);
+    }
+
+    inline void print_row(const char *name, size_t n, double ms, double baseline_ms = 0) {
+        if (baseline_ms > 0)
+            std::printf("%-32s n=%-10zu %10.3f ms  x%.2f\n", name, n, ms, baseline_ms / ms);
+        else
+            std::printf("%-32s n=%-10zu %10.3f ms\n", name, n, ms);
+    }
+
+}   // namespace bench
+
+#endif //MYCPPSTL_BENCH_UTIL_H
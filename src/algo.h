@@ -10,13 +10,16 @@
 #pragma warning(disable : 4244)
 #endif
 
+#include <cmath>
 #include <cstddef>
+#include <cstring>
 #include <ctime>
 
 #include "algobase.h"
 #include "memory.h"
 #include "heap_algo.h"
 #include "functional.h"
+#include "random.h"
 
 namespace stl {
 
@@ -55,12 +58,28 @@ namespace stl {
 // 对[first, last)区间内的元素与给定值进行比较，缺省使用 operator==，返回元素相等的个数
 /*****************************************************************************************/
     template<class InputIter, class T>
-    size_t count(InputIter first, InputIter last, const T &value) {
+    size_t unchecked_count(InputIter first, InputIter last, const T &value) {
         size_t n = 0;
         for (; first != last; ++first) if (*first == value) ++n;
         return n;
     }
 
+    // 为连续的算术类型区间提供向量化的特化版本
+    template<class Tp, class Up>
+    typename std::enable_if<stl::simd_value<Tp, Up>::value, size_t>::type
+    unchecked_count(Tp *first, Tp *last, const Up &value) {
+        typedef typename std::remove_const<Tp>::type value_type;
+        const value_type v = static_cast<value_type>(value);
+        // value 无法用元素类型表示时，不会有元素与它相等
+        if (static_cast<Up>(v) != value) return 0;
+        return stl::simd_count<value_type>(first, last, v);
+    }
+
+    template<class InputIter, class T>
+    size_t count(InputIter first, InputIter last, const T &value) {
+        return unchecked_count(first, last, value);
+    }
+
 /*****************************************************************************************/
 // count_if
 // 对[first, last)区间内的每个元素都进行一元 unary_pred 操作，返回结果为 true 的个数
@@ -77,23 +96,62 @@ namespace stl {
 // 在[first, last)区间内找到等于 value 的元素，返回指向该元素的迭代器
 /*****************************************************************************************/
     template<class InputIter, class T>
-    InputIter find(InputIter first, InputIter last, const T &value) {
+    InputIter unchecked_find(InputIter first, InputIter last, const T &value) {
         for (; first != last; ++first) if (*first == value) return first;
         return first;
     }
 
+    // 为连续的算术类型区间提供向量化的特化版本，单字节的整数使用 memchr
+    template<class Tp, class Up>
+    typename std::enable_if<stl::simd_value<Tp, Up>::value, Tp *>::type
+    unchecked_find(Tp *first, Tp *last, const Up &value) {
+        typedef typename std::remove_const<Tp>::type value_type;
+        const value_type v = static_cast<value_type>(value);
+        // value 无法用元素类型表示时(如在 char 中找 300，或 value 为 NaN)，不会有元素与它相等
+        if (static_cast<Up>(v) != value) return last;
+        return first + (stl::simd_find<value_type>(first, last, v) - first);
+    }
+
+    template<class InputIter, class T>
+    InputIter find(InputIter first, InputIter last, const T &value) {
+        return unchecked_find(first, last, value);
+    }
+
 
 /*****************************************************************************************/
 // find_if
 // 在[first, last)区间内找到第一个令一元操作 unary_pred 为 true 的元素并返回指向该元素的迭代器
 /*****************************************************************************************/
-
     template<class InputIter, class UnaryPredicate>
-    InputIter find_if(InputIter first, InputIter last, UnaryPredicate unary_pred) {
+    InputIter find_if_dispatch(InputIter first, InputIter last, UnaryPredicate unary_pred,
+                               stl::input_iterator_tag) {
         for (; first != last; ++first) if (unary_pred(*first)) return first;
         return first;
     }
 
+    // 随机访问迭代器：任意的谓词无法向量化，改为每轮展开检查 4 个元素，减少循环条件的判断
+    template<class RandomIter, class UnaryPredicate>
+    RandomIter find_if_dispatch(RandomIter first, RandomIter last, UnaryPredicate unary_pred,
+                                stl::random_access_iterator_tag) {
+        for (auto trip = (last - first) >> 2; trip > 0; --trip) {
+            if (unary_pred(*first)) return first;
+            ++first;
+            if (unary_pred(*first)) return first;
+            ++first;
+            if (unary_pred(*first)) return first;
+            ++first;
+            if (unary_pred(*first)) return first;
+            ++first;
+        }
+        for (; first != last; ++first) if (unary_pred(*first)) return first;
+        return first;
+    }
+
+    template<class InputIter, class UnaryPredicate>
+    InputIter find_if(InputIter first, InputIter last, UnaryPredicate unary_pred) {
+        return stl::find_if_dispatch(first, last, unary_pred, stl::iterator_category(first));
+    }
+
 /*****************************************************************************************/
 // find_if_not
 // 在[first, last)区间内找到第一个令一元操作 unary_pred 为 false 的元素并返回指向该元素的迭代器
@@ -104,39 +162,24 @@ namespace stl {
         return first;
     }
 
+    // 两个区间能否按字节查找：元素为相同的单字节整数类型
+    template<class Tp, class Up>
+    struct search_byte_range : m_bool_constant<
+            std::is_integral<typename std::remove_const<Tp>::type>::value && sizeof(Tp) == 1 &&
+            !std::is_volatile<Tp>::value &&
+            std::is_same<typename std::remove_const<Tp>::type, typename std::remove_const<Up>::type>::value> {
+    };
+
 /*****************************************************************************************/
 // search
 // 在[first1, last1)中查找[first2, last2)的首次出现点
+// 另有接受查找器(见 searcher.h)的版本：stl::search(first, last, searcher)
 /*****************************************************************************************/
-    // TODO:没看懂干什么
-    template<class ForwardIter1, class ForwardIter2>
-    ForwardIter1 search(ForwardIter1 first1, ForwardIter1 last1,
-                        ForwardIter2 first2, ForwardIter2 last2) {
-        auto d1 = stl::distance(first1, last1);
-        auto d2 = stl::distance(first2, last2);
-        if (d1 < d2) return last1;
-        auto curr1 = first1, curr2 = first2;
-        while (curr2 != last2) {
-            if (*curr1 == *curr2) {
-                ++curr1;
-                ++curr2;
-            } else {
-                if (d1 == d2) {
-                    return last1;
-                } else {
-                    curr1 = ++first1;
-                    curr2 = first2;
-                    --d1;
-                }
-            }
-        }
-        return first1;
-    }
-
+    // 逐个位置比较，最坏情况下为 O(n * m)
     template<class ForwardIter1, class ForwardIter2, class Compared>
     ForwardIter1
-    search(ForwardIter1 first1, ForwardIter1 last1,
-           ForwardIter2 first2, ForwardIter2 last2, Compared comp) {
+    unchecked_search(ForwardIter1 first1, ForwardIter1 last1,
+                     ForwardIter2 first2, ForwardIter2 last2, Compared comp) {
         auto d1 = stl::distance(first1, last1);
         auto d2 = stl::distance(first2, last2);
         if (d1 < d2)
@@ -160,60 +203,170 @@ namespace stl {
         return first1;
     }
 
+    // 连续的字节序列使用向量化的首尾字节过滤，见 simd.h 中的 simd_search
+    template<class Tp, class Up>
+    typename std::enable_if<stl::search_byte_range<Tp, Up>::value, Tp *>::type
+    unchecked_search(Tp *first1, Tp *last1, Up *first2, Up *last2, stl::transparent_equal) {
+        typedef typename std::remove_const<Tp>::type value_type;
+        return first1 + (stl::simd_search<value_type>(first1, last1, first2, last2) - first1);
+    }
+
+    template<class ForwardIter1, class ForwardIter2>
+    ForwardIter1 search(ForwardIter1 first1, ForwardIter1 last1,
+                        ForwardIter2 first2, ForwardIter2 last2) {
+        return stl::unchecked_search(first1, last1, first2, last2, stl::transparent_equal());
+    }
+
+    template<class ForwardIter1, class ForwardIter2, class Compared>
+    ForwardIter1
+    search(ForwardIter1 first1, ForwardIter1 last1,
+           ForwardIter2 first2, ForwardIter2 last2, Compared comp) {
+        return stl::unchecked_search(first1, last1, first2, last2, comp);
+    }
+
+    // 使用查找器，searcher(first, last) 返回匹配的区间
+    template<class ForwardIter, class Searcher>
+    ForwardIter search(ForwardIter first, ForwardIter last, const Searcher &searcher) {
+        return searcher(first, last).first;
+    }
+
 /*****************************************************************************************/
 // search_n
 // 在[first, last)中查找连续 n 个 value 所形成的子序列，返回一个迭代器指向该子序列的起始处
 /*****************************************************************************************/
-    template<class ForwardIter, class Size, class T>
-    ForwardIter search_n(ForwardIter first, ForwardIter last, Size n, T value) {
-        if (n <= 0) return first;
-        first = stl::find(first, last, value);
+    // search_n_dispatch 的 forward_iterator_tag 版本
+    template<class ForwardIter, class Size, class T, class Compared>
+    ForwardIter search_n_dispatch(ForwardIter first, ForwardIter last, Size n, const T &value,
+                                  Compared comp, stl::forward_iterator_tag) {
+        while (first != last && !comp(*first, value)) ++first;
         while (first != last) {
-            auto m = n - 1, i = first;
+            auto m = n - 1;
+            auto i = first;
             ++i;
-            while (i != last && m != 0 && *i == value) --m, ++i;
+            while (i != last && m != 0 && comp(*i, value)) ++i, --m;
             if (m == 0) return first;
-            else first = stl::find(i, last, value);
+            while (i != last && !comp(*i, value)) ++i;
+            first = i;
         }
         return last;
     }
 
-    template<class ForwardIter, class Size, class T, class Compared>
-    ForwardIter search_n(ForwardIter first, ForwardIter last, Size n, T value, Compared comp) {
-        if (n <= 0) return first;
-        while (first != last) {
-            // TODO: 为什么是comp
-            if (comp(*first, value)) break;
-            ++first;
-        }
-        while (first != last) {
-            auto m = n - 1, i = first;
-            ++i;
-            while (i != last && m != 0 && comp(*i, value)) ++i, --m;
-            if (m == 0)return first;
-            else {
-                while (i != last) {
-                    if (comp(*i, last))break;
-                    ++i;
-                }
-                first = i;
-            }
+    // search_n_dispatch 的 random_access_iterator_tag 版本
+    // 候选区间[cur, cur + n)从末尾往前检查，遇到不匹配的元素 p 时，包含 p 的候选都不可能，直接跳到 p 之后；
+    // 跳过去时 p 之后已经检查过的元素成为新候选的开头，记在 known 中不再重复检查。连续相等的元素较少时，
+    // 每个候选只需检查一两个元素就能跳过接近 n 个位置
+    template<class RandomIter, class Size, class T, class Compared>
+    RandomIter search_n_dispatch(RandomIter first, RandomIter last, Size n, const T &value,
+                                 Compared comp, stl::random_access_iterator_tag) {
+        typedef typename iterator_traits<RandomIter>::difference_type difference_type;
+        const difference_type count = static_cast<difference_type>(n);
+        RandomIter cur = first;
+        difference_type known = 0;
+        while (last - cur >= count) {
+            difference_type i = count;
+            while (i > known && comp(cur[i - 1], value)) --i;
+            if (i == known) return cur;
+            cur += i;
+            known = count - i;
         }
         return last;
     }
 
+    template<class ForwardIter, class Size, class T>
+    ForwardIter search_n(ForwardIter first, ForwardIter last, Size n, const T &value) {
+        if (n <= 0) return first;
+        return stl::search_n_dispatch(first, last, n, value, stl::transparent_equal(), stl::iterator_category(first));
+    }
+
+    // 重载版本使用函数对象 comp(*it, value) 判断元素是否匹配
+    template<class ForwardIter, class Size, class T, class Compared>
+    ForwardIter search_n(ForwardIter first, ForwardIter last, Size n, const T &value, Compared comp) {
+        if (n <= 0) return first;
+        return stl::search_n_dispatch(first, last, n, value, comp, stl::iterator_category(first));
+    }
+
 /*****************************************************************************************/
 // find_end
 // 在[first1, last1)区间中查找[first2, last2)最后一次出现的地方，若不存在返回 last1
 /*****************************************************************************************/
-// find_end_dispatch 的 forward_iterator_tag 版本
-    template<class ForwardIter1, class ForwardIter2>
+    // find_end_dispatch 的 forward_iterator_tag 版本：反复向后查找，记下最后一次找到的位置
+    template<class ForwardIter1, class ForwardIter2, class Compared>
     ForwardIter1
     find_end_dispatch(ForwardIter1 first1, ForwardIter1 last1,
-                      ForwardIter2 first2, ForwardIter2 last2,
+                      ForwardIter2 first2, ForwardIter2 last2, Compared comp,
                       forward_iterator_tag, forward_iterator_tag) {
+        if (first2 == last2) return last1;
+        ForwardIter1 result = last1;
+        while (true) {
+            ForwardIter1 pos = stl::unchecked_search(first1, last1, first2, last2, comp);
+            if (pos == last1) return result;
+            result = pos;
+            first1 = pos;
+            ++first1;
+        }
+    }
+
+    // find_end_dispatch 的 bidirectional_iterator_tag 版本：用反向迭代器从后往前查找，找到的第一个即为结果
+    template<class BidirectionalIter1, class BidirectionalIter2, class Compared>
+    BidirectionalIter1
+    find_end_dispatch(BidirectionalIter1 first1, BidirectionalIter1 last1,
+                      BidirectionalIter2 first2, BidirectionalIter2 last2, Compared comp,
+                      bidirectional_iterator_tag, bidirectional_iterator_tag) {
+        typedef stl::reverse_iterator<BidirectionalIter1> reverse_iter1;
+        typedef stl::reverse_iterator<BidirectionalIter2> reverse_iter2;
+        if (first2 == last2) return last1;
+        reverse_iter1 rlast1(first1);
+        reverse_iter1 rresult = stl::unchecked_search(reverse_iter1(last1), rlast1,
+                                                      reverse_iter2(last2), reverse_iter2(first2), comp);
+        if (rresult == rlast1) return last1;
+        // rresult 指向匹配的最后一个元素，往前退 m - 1 个得到起点
+        BidirectionalIter1 result = rresult.base();
+        stl::advance(result, -stl::distance(first2, last2));
+        return result;
+    }
+
+    template<class ForwardIter1, class ForwardIter2, class Compared>
+    ForwardIter1
+    unchecked_find_end(ForwardIter1 first1, ForwardIter1 last1,
+                       ForwardIter2 first2, ForwardIter2 last2, Compared comp) {
+        return stl::find_end_dispatch(first1, last1, first2, last2, comp,
+                                      stl::iterator_category(first1), stl::iterator_category(first2));
+    }
+
+    // 连续的字节序列使用反向的 Horspool 算法：窗口从末尾往前移动，先比较窗口的首字节，
+    // 移动的距离由窗口首字节在模式中(除首字节外)最靠前的出现位置决定，没有出现时直接移动 m
+    template<class Tp, class Up>
+    typename std::enable_if<stl::search_byte_range<Tp, Up>::value, Tp *>::type
+    unchecked_find_end(Tp *first1, Tp *last1, Up *first2, Up *last2, stl::transparent_equal) {
+        const size_t n = static_cast<size_t>(last1 - first1);
+        const size_t m = static_cast<size_t>(last2 - first2);
+        if (m == 0 || n < m) return last1;
+        size_t shift[256];
+        for (size_t c = 0; c < 256; ++c) shift[c] = m;
+        for (size_t i = m - 1; i > 0; --i) shift[static_cast<unsigned char>(first2[i])] = i;
+        size_t pos = n - m;
+        while (true) {
+            if (first1[pos] == first2[0] && std::memcmp(first1 + pos + 1, first2 + 1, m - 1) == 0) {
+                return first1 + pos;
+            }
+            const size_t k = shift[static_cast<unsigned char>(first1[pos])];
+            if (pos < k) return last1;
+            pos -= k;
+        }
+    }
 
+    template<class ForwardIter1, class ForwardIter2>
+    ForwardIter1
+    find_end(ForwardIter1 first1, ForwardIter1 last1,
+             ForwardIter2 first2, ForwardIter2 last2) {
+        return stl::unchecked_find_end(first1, last1, first2, last2, stl::transparent_equal());
+    }
 
+    template<class ForwardIter1, class ForwardIter2, class Compared>
+    ForwardIter1
+    find_end(ForwardIter1 first1, ForwardIter1 last1,
+             ForwardIter2 first2, ForwardIter2 last2, Compared comp) {
+        return stl::unchecked_find_end(first1, last1, first2, last2, comp);
     }
 
 /*****************************************************************************************/
@@ -282,6 +435,52 @@ namespace stl {
     }
 
 
+/*****************************************************************************************/
+// branchless_lower_bound / branchless_upper_bound
+// 随机访问迭代器上无分支的二分查找，lower_bound / upper_bound / equal_range 的随机访问版本使用它们
+/*****************************************************************************************/
+    // 预取 it 所指的元素，只对指针有效，其他迭代器什么也不做
+    template<class Iter>
+    inline void search_prefetch(Iter) noexcept {}
+
+    template<class T>
+    inline void search_prefetch(T *p) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(p);
+#endif
+    }
+
+    // 区间长度 len 每轮减去一半，但起点 first 是否前进由比较结果决定，编译器生成条件传送而不是分支，
+    // 避免了无法预测的分支。len 的变化与比较结果无关，所以下一轮可能访问的两个位置是确定的，提前预取它们，
+    // 表很大时可以把两层的内存访问重叠起来
+    template<class RandomIter, class T, class Compared>
+    RandomIter branchless_lower_bound(RandomIter first, RandomIter last, const T &value, Compared comp) {
+        auto len = last - first;
+        if (len == 0) return first;
+        while (len > 1) {
+            const auto half = len >> 1;
+            stl::search_prefetch(first + (half >> 1));
+            stl::search_prefetch(first + (half + (half >> 1)));
+            first = comp(first[half], value) ? first + half : first;
+            len -= half;
+        }
+        return comp(*first, value) ? first + 1 : first;
+    }
+
+    template<class RandomIter, class T, class Compared>
+    RandomIter branchless_upper_bound(RandomIter first, RandomIter last, const T &value, Compared comp) {
+        auto len = last - first;
+        if (len == 0) return first;
+        while (len > 1) {
+            const auto half = len >> 1;
+            stl::search_prefetch(first + (half >> 1));
+            stl::search_prefetch(first + (half + (half >> 1)));
+            first = comp(value, first[half]) ? first : first + half;
+            len -= half;
+        }
+        return comp(value, *first) ? first : first + 1;
+    }
+
 /*****************************************************************************************/
 // lower_bound
 // 在[first, last)中查找第一个不小于 value 的元素，并返回指向它的迭代器，若没有则返回 last
@@ -308,24 +507,11 @@ namespace stl {
         return first;
     }
 
-    // lbound_dispatch 的 random_access_iterator_tag 版本
+    // lbound_dispatch 的 random_access_iterator_tag 版本，使用无分支的二分查找，见 branchless_lower_bound
     template<class RandomIter, class T>
     RandomIter lbound_dispatch(RandomIter first, RandomIter last, const T &value,
                                random_access_iterator_tag) {
-        auto len = last - first;
-        auto half = len;
-        RandomIter middle;
-        while (len > 0) {
-            half = len >> 1;
-            middle = first + half;
-            if (*middle < value) {
-                first = middle + 1;
-                len = len - half - 1;
-            } else {
-                len = half;
-            }
-        }
-        return first;
+        return stl::branchless_lower_bound(first, last, value, stl::transparent_less());
     }
 
     template<class ForwardIter, class T>
@@ -362,20 +548,7 @@ namespace stl {
     RandomIter
     lbound_dispatch(RandomIter first, RandomIter last,
                     const T &value, random_access_iterator_tag, Compared comp) {
-        auto len = last - first;
-        auto half = len;
-        RandomIter middle;
-        while (len > 0) {
-            half = len >> 1;
-            middle = first + half;
-            if (comp(*middle, value)) {
-                first = middle + 1;
-                len = len - half - 1;
-            } else {
-                len = half;
-            }
-        }
-        return first;
+        return stl::branchless_lower_bound(first, last, value, comp);
     }
 
     template<class ForwardIter, class T, class Compared>
@@ -411,25 +584,12 @@ namespace stl {
         return first;
     }
 
-    // ubound_dispatch 的 random_access_iterator_tag 版本
+    // ubound_dispatch 的 random_access_iterator_tag 版本，使用无分支的二分查找，见 branchless_upper_bound
     template<class RandomIter, class T>
     RandomIter
     ubound_dispatch(RandomIter first, RandomIter last,
                     const T &value, random_access_iterator_tag) {
-        auto len = last - first;
-        auto half = len;
-        RandomIter middle;
-        while (len > 0) {
-            half = len >> 1;
-            middle = first + half;
-            if (value < *middle) {
-                len = half;
-            } else {
-                first = middle + 1;
-                len = len - half - 1;
-            }
-        }
-        return first;
+        return stl::branchless_upper_bound(first, last, value, stl::transparent_less());
     }
 
     template<class ForwardIter, class T>
@@ -467,20 +627,7 @@ namespace stl {
     RandomIter
     ubound_dispatch(RandomIter first, RandomIter last,
                     const T &value, random_access_iterator_tag, Compared comp) {
-        auto len = last - first;
-        auto half = len;
-        RandomIter middle;
-        while (len > 0) {
-            half = len >> 1;
-            middle = first + half;
-            if (comp(value, *middle)) {
-                len = half;
-            } else {
-                first = middle + 1;
-                len = len - half - 1;
-            }
-        }
-        return first;
+        return stl::branchless_upper_bound(first, last, value, comp);
     }
 
     template<class ForwardIter, class T, class Compared>
@@ -545,32 +692,37 @@ namespace stl {
                 return stl::pair<ForwardIter, ForwardIter>(left, right);
             }
         }
-        return stl::pair<ForwardIter, ForwardIter>(last, last);
+        // 没有相等的元素时，返回的区间为空，位于 value 应当插入的位置
+        return stl::pair<ForwardIter, ForwardIter>(first, first);
     }
 
     // erange_dispatch 的 random_access_iterator_tag 版本
+    // 先用无分支的二分查找找到左端，相等的元素通常不多，右端从左端开始倍增步长查找
+    template<class RandomIter, class T, class Compared>
+    stl::pair<RandomIter, RandomIter>
+    erange_dispatch(RandomIter first, RandomIter last,
+                    const T &value, random_access_iterator_tag, Compared comp) {
+        RandomIter left = stl::branchless_lower_bound(first, last, value, comp);
+        if (left == last || comp(value, *left)) {
+            return stl::pair<RandomIter, RandomIter>(left, left);
+        }
+        const auto len = last - left;
+        typename iterator_traits<RandomIter>::difference_type lo = 0, step = 1;
+        // 循环保持 left[lo] 与 value 相等，结束时右端位于 left + (lo, min(lo + step, len)]
+        while (lo + step < len && !comp(value, left[lo + step])) {
+            lo += step;
+            step <<= 1;
+        }
+        const auto hi = lo + step < len ? lo + step : len;
+        RandomIter right = stl::branchless_upper_bound(left + lo + 1, left + hi, value, comp);
+        return stl::pair<RandomIter, RandomIter>(left, right);
+    }
+
     template<class RandomIter, class T>
     stl::pair<RandomIter, RandomIter>
     erange_dispatch(RandomIter first, RandomIter last,
                     const T &value, random_access_iterator_tag) {
-        auto len = last - first;
-        auto half = len;
-        RandomIter middle, left, right;
-        while (len > 0) {
-            half = len >> 1;
-            middle = first + half;
-            if (*middle < value) {
-                first = middle + 1;
-                len = len - half - 1;
-            } else if (value < *middle) {
-                len = half;
-            } else {
-                left = stl::lower_bound(first, middle, value);
-                right = stl::upper_bound(++middle, first + len, value);
-                return stl::pair<RandomIter, RandomIter>(left, right);
-            }
-        }
-        return stl::pair<RandomIter, RandomIter>(last, last);
+        return stl::erange_dispatch(first, last, value, random_access_iterator_tag(), stl::transparent_less());
     }
 
     template<class ForwardIter, class T>
@@ -580,7 +732,7 @@ namespace stl {
     }
 
     // 重载版本使用函数对象 comp 代替比较操作
-    // erange_dispatch 的 forward iterator 版本
+    // erange_dispatch 的 forward iterator 版本，random access iterator 版本见上
     template<class ForwardIter, class T, class Compared>
     stl::pair<ForwardIter, ForwardIter>
     erange_dispatch(ForwardIter first, ForwardIter last,
@@ -605,32 +757,8 @@ namespace stl {
                 return stl::pair<ForwardIter, ForwardIter>(left, right);
             }
         }
-        return stl::pair<ForwardIter, ForwardIter>(last, last);
-    }
-
-    // erange_dispatch 的 random access iterator 版本
-    template<class RandomIter, class T, class Compared>
-    stl::pair<RandomIter, RandomIter>
-    erange_dispatch(RandomIter first, RandomIter last,
-                    const T &value, random_access_iterator_tag, Compared comp) {
-        auto len = last - first;
-        auto half = len;
-        RandomIter middle, left, right;
-        while (len > 0) {
-            half = len >> 1;
-            middle = first + half;
-            if (comp(*middle, value)) {
-                first = middle + 1;
-                len = len - half - 1;
-            } else if (comp(value, *middle)) {
-                len = half;
-            } else {
-                left = stl::lower_bound(first, middle, value, comp);
-                right = stl::upper_bound(++middle, first + len, value, comp);
-                return stl::pair<RandomIter, RandomIter>(left, right);
-            }
-        }
-        return stl::pair<RandomIter, RandomIter>(last, last);
+        // 没有相等的元素时，返回的区间为空，位于 value 应当插入的位置
+        return stl::pair<ForwardIter, ForwardIter>(first, first);
     }
 
     template<class ForwardIter, class T, class Compared>
@@ -639,6 +767,57 @@ namespace stl {
         return stl::erange_dispatch(first, last, value, iterator_category(first), comp);
     }
 
+/*****************************************************************************************/
+// lower_bound_batch
+// 对[vfirst, vlast)中的每个值在有序区间[first, last)中查找第一个不小于它的元素，
+// 把得到的迭代器依次写入 result，返回输出的尾后位置
+/*****************************************************************************************/
+// 同时进行的查找个数
+#ifndef LOWER_BOUND_BATCH_SIZE
+#define LOWER_BOUND_BATCH_SIZE 32
+#endif
+
+    // 与 branchless_lower_bound 相同，区间长度的变化与比较结果无关，所以一批查找可以逐层同步推进：
+    // 同一层的若干次访存互不依赖，CPU 可以同时发出，表超出缓存时访存延迟被这一批查找分摊
+    // 每次比较后预取该次查找下一层要访问的元素
+    template<class RandomIter, class ForwardIter, class OutputIter, class Compared>
+    OutputIter lower_bound_batch(RandomIter first, RandomIter last,
+                                 ForwardIter vfirst, ForwardIter vlast, OutputIter result, Compared comp) {
+        const auto n = last - first;
+        ForwardIter values[LOWER_BOUND_BATCH_SIZE];
+        RandomIter pos[LOWER_BOUND_BATCH_SIZE];
+        while (vfirst != vlast) {
+            size_t m = 0;
+            for (; m < LOWER_BOUND_BATCH_SIZE && vfirst != vlast; ++m, ++vfirst) {
+                values[m] = vfirst;
+                pos[m] = first;
+            }
+            if (n == 0) {
+                for (size_t i = 0; i < m; ++i, ++result) *result = first;
+                continue;
+            }
+            for (auto len = n; len > 1;) {
+                const auto half = len >> 1;
+                const auto next_half = (len - half) >> 1;
+                for (size_t i = 0; i < m; ++i) {
+                    pos[i] = comp(pos[i][half], *values[i]) ? pos[i] + half : pos[i];
+                    stl::search_prefetch(pos[i] + next_half);
+                }
+                len -= half;
+            }
+            for (size_t i = 0; i < m; ++i, ++result) {
+                *result = comp(*pos[i], *values[i]) ? pos[i] + 1 : pos[i];
+            }
+        }
+        return result;
+    }
+
+    template<class RandomIter, class ForwardIter, class OutputIter>
+    OutputIter lower_bound_batch(RandomIter first, RandomIter last,
+                                 ForwardIter vfirst, ForwardIter vlast, OutputIter result) {
+        return stl::lower_bound_batch(first, last, vfirst, vlast, result, stl::transparent_less());
+    }
+
 /*****************************************************************************************/
 // generate
 // 将函数对象 gen 的运算结果对[first, last)内的每个元素赋值
@@ -842,44 +1021,159 @@ namespace stl {
 // 交换的区间长度必须相同，两个序列不能互相重叠，返回一个迭代器指向序列二最后一个被交换元素的下一位置
 /*****************************************************************************************/
     template<class ForwardIter1, class ForwardIter2>
-    ForwardIter2 swap_ranges(ForwardIter1 first1, ForwardIter1 last1,
-                             ForwardIter2 first2) {
+    ForwardIter2 unchecked_swap_ranges(ForwardIter1 first1, ForwardIter1 last1,
+                                       ForwardIter2 first2) {
         for (; first1 != last1; ++first1, ++first2) {
             stl::iter_swap(first1, first2);
         }
         return first2;
     }
 
+    // 为 trivially copyable 类型的指针提供特化版本：经由栈上的缓冲区分块交换，
+    // 每块的 memcpy 长度是常量，编译器展开为宽的加载与存储
+    template<class Tp>
+    typename std::enable_if<std::is_trivially_copyable<Tp>::value && !std::is_const<Tp>::value, Tp *>::type
+    unchecked_swap_ranges(Tp *first1, Tp *last1, Tp *first2) {
+        const size_t chunk = sizeof(Tp) < 256 ? 256 / sizeof(Tp) : 1;   // 每块的元素个数
+        alignas(Tp) unsigned char buffer[chunk * sizeof(Tp)];
+        for (; static_cast<size_t>(last1 - first1) >= chunk; first1 += chunk, first2 += chunk) {
+            std::memcpy(buffer, first1, sizeof(buffer));
+            std::memcpy(first1, first2, sizeof(buffer));
+            std::memcpy(first2, buffer, sizeof(buffer));
+        }
+        // 不足一块的部分逐个交换，避免长度不定的 memcpy 调用
+        for (; first1 != last1; ++first1, ++first2) {
+            Tp tmp = *first1;
+            *first1 = *first2;
+            *first2 = tmp;
+        }
+        return first2;
+    }
+
+    template<class ForwardIter1, class ForwardIter2>
+    ForwardIter2 swap_ranges(ForwardIter1 first1, ForwardIter1 last1,
+                             ForwardIter2 first2) {
+        return stl::unchecked_swap_ranges(first1, last1, first2);
+    }
+
 /*****************************************************************************************/
 // transform
 // 第一个版本以函数对象 unary_op 作用于[first, last)中的每个元素并将结果保存至 result 中
 // 第二个版本以函数对象 binary_op 作用于两个序列[first1, last1)、[first2, last2)的相同位置
 /*****************************************************************************************/
     template<class InputIter, class OutputIter, class UnaryOperation>
-    OutputIter transform(InputIter first, InputIter last, OutputIter result,
-                         UnaryOperation unary_op) {
+    OutputIter unchecked_transform(InputIter first, InputIter last, OutputIter result,
+                                   UnaryOperation &unary_op) {
         for (; first != last; ++first, ++result) {
             *result = unary_op(*first);
         }
         return result;
     }
 
+    // 连续区间上的版本：用 STL_RESTRICT 告诉编译器输入与输出不重叠，不需要生成运行时的重叠检查；
+    // 每 8 个元素一组，组内循环的次数固定，编译器完全展开后即使在 -O2 下也会向量化，剩余的不足 8 个元素逐个处理
+    template<class Tp, class Up, class UnaryOperation>
+    void transform_restrict(const Tp *STL_RESTRICT first, Up *STL_RESTRICT result, size_t n,
+                            UnaryOperation &unary_op) {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            for (size_t j = i; j < i + 8; ++j) result[j] = unary_op(first[j]);
+        }
+        for (; i < n; ++i) result[i] = unary_op(first[i]);
+    }
+
+    // 原地变换，只有一个指针，同样没有重叠的问题
+    template<class Tp, class UnaryOperation>
+    void transform_inplace(Tp *STL_RESTRICT first, size_t n, UnaryOperation &unary_op) {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            for (size_t j = i; j < i + 8; ++j) first[j] = unary_op(first[j]);
+        }
+        for (; i < n; ++i) first[i] = unary_op(first[i]);
+    }
+
+    // 区间[a, a + an)与[b, b + bn)(以字节计)是否不相交，用整数比较以免比较无关的指针
+    inline bool transform_disjoint(const void *a, size_t an, const void *b, size_t bn) {
+        const uintptr_t x = reinterpret_cast<uintptr_t>(a), y = reinterpret_cast<uintptr_t>(b);
+        return x + an <= y || y + bn <= x;
+    }
+
+    // 为算术类型的连续区间提供特化版本，输入与输出不重叠或者完全重合(原地变换)时使用上面的内核，
+    // 部分重叠时按原来的顺序逐个处理。unary_op 不应通过其他途径访问输出区间
+    template<class Tp, class Up, class UnaryOperation>
+    typename std::enable_if<
+            std::is_arithmetic<typename std::remove_const<Tp>::type>::value &&
+            std::is_arithmetic<Up>::value,
+            Up *>::type
+    unchecked_transform(Tp *first, Tp *last, Up *result, UnaryOperation &unary_op) {
+        const size_t n = static_cast<size_t>(last - first);
+        if (std::is_same<typename std::remove_const<Tp>::type, Up>::value &&
+            static_cast<const void *>(first) == static_cast<const void *>(result)) {
+            transform_inplace(result, n, unary_op);
+        } else if (transform_disjoint(first, n * sizeof(Tp), result, n * sizeof(Up))) {
+            transform_restrict(first, result, n, unary_op);
+        } else {
+            for (size_t i = 0; i != n; ++i) result[i] = unary_op(first[i]);
+        }
+        return result + n;
+    }
+
+    template<class InputIter, class OutputIter, class UnaryOperation>
+    OutputIter transform(InputIter first, InputIter last, OutputIter result,
+                         UnaryOperation unary_op) {
+        return unchecked_transform(first, last, result, unary_op);
+    }
+
     template<class InputIter1, class InputIter2, class OutputIter, class BinaryOperation>
-    OutputIter
-    transform(InputIter1 first1, InputIter1 last1,
-              InputIter2 first2, OutputIter result, BinaryOperation binary_op) {
+    OutputIter unchecked_transform(InputIter1 first1, InputIter1 last1,
+                                   InputIter2 first2, OutputIter result, BinaryOperation &binary_op) {
         for (; first1 != last1; ++first1, ++first2, ++result) {
             *result = binary_op(*first1, *first2);
         }
         return result;
     }
 
-/*****************************************************************************************/
-// remove_copy
-// 移除区间内与指定 value 相等的元素，并将结果复制到以 result 标示起始位置的容器上
-/*****************************************************************************************/
-    template<class InputIter, class OutputIter, class T>
-    OutputIter remove_copy(InputIter first, InputIter last, const T &value, OutputIter result) {
+    template<class Tp1, class Tp2, class Up, class BinaryOperation>
+    void transform_restrict(const Tp1 *STL_RESTRICT first1, const Tp2 *STL_RESTRICT first2,
+                            Up *STL_RESTRICT result, size_t n, BinaryOperation &binary_op) {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            for (size_t j = i; j < i + 8; ++j) result[j] = binary_op(first1[j], first2[j]);
+        }
+        for (; i < n; ++i) result[i] = binary_op(first1[i], first2[i]);
+    }
+
+    // 两个输入之间可以重叠(都只读)，输出与两个输入都不重叠时使用上面的内核
+    template<class Tp1, class Tp2, class Up, class BinaryOperation>
+    typename std::enable_if<
+            std::is_arithmetic<typename std::remove_const<Tp1>::type>::value &&
+            std::is_arithmetic<typename std::remove_const<Tp2>::type>::value &&
+            std::is_arithmetic<Up>::value,
+            Up *>::type
+    unchecked_transform(Tp1 *first1, Tp1 *last1, Tp2 *first2, Up *result, BinaryOperation &binary_op) {
+        const size_t n = static_cast<size_t>(last1 - first1);
+        if (transform_disjoint(first1, n * sizeof(Tp1), result, n * sizeof(Up)) &&
+            transform_disjoint(first2, n * sizeof(Tp2), result, n * sizeof(Up))) {
+            transform_restrict(first1, first2, result, n, binary_op);
+        } else {
+            for (size_t i = 0; i != n; ++i) result[i] = binary_op(first1[i], first2[i]);
+        }
+        return result + n;
+    }
+
+    template<class InputIter1, class InputIter2, class OutputIter, class BinaryOperation>
+    OutputIter
+    transform(InputIter1 first1, InputIter1 last1,
+              InputIter2 first2, OutputIter result, BinaryOperation binary_op) {
+        return unchecked_transform(first1, last1, first2, result, binary_op);
+    }
+
+/*****************************************************************************************/
+// remove_copy
+// 移除区间内与指定 value 相等的元素，并将结果复制到以 result 标示起始位置的容器上
+/*****************************************************************************************/
+    template<class InputIter, class OutputIter, class T>
+    OutputIter remove_copy(InputIter first, InputIter last, const T &value, OutputIter result) {
         for (; first != last; ++first) {
             if (*first != value) *result = *first, ++result;
         }
@@ -922,12 +1216,27 @@ namespace stl {
 /*****************************************************************************************/
     template<class ForwardIter, class UnaryPredicate>
     ForwardIter
-    remove_if(ForwardIter first, ForwardIter last, UnaryPredicate unary_pred) {
+    unchecked_remove_if(ForwardIter first, ForwardIter last, UnaryPredicate &unary_pred) {
         first = stl::find_if(first, last, unary_pred);  // 利用 find_if 找出第一个匹配的地方
         auto next = first;
         return first == last ? first : stl::remove_copy_if(++next, last, first, unary_pred);
     }
 
+    // 为连续的算术类型区间提供特化版本，无分支地原地压缩，见 simd.h 中的 simd_remove_if
+    template<class Tp, class UnaryPredicate>
+    typename std::enable_if<
+            stl::simd_element<Tp>::value && !std::is_const<Tp>::value,
+            Tp *>::type
+    unchecked_remove_if(Tp *first, Tp *last, UnaryPredicate &unary_pred) {
+        return stl::simd_remove_if(first, last, unary_pred);
+    }
+
+    template<class ForwardIter, class UnaryPredicate>
+    ForwardIter
+    remove_if(ForwardIter first, ForwardIter last, UnaryPredicate unary_pred) {
+        return unchecked_remove_if(first, last, unary_pred);
+    }
+
 /*****************************************************************************************/
 // replace
 // 将区间内所有的 old_value 都以 new_value 替代
@@ -985,6 +1294,9 @@ namespace stl {
 // reverse
 // 将[first, last)区间内的元素反转
 /*****************************************************************************************/
+    template<class T, class Ref, class Ptr>
+    struct deque_iterator;
+
     // reverse_dispatch 的 bidirectional_iterator_tag 版本
     // TODO:真的有必要针对这两个迭代器写两种代码吗？加重了程序员负担
     // 但是感觉性能没有很高的提升，甚至由于封装reverse，多加了一层函数
@@ -1006,6 +1318,54 @@ namespace stl {
         while (first < last) stl::iter_swap(first++, --last);
     }
 
+    // 交换 first[i] 与 last[-1 - i]，i < k，两段不能重叠
+    template<class RandomIter>
+    void unchecked_swap_reversed(RandomIter first, RandomIter last, size_t k) {
+        for (; k != 0; --k) stl::iter_swap(first++, --last);
+    }
+
+    // 连续的算术类型区间每次从两端各读入一个向量，反转后交换，见 simd.h 中的 simd_swap_reversed
+    template<class Tp>
+    typename std::enable_if<stl::simd_element<Tp>::value, void>::type
+    unchecked_swap_reversed(Tp *first, Tp *last, size_t k) {
+        stl::simd_swap_reversed(first, last, k);
+    }
+
+    template<class Tp>
+    void reverse_dispatch(Tp *first, Tp *last, random_access_iterator_tag) {
+        stl::unchecked_swap_reversed(first, last, static_cast<size_t>(last - first) / 2);
+    }
+
+    // stl::deque：两端各自停留在一个缓冲区中，每次用指针交换两个缓冲区片段中较短的部分，
+    // 片段用完时才切换到相邻的缓冲区，不必每移动一步都检查是否越过缓冲区的边界
+    template<class T, class Ref, class Ptr>
+    void reverse_dispatch(deque_iterator<T, Ref, Ptr> first, deque_iterator<T, Ref, Ptr> last,
+                          random_access_iterator_tag) {
+        typedef deque_iterator<T, Ref, Ptr> iterator;
+        typedef typename iterator::value_pointer pointer;
+        size_t k = static_cast<size_t>(last - first) / 2;     // 需要交换的对数
+        pointer front = first.cur, front_end = first.last;
+        pointer back = last.cur, back_begin = last.first;
+        auto front_node = first.node, back_node = last.node;
+        while (k != 0) {
+            if (front == front_end) {
+                front = *++front_node;
+                front_end = front + iterator::buffer_size;
+            }
+            if (back == back_begin) {
+                back_begin = *--back_node;
+                back = back_begin + iterator::buffer_size;
+            }
+            size_t len = static_cast<size_t>(front_end - front);
+            if (static_cast<size_t>(back - back_begin) < len) len = static_cast<size_t>(back - back_begin);
+            if (k < len) len = k;
+            stl::unchecked_swap_reversed(front, back, len);
+            front += len;
+            back -= len;
+            k -= len;
+        }
+    }
+
     template<class BidirectionalIter>
     void reverse(BidirectionalIter first, BidirectionalIter last) {
         stl::reverse_dispatch(first, last, stl::iterator_category(first));
@@ -1016,8 +1376,8 @@ namespace stl {
 // 行为与 reverse 类似，不同的是将结果复制到 result 所指容器中
 /*****************************************************************************************/
     template<class BidirectionalIter, class OutputIter>
-    OutputIter reverse_copy(BidirectionalIter first, BidirectionalIter last,
-                            OutputIter result) {
+    OutputIter unchecked_reverse_copy(BidirectionalIter first, BidirectionalIter last,
+                                      OutputIter result) {
         while (first != last) {
             --last;
             *result = *last;
@@ -1026,36 +1386,159 @@ namespace stl {
         return result;
     }
 
+    // 为连续的算术类型区间提供向量化的特化版本，向 result 顺序写入，见 simd.h 中的 simd_reverse_copy
+    template<class Tp, class Up>
+    typename std::enable_if<
+            stl::simd_element<Tp>::value &&
+            std::is_same<typename std::remove_const<Tp>::type, Up>::value,
+            Up *>::type
+    unchecked_reverse_copy(Tp *first, Tp *last, Up *result) {
+        const size_t n = static_cast<size_t>(last - first);
+        // 区间重叠时结果未定义，这里仍然逐个拷贝，与通用版本的行为相同
+        if (!stl::transform_disjoint(first, n * sizeof(Tp), result, n * sizeof(Up))) {
+            while (first != last) *result++ = *--last;
+            return result;
+        }
+        return stl::simd_reverse_copy<Up>(first, last, result);
+    }
+
+    template<class BidirectionalIter, class OutputIter>
+    OutputIter reverse_copy(BidirectionalIter first, BidirectionalIter last,
+                            OutputIter result) {
+        return stl::unchecked_reverse_copy(first, last, result);
+    }
+
+/*****************************************************************************************/
+// shuffle
+// 用均匀随机位生成器 g 将[first, last)内的元素次序随机重排，每种排列的概率相同(Fisher-Yates)
+// 位置由 bounded_rand 生成，没有取模的偏差(见 random.h)
+/*****************************************************************************************/
+// 交换的位置提前这么多步算出并预取，大区间上随机位置的缓存缺失可以重叠
+#ifndef SHUFFLE_PREFETCH_DISTANCE
+#define SHUFFLE_PREFETCH_DISTANCE 8
+#endif
+
+    template<class RandomIter, class URBG>
+    void shuffle(RandomIter first, RandomIter last, URBG &&g) {
+        typedef typename iterator_traits<RandomIter>::difference_type difference_type;
+        const difference_type n = last - first;
+        if (n < 2) return;
+        // 第 i 步与 [0, i] 中的随机位置 j 交换，j 只取决于 g，可以提前生成。
+        // 生成的 j 存放在环形数组 ahead 中，提前 SHUFFLE_PREFETCH_DISTANCE 步；
+        // i < 2^32 时相邻两步的 j 由一个 64 位随机数生成(见 bounded_rand2)
+        const difference_type distance = SHUFFLE_PREFETCH_DISTANCE;
+        const difference_type mask = 2 * SHUFFLE_PREFETCH_DISTANCE - 1;
+        static_assert((SHUFFLE_PREFETCH_DISTANCE & (SHUFFLE_PREFETCH_DISTANCE - 1)) == 0,
+                      "SHUFFLE_PREFETCH_DISTANCE must be a power of 2");
+        difference_type ahead[2 * SHUFFLE_PREFETCH_DISTANCE];
+        difference_type next = n - 1;   // 下一个要生成 j 的步
+        for (difference_type i = n - 1; i > 0; --i) {
+            while (next > 0 && i - next < distance) {
+                if (next >= 2 && static_cast<uint64_t>(next) < (uint64_t(1) << 32)) {
+                    uint64_t j1, j2;
+                    stl::bounded_rand2(g, static_cast<uint64_t>(next) + 1, static_cast<uint64_t>(next), j1, j2);
+                    ahead[next & mask] = static_cast<difference_type>(j1);
+                    ahead[(next - 1) & mask] = static_cast<difference_type>(j2);
+                    stl::search_prefetch(first + static_cast<difference_type>(j1));
+                    stl::search_prefetch(first + static_cast<difference_type>(j2));
+                    next -= 2;
+                } else {
+                    const auto j = static_cast<difference_type>(stl::bounded_rand(g, static_cast<uint64_t>(next) + 1));
+                    ahead[next & mask] = j;
+                    stl::search_prefetch(first + j);
+                    --next;
+                }
+            }
+            stl::iter_swap(first + i, first + ahead[i & mask]);
+        }
+    }
+
 /*****************************************************************************************/
 // random_shuffle
 // 将[first, last)内的元素次序随机重排
-// 重载版本使用一个产生随机数的函数对象 rand
+// 第一个版本使用当前线程的默认引擎(见 random.h 的 default_random_engine)
+// 重载版本使用一个产生随机数的函数对象 rand，rand(n) 返回[0, n)内的随机数
 /*****************************************************************************************/
     template<class RandomIter>
     void random_shuffle(RandomIter first, RandomIter last) {
-        if (first == last) return;
-        srand((unsigned) time(0));
-        for (auto i = first + 1; i != last; ++i) {
-            stl::iter_swap(i, first + (rand() % (i - first + 1)));
-        }
+        stl::shuffle(first, last, stl::default_random_engine());
     }
 
     template<class RandomIter, class RandomNumberGenerator>
     void random_shuffle(RandomIter first, RandomIter last,
                         RandomNumberGenerator &rand) {
         if (first == last) return;
-        auto len = last - first;
         for (auto i = first + 1; i != last; ++i) {
-            // TODO：为什么和上面实现不一样
-            stl::iter_swap(i, first + (rand(i - first + 1) % len));
+            stl::iter_swap(i, first + rand(i - first + 1));
         }
     }
 
+/*****************************************************************************************/
+// sample
+// 从[first, last)中等概率地选出 min(n, 元素个数) 个元素写到 out 开始的位置，返回写入的尾后位置
+// 至少是前向迭代器时使用选择抽样(selection sampling)，结果保持原来的相对次序；
+// 只是输入迭代器时使用蓄水池抽样(reservoir sampling)，out 需要是随机访问迭代器，结果的次序是随机的
+/*****************************************************************************************/
+    // 选择抽样：还剩 remaining 个元素、还需要 n 个时，当前元素以 n / remaining 的概率选中
+    template<class ForwardIter, class OutputIter, class Distance, class URBG>
+    OutputIter sample_dispatch(ForwardIter first, ForwardIter last, OutputIter out, Distance n, URBG &g,
+                               forward_iterator_tag) {
+        if (n <= 0) return out;
+        auto remaining = static_cast<uint64_t>(stl::distance(first, last));
+        auto wanted = static_cast<uint64_t>(n);
+        for (; wanted != 0 && remaining != 0; ++first, --remaining) {
+            if (stl::bounded_rand(g, remaining) < wanted) {
+                *out = *first;
+                ++out;
+                --wanted;
+            }
+        }
+        return out;
+    }
+
+    // 蓄水池抽样(Li 的 Algorithm L)：先放入前 n 个元素，之后按几何分布直接算出下一个被选中的元素要跳过多少个，
+    // 被选中的元素替换蓄水池中的一个随机位置。只有选中的元素需要随机数，期望 O(n(1 + log(N / n))) 次
+    template<class InputIter, class RandomIter, class Distance, class URBG>
+    RandomIter sample_dispatch(InputIter first, InputIter last, RandomIter out, Distance n, URBG &g,
+                               input_iterator_tag) {
+        Distance k = 0;
+        for (; first != last && k < n; ++first, ++k) out[k] = *first;
+        if (first == last || n <= 0) return out + k;
+        const double inv_n = 1.0 / static_cast<double>(n);
+        double w = std::exp(std::log(stl::random_unit(g)) * inv_n);
+        for (;;) {
+            const double skip = std::floor(std::log(stl::random_unit(g)) / std::log1p(-w));
+            // w 极小时 skip 可能超出整数范围，这时等于跳到末尾
+            uint64_t count = skip < 1.8e19 ? static_cast<uint64_t>(skip) : ~uint64_t(0);
+            for (; count != 0 && first != last; --count) ++first;
+            if (first == last) break;
+            out[static_cast<Distance>(stl::bounded_rand(g, static_cast<uint64_t>(n)))] = *first;
+            ++first;
+            w *= std::exp(std::log(stl::random_unit(g)) * inv_n);
+        }
+        return out + n;
+    }
+
+    template<class PopulationIter, class SampleIter, class Distance, class URBG>
+    SampleIter sample(PopulationIter first, PopulationIter last, SampleIter out, Distance n, URBG &&g) {
+        return stl::sample_dispatch(first, last, out, n, g, iterator_category(first));
+    }
+
 /*****************************************************************************************/
 // rotate
 // 将[first, middle)内的元素和 [middle, last)内的元素互换，可以交换两个长度不同的区间
 // 返回交换后 middle 的位置
 /*****************************************************************************************/
+// 随机访问版本中，指针区间较短的一侧不超过这么多字节时，先把它拷贝到栈上的缓冲区，再用 memmove 移动另一侧
+#ifndef ROTATE_BUFFER_BYTES
+#define ROTATE_BUFFER_BYTES 2048
+#endif
+
+// 随机访问版本中，非 trivially copyable 类型在 n / min(l, r) 不超过这个值时使用 cycle leader(juggling)
+#ifndef ROTATE_JUGGLE_MAX_STREAMS
+#define ROTATE_JUGGLE_MAX_STREAMS 8
+#endif
+
     // rotate_dispatch 的 forward_iterator_tag 版本
     template<class ForwardIter>
     ForwardIter rotate_dispatch(ForwardIter first, ForwardIter middle,
@@ -1077,6 +1560,7 @@ namespace stl {
                 first2 = middle;
             }
         }
+        return new_middle;
     }
 
     // rotate_dispatch 的 bidirectional_iterator_tag 版本
@@ -1108,44 +1592,102 @@ namespace stl {
         return m;
     }
 
-    // rotate_dispatch 的 random_access_iterator_tag 版本
+    // 较短的一侧放得进栈上的缓冲区时，拷贝出较短的一侧，memmove 较长的一侧，再拷贝回来，每个元素只移动一到两次
+    // 只用于 trivially copyable 类型的指针，其余情况返回 false
+    template<class RandomIter, class Distance>
+    bool rotate_small_buffer(RandomIter, RandomIter, RandomIter, Distance, Distance) {
+        return false;
+    }
+
+    template<class Tp, class Distance>
+    typename std::enable_if<std::is_trivially_copyable<Tp>::value && !std::is_const<Tp>::value, bool>::type
+    rotate_small_buffer(Tp *first, Tp *middle, Tp *last, Distance l, Distance r) {
+        const size_t shorter = static_cast<size_t>(l < r ? l : r);
+        if (shorter * sizeof(Tp) > ROTATE_BUFFER_BYTES) return false;
+        alignas(Tp) unsigned char buffer[ROTATE_BUFFER_BYTES];
+        if (l <= r) {
+            std::memcpy(buffer, first, static_cast<size_t>(l) * sizeof(Tp));
+            std::memmove(first, middle, static_cast<size_t>(r) * sizeof(Tp));
+            std::memcpy(last - l, buffer, static_cast<size_t>(l) * sizeof(Tp));
+        } else {
+            std::memcpy(buffer, middle, static_cast<size_t>(r) * sizeof(Tp));
+            std::memmove(last - l, first, static_cast<size_t>(l) * sizeof(Tp));
+            std::memcpy(first, buffer, static_cast<size_t>(r) * sizeof(Tp));
+        }
+        return true;
+    }
+
+    // block swap(Gries-Mills)：把较短的一侧与另一侧紧挨着它的等长部分交换，交换到的部分已经就位，
+    // 剩下的仍是一次 rotate，较短的一侧不变，另一侧变短。每次都是两段连续区间的顺序交换，对缓存友好
+    // 共交换 n - gcd(n, l) 次
+    // 较短的一侧很短时每次只交换几个元素，trivially copyable 类型的指针这时改用缓冲区
+    template<class RandomIter, class Distance>
+    void rotate_block_swap(RandomIter first, RandomIter middle, RandomIter last, Distance l, Distance r) {
+        while (l != 0 && r != 0) {
+            // 较短的一侧变得很短时，逐块交换的开销大，能用缓冲区就直接完成
+            if (stl::rotate_small_buffer(first, middle, last, l, r)) return;
+            if (l <= r) {
+                // [first, middle) 与 [middle, middle + l) 交换后，前 l 个元素就位
+                stl::swap_ranges(first, middle, middle);
+                first = middle;
+                middle += l;
+                r -= l;
+            } else {
+                // [middle - r, middle) 与 [middle, last) 交换后，后 r 个元素就位
+                stl::swap_ranges(middle - r, middle, middle);
+                last = middle;
+                middle -= r;
+                l -= r;
+            }
+        }
+    }
+
+    // cycle leader(juggling)：位置 i 的新元素是原来位置 (i + l) % n 的元素，共 gcd(n, l) 个环，
+    // 每个环先移出环首，再沿环依次移动，每个元素只移动一次。
+    // 沿环的访问相当于约 n / min(l, r) 个交替前进的顺序流，较短的一侧很短时每一步都落在新的缓存行上，
+    // 所以只在流的个数较少、移动代价又较大时使用
+    template<class RandomIter, class Distance>
+    void rotate_cycle_leader(RandomIter first, RandomIter last, Distance l, Distance r) {
+        const Distance cycles = stl::rgcd(l + r, l);
+        const RandomIter pivot = last - l;     // 位置小于 pivot 时环上的下一个位置为 +l，否则为 -r
+        for (Distance i = 0; i < cycles; ++i) {
+            // 环首小于 gcd(n, l)，向后走 l 步不会回到环首，只需在向前走 r 步时检查
+            const RandomIter leader = first + i;
+            auto tmp = stl::move(*leader);
+            RandomIter hole = leader;
+            for (;;) {
+                for (; hole < pivot; hole += l) *hole = stl::move(*(hole + l));
+                const RandomIter next = hole - r;
+                if (next == leader) break;
+                *hole = stl::move(*next);
+                hole = next;
+            }
+            *hole = stl::move(tmp);
+        }
+    }
+
+    // rotate_dispatch 的 random_access_iterator_tag 版本，按区间的长度与元素类型选择：
+    //   * 两侧等长时直接 swap_ranges
+    //   * trivially copyable 类型的指针，较短的一侧不超过 ROTATE_BUFFER_BYTES 时借助栈上的缓冲区
+    //   * 非 trivially copyable 类型，n / min(l, r) 不超过 ROTATE_JUGGLE_MAX_STREAMS 时使用 cycle leader，
+    //     移动次数约为 block swap 的三分之一，访存仍是少数几个顺序流
+    //   * 其余情况使用 block swap，trivially copyable 类型逐块 memcpy 交换
     template<class RandomIter>
     RandomIter
     rotate_dispatch(RandomIter first, RandomIter middle,
                     RandomIter last, random_access_iterator_tag) {
-        auto n = last - first;
-        auto l = middle - first;
-        auto r = n - l;
-        auto result = first + (last - middle);
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        const auto l = middle - first;
+        const auto r = last - middle;
+        const RandomIter result = first + r;
         if (l == r) {
             stl::swap_ranges(first, middle, middle);
-            return result;
-        }
-        auto cycle_times = rgcd(n, l);
-        for (auto i = 0; i < cycle_times; ++i) {
-            auto tmp = *first;
-            auto p = first;
-            if (l < r) {
-                for (auto j = 0; j < r / cycle_times; ++j) {
-                    if (p > first + r) {
-                        *p = *(p - r);
-                        p -= r;
-                    }
-                    *p = *(p + l);
-                    p += l;
-                }
-            } else {
-                for (auto j = 0; j < l / cycle_times - 1; ++j) {
-                    if (p < last - l) {
-                        *p = *(p + l);
-                        p += l;
-                    }
-                    *p = *(p - r);
-                    p -= r;
-                }
-            }
-            *p = tmp;
-            ++first;
+        } else if (!stl::rotate_small_buffer(first, middle, last, l, r)) {
+            if (!std::is_trivially_copyable<value_type>::value &&
+                (l + r) / (l < r ? l : r) <= ROTATE_JUGGLE_MAX_STREAMS)
+                stl::rotate_cycle_leader(first, last, l, r);
+            else
+                stl::rotate_block_swap(first, middle, last, l, r);
         }
         return result;
     }
@@ -1160,6 +1702,973 @@ namespace stl {
         return stl::rotate_dispatch(first, middle, last, iterator_category(first));
     }
 
+/*****************************************************************************************/
+// sort
+// 将[first, last)内的元素以递增的方式排序
+// 采用内省式排序(introsort)，并参考 pdqsort(pattern-defeating quicksort) 做了以下改进：
+//   * 区间较小时使用插入排序
+//   * 区间较大时用三点取中(ninther)选取枢轴，划分严重不平衡时打乱部分元素来破坏输入的规律，
+//     不平衡的次数超过 log2(n) 时退化为堆排序，保证最坏情况下 O(nlogn)
+//   * 划分时没有发生交换(可能已经有序)，则尝试有限次数的插入排序，有序的输入只需 O(n)
+//   * 枢轴与左侧的元素相等时，把相等的元素都划分到左侧，重复元素很多时接近 O(n)
+//   * 算术类型并使用默认的比较方式时，采用无分支的块划分(BlockQuicksort)，避免分支预测失败
+/*****************************************************************************************/
+    constexpr static size_t kSortInsertionThreshold = 24;        // 小于该长度使用插入排序
+    constexpr static size_t kSortNintherThreshold = 128;         // 大于该长度使用ninther选取枢轴
+    constexpr static size_t kSortPartialInsertionLimit = 8;      // 尝试插入排序时最多移动的元素个数
+    constexpr static size_t kSortBlockSize = 64;                 // 块划分中每一块的大小
+
+    // 找出 lg(n) 的值，用于控制不平衡划分的次数
+    template<class Size>
+    Size slg2(Size n) {
+        Size k = 0;
+        for (; n > 1; n >>= 1)
+            ++k;
+        return k;
+    }
+
+    // 对三个位置上的元素排序，使 *a <= *b <= *c
+    // 与 median 一样取三者的中间值，但要把中间值和最大值放到确定的位置上，作为枢轴和划分时的哨兵
+    template<class RandomIter, class Compared>
+    void sort3(RandomIter a, RandomIter b, RandomIter c, Compared comp) {
+        if (comp(*b, *a)) stl::iter_swap(a, b);
+        if (comp(*c, *b)) stl::iter_swap(b, c);
+        if (comp(*b, *a)) stl::iter_swap(a, b);
+    }
+
+    // 是否可以使用无分支的块划分：算术类型，并且使用默认的 less / greater 比较
+    template<class T, class Compared>
+    struct is_branchless_sortable : public m_false_type {
+    };
+
+    template<class T>
+    struct is_branchless_sortable<T, stl::less<T>>
+            : public m_bool_constant<std::is_arithmetic<T>::value> {
+    };
+
+    template<class T>
+    struct is_branchless_sortable<T, stl::greater<T>>
+            : public m_bool_constant<std::is_arithmetic<T>::value> {
+    };
+
+    // 插入排序
+    template<class RandomIter, class Compared>
+    void insertion_sort(RandomIter first, RandomIter last, Compared comp) {
+        if (first == last) return;
+        for (auto cur = first + 1; cur != last; ++cur) {
+            auto sift = cur;
+            auto sift_1 = cur - 1;
+            if (comp(*sift, *sift_1)) {
+                auto tmp = stl::move(*sift);
+                do {
+                    *sift-- = stl::move(*sift_1);
+                } while (sift != first && comp(tmp, *--sift_1));
+                *sift = stl::move(tmp);
+            }
+        }
+    }
+
+    // 插入排序，要求first左侧存在一个不大于区间内所有元素的值作为哨兵，因此不必检查边界
+    template<class RandomIter, class Compared>
+    void unchecked_insertion_sort(RandomIter first, RandomIter last, Compared comp) {
+        if (first == last) return;
+        for (auto cur = first + 1; cur != last; ++cur) {
+            auto sift = cur;
+            auto sift_1 = cur - 1;
+            if (comp(*sift, *sift_1)) {
+                auto tmp = stl::move(*sift);
+                do {
+                    *sift-- = stl::move(*sift_1);
+                } while (comp(tmp, *--sift_1));
+                *sift = stl::move(tmp);
+            }
+        }
+    }
+
+    // 尝试用插入排序完成排序，移动的元素超过 kSortPartialInsertionLimit 个时放弃并返回 false
+    template<class RandomIter, class Compared>
+    bool partial_insertion_sort(RandomIter first, RandomIter last, Compared comp) {
+        if (first == last) return true;
+        size_t limit = 0;
+        for (auto cur = first + 1; cur != last; ++cur) {
+            auto sift = cur;
+            auto sift_1 = cur - 1;
+            if (comp(*sift, *sift_1)) {
+                auto tmp = stl::move(*sift);
+                do {
+                    *sift-- = stl::move(*sift_1);
+                } while (sift != first && comp(tmp, *--sift_1));
+                *sift = stl::move(tmp);
+                limit += cur - sift;
+            }
+            if (limit > kSortPartialInsertionLimit) return false;
+        }
+        return true;
+    }
+
+    // 以*first为枢轴划分区间，小于枢轴的在左侧，不小于枢轴的在右侧，返回枢轴的最终位置，
+    // already_partitioned表示划分前区间是否已经划分好(没有发生交换)
+    // 要求区间右侧存在不小于枢轴的元素，作为向右扫描的哨兵
+    template<class RandomIter, class Compared>
+    RandomIter partition_right(RandomIter first, RandomIter last, Compared comp,
+                               bool &already_partitioned) {
+        auto pivot = stl::move(*first);
+        auto begin = first;
+
+        while (comp(*++first, pivot));
+        // 如果first左侧没有小于枢轴的元素，向左扫描时需要检查边界
+        if (first - 1 == begin)
+            while (first < last && !comp(*--last, pivot));
+        else
+            while (!comp(*--last, pivot));
+
+        already_partitioned = first >= last;
+        while (first < last) {
+            stl::iter_swap(first, last);
+            while (comp(*++first, pivot));
+            while (!comp(*--last, pivot));
+        }
+
+        auto pivot_pos = first - 1;
+        *begin = stl::move(*pivot_pos);
+        *pivot_pos = stl::move(pivot);
+        return pivot_pos;
+    }
+
+    // 按照偏移量交换左右两侧位置错误的元素
+    // 两侧个数相同时逐对交换，否则用轮换的方式减少一半的赋值
+    template<class RandomIter>
+    void swap_offsets(RandomIter first, RandomIter last, unsigned char *offsets_l,
+                      unsigned char *offsets_r, size_t num, bool use_swaps) {
+        if (use_swaps) {
+            // 对于逆序的输入，必须逐对交换才能保持 O(n)
+            for (size_t i = 0; i < num; ++i)
+                stl::iter_swap(first + offsets_l[i], last - offsets_r[i]);
+        } else if (num > 0) {
+            auto l = first + offsets_l[0];
+            auto r = last - offsets_r[0];
+            auto tmp = stl::move(*l);
+            *l = stl::move(*r);
+            for (size_t i = 1; i < num; ++i) {
+                l = first + offsets_l[i];
+                *r = stl::move(*l);
+                r = last - offsets_r[i];
+                *l = stl::move(*r);
+            }
+            *r = stl::move(tmp);
+        }
+    }
+
+    // partition_right 的无分支版本
+    // 先分别扫描左右两块，把位置错误的元素的偏移量记录下来(比较结果直接累加到下标上，没有分支)，
+    // 再一次性交换，比较结果难以预测时可以避免大量的分支预测失败
+    template<class RandomIter, class Compared>
+    RandomIter partition_right_branchless(RandomIter first, RandomIter last, Compared comp,
+                                          bool &already_partitioned) {
+        auto pivot = stl::move(*first);
+        auto begin = first;
+
+        while (comp(*++first, pivot));
+        if (first - 1 == begin)
+            while (first < last && !comp(*--last, pivot));
+        else
+            while (!comp(*--last, pivot));
+
+        already_partitioned = first >= last;
+        if (!already_partitioned) {
+            stl::iter_swap(first, last);
+            ++first;
+
+            unsigned char offsets_l[kSortBlockSize];
+            unsigned char offsets_r[kSortBlockSize];
+            auto offsets_l_base = first;
+            auto offsets_r_base = last;
+            size_t num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+
+            while (first < last) {
+                // 决定这一轮左右两块各扫描多少个元素
+                const size_t num_unknown = last - first;
+                const size_t left_split = num_l == 0 ? (num_r == 0 ? num_unknown / 2 : num_unknown) : 0;
+                const size_t right_split = num_r == 0 ? (num_unknown - left_split) : 0;
+
+                if (left_split >= kSortBlockSize) {
+                    for (size_t i = 0; i < kSortBlockSize;) {
+                        offsets_l[num_l] = static_cast<unsigned char>(i++);
+                        num_l += !comp(*first, pivot);
+                        ++first;
+                        offsets_l[num_l] = static_cast<unsigned char>(i++);
+                        num_l += !comp(*first, pivot);
+                        ++first;
+                        offsets_l[num_l] = static_cast<unsigned char>(i++);
+                        num_l += !comp(*first, pivot);
+                        ++first;
+                        offsets_l[num_l] = static_cast<unsigned char>(i++);
+                        num_l += !comp(*first, pivot);
+                        ++first;
+                    }
+                } else {
+                    for (size_t i = 0; i < left_split;) {
+                        offsets_l[num_l] = static_cast<unsigned char>(i++);
+                        num_l += !comp(*first, pivot);
+                        ++first;
+                    }
+                }
+
+                if (right_split >= kSortBlockSize) {
+                    for (size_t i = 0; i < kSortBlockSize;) {
+                        offsets_r[num_r] = static_cast<unsigned char>(++i);
+                        num_r += comp(*--last, pivot);
+                        offsets_r[num_r] = static_cast<unsigned char>(++i);
+                        num_r += comp(*--last, pivot);
+                        offsets_r[num_r] = static_cast<unsigned char>(++i);
+                        num_r += comp(*--last, pivot);
+                        offsets_r[num_r] = static_cast<unsigned char>(++i);
+                        num_r += comp(*--last, pivot);
+                    }
+                } else {
+                    for (size_t i = 0; i < right_split;) {
+                        offsets_r[num_r] = static_cast<unsigned char>(++i);
+                        num_r += comp(*--last, pivot);
+                    }
+                }
+
+                // 交换两侧位置错误的元素，并更新块的起点
+                const size_t num = stl::min(num_l, num_r);
+                stl::swap_offsets(offsets_l_base, offsets_r_base, offsets_l + start_l,
+                                  offsets_r + start_r, num, num_l == num_r);
+                num_l -= num;
+                num_r -= num;
+                start_l += num;
+                start_r += num;
+
+                if (num_l == 0) {
+                    start_l = 0;
+                    offsets_l_base = first;
+                }
+                if (num_r == 0) {
+                    start_r = 0;
+                    offsets_r_base = last;
+                }
+            }
+
+            // 此时只有一侧还有剩余的位置错误的元素，把它们逐个换到中间
+            if (num_l) {
+                auto offsets = offsets_l + start_l;
+                while (num_l--)
+                    stl::iter_swap(offsets_l_base + offsets[num_l], --last);
+                first = last;
+            }
+            if (num_r) {
+                auto offsets = offsets_r + start_r;
+                while (num_r--) {
+                    stl::iter_swap(offsets_r_base - offsets[num_r], first);
+                    ++first;
+                }
+            }
+        }
+
+        auto pivot_pos = first - 1;
+        *begin = stl::move(*pivot_pos);
+        *pivot_pos = stl::move(pivot);
+        return pivot_pos;
+    }
+
+    // 以*first为枢轴划分区间，不大于枢轴的在左侧，大于枢轴的在右侧，返回枢轴的最终位置
+    // 用于枢轴与区间左侧的元素相等的情况，此时左侧的元素全部等于枢轴，之后不必再处理
+    template<class RandomIter, class Compared>
+    RandomIter partition_left(RandomIter first, RandomIter last, Compared comp) {
+        auto pivot = stl::move(*first);
+        auto begin = first;
+        auto end = last;
+
+        while (comp(pivot, *--last));
+        if (last + 1 == end)
+            while (first < last && !comp(pivot, *++first));
+        else
+            while (!comp(pivot, *++first));
+
+        while (first < last) {
+            stl::iter_swap(first, last);
+            while (comp(pivot, *--last));
+            while (!comp(pivot, *++first));
+        }
+
+        *begin = stl::move(*last);
+        *last = stl::move(pivot);
+        return last;
+    }
+
+    // 划分严重不平衡时，把区间内几个固定位置的元素交换，打乱输入的规律
+    template<class RandomIter, class Distance>
+    void break_patterns(RandomIter first, RandomIter last, Distance len) {
+        if (len < static_cast<Distance>(kSortInsertionThreshold)) return;
+        const auto quarter = len / 4;
+        stl::iter_swap(first, first + quarter);
+        stl::iter_swap(last - 1, last - quarter);
+        if (len > static_cast<Distance>(kSortNintherThreshold)) {
+            stl::iter_swap(first + 1, first + (quarter + 1));
+            stl::iter_swap(first + 2, first + (quarter + 2));
+            stl::iter_swap(last - 2, last - (quarter + 1));
+            stl::iter_swap(last - 3, last - (quarter + 2));
+        }
+    }
+
+    // 内省式排序的主循环，leftmost表示区间左侧是否没有其他元素(不能使用哨兵)
+    template<class RandomIter, class Compared, bool Branchless>
+    void intro_sort(RandomIter first, RandomIter last, Compared comp,
+                    size_t bad_allowed, bool leftmost) {
+        typedef typename iterator_traits<RandomIter>::difference_type difference_type;
+        while (true) {
+            const difference_type len = last - first;
+            if (len < static_cast<difference_type>(kSortInsertionThreshold)) {
+                if (leftmost)
+                    stl::insertion_sort(first, last, comp);
+                else
+                    stl::unchecked_insertion_sort(first, last, comp);
+                return;
+            }
+
+            // 选取枢轴，放到区间头部，同时区间右端会留下不小于枢轴的元素作为哨兵
+            const difference_type half = len / 2;
+            if (len > static_cast<difference_type>(kSortNintherThreshold)) {
+                // ninther：三组三点取中，再取三个中间值的中间值
+                stl::sort3(first, first + half, last - 1, comp);
+                stl::sort3(first + 1, first + (half - 1), last - 2, comp);
+                stl::sort3(first + 2, first + (half + 1), last - 3, comp);
+                stl::sort3(first + (half - 1), first + half, first + (half + 1), comp);
+                stl::iter_swap(first, first + half);
+            } else {
+                stl::sort3(first + half, first, last - 1, comp);
+            }
+
+            // 左侧的元素(上一次划分的枢轴)不小于当前枢轴，说明它们相等，
+            // 把与枢轴相等的元素都划分到左侧，之后只需要处理右侧
+            if (!leftmost && !comp(*(first - 1), *first)) {
+                first = stl::partition_left(first, last, comp) + 1;
+                continue;
+            }
+
+            bool already_partitioned = false;
+            auto pivot_pos = Branchless
+                             ? stl::partition_right_branchless(first, last, comp, already_partitioned)
+                             : stl::partition_right(first, last, comp, already_partitioned);
+            const difference_type l_len = pivot_pos - first;
+            const difference_type r_len = last - (pivot_pos + 1);
+
+            if (l_len < len / 8 || r_len < len / 8) {
+                // 划分严重不平衡
+                if (--bad_allowed == 0) {
+                    stl::make_heap(first, last, comp);
+                    stl::sort_heap(first, last, comp);
+                    return;
+                }
+                stl::break_patterns(first, pivot_pos, l_len);
+                stl::break_patterns(pivot_pos + 1, last, r_len);
+            } else if (already_partitioned && stl::partial_insertion_sort(first, pivot_pos, comp)
+                       && stl::partial_insertion_sort(pivot_pos + 1, last, comp)) {
+                // 划分时没有发生交换，并且两侧都很容易地用插入排序排好了
+                return;
+            }
+
+            // 递归处理左侧，循环处理右侧
+            stl::intro_sort<RandomIter, Compared, Branchless>(first, pivot_pos, comp, bad_allowed, leftmost);
+            first = pivot_pos + 1;
+            leftmost = false;
+        }
+    }
+
+    template<class RandomIter, class Compared>
+    void sort(RandomIter first, RandomIter last, Compared comp) {
+        if (last - first < 2) return;
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        stl::intro_sort<RandomIter, Compared, is_branchless_sortable<value_type, Compared>::value>(
+                first, last, comp, stl::slg2(static_cast<size_t>(last - first)), true);
+    }
+
+    template<class RandomIter>
+    void sort(RandomIter first, RandomIter last) {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        stl::sort(first, last, stl::less<value_type>());
+    }
+
+/*****************************************************************************************/
+// nth_element
+// 对序列重排，使得所有小于第 n 个元素的元素出现在它的前面，大于它的出现在它的后面
+// 采用内省式选择(introselect)：划分方式与 sort 相同，只继续处理 nth 所在的一侧，平均 O(n)
+// 不平衡的划分超过 log2(n) 次时改用中位数的中位数(median of medians)选取枢轴，保证最坏情况下 O(n)
+/*****************************************************************************************/
+    // 三路划分，以*first为枢轴，返回等于枢轴的区间[lt, gt)
+    // 不需要哨兵，用于 median of medians
+    template<class RandomIter, class Compared>
+    void partition3(RandomIter first, RandomIter last, RandomIter &lt, RandomIter &gt, Compared comp) {
+        auto pivot = *first;
+        lt = first;
+        gt = last;
+        for (auto i = first + 1; i < gt;) {
+            if (comp(*i, pivot))
+                stl::iter_swap(lt++, i++);
+            else if (comp(pivot, *i))
+                stl::iter_swap(i, --gt);
+            else
+                ++i;
+        }
+    }
+
+    // 每 5 个元素一组取中间值，中间值的中间值作为枢轴，保证两侧都至少有约 3/10 的元素
+    template<class RandomIter, class Compared>
+    void median_of_medians_select(RandomIter first, RandomIter nth, RandomIter last, Compared comp) {
+        while (last - first > static_cast<ptrdiff_t>(kSortInsertionThreshold)) {
+            auto store = first;
+            for (auto group = first; last - group >= 5; group += 5) {
+                stl::insertion_sort(group, group + 5, comp);
+                stl::iter_swap(store++, group + 2);
+            }
+            auto mid = first + (store - first) / 2;
+            stl::median_of_medians_select(first, mid, store, comp);
+
+            RandomIter lt, gt;
+            stl::iter_swap(first, mid);
+            stl::partition3(first, last, lt, gt, comp);
+            if (nth < lt)
+                last = lt;
+            else if (nth >= gt)
+                first = gt;
+            else
+                return;
+        }
+        stl::insertion_sort(first, last, comp);
+    }
+
+    template<class RandomIter, class Compared, bool Branchless>
+    void intro_select(RandomIter first, RandomIter nth, RandomIter last, Compared comp, size_t bad_allowed) {
+        typedef typename iterator_traits<RandomIter>::difference_type difference_type;
+        bool leftmost = true;
+        while (last - first >= static_cast<difference_type>(kSortInsertionThreshold)) {
+            const difference_type len = last - first;
+            const difference_type half = len / 2;
+            if (len > static_cast<difference_type>(kSortNintherThreshold)) {
+                stl::sort3(first, first + half, last - 1, comp);
+                stl::sort3(first + 1, first + (half - 1), last - 2, comp);
+                stl::sort3(first + 2, first + (half + 1), last - 3, comp);
+                stl::sort3(first + (half - 1), first + half, first + (half + 1), comp);
+                stl::iter_swap(first, first + half);
+            } else {
+                stl::sort3(first + half, first, last - 1, comp);
+            }
+
+            // 左侧的元素不大于区间内所有元素，与枢轴相等时，和枢轴相等的元素都是答案
+            if (!leftmost && !comp(*(first - 1), *first)) {
+                auto equal_last = stl::partition_left(first, last, comp);
+                if (nth <= equal_last) return;
+                first = equal_last + 1;
+                continue;
+            }
+
+            bool already_partitioned = false;
+            auto pivot_pos = Branchless
+                             ? stl::partition_right_branchless(first, last, comp, already_partitioned)
+                             : stl::partition_right(first, last, comp, already_partitioned);
+            if (pivot_pos == nth) return;
+
+            const difference_type l_len = pivot_pos - first;
+            const difference_type r_len = last - (pivot_pos + 1);
+            const bool go_left = nth < pivot_pos;
+            if (l_len < len / 8 || r_len < len / 8) {
+                if (--bad_allowed == 0) {
+                    if (go_left)
+                        stl::median_of_medians_select(first, nth, pivot_pos, comp);
+                    else
+                        stl::median_of_medians_select(pivot_pos + 1, nth, last, comp);
+                    return;
+                }
+                if (go_left)
+                    stl::break_patterns(first, pivot_pos, l_len);
+                else
+                    stl::break_patterns(pivot_pos + 1, last, r_len);
+            }
+
+            if (go_left) {
+                last = pivot_pos;
+            } else {
+                first = pivot_pos + 1;
+                leftmost = false;
+            }
+        }
+        stl::insertion_sort(first, last, comp);
+    }
+
+    template<class RandomIter, class Compared>
+    void nth_element(RandomIter first, RandomIter nth, RandomIter last, Compared comp) {
+        if (nth == last || last - first < 2) return;
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        stl::intro_select<RandomIter, Compared, is_branchless_sortable<value_type, Compared>::value>(
+                first, nth, last, comp, stl::slg2(static_cast<size_t>(last - first)));
+    }
+
+    template<class RandomIter>
+    void nth_element(RandomIter first, RandomIter nth, RandomIter last) {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        stl::nth_element(first, nth, last, stl::less<value_type>());
+    }
+
+/*****************************************************************************************/
+// partial_sort
+// 对整个序列做部分排序，保证较小的 middle - first 个元素以递增顺序置于[first, middle)内
+// k = middle - first 远小于 n 时用大小为 k 的堆，多数元素只需与堆顶比较一次，O(nlogk)
+// k 稍大时堆的替换次数和访存开销增长很快，改为先用 nth_element 选出前 k 个再排序，O(n + klogk)
+/*****************************************************************************************/
+    constexpr static size_t kPartialSortSelectRatio = 4096;   // k * ratio >= n 时改用 nth_element + sort
+
+    template<class RandomIter, class Compared>
+    void partial_sort(RandomIter first, RandomIter middle, RandomIter last, Compared comp) {
+        if (first == middle) return;
+        const auto k = middle - first;
+        const auto n = last - first;
+        if (static_cast<size_t>(k) * kPartialSortSelectRatio >= static_cast<size_t>(n)) {
+            if (middle == last) {
+                stl::sort(first, last, comp);
+                return;
+            }
+            // 第 k 个元素已经就位，只需排序它前面的部分
+            stl::nth_element(first, middle - 1, last, comp);
+            stl::sort(first, middle - 1, comp);
+            return;
+        }
+
+        stl::make_heap(first, middle, comp);
+        for (auto i = middle; i < last; ++i) {
+            // 比堆顶(前 k 个中最大的)小，取代堆顶
+            if (comp(*i, *first))
+                stl::pop_heap_aux(first, middle, i, stl::move(*i), distance_type(first), comp);
+        }
+        stl::sort_heap(first, middle, comp);
+    }
+
+    template<class RandomIter>
+    void partial_sort(RandomIter first, RandomIter middle, RandomIter last) {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        stl::partial_sort(first, middle, last, stl::less<value_type>());
+    }
+
+/*****************************************************************************************/
+// partial_sort_copy
+// 行为与 partial_sort 类似，不同的是把排序结果复制到 result 容器中，返回结果的末尾
+// 输入只需要是 input iterator，只遍历一次
+/*****************************************************************************************/
+    template<class InputIter, class RandomIter, class Compared>
+    RandomIter partial_sort_copy(InputIter first, InputIter last,
+                                 RandomIter result_first, RandomIter result_last, Compared comp) {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        typedef typename iterator_traits<RandomIter>::difference_type Distance;
+        if (result_first == result_last) return result_last;
+        auto result_iter = result_first;
+        for (; first != last && result_iter != result_last; ++first, ++result_iter)
+            *result_iter = *first;
+        stl::make_heap(result_first, result_iter, comp);
+        const Distance len = result_iter - result_first;
+        for (; first != last; ++first) {
+            if (comp(*first, *result_first))
+                stl::adjust_heap(result_first, static_cast<Distance>(0), len, value_type(*first), comp);
+        }
+        stl::sort_heap(result_first, result_iter, comp);
+        return result_iter;
+    }
+
+    template<class InputIter, class RandomIter>
+    RandomIter partial_sort_copy(InputIter first, InputIter last,
+                                 RandomIter result_first, RandomIter result_last) {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        return stl::partial_sort_copy(first, last, result_first, result_last, stl::less<value_type>());
+    }
+
+/*****************************************************************************************/
+// merge
+// 将两个经过排序的集合 S1 和 S2 合并起来置于另一段空间，返回一个迭代器指向最后一个元素的下一位置
+// 合并是稳定的，相等的元素中来自 S1 的排在前面
+/*****************************************************************************************/
+    template<class InputIter1, class InputIter2, class OutputIter>
+    OutputIter merge(InputIter1 first1, InputIter1 last1,
+                     InputIter2 first2, InputIter2 last2, OutputIter result) {
+        while (first1 != last1 && first2 != last2) {
+            if (*first2 < *first1) {
+                *result = *first2;
+                ++first2;
+            } else {
+                *result = *first1;
+                ++first1;
+            }
+            ++result;
+        }
+        return stl::copy(first2, last2, stl::copy(first1, last1, result));
+    }
+
+    // 重载版本使用函数对象 comp 代替比较操作
+    template<class InputIter1, class InputIter2, class OutputIter, class Compared>
+    OutputIter merge(InputIter1 first1, InputIter1 last1,
+                     InputIter2 first2, InputIter2 last2, OutputIter result, Compared comp) {
+        while (first1 != last1 && first2 != last2) {
+            if (comp(*first2, *first1)) {
+                *result = *first2;
+                ++first2;
+            } else {
+                *result = *first1;
+                ++first1;
+            }
+            ++result;
+        }
+        return stl::copy(first2, last2, stl::copy(first1, last1, result));
+    }
+
+/*****************************************************************************************/
+// inplace_merge
+// 把连接在一起的两个有序序列结合成单一序列并保持有序，合并是稳定的
+// 用 get_temporary_buffer 申请与较短一侧等长的缓冲区(申请失败时它会减半重试)：
+//   * 缓冲区放得下较短的一侧时，搬到缓冲区后线性合并
+//   * 放不下时在较长的一侧取中点，二分找到另一侧的对应位置，旋转后拆成两个独立的子问题
+//   * 完全没有缓冲区时，只用 rotate 完成合并，复杂度 O(nlogn)
+/*****************************************************************************************/
+    // 把缓冲区中的[buf_first, buf_last)与[first2, last2)合并到 result，result 位于 first2 之前
+    template<class Pointer, class BidirectionalIter, class Compared>
+    void move_merge_forward(Pointer buf_first, Pointer buf_last,
+                            BidirectionalIter first2, BidirectionalIter last2,
+                            BidirectionalIter result, Compared comp) {
+        while (buf_first != buf_last && first2 != last2) {
+            if (comp(*first2, *buf_first)) {
+                *result = stl::move(*first2);
+                ++first2;
+            } else {
+                *result = stl::move(*buf_first);
+                ++buf_first;
+            }
+            ++result;
+        }
+        // 第二个序列剩下的元素已经在正确的位置上
+        stl::move(buf_first, buf_last, result);
+    }
+
+    // 把[first1, last1)与缓冲区中的[buf_first, buf_last)从后向前合并，结果的末尾为 result
+    template<class BidirectionalIter, class Pointer, class Compared>
+    void move_merge_backward(BidirectionalIter first1, BidirectionalIter last1,
+                             Pointer buf_first, Pointer buf_last,
+                             BidirectionalIter result, Compared comp) {
+        if (first1 == last1) {
+            stl::move_backward(buf_first, buf_last, result);
+            return;
+        }
+        if (buf_first == buf_last) return;
+        --last1;
+        --buf_last;
+        while (true) {
+            // 相等时先放缓冲区中的元素，它来自第二个序列，应当排在后面
+            if (comp(*buf_last, *last1)) {
+                *--result = stl::move(*last1);
+                if (first1 == last1) {
+                    stl::move_backward(buf_first, ++buf_last, result);
+                    return;
+                }
+                --last1;
+            } else {
+                *--result = stl::move(*buf_last);
+                if (buf_first == buf_last) return;
+                --buf_last;
+            }
+        }
+    }
+
+    // 借助缓冲区旋转，缓冲区放不下任何一侧时使用 rotate
+    template<class BidirectionalIter, class Distance, class T>
+    BidirectionalIter rotate_adaptive(BidirectionalIter first, BidirectionalIter middle,
+                                      BidirectionalIter last, Distance len1, Distance len2,
+                                      T *buffer, Distance buffer_size) {
+        if (len1 > len2 && len2 <= buffer_size) {
+            if (len2 == 0) return first;
+            T *buf_end = stl::uninitialized_move(middle, last, buffer);
+            stl::move_backward(first, middle, last);
+            auto result = stl::move(buffer, buf_end, first);
+            stl::destroy(buffer, buf_end);
+            return result;
+        } else if (len1 <= buffer_size) {
+            if (len1 == 0) return last;
+            T *buf_end = stl::uninitialized_move(first, middle, buffer);
+            stl::move(middle, last, first);
+            auto result = stl::move_backward(buffer, buf_end, last);
+            stl::destroy(buffer, buf_end);
+            return result;
+        }
+        return stl::rotate(first, middle, last);
+    }
+
+    // 在较长的一侧取中点，在另一侧二分找到对应位置，cut1、cut2 之间的部分需要旋转
+    template<class BidirectionalIter, class Distance, class Compared>
+    void merge_split(BidirectionalIter first, BidirectionalIter middle, BidirectionalIter last,
+                     Distance len1, Distance len2, BidirectionalIter &cut1, BidirectionalIter &cut2,
+                     Distance &len11, Distance &len22, Compared comp) {
+        cut1 = first;
+        cut2 = middle;
+        if (len1 > len2) {
+            len11 = len1 / 2;
+            stl::advance(cut1, len11);
+            cut2 = stl::lower_bound(middle, last, *cut1, comp);
+            len22 = stl::distance(middle, cut2);
+        } else {
+            len22 = len2 / 2;
+            stl::advance(cut2, len22);
+            cut1 = stl::upper_bound(first, middle, *cut2, comp);
+            len11 = stl::distance(first, cut1);
+        }
+    }
+
+    // 没有缓冲区时的合并
+    template<class BidirectionalIter, class Distance, class Compared>
+    void merge_without_buffer(BidirectionalIter first, BidirectionalIter middle, BidirectionalIter last,
+                              Distance len1, Distance len2, Compared comp) {
+        while (len1 != 0 && len2 != 0) {
+            if (len1 + len2 == 2) {
+                if (comp(*middle, *first)) stl::iter_swap(first, middle);
+                return;
+            }
+            BidirectionalIter cut1, cut2;
+            Distance len11, len22;
+            stl::merge_split(first, middle, last, len1, len2, cut1, cut2, len11, len22, comp);
+            auto new_middle = stl::rotate(cut1, middle, cut2);
+            // 递归处理左侧，循环处理右侧
+            stl::merge_without_buffer(first, cut1, new_middle, len11, len22, comp);
+            first = new_middle;
+            middle = cut2;
+            len1 -= len11;
+            len2 -= len22;
+        }
+    }
+
+    // 有缓冲区时的合并，缓冲区能容纳 buffer_size 个元素
+    template<class BidirectionalIter, class Distance, class T, class Compared>
+    void merge_adaptive(BidirectionalIter first, BidirectionalIter middle, BidirectionalIter last,
+                        Distance len1, Distance len2, T *buffer, Distance buffer_size, Compared comp) {
+        while (len1 != 0 && len2 != 0) {
+            if (len1 <= len2 && len1 <= buffer_size) {
+                T *buf_end = stl::uninitialized_move(first, middle, buffer);
+                stl::move_merge_forward(buffer, buf_end, middle, last, first, comp);
+                stl::destroy(buffer, buf_end);
+                return;
+            }
+            if (len2 <= buffer_size) {
+                T *buf_end = stl::uninitialized_move(middle, last, buffer);
+                stl::move_merge_backward(first, middle, buffer, buf_end, last, comp);
+                stl::destroy(buffer, buf_end);
+                return;
+            }
+            BidirectionalIter cut1, cut2;
+            Distance len11, len22;
+            stl::merge_split(first, middle, last, len1, len2, cut1, cut2, len11, len22, comp);
+            auto new_middle = stl::rotate_adaptive(cut1, middle, cut2, len1 - len11, len22,
+                                                   buffer, buffer_size);
+            stl::merge_adaptive(first, cut1, new_middle, len11, len22, buffer, buffer_size, comp);
+            first = new_middle;
+            middle = cut2;
+            len1 -= len11;
+            len2 -= len22;
+        }
+    }
+
+    template<class BidirectionalIter, class Compared>
+    void inplace_merge(BidirectionalIter first, BidirectionalIter middle, BidirectionalIter last,
+                       Compared comp) {
+        if (first == middle || middle == last) return;
+        typedef typename iterator_traits<BidirectionalIter>::value_type value_type;
+        typedef typename iterator_traits<BidirectionalIter>::difference_type Distance;
+        const Distance len1 = stl::distance(first, middle);
+        const Distance len2 = stl::distance(middle, last);
+        auto buf = stl::get_temporary_buffer<value_type>(static_cast<ptrdiff_t>(stl::min(len1, len2)));
+        if (buf.first == nullptr) {
+            stl::merge_without_buffer(first, middle, last, len1, len2, comp);
+            return;
+        }
+        try {
+            stl::merge_adaptive(first, middle, last, len1, len2, buf.first,
+                                static_cast<Distance>(buf.second), comp);
+        }
+        catch (...) {
+            stl::release_temporary_buffer(buf.first);
+            throw;
+        }
+        stl::release_temporary_buffer(buf.first);
+    }
+
+    template<class BidirectionalIter>
+    void inplace_merge(BidirectionalIter first, BidirectionalIter middle, BidirectionalIter last) {
+        typedef typename iterator_traits<BidirectionalIter>::value_type value_type;
+        stl::inplace_merge(first, middle, last, stl::less<value_type>());
+    }
+
+/*****************************************************************************************/
+// stable_sort
+// 将[first, last)内的元素以递增的方式排序，相等元素的相对次序保持不变
+// 参考 TimSort：
+//   * 从左到右找出自然有序的区间(run)，严格降序的区间直接翻转，较短的 run 用二分插入排序补齐到 min_run
+//   * run 压入栈中，按 TimSort 的规则(栈中相邻 run 的长度近似斐波那契数列)合并相邻的 run，保证合并是平衡的
+//   * 合并前先二分跳过两侧已经就位的元素，基本有序的输入只需要很少的比较和移动
+//   * 合并使用 get_temporary_buffer 得到的缓冲区，大小不够时按 inplace_merge 的方式退化
+/*****************************************************************************************/
+    constexpr static size_t kStableSortMinMerge = 64;   // 小于该长度时整个区间直接插入排序
+    constexpr static size_t kStableSortMaxRuns = 128;   // run 栈的容量，合并规则保证栈深度为 O(logn)
+
+    // run 的最短长度，在[kStableSortMinMerge / 2, kStableSortMinMerge]内，使 n / min_run 接近 2 的幂
+    template<class Distance>
+    Distance stable_sort_min_run(Distance n) {
+        Distance r = 0;
+        while (n >= static_cast<Distance>(kStableSortMinMerge)) {
+            r |= n & 1;
+            n >>= 1;
+        }
+        return n + r;
+    }
+
+    // 从 first 开始找出一个 run 并使其升序，返回 run 的末尾
+    // 只有严格降序的部分才翻转，否则会破坏相等元素的次序
+    template<class RandomIter, class Compared>
+    RandomIter make_ascending_run(RandomIter first, RandomIter last, Compared comp) {
+        auto run_end = first + 1;
+        if (run_end == last) return last;
+        if (comp(*run_end, *first)) {
+            for (++run_end; run_end != last && comp(*run_end, *(run_end - 1)); ++run_end) {}
+            stl::reverse(first, run_end);
+        } else {
+            for (++run_end; run_end != last && !comp(*run_end, *(run_end - 1)); ++run_end) {}
+        }
+        return run_end;
+    }
+
+    // 二分插入排序，[first, start)已经有序
+    template<class RandomIter, class Compared>
+    void binary_insertion_sort(RandomIter first, RandomIter start, RandomIter last, Compared comp) {
+        for (; start != last; ++start) {
+            auto pos = stl::upper_bound(first, start, *start, comp);
+            if (pos != start) {
+                auto tmp = stl::move(*start);
+                stl::move_backward(pos, start, start + 1);
+                *pos = stl::move(tmp);
+            }
+        }
+    }
+
+    // 待合并的 run 栈及合并用的缓冲区
+    template<class RandomIter, class Compared>
+    class stable_sort_runs {
+    public:
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        typedef typename iterator_traits<RandomIter>::difference_type Distance;
+
+        stable_sort_runs(RandomIter first, Distance n, Compared comp)
+                : first_(first), comp_(comp), size_(0) {
+            auto buf = stl::get_temporary_buffer<value_type>(static_cast<ptrdiff_t>((n + 1) / 2));
+            buffer_ = buf.first;
+            buffer_size_ = static_cast<Distance>(buf.second);
+        }
+
+        ~stable_sort_runs() { stl::release_temporary_buffer(buffer_); }
+
+        void push(Distance base, Distance len) {
+            base_[size_] = base;
+            len_[size_] = len;
+            ++size_;
+        }
+
+        // 合并到栈中相邻 run 的长度满足：
+        //   len[i - 2] > len[i - 1] + len[i]，len[i - 1] > len[i]
+        // 同时检查 len[i - 3]，修正了 TimSort 原始实现中不变式可能被破坏的问题
+        void merge_collapse() {
+            while (size_ > 1) {
+                size_t n = size_ - 2;
+                if ((n > 0 && len_[n - 1] <= len_[n] + len_[n + 1]) ||
+                    (n > 1 && len_[n - 2] <= len_[n - 1] + len_[n])) {
+                    if (len_[n - 1] < len_[n + 1]) --n;
+                } else if (len_[n] > len_[n + 1]) {
+                    break;
+                }
+                merge_at(n);
+            }
+        }
+
+        // 合并剩下所有的 run
+        void merge_force_collapse() {
+            while (size_ > 1) {
+                size_t n = size_ - 2;
+                if (n > 0 && len_[n - 1] < len_[n + 1]) --n;
+                merge_at(n);
+            }
+        }
+
+    private:
+        // 合并栈中第 i 个和第 i + 1 个 run
+        void merge_at(size_t i) {
+            RandomIter lo = first_ + base_[i];
+            RandomIter mid = lo + len_[i];
+            RandomIter hi = mid + len_[i + 1];
+            len_[i] += len_[i + 1];
+            for (size_t k = i + 1; k + 1 < size_; ++k) {
+                base_[k] = base_[k + 1];
+                len_[k] = len_[k + 1];
+            }
+            --size_;
+
+            // 左侧不大于右侧第一个元素的部分、右侧不小于左侧最后一个元素的部分已经就位
+            lo = stl::upper_bound(lo, mid, *mid, comp_);
+            if (lo == mid) return;
+            hi = stl::lower_bound(mid, hi, *(mid - 1), comp_);
+            if (buffer_ == nullptr)
+                stl::merge_without_buffer(lo, mid, hi, mid - lo, hi - mid, comp_);
+            else
+                stl::merge_adaptive(lo, mid, hi, mid - lo, hi - mid, buffer_, buffer_size_, comp_);
+        }
+
+    private:
+        RandomIter first_;
+        Compared comp_;
+        value_type *buffer_;
+        Distance buffer_size_;
+        Distance base_[kStableSortMaxRuns];
+        Distance len_[kStableSortMaxRuns];
+        size_t size_;
+
+    private:
+        stable_sort_runs(const stable_sort_runs &);
+
+        void operator=(const stable_sort_runs &);
+    };
+
+    template<class RandomIter, class Compared>
+    void stable_sort(RandomIter first, RandomIter last, Compared comp) {
+        typedef typename iterator_traits<RandomIter>::difference_type Distance;
+        const Distance n = last - first;
+        if (n < 2) return;
+        if (n < static_cast<Distance>(kStableSortMinMerge)) {
+            stl::binary_insertion_sort(first, stl::make_ascending_run(first, last, comp), last, comp);
+            return;
+        }
+
+        stable_sort_runs<RandomIter, Compared> runs(first, n, comp);
+        const Distance min_run = stl::stable_sort_min_run(n);
+        for (RandomIter lo = first; lo != last;) {
+            RandomIter run_end = stl::make_ascending_run(lo, last, comp);
+            // 太短的 run 补齐到 min_run
+            if (run_end - lo < min_run) {
+                RandomIter forced_end = last - lo > min_run ? lo + min_run : last;
+                stl::binary_insertion_sort(lo, run_end, forced_end, comp);
+                run_end = forced_end;
+            }
+            runs.push(lo - first, run_end - lo);
+            runs.merge_collapse();
+            lo = run_end;
+        }
+        runs.merge_force_collapse();
+    }
+
+    template<class RandomIter>
+    void stable_sort(RandomIter first, RandomIter last) {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        stl::stable_sort(first, last, stl::less<value_type>());
+    }
+
 }
 
 
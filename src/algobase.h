@@ -8,6 +8,7 @@
 #include <cstring>
 
 #include "iterator.h"
+#include "simd.h"
 #include "utils.h"
 
 namespace stl {
@@ -166,14 +167,30 @@ namespace stl {
 /*****************************************************************************************/
     // 一元操作：有一个形参返回值为bool的函数
     template<class InputIter, class OutputIter, class UnaryPredicate>
-    OutputIter copy_if(InputIter first, InputIter last, OutputIter result,
-                       UnaryPredicate unary_pred) {
+    OutputIter unchecked_copy_if(InputIter first, InputIter last, OutputIter result,
+                                 UnaryPredicate unary_pred) {
         for (; first != last; ++first) {
             if (unary_pred(*first)) {
                 *result++ = *first;
             }
-            return result;
         }
+        return result;
+    }
+
+    // 为连续的算术类型区间提供特化版本，无分支地压缩，见 simd.h 中的 simd_copy_if
+    template<class Tp, class Up, class UnaryPredicate>
+    typename std::enable_if<
+            stl::simd_element<Tp>::value &&
+            std::is_same<typename std::remove_const<Tp>::type, Up>::value,
+            Up *>::type
+    unchecked_copy_if(Tp *first, Tp *last, Up *result, UnaryPredicate unary_pred) {
+        return stl::simd_copy_if<Up>(first, last, result, unary_pred);
+    }
+
+    template<class InputIter, class OutputIter, class UnaryPredicate>
+    OutputIter copy_if(InputIter first, InputIter last, OutputIter result,
+                       UnaryPredicate unary_pred) {
+        return unchecked_copy_if(first, last, result, unary_pred);
     }
 
 /*****************************************************************************************/
@@ -314,7 +331,7 @@ namespace stl {
 // 比较第一序列在 [first, last)区间上的元素值是否和第二序列相等
 /*****************************************************************************************/
     template<class InputIter1, class InputIter2>
-    bool equal(InputIter1 first1, InputIter1 last1, InputIter2 first2) {
+    bool unchecked_equal(InputIter1 first1, InputIter1 last1, InputIter2 first2) {
         for (; first1 != last1; ++first1, ++first2) {
             if (*first1 != *first2) {
                 return false;
@@ -323,6 +340,22 @@ namespace stl {
         return true;
     }
 
+    // 为元素类型相同的连续算术类型区间提供特化版本，整数使用 memcmp，浮点数使用向量化的比较
+    template<class Tp, class Up>
+    typename std::enable_if<
+            stl::simd_element<Tp>::value &&
+            std::is_same<typename std::remove_const<Tp>::type, typename std::remove_const<Up>::type>::value,
+            bool>::type
+    unchecked_equal(Tp *first1, Tp *last1, Up *first2) {
+        typedef typename std::remove_const<Tp>::type value_type;
+        return stl::simd_equal<value_type>(first1, first2, static_cast<size_t>(last1 - first1));
+    }
+
+    template<class InputIter1, class InputIter2>
+    bool equal(InputIter1 first1, InputIter1 last1, InputIter2 first2) {
+        return unchecked_equal(first1, last1, first2);
+    }
+
     // 重载版本 使用函数对象 comp 代替来进行比较
     template<class InputIter1, class InputIter2, class Compared>
     bool equal(InputIter1 first1, InputIter1 last1, InputIter2 first2,
@@ -346,22 +379,19 @@ namespace stl {
         return first;
     }
 
-    // 为 one-byte 类型提供特化版本
+    // 为连续的、可平凡复制的类型提供特化版本，整组写入，见 simd.h 中的 simd_fill
+    // 填入的值先转换为 Tp，只有 Up 与 Tp 相同或者两者都是算术类型时，这与逐个赋值的结果相同
     template<class Tp, class Size, class Up>
-    // 检查 T 是否为整数类型。若 T 为 bool 、 char 、 char8_t 、
-    // char16_t 、 char32_t 、 wchar_t 、 short 、 int 、 long 、
-    // long long 类型，或任何实现定义的扩展整数类型，包含任何有符号、无符号
-    // 及 cv 限定的变体。则提供等于 true 的成员常量 value 。否则， value 等于 false 。
     typename std::enable_if<
-            std::is_integral<Tp>::value && sizeof(Tp) == 1 &&
-            !std::is_same<Tp, bool>::value &&
-            std::is_integral<Up>::value && sizeof(Up) == 1,
+            std::is_trivially_copyable<Tp>::value && std::is_trivially_copy_assignable<Tp>::value &&
+            !std::is_volatile<Tp>::value &&
+            (std::is_same<Tp, typename std::remove_cv<Up>::type>::value ||
+             (std::is_arithmetic<Tp>::value && std::is_arithmetic<Up>::value)),
             Tp *>::type
-    unchecked_fill_n(Tp *first, Size n, Up value) {
-        if (n > 0) {
-            std::memset(first, (unsigned char) value, (size_t) (n));
-        }
-        return first + n;
+    unchecked_fill_n(Tp *first, Size n, const Up &value) {
+        if (n <= 0) return first;
+        const Tp v = static_cast<Tp>(value);
+        return stl::simd_fill(first, static_cast<size_t>(n), v);
     }
 
     template<class OutputIter, class Size, class T>
@@ -434,7 +464,7 @@ namespace stl {
 /*****************************************************************************************/
     template<class InputIter1, class InputIter2>
     stl::pair<InputIter1, InputIter2>
-    mismatch(InputIter1 first1, InputIter1 last1, InputIter2 first2) {
+    unchecked_mismatch(InputIter1 first1, InputIter1 last1, InputIter2 first2) {
         while (first1 != last1 && *first1 == *first2) {
             ++first1;
             ++first2;
@@ -442,6 +472,24 @@ namespace stl {
         return stl::pair<InputIter1, InputIter2>(first1, first2);
     }
 
+    // 为元素类型相同的连续算术类型区间提供向量化的特化版本
+    template<class Tp, class Up>
+    typename std::enable_if<
+            stl::simd_element<Tp>::value &&
+            std::is_same<typename std::remove_const<Tp>::type, typename std::remove_const<Up>::type>::value,
+            stl::pair<Tp *, Up *>>::type
+    unchecked_mismatch(Tp *first1, Tp *last1, Up *first2) {
+        typedef typename std::remove_const<Tp>::type value_type;
+        const size_t i = stl::simd_mismatch<value_type>(first1, first2, static_cast<size_t>(last1 - first1));
+        return stl::pair<Tp *, Up *>(first1 + i, first2 + i);
+    }
+
+    template<class InputIter1, class InputIter2>
+    stl::pair<InputIter1, InputIter2>
+    mismatch(InputIter1 first1, InputIter1 last1, InputIter2 first2) {
+        return unchecked_mismatch(first1, last1, first2);
+    }
+
     // 重载版本使用函数对象 comp 代替比较操作
     template<class InputIter1, class InputIter2, class Compred>
     stl::pair<InputIter1, InputIter2>
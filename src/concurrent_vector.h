@@ -0,0 +1,213 @@
+#ifndef MYCPPSTL_CONCURRENT_VECTOR_H
+#define MYCPPSTL_CONCURRENT_VECTOR_H
+
+// 这个头文件包含一个模板类 concurrent_vector
+// concurrent_vector : 只能在尾部追加的并发向量，多个线程可以同时 push_back，同时其他线程按下标读取
+
+// notes:
+//
+// 布局与 deque 类似，由一个 map 和多段缓冲区(段)构成，区别在于：
+//   * 第 k 段的大小为 first_segment_size << k，按几何级数增长，因此 map 的大小是固定的，
+//     永远不需要重新分配，已有的元素也永远不会移动
+//   * push_back 通过 fetch_add 领取一个下标，不需要加锁；段由第一个用到它的线程分配，
+//     多个线程同时分配同一段时用 compare_exchange 决出胜者，失败者释放自己分配的段
+//   * operator[] 只做几次位运算和一次原子读，是 wait-free 的
+//
+// 可见性：
+//   push_back 返回后，对应下标的元素在本线程内立即可用；其他线程需要通过某种同步手段
+//   (例如把下标通过原子变量传过去)得知这个下标后才能读取它。size() 统计的是已经领取的下标个数，
+//   其中可能包含仍在构造中的元素
+//
+// 异常保证：
+//   push_back / emplace_back 为 noexcept，元素构造或者段的分配抛出异常时会调用 std::terminate
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+
+#include "algobase.h"
+#include "allocator.h"
+#include "construct.h"
+#include "utils.h"
+#include "exceptdef.h"
+
+namespace stl {
+
+// 第一段的大小为 2^CONCURRENT_VECTOR_FIRST_SEGMENT_BITS
+#ifndef CONCURRENT_VECTOR_FIRST_SEGMENT_BITS
+#define CONCURRENT_VECTOR_FIRST_SEGMENT_BITS 5
+#endif
+
+    // x的最高位1所在的位置，x不能为0
+    inline size_t concurrent_vector_log2(size_t x) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        return sizeof(unsigned long long) * 8 - 1 - __builtin_clzll(x);
+#else
+        size_t n = 0;
+        while (x >>= 1) ++n;
+        return n;
+#endif
+    }
+
+    template<class T>
+    class concurrent_vector {
+    public:
+        typedef stl::allocator<T> allocator_type;
+        typedef stl::allocator<T> data_allocator;
+
+        typedef typename allocator_type::value_type value_type;
+        typedef typename allocator_type::pointer pointer;
+        typedef typename allocator_type::const_pointer const_pointer;
+        typedef typename allocator_type::reference reference;
+        typedef typename allocator_type::const_reference const_reference;
+        typedef typename allocator_type::size_type size_type;
+        typedef typename allocator_type::difference_type difference_type;
+
+        allocator_type get_allocator() { return allocator_type(); }
+
+        static constexpr size_type first_segment_bits = CONCURRENT_VECTOR_FIRST_SEGMENT_BITS;
+        static constexpr size_type first_segment_size = static_cast<size_type>(1) << first_segment_bits;
+        // 段的个数，所有段的容量之和覆盖整个size_type的范围
+        static constexpr size_type segment_count = sizeof(size_type) * 8 - first_segment_bits;
+
+    private:
+        std::atomic<pointer> map_[segment_count];   // 每个元素指向一段缓冲区，未分配时为nullptr
+        std::atomic<size_type> size_;               // 已经领取的下标个数
+
+    public:
+
+        /// constructor 构造，析构
+
+        concurrent_vector() : size_(0) {
+            for (size_type k = 0; k < segment_count; ++k)
+                map_[k].store(nullptr, std::memory_order_relaxed);
+            // 第一段总会用到，提前分配避免多个线程在一开始就竞争
+            map_[0].store(data_allocator::allocate(first_segment_size), std::memory_order_relaxed);
+        }
+
+        // 元素的地址要保持不变，因此不能拷贝和移动
+        concurrent_vector(const concurrent_vector &) = delete;
+
+        concurrent_vector &operator=(const concurrent_vector &) = delete;
+
+        // 析构时不能有其他线程仍在访问
+        ~concurrent_vector() {
+            const size_type n = size_.load(std::memory_order_acquire);
+            for (size_type k = 0; k < segment_count; ++k) {
+                pointer seg = map_[k].load(std::memory_order_acquire);
+                if (seg == nullptr) continue;
+                const size_type begin = segment_base(k);
+                if (begin < n) {
+                    const size_type end = stl::min(n, begin + segment_size(k));
+                    data_allocator::destroy(seg, seg + (end - begin));
+                }
+                data_allocator::deallocate(seg, segment_size(k));
+            }
+        }
+
+    public:
+
+        /// 容量相关操作
+
+        // 已经领取的下标个数，其中可能有元素仍在构造中
+        size_type size() const noexcept { return size_.load(std::memory_order_acquire); }
+
+        bool empty() const noexcept { return size() == 0; }
+
+        size_type max_size() const noexcept { return static_cast<size_type>(-1) - first_segment_size; }
+
+        // 已经分配好的段所能容纳的元素个数(从下标0开始连续的部分)
+        size_type capacity() const noexcept {
+            size_type k = 0;
+            while (k < segment_count && map_[k].load(std::memory_order_acquire) != nullptr) ++k;
+            return segment_base(k);
+        }
+
+        // 提前分配能容纳n个元素的段，可以与push_back并发调用
+        void reserve(size_type n) {
+            if (n == 0) return;
+            const size_type last = segment_of(n - 1);
+            for (size_type k = 0; k <= last; ++k)
+                ensure_segment(k);
+        }
+
+        /// 访问元素相关操作
+
+        // wait-free：不加锁，也不会等待其他线程
+        reference operator[](size_type n) noexcept {
+            const size_type k = segment_of(n);
+            return map_[k].load(std::memory_order_acquire)[n + first_segment_size - segment_start(k)];
+        }
+
+        const_reference operator[](size_type n) const noexcept {
+            const size_type k = segment_of(n);
+            return map_[k].load(std::memory_order_acquire)[n + first_segment_size - segment_start(k)];
+        }
+
+        reference at(size_type n) {
+            THROW_OUT_OF_RANGE_IF(!(n < size()), "concurrent_vector<T>::at() subscript out of range");
+            return (*this)[n];
+        }
+
+        const_reference at(size_type n) const {
+            THROW_OUT_OF_RANGE_IF(!(n < size()), "concurrent_vector<T>::at() subscript out of range");
+            return (*this)[n];
+        }
+
+        /// 修改容器相关操作
+
+        // 返回新元素的下标
+        template<class ...Args>
+        size_type emplace_back(Args &&...args) noexcept {
+            const size_type n = size_.fetch_add(1, std::memory_order_acq_rel);
+            const size_type k = segment_of(n);
+            pointer seg = ensure_segment(k);
+            data_allocator::construct(seg + (n + first_segment_size - segment_start(k)),
+                                      stl::forward<Args>(args)...);
+            return n;
+        }
+
+        size_type push_back(const value_type &value) noexcept { return emplace_back(value); }
+
+        size_type push_back(value_type &&value) noexcept { return emplace_back(stl::move(value)); }
+
+    private:
+
+        /// help function
+
+        // 下标n所在的段：令 m = n + first_segment_size，第k段覆盖 [2^(k+b), 2^(k+b+1)) 内的m
+        static size_type segment_of(size_type n) noexcept {
+            return concurrent_vector_log2(n + first_segment_size) - first_segment_bits;
+        }
+
+        // 第k段第一个元素对应的 m = n + first_segment_size
+        static size_type segment_start(size_type k) noexcept {
+            return first_segment_size << k;
+        }
+
+        // 第k段第一个元素的下标
+        static size_type segment_base(size_type k) noexcept {
+            return segment_start(k) - first_segment_size;
+        }
+
+        static size_type segment_size(size_type k) noexcept {
+            return first_segment_size << k;
+        }
+
+        // 保证第k段已经分配，返回该段的地址
+        pointer ensure_segment(size_type k) {
+            pointer seg = map_[k].load(std::memory_order_acquire);
+            if (seg != nullptr) return seg;
+            pointer fresh = data_allocator::allocate(segment_size(k));
+            if (map_[k].compare_exchange_strong(seg, fresh, std::memory_order_acq_rel,
+                                                std::memory_order_acquire))
+                return fresh;
+            // 其他线程先分配好了，使用它的段
+            data_allocator::deallocate(fresh, segment_size(k));
+            return seg;
+        }
+    };
+
+}   // namespace stl
+
+#endif //MYCPPSTL_CONCURRENT_VECTOR_H
@@ -39,10 +39,42 @@ namespace stl {
 #define DEQUE_MAP_INIT_SIZE 8
 #endif
 
+// 空闲缓冲区的回收策略(滞后回收)：
+// 元素被删除后空出的缓冲区不会立即释放，而是作为空闲缓冲区留在map中，供之后的插入复用
+// 当某一侧的空闲缓冲区超过 DEQUE_SPARE_NODE_HIGH 个时，才释放到只剩 DEQUE_SPARE_NODE_LOW 个
+#ifndef DEQUE_SPARE_NODE_HIGH
+#define DEQUE_SPARE_NODE_HIGH 4
+#endif
+
+#ifndef DEQUE_SPARE_NODE_LOW
+#define DEQUE_SPARE_NODE_LOW 1
+#endif
+
+// 缓冲区大小取2的幂(向下取整)，定位元素所在的缓冲区和偏移时可以用移位和掩码代替除法和取模
+// 元素大小本身是2的幂时(int、double、指针等)，缓冲区大小天然就是2的幂，不受该选项影响
+#ifndef DEQUE_BUF_POW2
+#define DEQUE_BUF_POW2 0
+#endif
+
+    // 不大于n的最大的2的幂
+    constexpr size_t deque_floor_pow2(size_t n) {
+        return n <= 1 ? 1 : deque_floor_pow2(n >> 1) << 1;
+    }
+
+    // 2的幂n的以2为底的对数
+    constexpr size_t deque_log2(size_t n) {
+        return n <= 1 ? 0 : deque_log2(n >> 1) + 1;
+    }
+
     template<class T>
     struct deque_buf_size {
         // 保证元素个数不少于16
-        static constexpr size_t value = sizeof(T) < 256 ? 4096 / sizeof(T) : 16;
+        static constexpr size_t raw_value = sizeof(T) < 256 ? 4096 / sizeof(T) : 16;
+        static constexpr size_t value = DEQUE_BUF_POW2 ? deque_floor_pow2(raw_value) : raw_value;
+
+        static constexpr bool is_pow2 = (value & (value - 1)) == 0;
+        static constexpr size_t shift = deque_log2(value);  // 仅当is_pow2时有意义
+        static constexpr size_t mask = value - 1;           // 仅当is_pow2时有意义
     };
 
     // deque 的迭代器
@@ -87,26 +119,20 @@ namespace stl {
                 : cur(v), first(*n), last(*n + buffer_size), node(n) {}
 
         // 直接把指针拷贝一份，迭代器只起到定位的作用，不回去释放内存
-        explicit deque_iterator(const iterator &rhs)
+        deque_iterator(const iterator &rhs)
                 : cur(rhs.cur), first(rhs.first), last(rhs.last), node(rhs.node) {}
 
-        explicit deque_iterator(iterator &&rhs) noexcept
+        deque_iterator(iterator &&rhs) noexcept
                 : cur(rhs.cur), first(rhs.first), last(rhs.last), node(rhs.node) {
-            rhs.cur = rhs.first = rhs.last = rhs.node = nullptr;
+            rhs.cur = rhs.first = rhs.last = nullptr;
+            rhs.node = nullptr;
         }
 
-        explicit deque_iterator(const const_iterator &rhs) : cur(rhs.cur), first(rhs.first), last(rhs.last),
+        deque_iterator(const const_iterator &rhs) : cur(rhs.cur), first(rhs.first), last(rhs.last),
                                                              node(rhs.node) {}
 
-        self &operator=(const iterator &rhs) {
-            if (this != &rhs) {
-                cur = rhs.cur;
-                first = rhs.first;
-                last = rhs.last;
-                node = rhs.node;
-            }
-            return *this;
-        }
+        // const_iterator 由 iterator 赋值时先经过上面的转换构造函数
+        deque_iterator &operator=(const deque_iterator &) = default;
 
         // 切换到另一个缓冲区
         void set_node(map_pointer new_node) {
@@ -168,6 +194,13 @@ namespace stl {
             const auto offset = n + (cur - first);
             if (offset >= 0 && offset < static_cast<difference_type>(buffer_size)) {
                 cur = first + offset;
+            } else if (deque_buf_size<T>::is_pow2) {
+                // C++20之前负数右移的结果由实现定义，负数时对-offset-1右移再取反，得到向下取整的除法；
+                // 转成无符号数后与掩码相与即非负的余数
+                const auto step = offset >= 0 ? offset >> deque_buf_size<T>::shift
+                                              : -((-offset - 1) >> deque_buf_size<T>::shift) - 1;
+                set_node(node + step);
+                cur = first + static_cast<difference_type>(static_cast<size_t>(offset) & deque_buf_size<T>::mask);
             } else {
                 const auto step = offset > 0 ?
                                   offset / static_cast<difference_type>(buffer_size)
@@ -178,7 +211,7 @@ namespace stl {
             return *this;
         }
 
-        self operator+(difference_type n) {
+        self operator+(difference_type n) const {
             self tmp = *this;
             return tmp += n;
         }
@@ -187,7 +220,7 @@ namespace stl {
             return (*this) += (-n);
         }
 
-        self operator-(difference_type n) {
+        self operator-(difference_type n) const {
             self tmp = *this;
             return tmp += (-n);
         }
@@ -257,6 +290,16 @@ namespace stl {
                                  每个数据块指向一个长为buffer_size的缓冲区 */
         size_type map_size_;    // 数据块的个数
 
+        /// 空闲缓冲区的回收策略
+        /// 空闲缓冲区指map中位于[begin_.node, end_.node]之外、已经分配了的缓冲区，它们总是紧挨着
+        /// begin_.node和end_.node连续排列
+        size_type spare_high_ = DEQUE_SPARE_NODE_HIGH;  // 单侧空闲缓冲区多于该值时触发回收
+        size_type spare_low_ = DEQUE_SPARE_NODE_LOW;    // 回收后单侧保留的空闲缓冲区个数
+        size_type front_reserved_ = 0;  // reserve_front预留的空闲缓冲区个数，回收时至少保留这么多
+        size_type back_reserved_ = 0;   // reserve_back预留的空闲缓冲区个数
+        size_type front_spare_ = 0;     // 头部空闲缓冲区的个数，分配、释放缓冲区或begin_跨过缓冲区时更新
+        size_type back_spare_ = 0;      // 尾部空闲缓冲区的个数
+
     public:
 
         /// constructor 构造，拷贝，移动，析构
@@ -290,7 +333,10 @@ namespace stl {
 
         deque(deque &&rhs) noexcept
                 : begin_(stl::move(rhs.begin_)), end_(stl::move(rhs.end_)),
-                  map_size_(rhs.map_size_), map_(rhs.map_) {
+                  map_size_(rhs.map_size_), map_(rhs.map_),
+                  spare_high_(rhs.spare_high_), spare_low_(rhs.spare_low_),
+                  front_reserved_(rhs.front_reserved_), back_reserved_(rhs.back_reserved_),
+                  front_spare_(rhs.front_spare_), back_spare_(rhs.back_spare_) {
             rhs.map_ = nullptr;
             rhs.map_size_ = 0;
         }
@@ -361,27 +407,66 @@ namespace stl {
 
         void resize(size_type new_size, const value_type &value);
 
-        void shrink_to_fit() noexcept;
+        // 释放所有空闲缓冲区，并将map收缩到只比使用中的缓冲区略大
+        void shrink_to_fit() noexcept { trim(0); }
+
+        // 每一侧最多保留keep_spare_nodes个空闲缓冲区，其余的释放，并收缩map
+        // 同时取消reserve_front/reserve_back所做的预留
+        void trim(size_type keep_spare_nodes) noexcept;
+
+        // reserve_front / reserve_back
+        // 预留出在头部/尾部再插入n个元素所需的空间：扩充map，使这一侧的插入不会再移动map
+        // alloc_buffer为true时同时分配好缓冲区，之后在这一侧插入n个元素不会再申请内存，
+        // 这些缓冲区不受回收策略影响，直到调用trim/shrink_to_fit
+        void reserve_front(size_type n, bool alloc_buffer = true);
+
+        void reserve_back(size_type n, bool alloc_buffer = true);
+
+        // 设置空闲缓冲区的回收策略：单侧空闲缓冲区多于high个时，释放到只剩low个
+        void set_reclaim_policy(size_type low, size_type high) noexcept {
+            STL_DEBUG(low <= high);
+            spare_low_ = low;
+            spare_high_ = high;
+            reclaim_spare(true);
+            reclaim_spare(false);
+        }
+
+        // 头部/尾部空闲缓冲区的个数
+        size_type front_spare_nodes() const noexcept { return front_spare_; }
+
+        size_type back_spare_nodes() const noexcept { return back_spare_; }
 
         /// 访问元素相关操作
         reference operator[](size_type n) {
             STL_DEBUG(n < size());
-            return begin_[n];
+            return at_index(n);
         }
 
         const_reference operator[](size_type n) const {
             STL_DEBUG(n < size());
-            return begin_[n];
+            return at_index(n);
         }
 
         reference at(size_type n) {
             STL_DEBUG(n < size());
-            return begin_[n];
+            return at_index(n);
         }
 
         const_reference at(size_type n) const {
             STL_DEBUG(n < size());
-            return begin_[n];
+            return at_index(n);
+        }
+
+        // 直接由下标计算缓冲区和偏移，不构造迭代器，也没有跨缓冲区的分支
+        // 缓冲区大小为2的幂时只需要一次移位和一次掩码
+        reference at_index(size_type n) noexcept {
+            const size_type offset = n + static_cast<size_type>(begin_.cur - begin_.first);
+            return begin_.node[node_index(offset)][node_offset(offset)];
+        }
+
+        const_reference at_index(size_type n) const noexcept {
+            const size_type offset = n + static_cast<size_type>(begin_.cur - begin_.first);
+            return begin_.node[node_index(offset)][node_offset(offset)];
         }
 
         reference front() {
@@ -442,6 +527,26 @@ namespace stl {
 
         void pop_back();
 
+        // append / prepend
+        // 批量在尾部/头部插入[first, last)，一次性预留所需的缓冲区，再按缓冲区整段拷贝
+        template<class IIter, typename std::enable_if<
+                stl::is_input_iterator<IIter>::value, int>::type = 0>
+        void append(IIter first, IIter last) {
+            append_dispatch(first, last, iterator_category(first));
+        }
+
+        template<class IIter, typename std::enable_if<
+                stl::is_input_iterator<IIter>::value, int>::type = 0>
+        void prepend(IIter first, IIter last) {
+            prepend_dispatch(first, last, iterator_category(first));
+        }
+
+        // pop_front_n / pop_back_n
+        // 批量删除头部/尾部的n个元素，按缓冲区整段析构，并一次性释放空出的缓冲区
+        void pop_front_n(size_type n);
+
+        void pop_back_n(size_type n);
+
         // insert
 
         iterator insert(iterator pos, const value_type &value);
@@ -472,6 +577,26 @@ namespace stl {
 
         /// help function
 
+        // 相对于begin_.first的偏移offset所在的缓冲区序号，以及在缓冲区内的偏移
+        static size_type node_index(size_type offset) noexcept {
+            return deque_buf_size<T>::is_pow2 ? offset >> deque_buf_size<T>::shift : offset / buffer_size;
+        }
+
+        static size_type node_offset(size_type offset) noexcept {
+            return deque_buf_size<T>::is_pow2 ? offset & deque_buf_size<T>::mask : offset % buffer_size;
+        }
+
+        // 移动begin_/end_，跨过的缓冲区在使用中的缓冲区与空闲缓冲区之间转移
+        void set_begin(const iterator &new_begin) noexcept {
+            front_spare_ += static_cast<size_type>(new_begin.node - begin_.node);
+            begin_ = new_begin;
+        }
+
+        void set_end(const iterator &new_end) noexcept {
+            back_spare_ += static_cast<size_type>(end_.node - new_end.node);
+            end_ = new_end;
+        }
+
         /// creator node / destroy node
         map_pointer create_map(size_type size);
 
@@ -479,6 +604,13 @@ namespace stl {
 
         void destroy_buffer(map_pointer start, map_pointer finish);
 
+        // 空闲缓冲区的回收
+        void release_spare(bool front, size_type keep) noexcept;
+
+        void reclaim_spare(bool front) noexcept;
+
+        void compact_map(size_type keep) noexcept;
+
         // initialize
         void map_init(size_type n_elem);
 
@@ -514,13 +646,29 @@ namespace stl {
         template<class FIter>
         void insert_dispatch(iterator, FIter, FIter, forward_iterator_tag);
 
+        // append / prepend
+        template<class IIter>
+        void append_dispatch(IIter first, IIter last, input_iterator_tag);
+
+        template<class FIter>
+        void append_dispatch(FIter first, FIter last, forward_iterator_tag);
+
+        template<class IIter>
+        void prepend_dispatch(IIter first, IIter last, input_iterator_tag);
+
+        template<class FIter>
+        void prepend_dispatch(FIter first, FIter last, forward_iterator_tag);
+
+        template<class FIter>
+        FIter copy_to_buffers(iterator pos, FIter first, size_type n);
+
         // reallocate
 
         void require_capacity(size_type n, bool front);
 
-        void reallocate_map_at_front(size_type need);
+        void reallocate_map_at_front(size_type need, bool alloc_buffer = true);
 
-        void reallocate_map_at_back(size_type need);
+        void reallocate_map_at_back(size_type need, bool alloc_buffer = true);
     };
 
 
@@ -547,6 +695,12 @@ namespace stl {
         end_ = stl::move(rhs.end_);
         map_ = rhs.map_;
         map_size_ = rhs.map_size_;
+        spare_high_ = rhs.spare_high_;
+        spare_low_ = rhs.spare_low_;
+        front_reserved_ = rhs.front_reserved_;
+        back_reserved_ = rhs.back_reserved_;
+        front_spare_ = rhs.front_spare_;
+        back_spare_ = rhs.back_spare_;
 
         rhs.map_ = nullptr;
         rhs.map_size_ = 0;
@@ -566,15 +720,42 @@ namespace stl {
 
     // 减小容器容量
     template<class T>
-    void deque<T>::shrink_to_fit() noexcept {
-        // 完全为空的缓冲区(竖条)会被释放
-        for (auto cur = map_; cur < begin_.node; ++cur) {
-            data_allocator::deallocate(*cur, buffer_size);
-            *cur = nullptr;
+    void deque<T>::trim(size_type keep_spare_nodes) noexcept {
+        front_reserved_ = 0;
+        back_reserved_ = 0;
+        release_spare(true, keep_spare_nodes);
+        release_spare(false, keep_spare_nodes);
+        compact_map(keep_spare_nodes);
+    }
+
+    template<class T>
+    void deque<T>::reserve_front(size_type n, bool alloc_buffer) {
+        const size_type avail = begin_.cur - begin_.first;
+        if (n <= avail) return;
+        const size_type need = (n - avail + buffer_size - 1) / buffer_size;
+        if (alloc_buffer) {
+            require_capacity(n, true);
+            front_reserved_ = stl::max(front_reserved_, need);
+        } else {
+            // 只扩充map，缓冲区等到真正插入时再分配
+            const size_type spare = front_spare_;
+            if (need > spare && need - spare > static_cast<size_type>(begin_.node - spare - map_))
+                reallocate_map_at_front(need - spare, false);
         }
-        for (auto cur = end_.node + 1; cur < map_ + map_size_; ++cur) {
-            data_allocator::deallocate(*cur, buffer_size);
-            *cur = nullptr;
+    }
+
+    template<class T>
+    void deque<T>::reserve_back(size_type n, bool alloc_buffer) {
+        const size_type avail = end_.last - end_.cur - 1;
+        if (n <= avail) return;
+        const size_type need = (n - avail + buffer_size - 1) / buffer_size;
+        if (alloc_buffer) {
+            require_capacity(n, false);
+            back_reserved_ = stl::max(back_reserved_, need);
+        } else {
+            const size_type spare = back_spare_;
+            if (need > spare && need - spare > static_cast<size_type>((map_ + map_size_) - (end_.node + spare) - 1))
+                reallocate_map_at_back(need - spare, false);
         }
     }
 
@@ -588,9 +769,11 @@ namespace stl {
             require_capacity(1, true);
             try {
                 --begin_;
+                --front_spare_;
                 data_allocator::construct(begin_.cur, stl::forward<Args>(args)...);
             } catch (...) {
                 ++begin_;
+                ++front_spare_;
                 throw;
             }
         }
@@ -607,6 +790,7 @@ namespace stl {
             require_capacity(1, false);
             data_allocator::construct(end_.cur, stl::forward<Args>(args)...);
             ++end_;
+            --back_spare_;
         }
     }
 
@@ -634,10 +818,12 @@ namespace stl {
             require_capacity(1, true);
             try {
                 --begin_;
+                --front_spare_;
                 /// 此处如果构造失败，需要回滚begin_，因此需要先catch，回滚，然后再抛出
                 data_allocator::construct(begin_.cur, value);
             } catch (...) {
                 ++begin_;
+                ++front_spare_;
                 throw;
             }
         }
@@ -654,6 +840,7 @@ namespace stl {
             /// 此处不可以为++end_.cur，因为要往下一个缓冲区走，迭代器可以完成这一操作，
             /// 仅仅是指针自增不可以
             ++end_;
+            --back_spare_;
         }
     }
 
@@ -666,8 +853,10 @@ namespace stl {
         } else {
             data_allocator::destroy(begin_.cur);
             // 要跨过缓冲区 所以需要用迭代器
+            // 空出的缓冲区先作为空闲缓冲区保留，按回收策略释放
             ++begin_;
-            destroy_buffer(begin_.node - 1, begin_.node - 1);
+            ++front_spare_;
+            reclaim_spare(true);
         }
     }
 
@@ -678,15 +867,46 @@ namespace stl {
             data_allocator::destroy(end_.cur - 1);
             end_.cur--;
         } else {
-            try {
-                --end_;
-                data_allocator::destroy(end_.cur);
-                destroy_buffer(end_.node + 1, end_.node + 1);
-            } catch (...) {
-                ++end_;
-                throw;
-            }
+            --end_;
+            ++back_spare_;
+            data_allocator::destroy(end_.cur);
+            reclaim_spare(false);
+        }
+    }
+
+    template<class T>
+    void deque<T>::pop_front_n(size_type n) {
+        STL_DEBUG(n <= size());
+        if (n == 0) return;
+        auto new_begin = begin_ + n;
+        if (begin_.node == new_begin.node) {
+            data_allocator::destroy(begin_.cur, new_begin.cur);
+        } else {
+            // 头尾两个缓冲区只析构部分元素，中间的缓冲区整段析构
+            data_allocator::destroy(begin_.cur, begin_.last);
+            for (auto cur = begin_.node + 1; cur < new_begin.node; ++cur)
+                data_allocator::destroy(*cur, *cur + buffer_size);
+            data_allocator::destroy(new_begin.first, new_begin.cur);
+        }
+        set_begin(new_begin);
+        reclaim_spare(true);
+    }
+
+    template<class T>
+    void deque<T>::pop_back_n(size_type n) {
+        STL_DEBUG(n <= size());
+        if (n == 0) return;
+        auto new_end = end_ - n;
+        if (new_end.node == end_.node) {
+            data_allocator::destroy(new_end.cur, end_.cur);
+        } else {
+            data_allocator::destroy(new_end.cur, new_end.last);
+            for (auto cur = new_end.node + 1; cur < end_.node; ++cur)
+                data_allocator::destroy(*cur, *cur + buffer_size);
+            data_allocator::destroy(end_.first, end_.cur);
         }
+        set_end(new_end);
+        reclaim_spare(false);
     }
 
     template<class T>
@@ -726,11 +946,11 @@ namespace stl {
             require_capacity(n, true);
             auto new_begin = begin_ - n;
             stl::uninitialized_fill_n(new_begin, n, value);
-            begin_ = new_begin;
+            set_begin(new_begin);
         } else if (pos.cur == end_.cur) {
             require_capacity(n, false);
             stl::uninitialized_fill_n(end_, n, value);
-            end_ += n;
+            set_end(end_ + n);
         } else {
             fill_insert(pos, n, value);
         }
@@ -764,15 +984,16 @@ namespace stl {
                 auto new_begin = begin_ + len;
                 // TODO:源项目传参是begin_.cur 是错误的
                 data_allocator::destroy(begin_, new_begin);
-                begin_ = new_begin;
+                set_begin(new_begin);
             } else {
                 stl::copy(last, end_, first);
                 auto new_end = end_ - len;
                 data_allocator::destroy(new_end, end_);
-                end_ = new_end;
+                set_end(new_end);
             }
-            // 删除元素后 收缩节点数量
-            shrink_to_fit();
+            // 删除元素后 按回收策略释放空闲缓冲区
+            reclaim_spare(true);
+            reclaim_spare(false);
             return begin_ + elems_before;
         }
 
@@ -782,7 +1003,7 @@ namespace stl {
     template<class T>
     void deque<T>::clear() {
         /// 摧毁所有缓冲区的对象 将end_移动到begin_
-        for (auto cur = begin_.node + 1; cur != end_.node; ++cur) {
+        for (auto cur = begin_.node + 1; cur < end_.node; ++cur) {
             // 释放中间缓冲区的对象
             data_allocator::destroy(*cur, *cur + buffer_size);
         }
@@ -795,8 +1016,8 @@ namespace stl {
         } else {
             data_allocator::destroy(begin_.cur, end_.cur);
         }
-        shrink_to_fit();
-        end_ = begin_;
+        set_end(begin_);
+        reclaim_spare(false);
     }
 
     template<class T>
@@ -806,6 +1027,12 @@ namespace stl {
             stl::swap(end_, rhs.end_);
             stl::swap(map_, rhs.map_);
             stl::swap(map_size_, rhs.map_size_);
+            stl::swap(spare_high_, rhs.spare_high_);
+            stl::swap(spare_low_, rhs.spare_low_);
+            stl::swap(front_reserved_, rhs.front_reserved_);
+            stl::swap(back_reserved_, rhs.back_reserved_);
+            stl::swap(front_spare_, rhs.front_spare_);
+            stl::swap(back_spare_, rhs.back_spare_);
         }
     }
 
@@ -852,6 +1079,64 @@ namespace stl {
         }
     }
 
+    template<class T>
+    void deque<T>::release_spare(bool front, size_type keep) noexcept {
+        /// 某一侧只保留离使用中的缓冲区最近的keep个空闲缓冲区，更远的全部释放
+        if (front) {
+            if (front_spare_ > keep) {
+                destroy_buffer(begin_.node - front_spare_, begin_.node - keep - 1);
+                front_spare_ = keep;
+            }
+        } else {
+            if (back_spare_ > keep) {
+                destroy_buffer(end_.node + keep + 1, end_.node + back_spare_);
+                back_spare_ = keep;
+            }
+        }
+    }
+
+    template<class T>
+    void deque<T>::reclaim_spare(bool front) noexcept {
+        /// 滞后回收：空闲缓冲区超过上限spare_high_时，才一次性释放到spare_low_个
+        /// 避免队列长度在缓冲区边界附近来回波动时反复申请/释放缓冲区
+        /// 通过reserve_front/reserve_back预留的缓冲区不会被回收
+        const size_type spare = front ? front_spare_ : back_spare_;
+        const size_type reserved = front ? front_reserved_ : back_reserved_;
+        if (spare > stl::max(spare_high_, reserved))
+            release_spare(front, stl::max(spare_low_, reserved));
+    }
+
+    template<class T>
+    void deque<T>::compact_map(size_type keep) noexcept {
+        /// 将map收缩到只比已分配的缓冲区略大，两侧各留出keep个空的数据块
+        /// map的大小只会随push增大，如果不收缩，一次峰值之后map会一直保持峰值时的大小
+        const size_type front_spare = front_spare_;
+        const size_type used = front_spare + (end_.node - begin_.node + 1) + back_spare_;
+        const size_type new_map_size = stl::max(static_cast<size_type>(DEQUE_MAP_INIT_SIZE),
+                                                used + 2 * keep + 2);
+        if (new_map_size >= map_size_) return;
+
+        map_pointer new_map = nullptr;
+        try {
+            new_map = create_map(new_map_size);
+        } catch (...) {
+            // 申请失败时保持原样即可
+            return;
+        }
+        auto new_start = new_map + (new_map_size - used) / 2;
+        auto old_start = begin_.node - front_spare;
+        for (size_type i = 0; i < used; ++i)
+            new_start[i] = old_start[i];
+
+        auto new_begin_node = new_start + front_spare;
+        auto new_end_node = new_begin_node + (end_.node - begin_.node);
+        begin_ = iterator(begin_.cur, new_begin_node);
+        end_ = iterator(end_.cur, new_end_node);
+        map_allocator::deallocate(map_, map_size_);
+        map_ = new_map;
+        map_size_ = new_map_size;
+    }
+
     template<class T>
     void deque<T>::map_init(size_type n_elem) {
         /// 初始化map数据块，为中心的数据块分配缓冲区空间，两边分别预留出一些空的map数据块（没有分配缓冲区）
@@ -1025,7 +1310,7 @@ namespace stl {
                     // 前n个需要使用uninitialized_copy，后elems_before-n个用copy
                     auto begin_n = begin_ + n;
                     stl::uninitialized_copy(begin_, begin_n, new_begin);
-                    begin_ = new_begin;
+                    set_begin(new_begin);
                     stl::copy(begin_n, position, old_begin);
                     stl::fill(position - n, position, value_copy);
                 } else {
@@ -1034,12 +1319,11 @@ namespace stl {
                     // elems_before个数据使用fill来填充值
                     stl::uninitialized_fill(stl::uninitialized_copy(begin_, position, new_begin),
                                             begin_, value_copy);
-                    begin_ = new_begin;
+                    set_begin(new_begin);
                     stl::fill(old_begin, position, value_copy);
                 }
             } catch (...) {
-                if (new_begin.node != begin_.node)
-                    destroy_buffer(new_begin.node, begin_.node - 1);
+                reclaim_spare(true);
                 throw;
             }
         } else {
@@ -1053,18 +1337,17 @@ namespace stl {
                 if (elems_after >= n) {
                     auto end_n = end_ - n;
                     stl::uninitialized_copy(end_n, end_, end_);
-                    end_ = new_end;
+                    set_end(new_end);
                     stl::copy_backward(position, end_n, old_end);
                     stl::fill(position, position + n, value_copy);
                 } else {
                     stl::uninitialized_fill(end_, position + n, value_copy);
                     stl::uninitialized_copy(position, end_, position + n);
-                    end_ = new_end;
+                    set_end(new_end);
                     stl::fill(position, old_end, value_copy);
                 }
             } catch (...) {
-                if (new_end.node != end_.node)
-                    destroy_buffer(end_.node + 1, new_end.nod);
+                reclaim_spare(false);
                 throw;
             }
         }
@@ -1105,12 +1388,11 @@ namespace stl {
             auto new_begin = begin_ - n;
             try {
                 stl::uninitialized_copy(first, last, new_begin);
-                begin_ = new_begin;
+                set_begin(new_begin);
             }
             catch (...) {
                 // 如果copy出现异常，他会把copy一半的元素释放掉 这里只需要释放空白的缓冲区即可
-                if (new_begin.node != begin_.node)
-                    destroy_buffer(new_begin.node, begin_.node - 1);
+                reclaim_spare(true);
                 throw;
             }
         } else if (pos.cur == end_.cur) {
@@ -1119,10 +1401,9 @@ namespace stl {
             auto new_end = end_ + n;
             try {
                 stl::uninitialized_copy(first, last, end_);
-                end_ = new_end;
+                set_end(new_end);
             } catch (...) {
-                if (new_end.node != end_.node)
-                    destroy_buffer(end_.node + 1, new_end.node);
+                reclaim_spare(false);
                 throw;
             }
         } else {
@@ -1130,42 +1411,134 @@ namespace stl {
         }
     }
 
+    template<class T>
+    template<class IIter>
+    void deque<T>::append_dispatch(IIter first, IIter last, input_iterator_tag) {
+        // input迭代器无法预先得知长度，只能逐个插入
+        for (; first != last; ++first)
+            emplace_back(*first);
+    }
+
+    template<class T>
+    template<class FIter>
+    void deque<T>::append_dispatch(FIter first, FIter last, forward_iterator_tag) {
+        const size_type n = stl::distance(first, last);
+        if (n == 0) return;
+        require_capacity(n, false);
+        auto new_end = end_ + n;
+        try {
+            copy_to_buffers(end_, first, n);
+        } catch (...) {
+            reclaim_spare(false);
+            throw;
+        }
+        set_end(new_end);
+    }
+
+    template<class T>
+    template<class IIter>
+    void deque<T>::prepend_dispatch(IIter first, IIter last, input_iterator_tag) {
+        // 逐个emplace_front会使元素逆序，所以先收集到临时的deque中
+        deque tmp;
+        tmp.append(first, last);
+        prepend_dispatch(tmp.begin(), tmp.end(), forward_iterator_tag{});
+    }
+
+    template<class T>
+    template<class FIter>
+    void deque<T>::prepend_dispatch(FIter first, FIter last, forward_iterator_tag) {
+        const size_type n = stl::distance(first, last);
+        if (n == 0) return;
+        require_capacity(n, true);
+        auto new_begin = begin_ - n;
+        try {
+            copy_to_buffers(new_begin, first, n);
+        } catch (...) {
+            reclaim_spare(true);
+            throw;
+        }
+        set_begin(new_begin);
+    }
+
+    template<class T>
+    template<class FIter>
+    FIter deque<T>::copy_to_buffers(iterator pos, FIter first, size_type n) {
+        /// 从pos开始在未初始化的空间上构造[first, first + n)，缓冲区必须已经分配好
+        /// 每次对一整段连续的缓冲区调用uninitialized_copy，不必逐个元素判断是否跨越缓冲区
+        /// 如果构造失败，已经构造的元素会被析构，然后继续抛出异常
+
+        auto cur = pos;
+        try {
+            while (n > 0) {
+                const size_type len = stl::min(n, static_cast<size_type>(cur.last - cur.cur));
+                auto next = first;
+                stl::advance(next, len);
+                stl::uninitialized_copy(first, next, cur.cur);
+                first = next;
+                n -= len;
+                if (cur.cur + len == cur.last) {
+                    cur.set_node(cur.node + 1);
+                    cur.cur = cur.first;
+                } else {
+                    cur.cur += len;
+                }
+            }
+        } catch (...) {
+            stl::destroy(pos, cur);
+            throw;
+        }
+        return first;
+    }
+
     template<class T>
     void deque<T>::require_capacity(size_type n, bool front) {
 
         if (front && (static_cast<size_type>(begin_.cur - begin_.first) < n)) {
             // 在头部扩充 并且要扩充的数目大于begin_缓冲区中的余量
 
-            // 计算需要增加缓冲区的个数
-            const size_type need_buffer = (n - (begin_.cur - begin_.first)) / buffer_size + 1;
-            if (need_buffer > static_cast<size_type>(begin_.node - map_)) {
+            // 计算需要增加缓冲区的个数，优先复用头部的空闲缓冲区
+            size_type need_buffer = (n - (begin_.cur - begin_.first) + buffer_size - 1) / buffer_size;
+            const size_type spare = front_spare_;
+            if (need_buffer <= spare) return;
+            need_buffer -= spare;
+            const auto first_spare = begin_.node - spare;
+            if (need_buffer > static_cast<size_type>(first_spare - map_)) {
                 // 需要缓冲区的个数大于map_头部预留的数量
                 reallocate_map_at_front(need_buffer);
                 return;
             }
-            create_buffer(begin_.node - need_buffer, begin_.node - 1);
+            create_buffer(first_spare - need_buffer, first_spare - 1);
+            front_spare_ += need_buffer;
         } else if (!front && (static_cast<size_type>(end_.last - end_.cur - 1) < n)) {   // 减1不能忘
             // 在尾部扩充 并且要扩充的数目大于end_缓冲区中的余量
 
-            const size_type need_buffer = (n - (end_.last - end_.cur - 1)) / buffer_size + 1;
-            if (need_buffer > static_cast<size_type>((map_ + map_size_) - end_.node - 1)) {
+            size_type need_buffer = (n - (end_.last - end_.cur - 1) + buffer_size - 1) / buffer_size;
+            const size_type spare = back_spare_;
+            if (need_buffer <= spare) return;
+            need_buffer -= spare;
+            const auto last_spare = end_.node + spare;
+            if (need_buffer > static_cast<size_type>((map_ + map_size_) - last_spare - 1)) {
                 // 需要缓冲区的个数大于map_尾部预留的数量
                 reallocate_map_at_back(need_buffer);
                 return;
             }
-            create_buffer(end_.node + 1, end_.node + need_buffer);
+            create_buffer(last_spare + 1, last_spare + need_buffer);
+            back_spare_ += need_buffer;
         }
     }
 
     template<class T>
-    void deque<T>::reallocate_map_at_front(deque::size_type need) {
-        /// 重新分配map数据块，在头部预留出need个空的数据块
+    void deque<T>::reallocate_map_at_front(deque::size_type need, bool alloc_buffer) {
+        /// 重新分配map数据块，在头部预留出need个数据块，alloc_buffer为true时为它们分配缓冲区
+        /// 原有的缓冲区(包括两侧的空闲缓冲区)原样搬到新的map上
 
         // 至少扩大两倍的空间 避免多次移动
         const size_type new_map_size = stl::max(map_size_ << 1,
                                                 map_size_ + need + DEQUE_MAP_INIT_SIZE);
         map_pointer new_map = create_map(new_map_size);
-        const size_type old_buffer = end_.node - begin_.node + 1;
+        const size_type front_spare = front_spare_;
+        const auto old_start = begin_.node - front_spare;
+        const size_type old_buffer = (end_.node + back_spare_) - old_start + 1;
         const size_type new_buffer = old_buffer + need;     // 目前需要的总的数据块个数
 
         // 分配的空间要比要求的多一些，即余量。头部和尾部各留出一半的余量，这些数据块都是nullptr
@@ -1175,27 +1548,38 @@ namespace stl {
         auto end = mid + old_buffer;
 
         // 为need空间分配缓冲区
-        create_buffer(begin, mid - 1);
+        try {
+            if (alloc_buffer) create_buffer(begin, mid - 1);
+        } catch (...) {
+            map_allocator::deallocate(new_map, new_map_size);
+            throw;
+        }
+        if (alloc_buffer) front_spare_ += need;
         // 将之前原有的缓冲区移动到新的map数据块上
-        for (auto begin1 = mid, begin2 = begin_.node; begin1 != end; ++begin1, ++begin2)
+        for (auto begin1 = mid, begin2 = old_start; begin1 != end; ++begin1, ++begin2)
             *begin1 = *begin2;
 
+        auto begin_node = mid + front_spare;
+        auto end_node = begin_node + (end_.node - begin_.node);
         map_allocator::deallocate(map_, map_size_); // 释放老的map数据块
         map_ = new_map;
         map_size_ = new_map_size;
-        begin_ = iterator(*mid + (begin_.cur - begin_.first), mid);
-        end_ = iterator(*(end - 1) + (end_.cur - end_.first), end - 1);
+        begin_ = iterator(begin_.cur, begin_node);
+        end_ = iterator(end_.cur, end_node);
     }
 
     template<class T>
-    void deque<T>::reallocate_map_at_back(deque::size_type need) {
-        /// 重新分配map数据块，在尾部预留出need个空的数据块
+    void deque<T>::reallocate_map_at_back(deque::size_type need, bool alloc_buffer) {
+        /// 重新分配map数据块，在尾部预留出need个数据块，alloc_buffer为true时为它们分配缓冲区
+        /// 原有的缓冲区(包括两侧的空闲缓冲区)原样搬到新的map上
 
         // 至少扩大两倍的空间 避免多次移动
         const size_type new_map_size = stl::max(map_size_ << 1,
                                                 map_size_ + need + DEQUE_MAP_INIT_SIZE);
         map_pointer new_map = create_map(new_map_size);
-        const size_type old_buffer = end_.node - begin_.node + 1;
+        const size_type front_spare = front_spare_;
+        const auto old_start = begin_.node - front_spare;
+        const size_type old_buffer = (end_.node + back_spare_) - old_start + 1;
         const size_type new_buffer = old_buffer + need;     // 目前需要的总的数据块个数
 
         // 分配的空间要比要求的多一些，即余量。头部和尾部各留出一半的余量，这些数据块都是nullptr
@@ -1205,16 +1589,24 @@ namespace stl {
         auto end = mid + need;
 
         // 为need空间分配缓冲区
-        create_buffer(mid, end - 1);
+        try {
+            if (alloc_buffer) create_buffer(mid, end - 1);
+        } catch (...) {
+            map_allocator::deallocate(new_map, new_map_size);
+            throw;
+        }
+        if (alloc_buffer) back_spare_ += need;
         // 将之前原有的缓冲区移动到新的map数据块上
-        for (auto begin1 = begin, begin2 = begin_.node; begin1 != mid; ++begin1, ++begin2)
+        for (auto begin1 = begin, begin2 = old_start; begin1 != mid; ++begin1, ++begin2)
             *begin1 = *begin2;
 
+        auto begin_node = begin + front_spare;
+        auto end_node = begin_node + (end_.node - begin_.node);
         map_allocator::deallocate(map_, map_size_); // 释放老的map数据块
         map_ = new_map;
         map_size_ = new_map_size;
-        begin_ = iterator(*begin + (begin_.cur - begin_.first), begin);
-        end_ = iterator(*(mid - 1) + (end_.cur - end_.first), mid - 1);
+        begin_ = iterator(begin_.cur, begin_node);
+        end_ = iterator(end_.cur, end_node);
     }
 
     template<class T>
@@ -0,0 +1,637 @@
+#ifndef MYCPPSTL_EXECUTION_H
+#define MYCPPSTL_EXECUTION_H
+
+// 这个头文件包含执行策略，以及 algo.h 中部分算法接受执行策略的重载版本
+// execution::seq       : 顺序执行，与不带策略的版本相同
+// execution::par       : 多线程执行，par(threads) 指定线程数(包括调用线程)，缺省为 hardware_concurrency
+// execution::par_unseq : 多线程执行，并允许线程内部向量化
+//
+// 支持执行策略的算法：for_each, transform, count_if, find_if, all_of, any_of, none_of, replace_if, generate,
+//                    min_element, max_element, shuffle
+
+// notes:
+//
+// 只对随机访问迭代器并行，其他迭代器退化为顺序版本。线程取自全局的线程池，
+// 线程数的确定与 parallel_algo.h 相同(见 parallel_thread_count)，区间较小时同样退化为顺序版本
+//
+// 区间被切成线程数 EXECUTION_CHUNKS_PER_THREAD 倍的块，线程按顺序领取，先做完的线程会多领几块。
+// stl::deque 的块边界与缓冲区边界对齐，块内逐个缓冲区用指针处理，不必每移动一步都检查是否越过缓冲区，
+// 指针版本的算法还可以向量化；其他随机访问迭代器直接按下标切分
+//
+// find_if / any_of / all_of / none_of 找到结果后通知其他线程提前结束，每处理 EXECUTION_CHECK_SIZE 个元素检查一次：
+// any_of 一类只要有一个线程找到就全部停止；find_if 要返回第一个匹配，记录目前找到的最小位置，
+// 位于它之后的块不再处理，之前的块仍然要查完
+//
+// min_element / max_element 各段分别求出结果后再合并，相等时取位置靠前的，与顺序版本一样返回第一个最小(最大)的元素
+//
+// par 与 par_unseq 的实现相同，块内调用的顺序版本对指针已经有向量化的特化(见 simd.h)
+//
+// shuffle 需要一个与区间等长的临时缓冲区以及每个元素一字节的桶号，缓冲区申请不到时退化为顺序版本
+//
+// 函数对象会被多个线程同时调用，需要是线程安全的；generate 的 gen 也是同一个对象被并发调用。
+// 函数对象抛出异常时，所有线程结束后在调用线程中重新抛出第一个异常(标准库的做法是调用 std::terminate)
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <mutex>
+#include <type_traits>
+
+#include "algo.h"
+#include "deque.h"
+#include "functional.h"
+#include "iterator.h"
+#include "parallel_algo.h"
+#include "random.h"
+#include "type_traits.h"
+
+namespace stl {
+
+// 每个线程平均分到的块数，块越多负载越均衡，查找类的算法也能更早结束
+#ifndef EXECUTION_CHUNKS_PER_THREAD
+#define EXECUTION_CHUNKS_PER_THREAD 4
+#endif
+
+// 查找类的算法每处理这么多个元素检查一次其他线程是否已经找到
+#ifndef EXECUTION_CHECK_SIZE
+#define EXECUTION_CHECK_SIZE 4096
+#endif
+
+    namespace execution {
+
+        // 顺序执行
+        class sequenced_policy {
+        };
+
+        // 多线程执行，threads 为使用的线程数(包括调用线程)，为 0 时使用 std::thread::hardware_concurrency()
+        class parallel_policy {
+        public:
+            size_t threads;
+
+            constexpr explicit parallel_policy(size_t t = 0) noexcept: threads(t) {}
+
+            constexpr parallel_policy operator()(size_t t) const noexcept { return parallel_policy(t); }
+        };
+
+        // 多线程执行，并允许线程内部向量化
+        class parallel_unsequenced_policy {
+        public:
+            size_t threads;
+
+            constexpr explicit parallel_unsequenced_policy(size_t t = 0) noexcept: threads(t) {}
+
+            constexpr parallel_unsequenced_policy operator()(size_t t) const noexcept {
+                return parallel_unsequenced_policy(t);
+            }
+        };
+
+        constexpr sequenced_policy seq{};
+        constexpr parallel_policy par{};
+        constexpr parallel_unsequenced_policy par_unseq{};
+
+    }   // namespace execution
+
+    template<class T>
+    struct is_execution_policy : public m_false_type {
+    };
+
+    template<>
+    struct is_execution_policy<execution::sequenced_policy> : public m_true_type {
+    };
+
+    template<>
+    struct is_execution_policy<execution::parallel_policy> : public m_true_type {
+    };
+
+    template<>
+    struct is_execution_policy<execution::parallel_unsequenced_policy> : public m_true_type {
+    };
+
+    // 只有第一个参数是执行策略时才参与重载，返回类型为 T
+    template<class ExecutionPolicy, class T = void>
+    using execution_enable_if =
+            typename std::enable_if<is_execution_policy<typename std::decay<ExecutionPolicy>::type>::value, T>::type;
+
+    // 执行策略要求的线程数，0 表示 hardware_concurrency
+    inline size_t execution_threads(const execution::sequenced_policy &) noexcept { return 1; }
+
+    inline size_t execution_threads(const execution::parallel_policy &policy) noexcept { return policy.threads; }
+
+    inline size_t execution_threads(const execution::parallel_unsequenced_policy &policy) noexcept {
+        return policy.threads;
+    }
+
+    // 全部迭代器都是随机访问迭代器时才能并行
+    template<class... Iters>
+    struct execution_random_access : public m_true_type {
+    };
+
+    template<class Iter, class... Rest>
+    struct execution_random_access<Iter, Rest...>
+            : public m_bool_constant<is_random_access_iterator<Iter>::value &&
+                                     execution_random_access<Rest...>::value> {
+    };
+
+/*****************************************************************************************/
+// execution_chunks
+// 把从 first 开始的 n 个元素切成若干块，for_each_piece(c, f) 对第 c 块中的每一段连续的元素依次调用 f(lo, hi, offset)，
+// offset 为 lo 在区间中的下标，f 返回 false 时不再处理这一块剩下的段
+/*****************************************************************************************/
+    template<class RandomIter>
+    class execution_chunks {
+    private:
+        typedef typename iterator_traits<RandomIter>::difference_type difference_type;
+
+        RandomIter first_;
+        size_t n_;
+        size_t count_;
+
+    public:
+        execution_chunks(RandomIter first, size_t n, size_t wanted)
+                : first_(first), n_(n), count_(wanted == 0 ? 1 : wanted) {}
+
+        size_t count() const noexcept { return count_; }
+
+        template<class Func>
+        void for_each_piece(size_t c, Func &f) const {
+            const size_t lo = n_ / count_ * c + n_ % count_ * c / count_;
+            const size_t hi = n_ / count_ * (c + 1) + n_ % count_ * (c + 1) / count_;
+            if (lo < hi) {
+                f(first_ + static_cast<difference_type>(lo), first_ + static_cast<difference_type>(hi), lo);
+            }
+        }
+    };
+
+    // stl::deque：块由整数个缓冲区组成，每个缓冲区是一段
+    // 位置从 first 所在缓冲区的开头算起，区间占据其中的[head_, head_ + n_)
+    template<class T, class Ref, class Ptr>
+    class execution_chunks<deque_iterator<T, Ref, Ptr>> {
+    private:
+        typedef deque_iterator<T, Ref, Ptr> iterator;
+        typedef typename iterator::map_pointer map_pointer;
+
+        static constexpr size_t buffer_size = iterator::buffer_size;
+
+        map_pointer node_;          // first 所在的缓冲区
+        size_t head_;               // first 在所在缓冲区中的下标
+        size_t n_;
+        size_t chunk_buffers_;      // 每块的缓冲区数
+        size_t count_;
+
+    public:
+        execution_chunks(iterator first, size_t n, size_t wanted)
+                : node_(first.node), head_(static_cast<size_t>(first.cur - first.first)), n_(n) {
+            const size_t buffers = (head_ + n_ + buffer_size - 1) / buffer_size;
+            if (wanted == 0) wanted = 1;
+            chunk_buffers_ = buffers <= wanted ? 1 : (buffers + wanted - 1) / wanted;
+            count_ = (buffers + chunk_buffers_ - 1) / chunk_buffers_;
+        }
+
+        size_t count() const noexcept { return count_; }
+
+        template<class Func>
+        void for_each_piece(size_t c, Func &f) const {
+            size_t pos = c * chunk_buffers_ * buffer_size;
+            size_t end = pos + chunk_buffers_ * buffer_size;
+            if (pos < head_) pos = head_;
+            if (end > head_ + n_) end = head_ + n_;
+            while (pos < end) {
+                const size_t b = pos / buffer_size;
+                const size_t stop = (b + 1) * buffer_size < end ? (b + 1) * buffer_size : end;
+                const Ptr buffer = node_[b];
+                if (!f(buffer + (pos - b * buffer_size), buffer + (stop - b * buffer_size), pos - head_)) return;
+                pos = stop;
+            }
+        }
+    };
+
+    // 用至多 threads 个线程处理[first, last)：切块后交给 parallel_run，f(lo, hi, offset) 处理其中连续的一段
+    // 元素较少或只用一个线程时，在调用线程中用原来的迭代器处理整个区间
+    template<class RandomIter, class Func>
+    void execution_run(RandomIter first, RandomIter last, size_t threads, Func f) {
+        const size_t n = static_cast<size_t>(last - first);
+        threads = stl::parallel_thread_count(n, threads);
+        if (threads == 1) {
+            f(first, last, size_t(0));
+            return;
+        }
+        const execution_chunks<RandomIter> chunks(first, n, threads * EXECUTION_CHUNKS_PER_THREAD);
+        stl::parallel_run(chunks.count(), threads, [&](size_t c) { chunks.for_each_piece(c, f); });
+    }
+
+/*****************************************************************************************/
+// for_each
+// 没有返回值
+/*****************************************************************************************/
+    template<class InputIter, class Function>
+    void execution_for_each(size_t, InputIter first, InputIter last, Function &f, m_false_type) {
+        stl::for_each(first, last, f);
+    }
+
+    template<class RandomIter, class Function>
+    void execution_for_each(size_t threads, RandomIter first, RandomIter last, Function &f, m_true_type) {
+        stl::execution_run(first, last, threads, [&](auto lo, auto hi, size_t) {
+            for (; lo != hi; ++lo) f(*lo);
+            return true;
+        });
+    }
+
+    template<class ExecutionPolicy, class ForwardIter, class Function>
+    execution_enable_if<ExecutionPolicy>
+    for_each(ExecutionPolicy &&policy, ForwardIter first, ForwardIter last, Function f) {
+        stl::execution_for_each(stl::execution_threads(policy), first, last, f,
+                                execution_random_access<ForwardIter>());
+    }
+
+/*****************************************************************************************/
+// transform
+// 返回一个迭代器指向结果的末尾，输出区间不能与输入区间部分重叠(可以完全相同)
+/*****************************************************************************************/
+    template<class InputIter, class OutputIter, class UnaryOperation>
+    OutputIter execution_transform(size_t, InputIter first, InputIter last, OutputIter result,
+                                   UnaryOperation &unary_op, m_false_type) {
+        return stl::transform(first, last, result, unary_op);
+    }
+
+    template<class RandomIter1, class RandomIter2, class UnaryOperation>
+    RandomIter2 execution_transform(size_t threads, RandomIter1 first, RandomIter1 last, RandomIter2 result,
+                                    UnaryOperation &unary_op, m_true_type) {
+        typedef typename iterator_traits<RandomIter2>::difference_type difference_type;
+        stl::execution_run(first, last, threads, [&](auto lo, auto hi, size_t offset) {
+            stl::transform(lo, hi, result + static_cast<difference_type>(offset), unary_op);
+            return true;
+        });
+        return result + static_cast<difference_type>(last - first);
+    }
+
+    template<class ExecutionPolicy, class ForwardIter1, class ForwardIter2, class UnaryOperation>
+    execution_enable_if<ExecutionPolicy, ForwardIter2>
+    transform(ExecutionPolicy &&policy, ForwardIter1 first, ForwardIter1 last, ForwardIter2 result,
+              UnaryOperation unary_op) {
+        return stl::execution_transform(stl::execution_threads(policy), first, last, result, unary_op,
+                                        execution_random_access<ForwardIter1, ForwardIter2>());
+    }
+
+    // 二元操作的版本
+    template<class InputIter1, class InputIter2, class OutputIter, class BinaryOperation>
+    OutputIter execution_transform(size_t, InputIter1 first1, InputIter1 last1, InputIter2 first2,
+                                   OutputIter result, BinaryOperation &binary_op, m_false_type) {
+        return stl::transform(first1, last1, first2, result, binary_op);
+    }
+
+    template<class RandomIter1, class RandomIter2, class RandomIter3, class BinaryOperation>
+    RandomIter3 execution_transform(size_t threads, RandomIter1 first1, RandomIter1 last1, RandomIter2 first2,
+                                    RandomIter3 result, BinaryOperation &binary_op, m_true_type) {
+        typedef typename iterator_traits<RandomIter2>::difference_type difference_type2;
+        typedef typename iterator_traits<RandomIter3>::difference_type difference_type3;
+        stl::execution_run(first1, last1, threads, [&](auto lo, auto hi, size_t offset) {
+            stl::transform(lo, hi, first2 + static_cast<difference_type2>(offset),
+                           result + static_cast<difference_type3>(offset), binary_op);
+            return true;
+        });
+        return result + static_cast<difference_type3>(last1 - first1);
+    }
+
+    template<class ExecutionPolicy, class ForwardIter1, class ForwardIter2, class ForwardIter3,
+            class BinaryOperation>
+    execution_enable_if<ExecutionPolicy, ForwardIter3>
+    transform(ExecutionPolicy &&policy, ForwardIter1 first1, ForwardIter1 last1, ForwardIter2 first2,
+              ForwardIter3 result, BinaryOperation binary_op) {
+        return stl::execution_transform(stl::execution_threads(policy), first1, last1, first2, result, binary_op,
+                                        execution_random_access<ForwardIter1, ForwardIter2, ForwardIter3>());
+    }
+
+/*****************************************************************************************/
+// count_if
+// 各段分别计数后累加
+/*****************************************************************************************/
+    template<class InputIter, class UnaryPredicate>
+    size_t execution_count_if(size_t, InputIter first, InputIter last, UnaryPredicate &unary_pred, m_false_type) {
+        return stl::count_if(first, last, unary_pred);
+    }
+
+    template<class RandomIter, class UnaryPredicate>
+    size_t execution_count_if(size_t threads, RandomIter first, RandomIter last, UnaryPredicate &unary_pred,
+                              m_true_type) {
+        std::atomic<size_t> total(0);
+        stl::execution_run(first, last, threads, [&](auto lo, auto hi, size_t) {
+            total.fetch_add(stl::count_if(lo, hi, unary_pred), std::memory_order_relaxed);
+            return true;
+        });
+        return total.load(std::memory_order_relaxed);
+    }
+
+    template<class ExecutionPolicy, class ForwardIter, class UnaryPredicate>
+    execution_enable_if<ExecutionPolicy, size_t>
+    count_if(ExecutionPolicy &&policy, ForwardIter first, ForwardIter last, UnaryPredicate unary_pred) {
+        return stl::execution_count_if(stl::execution_threads(policy), first, last, unary_pred,
+                                       execution_random_access<ForwardIter>());
+    }
+
+/*****************************************************************************************/
+// find_if
+// 返回第一个令 unary_pred 为 true 的元素，没有则返回 last
+/*****************************************************************************************/
+    template<class InputIter, class UnaryPredicate>
+    InputIter execution_find_if(size_t, InputIter first, InputIter last, UnaryPredicate &unary_pred, m_false_type) {
+        return stl::find_if(first, last, unary_pred);
+    }
+
+    template<class RandomIter, class UnaryPredicate>
+    RandomIter execution_find_if(size_t threads, RandomIter first, RandomIter last, UnaryPredicate &unary_pred,
+                                 m_true_type) {
+        typedef typename iterator_traits<RandomIter>::difference_type difference_type;
+        const size_t n = static_cast<size_t>(last - first);
+        std::atomic<size_t> found(n);   // 目前找到的最小位置
+        stl::execution_run(first, last, threads, [&](auto lo, auto hi, size_t offset) {
+            while (lo != hi) {
+                // 前面已经有匹配，这一段不必再查
+                if (found.load(std::memory_order_relaxed) < offset) return false;
+                const size_t step = static_cast<size_t>(hi - lo) < EXECUTION_CHECK_SIZE
+                                    ? static_cast<size_t>(hi - lo) : EXECUTION_CHECK_SIZE;
+                const auto end = lo + static_cast<decltype(hi - lo)>(step);
+                const auto pos = stl::find_if(lo, end, unary_pred);
+                if (pos != end) {
+                    const size_t k = offset + static_cast<size_t>(pos - lo);
+                    size_t cur = found.load(std::memory_order_relaxed);
+                    while (k < cur && !found.compare_exchange_weak(cur, k, std::memory_order_relaxed)) {}
+                    return false;
+                }
+                lo = end;
+                offset += step;
+            }
+            return true;
+        });
+        return first + static_cast<difference_type>(found.load(std::memory_order_relaxed));
+    }
+
+    template<class ExecutionPolicy, class ForwardIter, class UnaryPredicate>
+    execution_enable_if<ExecutionPolicy, ForwardIter>
+    find_if(ExecutionPolicy &&policy, ForwardIter first, ForwardIter last, UnaryPredicate unary_pred) {
+        return stl::execution_find_if(stl::execution_threads(policy), first, last, unary_pred,
+                                      execution_random_access<ForwardIter>());
+    }
+
+/*****************************************************************************************/
+// any_of / all_of / none_of
+// 都转化为 any_of，一个线程找到后其余线程都停止
+/*****************************************************************************************/
+    template<class InputIter, class UnaryPredicate>
+    bool execution_any_of(size_t, InputIter first, InputIter last, UnaryPredicate &unary_pred, m_false_type) {
+        return stl::any_of(first, last, unary_pred);
+    }
+
+    template<class RandomIter, class UnaryPredicate>
+    bool execution_any_of(size_t threads, RandomIter first, RandomIter last, UnaryPredicate &unary_pred,
+                          m_true_type) {
+        std::atomic<bool> found(false);
+        stl::execution_run(first, last, threads, [&](auto lo, auto hi, size_t) {
+            while (lo != hi) {
+                if (found.load(std::memory_order_relaxed)) return false;
+                const auto step = hi - lo < EXECUTION_CHECK_SIZE ? hi - lo : EXECUTION_CHECK_SIZE;
+                const auto end = lo + step;
+                if (stl::any_of(lo, end, unary_pred)) {
+                    found.store(true, std::memory_order_relaxed);
+                    return false;
+                }
+                lo = end;
+            }
+            return true;
+        });
+        return found.load(std::memory_order_relaxed);
+    }
+
+    // 对谓词取反
+    template<class UnaryPredicate>
+    struct execution_not_pred {
+        UnaryPredicate &pred;
+
+        template<class T>
+        bool operator()(T &&x) const { return !pred(x); }
+    };
+
+    template<class ExecutionPolicy, class ForwardIter, class UnaryPredicate>
+    execution_enable_if<ExecutionPolicy, bool>
+    any_of(ExecutionPolicy &&policy, ForwardIter first, ForwardIter last, UnaryPredicate unary_pred) {
+        return stl::execution_any_of(stl::execution_threads(policy), first, last, unary_pred,
+                                     execution_random_access<ForwardIter>());
+    }
+
+    template<class ExecutionPolicy, class ForwardIter, class UnaryPredicate>
+    execution_enable_if<ExecutionPolicy, bool>
+    all_of(ExecutionPolicy &&policy, ForwardIter first, ForwardIter last, UnaryPredicate unary_pred) {
+        execution_not_pred<UnaryPredicate> not_pred{unary_pred};
+        return !stl::execution_any_of(stl::execution_threads(policy), first, last, not_pred,
+                                      execution_random_access<ForwardIter>());
+    }
+
+    template<class ExecutionPolicy, class ForwardIter, class UnaryPredicate>
+    execution_enable_if<ExecutionPolicy, bool>
+    none_of(ExecutionPolicy &&policy, ForwardIter first, ForwardIter last, UnaryPredicate unary_pred) {
+        return !stl::execution_any_of(stl::execution_threads(policy), first, last, unary_pred,
+                                      execution_random_access<ForwardIter>());
+    }
+
+/*****************************************************************************************/
+// replace_if
+// 将所有令 unary_pred 为 true 的元素替换为 new_value
+/*****************************************************************************************/
+    template<class ForwardIter, class UnaryPredicate, class T>
+    void execution_replace_if(size_t, ForwardIter first, ForwardIter last, UnaryPredicate &unary_pred,
+                              const T &new_value, m_false_type) {
+        stl::replace_if(first, last, unary_pred, new_value);
+    }
+
+    template<class RandomIter, class UnaryPredicate, class T>
+    void execution_replace_if(size_t threads, RandomIter first, RandomIter last, UnaryPredicate &unary_pred,
+                              const T &new_value, m_true_type) {
+        stl::execution_run(first, last, threads, [&](auto lo, auto hi, size_t) {
+            stl::replace_if(lo, hi, unary_pred, new_value);
+            return true;
+        });
+    }
+
+    template<class ExecutionPolicy, class ForwardIter, class UnaryPredicate, class T>
+    execution_enable_if<ExecutionPolicy>
+    replace_if(ExecutionPolicy &&policy, ForwardIter first, ForwardIter last, UnaryPredicate unary_pred,
+               const T &new_value) {
+        stl::execution_replace_if(stl::execution_threads(policy), first, last, unary_pred, new_value,
+                                  execution_random_access<ForwardIter>());
+    }
+
+/*****************************************************************************************/
+// generate
+// 各线程调用同一个 gen，生成的值写入各自负责的位置
+/*****************************************************************************************/
+    template<class ForwardIter, class Generator>
+    void execution_generate(size_t, ForwardIter first, ForwardIter last, Generator &gen, m_false_type) {
+        for (; first != last; ++first) *first = gen();
+    }
+
+    template<class RandomIter, class Generator>
+    void execution_generate(size_t threads, RandomIter first, RandomIter last, Generator &gen, m_true_type) {
+        stl::execution_run(first, last, threads, [&](auto lo, auto hi, size_t) {
+            for (; lo != hi; ++lo) *lo = gen();
+            return true;
+        });
+    }
+
+    template<class ExecutionPolicy, class ForwardIter, class Generator>
+    execution_enable_if<ExecutionPolicy>
+    generate(ExecutionPolicy &&policy, ForwardIter first, ForwardIter last, Generator gen) {
+        stl::execution_generate(stl::execution_threads(policy), first, last, gen,
+                                execution_random_access<ForwardIter>());
+    }
+
+/*****************************************************************************************/
+// min_element / max_element
+// max_element 即交换比较参数后的 min_element：两者都返回第一个满足条件的元素
+/*****************************************************************************************/
+    template<class ForwardIter, class Compared>
+    ForwardIter execution_min_element(size_t, ForwardIter first, ForwardIter last, Compared &comp, m_false_type) {
+        return stl::min_element(first, last, comp);
+    }
+
+    template<class RandomIter, class Compared>
+    RandomIter execution_min_element(size_t threads, RandomIter first, RandomIter last, Compared &comp,
+                                     m_true_type) {
+        typedef typename iterator_traits<RandomIter>::difference_type difference_type;
+        const size_t n = static_cast<size_t>(last - first);
+        size_t best = n;
+        std::mutex best_mutex;
+        stl::execution_run(first, last, threads, [&](auto lo, auto hi, size_t offset) {
+            const auto pos = stl::min_element(lo, hi, comp);
+            const size_t k = offset + static_cast<size_t>(pos - lo);
+            std::lock_guard<std::mutex> lock(best_mutex);
+            // 各段完成的顺序不定，值相等时比较位置
+            if (best == n || comp(*pos, first[static_cast<difference_type>(best)]) ||
+                (k < best && !comp(first[static_cast<difference_type>(best)], *pos))) {
+                best = k;
+            }
+            return true;
+        });
+        return first + static_cast<difference_type>(best);
+    }
+
+    // 交换比较的两个参数
+    template<class Compared>
+    struct execution_reverse_comp {
+        Compared &comp;
+
+        template<class T, class U>
+        bool operator()(T &&a, U &&b) const { return comp(b, a); }
+    };
+
+    template<class ExecutionPolicy, class ForwardIter, class Compared>
+    execution_enable_if<ExecutionPolicy, ForwardIter>
+    min_element(ExecutionPolicy &&policy, ForwardIter first, ForwardIter last, Compared comp) {
+        return stl::execution_min_element(stl::execution_threads(policy), first, last, comp,
+                                          execution_random_access<ForwardIter>());
+    }
+
+    template<class ExecutionPolicy, class ForwardIter>
+    execution_enable_if<ExecutionPolicy, ForwardIter>
+    min_element(ExecutionPolicy &&policy, ForwardIter first, ForwardIter last) {
+        return stl::min_element(policy, first, last,
+                                stl::less<typename iterator_traits<ForwardIter>::value_type>());
+    }
+
+    template<class ExecutionPolicy, class ForwardIter, class Compared>
+    execution_enable_if<ExecutionPolicy, ForwardIter>
+    max_element(ExecutionPolicy &&policy, ForwardIter first, ForwardIter last, Compared comp) {
+        execution_reverse_comp<Compared> reverse_comp{comp};
+        return stl::execution_min_element(stl::execution_threads(policy), first, last, reverse_comp,
+                                          execution_random_access<ForwardIter>());
+    }
+
+    template<class ExecutionPolicy, class ForwardIter>
+    execution_enable_if<ExecutionPolicy, ForwardIter>
+    max_element(ExecutionPolicy &&policy, ForwardIter first, ForwardIter last) {
+        return stl::max_element(policy, first, last,
+                                stl::less<typename iterator_traits<ForwardIter>::value_type>());
+    }
+
+/*****************************************************************************************/
+// shuffle
+// 先把每个元素独立地随机分到一个桶中，再把各个桶分别随机重排后按桶的顺序放回：
+// 各桶大小服从多项分布，桶内是均匀的排列，拼接起来每种排列的概率仍然相同。
+// 随机数由 g 生成各线程、各桶的种子，再各自用 wyrand 生成；结果取决于 g 的状态与实际使用的线程数
+/*****************************************************************************************/
+    template<class RandomIter, class URBG>
+    void execution_shuffle(size_t, RandomIter first, RandomIter last, URBG &g, m_false_type) {
+        stl::shuffle(first, last, g);
+    }
+
+    template<class RandomIter, class URBG>
+    void execution_shuffle(size_t threads, RandomIter first, RandomIter last, URBG &g, m_true_type) {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        typedef typename iterator_traits<RandomIter>::difference_type difference_type;
+        // 桶号取随机数的最高 8 位；桶的平均大小为 n / 256，区间很大时每个桶也能放进缓存
+        const size_t buckets = 256;
+        const size_t n = static_cast<size_t>(last - first);
+        threads = stl::parallel_thread_count(n, threads);
+        if (threads == 1) {
+            stl::shuffle(first, last, g);
+            return;
+        }
+        temporary_buffer<RandomIter, value_type> buf(first, last);
+        if (static_cast<size_t>(buf.size()) < n) {
+            stl::shuffle(first, last, g);
+            return;
+        }
+        const size_t parts = threads;
+        stl::vector<uint64_t> seeds(parts + buckets);
+        for (auto &seed : seeds) seed = stl::random_bits64(g);
+        stl::vector<unsigned char> ids(n);
+        stl::vector<size_t> offsets(parts * buckets, 0);   // 先是各段各桶的元素个数，之后是各段各桶在缓冲区中的位置
+        stl::vector<size_t> bucket_start(buckets + 1, 0);
+        auto part_begin = [&](size_t t) { return n / parts * t + n % parts * t / parts; };
+
+        // 第一遍：各段分别为元素选桶并计数
+        stl::parallel_run(parts, threads, [&](size_t t) {
+            stl::wyrand rng(seeds[t]);
+            size_t *count = offsets.data() + t * buckets;
+            for (size_t i = part_begin(t), hi = part_begin(t + 1); i < hi; ++i) {
+                const auto id = static_cast<unsigned char>(rng() >> 56);
+                ids[i] = id;
+                ++count[id];
+            }
+        });
+        // 桶按顺序排列，同一个桶内各段按顺序排列
+        size_t pos = 0;
+        for (size_t b = 0; b < buckets; ++b) {
+            bucket_start[b] = pos;
+            for (size_t t = 0; t < parts; ++t) {
+                const size_t c = offsets[t * buckets + b];
+                offsets[t * buckets + b] = pos;
+                pos += c;
+            }
+        }
+        bucket_start[buckets] = pos;
+
+        // 第二遍：各段把元素移到所在的桶中
+        value_type *const out = buf.begin();
+        stl::parallel_run(parts, threads, [&](size_t t) {
+            size_t *offset = offsets.data() + t * buckets;
+            for (size_t i = part_begin(t), hi = part_begin(t + 1); i < hi; ++i) {
+                out[offset[ids[i]]++] = stl::move(first[static_cast<difference_type>(i)]);
+            }
+        });
+        // 各桶分别重排后移回原区间
+        stl::parallel_run(buckets, threads, [&](size_t b) {
+            stl::wyrand rng(seeds[parts + b]);
+            value_type *lo = out + bucket_start[b], *hi = out + bucket_start[b + 1];
+            stl::shuffle(lo, hi, rng);
+            stl::move(lo, hi, first + static_cast<difference_type>(bucket_start[b]));
+        });
+    }
+
+    template<class ExecutionPolicy, class RandomIter, class URBG>
+    execution_enable_if<ExecutionPolicy>
+    shuffle(ExecutionPolicy &&policy, RandomIter first, RandomIter last, URBG &&g) {
+        stl::execution_shuffle(stl::execution_threads(policy), first, last, g, execution_random_access<RandomIter>());
+    }
+
+}   // namespace stl
+
+#endif //MYCPPSTL_EXECUTION_H
@@ -0,0 +1,165 @@
+#ifndef MYCPPSTL_EYTZINGER_INDEX_H
+#define MYCPPSTL_EYTZINGER_INDEX_H
+
+// 这个头文件包含一个模板类 eytzinger_index
+// eytzinger_index : 静态有序表的查找索引，由有序区间构造，回答 lower_bound / upper_bound 查询，
+//                   结果为元素在原区间中的位置
+
+// notes:
+//
+// 把有序区间按二叉搜索树的中序重新排列，树按层存储在数组中(Eytzinger 布局)：结点 k 的孩子为 2k、2k + 1，根为 1，
+// 与二叉堆的存储方式相同。查找从根走到叶子，前几层集中在数组开头，始终留在缓存中；
+// 结点 k 往下第 L 层的 2^L 个后代在数组中是连续的，L 取它们恰好占一个 64 字节缓存行的层数(见 kPrefetchLevels)，
+// 每走一步预取它们，访存延迟与之后的几次比较重叠。相比在有序数组上二分，缓存的利用率高得多
+//
+// 走到叶子以后，最后一次向左的转向处即为结果：k 的二进制末尾连续的 1 表示最后几次向右，把它们和之前的一个 0 去掉就得到结果结点。
+// 结点在原区间中的位置由编号直接算出(见 rank)，不需要额外的存储
+//
+// 元素类型需要可以默认构造，原区间需要按 comp 有序
+
+#include <cstddef>
+#include <cstdint>
+
+#include "algo.h"
+#include "functional.h"
+#include "vector.h"
+
+namespace stl {
+
+    template<class T, class Compared = stl::less<T>>
+    class eytzinger_index {
+    public:
+        typedef T value_type;
+        typedef const T &const_reference;
+        typedef size_t size_type;
+
+    private:
+        // 预取往下这么多层的后代，它们恰好占满一个 64 字节的缓存行
+        static constexpr size_type kPrefetchLevels =
+                sizeof(T) <= 4 ? 4 : (sizeof(T) <= 8 ? 3 : (sizeof(T) <= 16 ? 2 : 1));
+
+        stl::vector<T> tree_;   // tree_[1, n] 为各个结点，tree_[0] 不使用
+        size_type n_;
+        size_type height_;      // 树的层数
+        size_type last_level_;  // 最后一层的结点数
+        Compared comp_;
+
+    public:
+        explicit eytzinger_index(Compared comp = Compared())
+                : n_(0), height_(0), last_level_(0), comp_(comp) {}
+
+        // 由有序区间[first, last)构造
+        template<class RandomIter>
+        eytzinger_index(RandomIter first, RandomIter last, Compared comp = Compared())
+                : n_(static_cast<size_type>(last - first)), height_(0), last_level_(0), comp_(comp) {
+            if (n_ == 0) return;
+            tree_.resize(n_ + 1);
+            while ((size_type(1) << height_) <= n_) ++height_;
+            last_level_ = n_ - ((size_type(1) << (height_ - 1)) - 1);
+            // 按中序遍历依次填入，用显式的栈代替递归
+            size_type stack[sizeof(size_type) * 8];
+            size_type top = 0, k = 1, i = 0;
+            while (k <= n_ || top > 0) {
+                if (k <= n_) {
+                    stack[top++] = k;
+                    k <<= 1;
+                } else {
+                    k = stack[--top];
+                    tree_[k] = first[i++];
+                    k = (k << 1) + 1;
+                }
+            }
+        }
+
+    public:
+        /// 容量相关操作
+
+        size_type size() const noexcept { return n_; }
+
+        bool empty() const noexcept { return n_ == 0; }
+
+        /// 查找相关操作
+
+        // 第一个不小于 value 的元素在原区间中的位置，没有则返回 size()
+        size_type lower_bound(const T &value) const { return rank(lower_node(value)); }
+
+        // 第一个大于 value 的元素在原区间中的位置，没有则返回 size()
+        // 第一个大于 value 的元素即第一个不满足 !(value < x) 的元素
+        size_type upper_bound(const T &value) const {
+            return rank(descend([&](const T &x) { return !comp_(value, x); }));
+        }
+
+        bool contains(const T &value) const {
+            const size_type k = lower_node(value);
+            return k != 0 && !comp_(value, tree_[k]);
+        }
+
+    private:
+        // 第一个不小于 value 的结点的编号，没有则返回 0
+        size_type lower_node(const T &value) const {
+            return descend([&](const T &x) { return comp_(x, value); });
+        }
+
+        // 从根走到叶子，go_right(x) 为 true 时走向右孩子，返回第一个令 go_right 为 false 的结点，没有则返回 0
+        // 除最后一层外每层都是满的，所以前 height - 1 步固定执行，循环次数与查找的值无关，没有难以预测的分支；
+        // 最后一步的结点不存在时当作向右走，向右走的步骤在最后会被去掉，不影响结果
+        template<class GoRight>
+        size_type descend(GoRight go_right) const {
+            if (n_ == 0) return 0;
+            const T *tree = tree_.data();
+            size_type k = 1;
+            for (size_type h = 1; h < height_; ++h) {
+                prefetch(k);
+                k = (k << 1) + static_cast<size_type>(go_right(tree[k]));
+            }
+            const bool exists = k <= n_;
+            const bool right = go_right(tree[exists ? k : 1]);
+            k = (k << 1) + static_cast<size_type>(!exists || right);
+            return k >> (count_trailing_ones(k) + 1);
+        }
+
+        // 预取不会引发访存错误，越过数组末尾的地址也可以预取，用整数运算得到地址以免越界的指针运算，也省去判断
+        void prefetch(size_type k) const noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+            __builtin_prefetch(reinterpret_cast<const char *>(
+                    reinterpret_cast<uintptr_t>(tree_.data()) + (k << kPrefetchLevels) * sizeof(T)));
+#else
+            (void) k;
+#endif
+        }
+
+        static size_type count_trailing_ones(size_type k) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+            return static_cast<size_type>(__builtin_ctzll(~static_cast<unsigned long long>(k)));
+#else
+            size_type n = 0;
+            for (; k & 1; k >>= 1) ++n;
+            return n;
+#endif
+        }
+
+        static size_type floor_log2(size_type k) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+            return sizeof(unsigned long long) * 8 - 1 - __builtin_clzll(k);
+#else
+            size_type n = 0;
+            while (k >>= 1) ++n;
+            return n;
+#endif
+        }
+
+        // 结点 k 在原区间中的位置，k 为 0 时表示没有，返回 n
+        // 先按满二叉树算出中序位置 p：深度为 d 的结点是它所在层的第 j 个，p = (2j + 1) * 2^(height - 1 - d) - 1，
+        // 满二叉树中最后一层的第 j 个结点位于 2j，再减去排在 p 之前、实际并不存在的最后一层结点
+        size_type rank(size_type k) const noexcept {
+            if (k == 0) return n_;
+            const size_type d = floor_log2(k);
+            const size_type p = ((((k - (size_type(1) << d)) << 1) + 1) << (height_ - 1 - d)) - 1;
+            const size_type before = (p + 1) >> 1;
+            return before > last_level_ ? p - (before - last_level_) : p;
+        }
+    };
+
+}   // namespace stl
+
+#endif //MYCPPSTL_EYTZINGER_INDEX_H
@@ -96,6 +96,17 @@ namespace stl {
         bool operator()(const T &x, const T &y) const { return x < y; }
     };
 
+    // 异构的小于、等于比较，两边的类型可以不同，没有 comp 的算法用它们复用带 comp 的实现
+    struct transparent_less {
+        template<class T1, class T2>
+        bool operator()(const T1 &lhs, const T2 &rhs) const { return lhs < rhs; }
+    };
+
+    struct transparent_equal {
+        template<class T1, class T2>
+        bool operator()(const T1 &lhs, const T2 &rhs) const { return lhs == rhs; }
+    };
+
     // 函数对象 大于等于
     template<class T>
     struct greater_equal : public binary_function<T, T, bool> {
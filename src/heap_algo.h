@@ -7,8 +7,23 @@
 
 // 这个头文件包含 heap 的四个算法 : push_heap, pop_heap,
 // sort_heap, make_heap
+// 以及 d 叉堆上的对应算法 : push_dary_heap, pop_dary_heap, sort_dary_heap, make_dary_heap, is_dary_heap
+
+// notes:
+//
+// 调整堆时只有一个空位在移动，元素都是移动赋值到空位上，最后把暂存的值移动到空位，不会拷贝元素
+//
+// pop 时空位先沿较大的孩子一直下沉到叶子，再把原来的末尾元素从叶子上浮。末尾元素通常很小，上浮的距离很短，
+// 比每层都与它比较一次少用约一半的比较。make_heap 从最后一个内部节点开始向前逐个调整(Floyd 建堆)，共 O(n) 次比较
+//
+// d 叉堆中节点 i 的孩子是 d * i + 1 ... d * i + d，同一个节点的孩子是连续的，4 个 8 字节的元素只占半个缓存行。
+// 树高是二叉堆的 1 / log2(d)，push 的上浮只需要 log_d(n) 次比较，建堆时调整的节点也少得多；pop 每层要在 d 个孩子中
+// 选出最大的，总的比较次数更多，但访问的缓存行更少。实测 4 叉堆在反复 pop / push 时比二叉堆快，8 叉堆 pop 的比较太多，
+// 只有建堆更快(见 bench/bench_heap.cpp)。D = 2 时与二叉堆相同
 
 #include "iterator.h"
+#include "functional.h"
+#include "utils.h"
 
 namespace stl {
 
@@ -23,16 +38,16 @@ namespace stl {
         // 大顶堆，如果当前节点holeIndex(value)大于其父节点，则交换它们两个
         // 重复这个操作直到堆顶或者value<其父节点
         while (holeIndex > topIndex && *(first + parent) < value) {
-            *(first + holeIndex) = *(first + parent);
+            *(first + holeIndex) = stl::move(*(first + parent));
             holeIndex = parent;
             parent = (holeIndex - 1) / 2;
         }
-        *(first + holeIndex) = value;
+        *(first + holeIndex) = stl::move(value);
     }
 
     template<class RandomIter, class Distance>
     void push_heap_d(RandomIter first, RandomIter last, Distance *) {
-        stl::push_heap_aux(first, (last - first) - 1, static_cast<Distance>(0), *(last - 1));
+        stl::push_heap_aux(first, (last - first) - 1, static_cast<Distance>(0), stl::move(*(last - 1)));
     }
 
     template<class RandomIter>
@@ -46,16 +61,16 @@ namespace stl {
         // 大顶堆，如果当前节点holeIndex(value)大于其父节点，则交换它们两个
         // 重复这个操作直到堆顶或者value<其父节点
         while (holeIndex > topIndex && comp(*(first + parent), value)) {
-            *(first + holeIndex) = *(first + parent);
+            *(first + holeIndex) = stl::move(*(first + parent));
             holeIndex = parent;
             parent = (holeIndex - 1) / 2;
         }
-        *(first + holeIndex) = value;
+        *(first + holeIndex) = stl::move(value);
     }
 
     template<class RandomIter, class Distance, class Compared>
-    void push_heap_d(RandomIter first, RandomIter last, Distance *, Compared, Compared comp) {
-        stl::push_heap_aux(first, (last - first) - 1, static_cast<Distance>(0), *(last - 1), comp);
+    void push_heap_d(RandomIter first, RandomIter last, Distance *, Compared comp) {
+        stl::push_heap_aux(first, (last - first) - 1, static_cast<Distance>(0), stl::move(*(last - 1)), comp);
     }
 
     template<class RandomIter, class Compared>
@@ -75,34 +90,35 @@ namespace stl {
         auto rchild = 2 * holeIndex + 2;
         while (rchild < len) {
             if (*(first + rchild) < *(first + rchild - 1)) --rchild;
-            *(first + holeIndex) = *(first + rchild);
+            *(first + holeIndex) = stl::move(*(first + rchild));
             holeIndex = rchild;
             rchild = 2 * (rchild + 1);
         }
         if (rchild == len) {
             // 如果有左孩子，没有右孩子
-            *(first + holeIndex) = *(first + rchild - 1);
+            *(first + holeIndex) = stl::move(*(first + rchild - 1));
             holeIndex = rchild - 1;
         }
 
         // 下坠的叶子节点，把value（原堆中最右侧的值）放进去
         // 此时这个value不一定合法，因为他不一定是最小的，因此还要上升
-        stl::push_heap_aux(first, holeIndex, topIndex, value);
+        stl::push_heap_aux(first, holeIndex, topIndex, stl::move(value));
     }
 
     template<class RandomIter, class T, class Distance>
     void pop_heap_aux(RandomIter first, RandomIter last, RandomIter result, T value, Distance *) {
         // 将堆顶的值放到尾部，即堆排序的基本操作，反复执行即可完成堆排序
         // 然后调整[first, last-1)使之重新成为一个 max-heap
-        *result = *first;
+        *result = stl::move(*first);
         // value里面存放堆中最右侧的值
-        stl::adjust_heap(first, static_cast<Distance>(0), last - first, value);
+        stl::adjust_heap(first, static_cast<Distance>(0), last - first, stl::move(value));
     }
 
     template<class RandomIter>
     void pop_heap(RandomIter first, RandomIter last) {
+        if (last - first < 2) return;
         // 将堆中最右侧的值给value
-        stl::pop_heap_aux(first, last - 1, last - 1, *(last - 1), distance_type(first));
+        stl::pop_heap_aux(first, last - 1, last - 1, stl::move(*(last - 1)), distance_type(first));
     }
 
     template<class RandomIter, class T, class Distance, class Compared>
@@ -112,29 +128,30 @@ namespace stl {
         auto rchild = 2 * holeIndex + 2;
         while (rchild < len) {
             if (comp(*(first + rchild), *(first + rchild - 1))) --rchild;
-            *(first + holeIndex) = *(first + rchild);
+            *(first + holeIndex) = stl::move(*(first + rchild));
             holeIndex = rchild;
             rchild = holeIndex * 2 + 2;
         }
         if (rchild == len) {
-            *(first + rchild) = *(first + rchild - 1);
+            *(first + holeIndex) = stl::move(*(first + rchild - 1));
             holeIndex = rchild - 1;
         }
 
-        stl::push_heap_aux(first, holeIndex, topIndex, value, comp);
+        stl::push_heap_aux(first, holeIndex, topIndex, stl::move(value), comp);
     }
 
     template<class RandomIter, class T, class Distance, class Compared>
     void pop_heap_aux(RandomIter first, RandomIter last, RandomIter result,
                       T value, Distance *, Compared comp) {
-        *result = *first;  // 先将尾指设置成首值，即尾指为欲求结果
+        *result = stl::move(*first);  // 先将尾指设置成首值，即尾指为欲求结果
         // 尾值存在value中
-        stl::adjust_heap(first, static_cast<Distance>(0), last - first, value, comp);
+        stl::adjust_heap(first, static_cast<Distance>(0), last - first, stl::move(value), comp);
     }
 
     template<class RandomIter, class Compared>
     void pop_heap(RandomIter first, RandomIter last, Compared comp) {
-        stl::pop_heap_aux(first, last - 1, last - 1, *(last - 1),
+        if (last - first < 2) return;
+        stl::pop_heap_aux(first, last - 1, last - 1, stl::move(*(last - 1)),
                           distance_type(first), comp);
     }
 
@@ -169,7 +186,7 @@ namespace stl {
         auto holeIndex = (len - 2) / 2;     // last指向最后一个的后一个 所以减二
         while (true) {
             //
-            stl::adjust_heap(first, holeIndex, len, *(first + holeIndex));
+            stl::adjust_heap(first, holeIndex, len, stl::move(*(first + holeIndex)));
             if (holeIndex == 0) return;
             holeIndex--;
         }
@@ -181,12 +198,12 @@ namespace stl {
     }
 
     template<class RandomIter, class Distance, class Compared>
-    void make_heap_aux(RandomIter first, RandomIter last, Compared comp) {
+    void make_heap_aux(RandomIter first, RandomIter last, Distance *, Compared comp) {
         if (last - first < 2) return;
         auto len = last - first;
         auto holeIndex = (len - 2) / 2;
         while (true) {
-            stl::adjust_heap(first, holeIndex, len, *(first + holeIndex), comp);
+            stl::adjust_heap(first, holeIndex, len, stl::move(*(first + holeIndex)), comp);
             if (holeIndex == 0) return;
             --holeIndex;
         }
@@ -197,6 +214,137 @@ namespace stl {
         stl::make_heap_aux(first, last, distance_type(first), comp);
     }
 
+/*****************************************************************************************/
+// d 叉堆
+// 用法与上面的二叉堆算法相同，模板参数 D 是每个节点的孩子个数，如 stl::push_dary_heap<4>(first, last)
+// 节点 i 的孩子是 D * i + 1 ... D * i + D，父节点是 (i - 1) / D
+/*****************************************************************************************/
+    // 把 value 从 holeIndex 上浮，不超过 topIndex
+    template<size_t D, class RandomIter, class Distance, class T, class Compared>
+    void dary_push_heap_aux(RandomIter first, Distance holeIndex, Distance topIndex, T value, Compared &comp) {
+        static_assert(D >= 2, "a d-ary heap needs at least two children per node");
+        const Distance d = static_cast<Distance>(D);
+        auto parent = (holeIndex - 1) / d;
+        while (holeIndex > topIndex && comp(*(first + parent), value)) {
+            *(first + holeIndex) = stl::move(*(first + parent));
+            holeIndex = parent;
+            parent = (holeIndex - 1) / d;
+        }
+        *(first + holeIndex) = stl::move(value);
+    }
+
+    // 在[child, child + n)中找到最大的孩子
+    template<class RandomIter, class Distance, class Compared>
+    Distance dary_max_child(RandomIter first, Distance child, Distance n, Compared &comp) {
+        Distance best = child;
+        for (Distance c = child + 1; c < child + n; ++c) {
+            if (comp(*(first + best), *(first + c))) best = c;
+        }
+        return best;
+    }
+
+    // 把 value 放到以 holeIndex 为根的子树中，与 adjust_heap 相同：空位先沿最大的孩子下沉到叶子，再让 value 上浮
+    template<size_t D, class RandomIter, class Distance, class T, class Compared>
+    void dary_adjust_heap(RandomIter first, Distance holeIndex, Distance len, T value, Compared &comp) {
+        const Distance d = static_cast<Distance>(D);
+        const auto topIndex = holeIndex;
+        auto child = d * holeIndex + 1;
+        // 孩子齐全的节点
+        while (child < len - d + 1) {
+            const auto best = stl::dary_max_child(first, child, d, comp);
+            *(first + holeIndex) = stl::move(*(first + best));
+            holeIndex = best;
+            child = d * holeIndex + 1;
+        }
+        // 最后一个内部节点可能只有一部分孩子
+        if (child < len) {
+            const auto best = stl::dary_max_child(first, child, len - child, comp);
+            *(first + holeIndex) = stl::move(*(first + best));
+            holeIndex = best;
+        }
+        stl::dary_push_heap_aux<D>(first, holeIndex, topIndex, stl::move(value), comp);
+    }
+
+    template<size_t D, class RandomIter, class Compared>
+    void push_dary_heap(RandomIter first, RandomIter last, Compared comp) {
+        typedef typename iterator_traits<RandomIter>::difference_type Distance;
+        if (last - first < 2) return;
+        stl::dary_push_heap_aux<D>(first, (last - first) - 1, static_cast<Distance>(0), stl::move(*(last - 1)), comp);
+    }
+
+    template<size_t D, class RandomIter>
+    void push_dary_heap(RandomIter first, RandomIter last) {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        stl::push_dary_heap<D>(first, last, stl::less<value_type>());
+    }
+
+    // 把堆顶移到 last - 1，调整[first, last - 1)使之重新成为堆
+    template<size_t D, class RandomIter, class Compared>
+    void pop_dary_heap(RandomIter first, RandomIter last, Compared comp) {
+        typedef typename iterator_traits<RandomIter>::difference_type Distance;
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        if (last - first < 2) return;
+        --last;
+        value_type value = stl::move(*last);
+        *last = stl::move(*first);
+        stl::dary_adjust_heap<D>(first, static_cast<Distance>(0), last - first, stl::move(value), comp);
+    }
+
+    template<size_t D, class RandomIter>
+    void pop_dary_heap(RandomIter first, RandomIter last) {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        stl::pop_dary_heap<D>(first, last, stl::less<value_type>());
+    }
+
+    template<size_t D, class RandomIter, class Compared>
+    void sort_dary_heap(RandomIter first, RandomIter last, Compared comp) {
+        while (last - first > 1) {
+            stl::pop_dary_heap<D>(first, last, comp);
+            --last;
+        }
+    }
+
+    template<size_t D, class RandomIter>
+    void sort_dary_heap(RandomIter first, RandomIter last) {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        stl::sort_dary_heap<D>(first, last, stl::less<value_type>());
+    }
+
+    // Floyd 建堆：从最后一个内部节点开始向前，逐个把节点调整到它的子树中
+    template<size_t D, class RandomIter, class Compared>
+    void make_dary_heap(RandomIter first, RandomIter last, Compared comp) {
+        typedef typename iterator_traits<RandomIter>::difference_type Distance;
+        const Distance len = last - first;
+        if (len < 2) return;
+        for (Distance holeIndex = (len - 2) / static_cast<Distance>(D);; --holeIndex) {
+            stl::dary_adjust_heap<D>(first, holeIndex, len, stl::move(*(first + holeIndex)), comp);
+            if (holeIndex == 0) return;
+        }
+    }
+
+    template<size_t D, class RandomIter>
+    void make_dary_heap(RandomIter first, RandomIter last) {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        stl::make_dary_heap<D>(first, last, stl::less<value_type>());
+    }
+
+    // [first, last)是否是一个 d 叉堆
+    template<size_t D, class RandomIter, class Compared>
+    bool is_dary_heap(RandomIter first, RandomIter last, Compared comp) {
+        typedef typename iterator_traits<RandomIter>::difference_type Distance;
+        const Distance len = last - first;
+        for (Distance i = 1; i < len; ++i) {
+            if (comp(*(first + (i - 1) / static_cast<Distance>(D)), *(first + i))) return false;
+        }
+        return true;
+    }
+
+    template<size_t D, class RandomIter>
+    bool is_dary_heap(RandomIter first, RandomIter last) {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        return stl::is_dary_heap<D>(first, last, stl::less<value_type>());
+    }
+
 }
 
 #endif //MYCPPSTL_HEAD_ALGO_H
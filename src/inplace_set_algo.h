@@ -0,0 +1,151 @@
+#ifndef MYCPPSTL_INPLACE_SET_ALGO_H
+#define MYCPPSTL_INPLACE_SET_ALGO_H
+
+// 这个头文件包含直接修改 stl::vector 的集合运算，不需要输出迭代器，也不需要另一块缓冲区
+// inplace_set_union        : vec = vec ∪ other
+// inplace_set_intersection : vec = vec ∩ other
+// inplace_set_difference   : vec = vec - other
+//
+// vec 与 other 都要按 comp(默认为 operator<)有序，结果与 set_algo.h 中对应的算法写到新区间的结果相同(包括有重复元素时)
+
+// notes:
+//
+// inplace_set_union 先用 set_intersection_size 算出结果的长度，vec 只扩大一次，容量足够时不分配内存。
+// 然后从两个序列的末尾向前合并，结果从 vec 新的末尾向前写。剩下的结果始终不少于 vec 中剩下的元素，
+// 写入的位置不会越过还没有读的元素；两者相等时剩下的结果就是 vec 的前缀，已经在原位，可以提前结束
+//
+// inplace_set_intersection / inplace_set_difference 的结果是 vec 的子序列，从前往后压缩，写入的位置不超过读取的位置，
+// 最后删掉尾部，不会分配内存。交集复用 set_intersection 的实现(galloping，4 字节整数的分块比较)；
+// 差集在 other 很短时在 vec 中 galloping 找到要删除的元素，两者之间的一段整段前移
+//
+// vec 中的元素用移动赋值搬动，other 中的元素用拷贝赋值写入
+
+#include <cstddef>
+
+#include "set_algo.h"
+#include "vector.h"
+
+namespace stl {
+
+    // 把交集中的元素移动到 result，写入的位置与读取的位置相同时不用动
+    template<class T>
+    struct inplace_set_sink {
+        T *result;
+
+        // 分块比较的版本传入 const 指针，这时只有整数，移动退化为拷贝
+        template<class Iter>
+        void operator()(const Iter &it) {
+            if (result != &*it) *result = stl::move(*it);
+            ++result;
+        }
+    };
+
+    // 把[first, last)前移到 result，返回写入的尾后位置
+    template<class T>
+    T *inplace_set_shift(T *first, T *last, T *result) {
+        if (result == first) return last;
+        return stl::move(first, last, result);
+    }
+
+/*****************************************************************************************/
+// inplace_set_union
+// 把 other 中不在 vec 中的元素合并到 vec 中
+/*****************************************************************************************/
+    template<class T, class Compared>
+    void inplace_set_union(vector<T> &vec, const vector<T> &other, Compared comp) {
+        if (&vec == &other || other.empty()) return;
+        const size_t n1 = vec.size();
+        const size_t n = n1 + other.size() -
+                         stl::set_intersection_size(vec.begin(), vec.end(), other.begin(), other.end(), comp);
+        // other 是 vec 的子集
+        if (n == n1) return;
+        vec.resize(n);
+
+        T *first1 = vec.begin(), *last1 = first1 + n1, *result = vec.end();
+        const T *first2 = other.begin(), *last2 = other.end();
+        while (result != last1) {
+            // result 在 last1 之后，所以 other 中一定还有元素
+            if (last1 == first1 || comp(last1[-1], last2[-1])) {
+                *--result = *--last2;
+            } else if (comp(last2[-1], last1[-1])) {
+                *--result = stl::move(*--last1);
+            } else {
+                // 相等的一组：与 set_union 相同，先是 vec 中的 c1 个，再是 other 中多出来的最后 c2 - c1 个
+                ptrdiff_t c1 = 1, c2 = 1;
+                while (c1 < last1 - first1 && !comp(last1[-c1 - 1], last2[-1])) ++c1;
+                while (c2 < last2 - first2 && !comp(last2[-c2 - 1], last1[-1])) ++c2;
+                for (; c2 > c1; --c2) *--result = *--last2;
+                last2 -= c2;
+                result = result == last1 ? last1 - c1 : stl::move_backward(last1 - c1, last1, result);
+                last1 -= c1;
+            }
+        }
+    }
+
+    template<class T>
+    void inplace_set_union(vector<T> &vec, const vector<T> &other) {
+        stl::inplace_set_union(vec, other, stl::transparent_less());
+    }
+
+/*****************************************************************************************/
+// inplace_set_intersection
+// 只保留 vec 中也在 other 中的元素
+/*****************************************************************************************/
+    template<class T, class Compared>
+    void inplace_set_intersection(vector<T> &vec, const vector<T> &other, Compared comp) {
+        if (&vec == &other) return;
+        inplace_set_sink<T> sink{vec.begin()};
+        stl::set_intersection_aux(vec.begin(), vec.end(), other.begin(), other.end(), sink, comp);
+        vec.erase(sink.result, vec.end());
+    }
+
+    template<class T>
+    void inplace_set_intersection(vector<T> &vec, const vector<T> &other) {
+        stl::inplace_set_intersection(vec, other, stl::transparent_less());
+    }
+
+/*****************************************************************************************/
+// inplace_set_difference
+// 删掉 vec 中也在 other 中的元素
+/*****************************************************************************************/
+    template<class T, class Compared>
+    void inplace_set_difference(vector<T> &vec, const vector<T> &other, Compared comp) {
+        if (&vec == &other) {
+            vec.clear();
+            return;
+        }
+        T *first1 = vec.begin(), *last1 = vec.end(), *result = first1;
+        const T *first2 = other.begin(), *last2 = other.end();
+        if (vec.size() / SET_GALLOP_RATIO >= other.size()) {
+            for (; first2 != last2; ++first2) {
+                T *pos = stl::set_gallop(first1, last1, *first2, comp);
+                result = stl::inplace_set_shift(first1, pos, result);
+                first1 = pos;
+                if (first1 == last1) break;
+                // 相等，删掉 vec 中的一个
+                if (!comp(*first2, *first1)) ++first1;
+            }
+        } else {
+            while (first1 != last1 && first2 != last2) {
+                if (comp(*first1, *first2)) {
+                    if (result != first1) *result = stl::move(*first1);
+                    ++result, ++first1;
+                } else if (comp(*first2, *first1)) {
+                    ++first2;
+                } else {
+                    ++first1, ++first2;
+                }
+            }
+        }
+        result = stl::inplace_set_shift(first1, last1, result);
+        vec.erase(result, vec.end());
+    }
+
+    template<class T>
+    void inplace_set_difference(vector<T> &vec, const vector<T> &other) {
+        stl::inplace_set_difference(vec, other, stl::transparent_less());
+    }
+
+}
+
+#endif //MYCPPSTL_INPLACE_SET_ALGO_H
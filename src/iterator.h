@@ -222,7 +222,7 @@ namespace stl {
 
     // distance 的 random_access_iterator_tag 的版本
     template<class RandomIter>
-    typename iterator_traits<RandomIter>::diference_type
+    typename iterator_traits<RandomIter>::difference_type
     distance_dispatch(RandomIter first, RandomIter last, random_access_iterator_tag) {
         return last - first;
     }
@@ -230,7 +230,7 @@ namespace stl {
     template<class InputIterator>
     typename iterator_traits<InputIterator>::difference_type
     distance(InputIterator first, InputIterator last) {
-        distance_dispatch<InputIterator>(first, last, iterator_category(first));
+        return distance_dispatch(first, last, iterator_category(first));
     }
 
     // 以下函数用于让迭代器前进 n 个距离
@@ -288,6 +288,8 @@ namespace stl {
 
         reverse_iterator(const self &rhs) : current(rhs.current) {}
 
+        reverse_iterator &operator=(const self &) = default;
+
     public:
         // 取出对应的正向迭代器
         iterator_type base() const {
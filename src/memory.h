@@ -9,8 +9,8 @@
 // 包含一些基本函数、空间配置器、未初始化的储存空间管理，以及一个模板类 auto_ptr
 
 #include <cstddef>
+#include <cstdint>
 #include <cstdlib>
-#include <climits>
 
 #include "algobase.h"
 #include "allocator.h"
@@ -29,8 +29,8 @@ namespace stl {
     // 获取/释放 临时缓冲区
     template<class T>
     pair<T *, ptrdiff_t> get_buffer_helper(ptrdiff_t len, T *) {
-        if (len > static_cast<ptrdiff_t>(INT_MAX / sizeof(T)))
-            len = INT_MAX / sizeof(T);
+        if (len > static_cast<ptrdiff_t>(PTRDIFF_MAX / sizeof(T)))
+            len = PTRDIFF_MAX / sizeof(T);
         while (len > 0) {
             T *tmp = static_cast<T *>(malloc(static_cast<size_t>(len) * sizeof(T)));
             if (tmp)
@@ -122,10 +122,11 @@ namespace stl {
     template<class ForwardIter, class T>
     void temporary_buffer<ForwardIter, T>::allocate_buffer() {
         original_len = len;
-        if (len > static_cast<ptrdiff_t>(INT_MAX / sizeof(T)))
-            len = INT_MAX / sizeof(T);
+        buffer = nullptr;
+        if (len > static_cast<ptrdiff_t>(PTRDIFF_MAX / sizeof(T)))
+            len = PTRDIFF_MAX / sizeof(T);
         while (len > 0) {
-            buffer = static_cast<T *>(malloc(len * sizeof(T)));
+            buffer = static_cast<T *>(malloc(static_cast<size_t>(len) * sizeof(T)));
             if (buffer != nullptr) break;
             len = len / 2;
         }
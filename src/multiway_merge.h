@@ -0,0 +1,383 @@
+#ifndef MYCPPSTL_MULTIWAY_MERGE_H
+#define MYCPPSTL_MULTIWAY_MERGE_H
+
+// 这个头文件包含多路有序序列的合并与集合运算，一次处理所有的路，不必两两合并
+// k_way_merge            : 稳定地合并 k 路有序序列
+// k_way_merge_unique     : 合并的同时去掉重复的元素，每个值只输出一次
+// multi_set_union        : k 路的并集，每个值出现的次数是它在各路中出现次数的最大值
+// multi_set_intersection : k 路的交集，每个值出现的次数是它在各路中出现次数的最小值
+//
+// 各路由[first_run, last_run)给出，每一路可以是有 begin() / end() 的容器(如 stl::vector)，也可以是表示区间的 stl::pair<Iter, Iter>
+// 所有的路必须使用同一种迭代器，并且按 comp(默认为 operator<)有序
+
+// notes:
+//
+// k_way_merge / k_way_merge_unique / multi_set_union 使用败者树(tournament tree)：k 个叶子是各路的当前元素，
+// 每个内部节点记录在该处比赛中落败的路，根之上记录胜者。取走胜者后只需沿它的叶子到根的路径重赛一次，
+// 每个元素 ceil(log2 k) 次比较，与二叉堆的 pop 相比省去了与兄弟节点的比较。取完的路视为无穷大，
+// 只剩一路时直接拷贝剩下的部分。相等的元素按所在路的次序输出，所以合并是稳定的。
+// 逐个调用 set_union 累加需要 O(nk) 次元素搬运，平衡的两两合并需要 O(n log k) 次，这里每个元素只搬运一次，
+// 只读一遍输入，也不需要中间缓冲区，结果可以直接写到只能写一次的输出迭代器。数据都在内存中时，
+// 平衡的两两合并每轮都顺序访问内存，仍然可能更快
+//
+// multi_set_intersection 不需要败者树：先求第一路与最短一路的交集，把第一路中的位置作为候选，
+// 再按长度从小到大依次与其他各路求交集，只保留仍然匹配的候选(small vs small)。每一步都复用 set_algo.h 中的
+// set_intersection，长度相差很大时 galloping，较长的路大段地跳过；候选变空时不必再看剩下的路
+//
+// 结果写到 result，返回写入的尾后位置，result 不能与任何一路重叠
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "set_algo.h"
+#include "utils.h"
+#include "vector.h"
+
+namespace stl {
+
+    // 一路的首尾
+    template<class Run>
+    auto multiway_begin(Run &run) -> decltype(run.begin()) { return run.begin(); }
+
+    template<class Run>
+    auto multiway_end(Run &run) -> decltype(run.end()) { return run.end(); }
+
+    template<class Iter>
+    Iter multiway_begin(const pair<Iter, Iter> &run) { return run.first; }
+
+    template<class Iter>
+    Iter multiway_end(const pair<Iter, Iter> &run) { return run.second; }
+
+    // 各路当前的位置与尾后位置
+    template<class RunIter>
+    struct multiway_cursors {
+        typedef decltype(stl::multiway_begin(*std::declval<RunIter &>())) iterator;
+
+        stl::vector<iterator> cur;
+        stl::vector<iterator> last;
+
+        multiway_cursors(RunIter first_run, RunIter last_run) {
+            for (; first_run != last_run; ++first_run) {
+                cur.push_back(stl::multiway_begin(*first_run));
+                last.push_back(stl::multiway_end(*first_run));
+            }
+        }
+
+        size_t size() const { return cur.size(); }
+    };
+
+    // 败者树比较时读取的各路当前元素。默认经过迭代器读取；算术类型与指针拷贝的代价很小，
+    // 缓存在连续的数组中，每层比较少一次依赖的间接访问
+    template<class Iter, bool = std::is_arithmetic<typename iterator_traits<Iter>::value_type>::value ||
+                                std::is_pointer<typename iterator_traits<Iter>::value_type>::value>
+    struct merge_keys {
+        static const bool cached = false;
+
+        Iter *cur;
+
+        merge_keys(Iter *c, size_t) : cur(c) {}
+
+        typename iterator_traits<Iter>::reference operator[](size_t i) const { return *cur[i]; }
+
+        void load(size_t) {}
+    };
+
+    template<class Iter>
+    struct merge_keys<Iter, true> {
+        typedef typename iterator_traits<Iter>::value_type value_type;
+
+        static const bool cached = true;
+
+        Iter *cur;
+        stl::vector<value_type> keys;
+
+        merge_keys(Iter *c, size_t k) : cur(c), keys(k, value_type()) {}
+
+        const value_type &operator[](size_t i) const { return keys[i]; }
+
+        void load(size_t i) { keys[i] = *cur[i]; }
+    };
+
+/*****************************************************************************************/
+// merge_loser_tree
+// k 路合并用的败者树，top() 为胜者的当前位置，run() 为胜者所在的路，pop() 取走胜者并重赛
+/*****************************************************************************************/
+    template<class Iter, class Compared>
+    class merge_loser_tree {
+    private:
+        Iter *cur_;
+        const Iter *last_;
+        size_t k_;
+        size_t live_;                   // 还没有取完的路数
+        stl::vector<size_t> tree_;      // tree_[0] 为胜者，tree_[1, k) 为各内部节点上的败者
+        stl::vector<char> done_;        // 各路是否已取完
+        merge_keys<Iter> keys_;
+        Compared &comp_;
+
+    public:
+        merge_loser_tree(Iter *cur, const Iter *last, size_t k, Compared &comp)
+                : cur_(cur), last_(last), k_(k), live_(0), tree_(k, 0), done_(k, 0), keys_(cur, k), comp_(comp) {
+            for (size_t i = 0; i < k; ++i) {
+                done_[i] = cur[i] == last[i];
+                live_ += !done_[i];
+                if (!done_[i]) keys_.load(i);
+            }
+            // 自底向上比赛，win[n] 为节点 n 处的胜者，叶子 k + i 对应第 i 路
+            stl::vector<size_t> win(k, 0);
+            for (size_t n = k - 1; n >= 1; --n) {
+                const size_t l = 2 * n < k ? win[2 * n] : 2 * n - k;
+                const size_t r = 2 * n + 1 < k ? win[2 * n + 1] : 2 * n + 1 - k;
+                if (before(r, l)) win[n] = r, tree_[n] = l;
+                else win[n] = l, tree_[n] = r;
+            }
+            tree_[0] = k > 1 ? win[1] : 0;
+        }
+
+        // 所有的路都已取完
+        bool empty() const { return live_ == 0; }
+
+        // 只剩下胜者一路
+        bool single() const { return live_ == 1; }
+
+        size_t run() const { return tree_[0]; }
+
+        const Iter &top() const { return cur_[tree_[0]]; }
+
+        void pop() {
+            size_t w = tree_[0];
+            if (++cur_[w] == last_[w]) done_[w] = 1, --live_;
+            else keys_.load(w);
+            for (size_t n = (w + k_) / 2; n >= 1; n /= 2) {
+                const size_t t = tree_[n];
+                if (merge_keys<Iter>::cached) {
+                    // 比较很便宜，而每一层的胜负几乎是随机的：用掩码交换代替分支，避免频繁的分支预测失败
+                    const size_t mask = (t ^ w) & (size_t(0) - static_cast<size_t>(before(t, w)));
+                    tree_[n] = t ^ mask;
+                    w ^= mask;
+                } else if (before(t, w)) {
+                    // 比较代价较高(如字符串)：保留分支，处理器可以推测执行上一层的比较，不必等待这一次比较完成
+                    tree_[n] = w;
+                    w = t;
+                }
+            }
+            tree_[0] = w;
+        }
+
+    private:
+        // 第 i 路的当前元素是否排在第 j 路之前：取完的路排在最后，相等时路的编号小的在前
+        // 编号小的一路在前时结果为 !comp(j, i)，否则为 comp(i, j)，先选出参数再比较一次，不必按编号分支
+        bool before(size_t i, size_t j) const {
+            if (done_[i] | done_[j]) return !done_[i];
+            const bool i_first = i < j;
+            const bool c = static_cast<bool>(comp_(keys_[i_first ? j : i], keys_[i_first ? i : j]));
+            return c != i_first;
+        }
+    };
+
+/*****************************************************************************************/
+// k_way_merge
+// 稳定地合并[first_run, last_run)中的各路有序序列，结果保存到 result 中，返回一个迭代器指向输出结果的尾部
+/*****************************************************************************************/
+    template<class RunIter, class OutputIter, class Compared>
+    OutputIter k_way_merge(RunIter first_run, RunIter last_run, OutputIter result, Compared comp) {
+        multiway_cursors<RunIter> c(first_run, last_run);
+        if (c.size() == 0) return result;
+        merge_loser_tree<typename multiway_cursors<RunIter>::iterator, Compared>
+                tree(c.cur.data(), c.last.data(), c.size(), comp);
+        while (!tree.empty()) {
+            if (tree.single()) return stl::copy(tree.top(), c.last[tree.run()], result);
+            *result = *tree.top();
+            ++result;
+            tree.pop();
+        }
+        return result;
+    }
+
+    template<class RunIter, class OutputIter>
+    OutputIter k_way_merge(RunIter first_run, RunIter last_run, OutputIter result) {
+        return stl::k_way_merge(first_run, last_run, result, stl::transparent_less());
+    }
+
+/*****************************************************************************************/
+// k_way_merge_unique
+// 合并各路有序序列，相等的元素只输出第一个(所在路的编号最小的那个)
+/*****************************************************************************************/
+    template<class RunIter, class OutputIter, class Compared>
+    OutputIter k_way_merge_unique(RunIter first_run, RunIter last_run, OutputIter result, Compared comp) {
+        typedef typename multiway_cursors<RunIter>::iterator iterator;
+        multiway_cursors<RunIter> c(first_run, last_run);
+        if (c.size() == 0) return result;
+        merge_loser_tree<iterator, Compared> tree(c.cur.data(), c.last.data(), c.size(), comp);
+        if (tree.empty()) return result;
+        // prev 指向上一个输出的元素，元素有序，它与当前元素不相等当且仅当 comp(*prev, 当前元素)
+        iterator prev = tree.top();
+        *result = *prev;
+        ++result;
+        tree.pop();
+        while (!tree.empty()) {
+            if (comp(*prev, *tree.top())) {
+                prev = tree.top();
+                *result = *prev;
+                ++result;
+            }
+            tree.pop();
+        }
+        return result;
+    }
+
+    template<class RunIter, class OutputIter>
+    OutputIter k_way_merge_unique(RunIter first_run, RunIter last_run, OutputIter result) {
+        return stl::k_way_merge_unique(first_run, last_run, result, stl::transparent_less());
+    }
+
+/*****************************************************************************************/
+// multi_set_union
+// 计算各路的并集，某个值在某一路中出现 m 次、在各路中最多出现 M 次时，结果中出现 M 次，
+// 按路的编号依次取：先取第一路中的全部，再取之后各路中超出已输出次数的部分。与两路的 set_union 一致
+/*****************************************************************************************/
+    template<class RunIter, class OutputIter, class Compared>
+    OutputIter multi_set_union(RunIter first_run, RunIter last_run, OutputIter result, Compared comp) {
+        typedef typename multiway_cursors<RunIter>::iterator iterator;
+        multiway_cursors<RunIter> c(first_run, last_run);
+        const size_t k = c.size();
+        if (k == 0) return result;
+        merge_loser_tree<iterator, Compared> tree(c.cur.data(), c.last.data(), k, comp);
+        if (tree.empty()) return result;
+        // 当前值在各路中已出现的次数，只重置出现过的路
+        stl::vector<size_t> count(k, 0);
+        stl::vector<size_t> touched;
+        iterator group = tree.top();    // 当前值的第一个元素
+        size_t emitted = 0;             // 当前值已输出的次数
+        while (!tree.empty()) {
+            const size_t w = tree.run();
+            if (emitted != 0 && comp(*group, *tree.top())) {
+                for (size_t r : touched) count[r] = 0;
+                touched.clear();
+                group = tree.top();
+                emitted = 0;
+            }
+            if (count[w]++ == 0) touched.push_back(w);
+            if (count[w] > emitted) {
+                *result = *tree.top();
+                ++result;
+                ++emitted;
+            }
+            tree.pop();
+        }
+        return result;
+    }
+
+    template<class RunIter, class OutputIter>
+    OutputIter multi_set_union(RunIter first_run, RunIter last_run, OutputIter result) {
+        return stl::multi_set_union(first_run, last_run, result, stl::transparent_less());
+    }
+
+/*****************************************************************************************/
+// multi_set_intersection
+// 计算各路的交集，某个值在各路中最少出现 m 次时，结果中出现 m 次，输出的是第一路中的元素。与两路的 set_intersection 一致
+/*****************************************************************************************/
+    // 交集的候选：第一路中的位置。指针统一保存为指向 const 的指针，分块比较以 const 指针回调 sink
+    template<class Iter>
+    struct multiway_candidate {
+        Iter it;
+    };
+
+    template<class Iter>
+    struct multiway_candidate_iter {
+        typedef Iter type;
+    };
+
+    template<class Tp>
+    struct multiway_candidate_iter<Tp *> {
+        typedef const Tp *type;
+    };
+
+    // 候选与其他路中元素的比较
+    template<class Compared>
+    struct multiway_candidate_comp {
+        Compared &comp;
+
+        template<class Iter, class T>
+        bool operator()(const multiway_candidate<Iter> &lhs, const T &rhs) { return comp(*lhs.it, rhs); }
+
+        template<class T, class Iter>
+        bool operator()(const T &lhs, const multiway_candidate<Iter> &rhs) { return comp(lhs, *rhs.it); }
+    };
+
+    // 收集第一路与最短一路的交集作为候选；之后每与一路求交集，原地保留仍然匹配的候选(写入位置不超过读取位置)
+    template<class Iter>
+    struct multiway_candidate_sink {
+        multiway_candidate<Iter> *result;
+
+        void operator()(const Iter &it) {
+            result->it = it;
+            ++result;
+        }
+
+        void operator()(multiway_candidate<Iter> *p) {
+            *result = *p;
+            ++result;
+        }
+    };
+
+    // 除第一路以外各路的处理次序：随机访问迭代器按长度从小到大，候选尽早变少；否则按原来的次序
+    template<class RunIter>
+    void multiway_intersection_order(const multiway_cursors<RunIter> &c, stl::vector<size_t> &order,
+                                     input_iterator_tag) {
+        for (size_t i = 1; i < c.size(); ++i) order.push_back(i);
+    }
+
+    template<class RunIter>
+    void multiway_intersection_order(const multiway_cursors<RunIter> &c, stl::vector<size_t> &order,
+                                     random_access_iterator_tag) {
+        for (size_t i = 1; i < c.size(); ++i) {
+            const auto len = c.last[i] - c.cur[i];
+            size_t j = order.size();
+            order.push_back(i);
+            for (; j > 0 && c.last[order[j - 1]] - c.cur[order[j - 1]] > len; --j) order[j] = order[j - 1];
+            order[j] = i;
+        }
+    }
+
+    template<class RunIter, class OutputIter, class Compared>
+    OutputIter multi_set_intersection(RunIter first_run, RunIter last_run, OutputIter result, Compared comp) {
+        typedef typename multiway_candidate_iter<typename multiway_cursors<RunIter>::iterator>::type iterator;
+        multiway_cursors<RunIter> c(first_run, last_run);
+        const size_t k = c.size();
+        if (k == 0) return result;
+        if (k == 1) return stl::copy(c.cur[0], c.last[0], result);
+        stl::vector<size_t> order;
+        stl::multiway_intersection_order(c, order, stl::iterator_category(c.cur[0]));
+
+        // 候选不会多于最短的一路
+        const size_t s = order[0];
+        stl::vector<multiway_candidate<iterator>> cand(
+                static_cast<size_t>(stl::distance(c.cur[s], c.last[s])), multiway_candidate<iterator>());
+        multiway_candidate_sink<iterator> sink{cand.data()};
+        stl::set_intersection_aux(c.cur[0], c.last[0], c.cur[s], c.last[s], sink, comp);
+        size_t size = static_cast<size_t>(sink.result - cand.data());
+
+        multiway_candidate_comp<Compared> cand_comp{comp};
+        for (size_t j = 1; j < order.size() && size != 0; ++j) {
+            const size_t r = order[j];
+            multiway_candidate_sink<iterator> filter{cand.data()};
+            stl::set_intersection_dispatch(cand.data(), cand.data() + size, c.cur[r], c.last[r], filter, cand_comp,
+                                           random_access_iterator_tag(), stl::iterator_category(c.cur[r]));
+            size = static_cast<size_t>(filter.result - cand.data());
+        }
+        for (size_t i = 0; i < size; ++i) {
+            *result = *cand[i].it;
+            ++result;
+        }
+        return result;
+    }
+
+    template<class RunIter, class OutputIter>
+    OutputIter multi_set_intersection(RunIter first_run, RunIter last_run, OutputIter result) {
+        return stl::multi_set_intersection(first_run, last_run, result, stl::transparent_less());
+    }
+
+}   // namespace stl
+
+#endif //MYCPPSTL_MULTIWAY_MERGE_H
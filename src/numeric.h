@@ -0,0 +1,651 @@
+#ifndef MYCPPSTL_NUMERIC_H
+#define MYCPPSTL_NUMERIC_H
+
+// 这个头文件包含数值算法
+// accumulate       : 从左到右依次累加
+// reduce           : 归约，计算的顺序不定
+// transform_reduce : 先变换再归约，缺省为点积
+// inclusive_scan   : 前缀和，第 i 个结果包含第 i 个元素
+// exclusive_scan   : 前缀和，第 i 个结果不包含第 i 个元素
+// histogram        : 统计落在各个桶中的元素个数
+// 除 accumulate 外都有接受执行策略(见 execution.h)的重载版本
+
+// notes:
+//
+// reduce / transform_reduce 要求 op 满足结合律与交换律，scan 要求 op 满足结合律，顺序版本也会利用这一点重新组织计算：
+// 区间为算术类型的指针且使用缺省的 stl::plus 时，调用 simd.h 中向量化的求和与前缀和，浮点数的点积调用 simd_dot。
+// 整数的结果与逐个计算相同，浮点数的舍入可能不同
+//
+// 并行版本只对随机访问迭代器并行，区间与 execution.h 一样切块，stl::deque 的块与缓冲区对齐，块内用指针处理：
+//   reduce / transform_reduce 各块分别归约，再按块的顺序合并到 init 上，结果与线程完成的先后无关
+//   scan 分两遍：第一遍各块分别归约；之后顺序求出每块之前所有元素的和；第二遍各块以这个和为初值分别求前缀和。
+//   输入读两遍，输出写一遍，result 可以等于 first
+//   histogram 每个线程统计一段，使用私有的计数数组，最后把各个线程的计数按桶分段并行累加
+//
+// histogram 的桶数不超过 HISTOGRAM_SPLIT_BINS 时，随机访问的区间上相邻的元素轮流计入 4 组计数，
+// 连续落在同一个桶中的元素不必等待上一次计数写回，最后再把 4 组合并
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "execution.h"
+#include "functional.h"
+#include "iterator.h"
+#include "parallel_algo.h"
+#include "simd.h"
+#include "type_traits.h"
+#include "vector.h"
+
+namespace stl {
+
+// 桶数不超过这个值时使用 4 组计数
+#ifndef HISTOGRAM_SPLIT_BINS
+#define HISTOGRAM_SPLIT_BINS 1024
+#endif
+
+/*****************************************************************************************/
+// accumulate
+// 以 init 为初值，从左到右依次累加区间内的元素，缺省使用 operator+
+/*****************************************************************************************/
+    template<class InputIter, class T>
+    T accumulate(InputIter first, InputIter last, T init) {
+        for (; first != last; ++first) init = init + *first;
+        return init;
+    }
+
+    // 重载版本使用函数对象 binary_op 代替加法
+    template<class InputIter, class T, class BinaryOperation>
+    T accumulate(InputIter first, InputIter last, T init, BinaryOperation binary_op) {
+        for (; first != last; ++first) init = binary_op(init, *first);
+        return init;
+    }
+
+/*****************************************************************************************/
+// reduce
+// 以 init 为初值归约区间内的元素，缺省使用 stl::plus，binary_op 需要满足结合律与交换律
+/*****************************************************************************************/
+    template<class InputIter, class T, class BinaryOperation>
+    T unchecked_reduce(InputIter first, InputIter last, T init, BinaryOperation &binary_op) {
+        for (; first != last; ++first) init = binary_op(init, *first);
+        return init;
+    }
+
+    // 算术类型的指针求和时调用向量化的版本
+    template<class Tp, class T>
+    typename std::enable_if<std::is_same<typename std::remove_const<Tp>::type, T>::value &&
+                            simd_element<T>::value && !std::is_same<T, bool>::value, T>::type
+    unchecked_reduce(Tp *first, Tp *last, T init, stl::plus<T> &) {
+        return stl::simd_reduce_add(static_cast<const T *>(first), static_cast<const T *>(last), init);
+    }
+
+    template<class InputIter, class T, class BinaryOperation>
+    T reduce(InputIter first, InputIter last, T init, BinaryOperation binary_op) {
+        return stl::unchecked_reduce(first, last, init, binary_op);
+    }
+
+    template<class InputIter, class T>
+    T reduce(InputIter first, InputIter last, T init) {
+        return stl::reduce(first, last, init, stl::plus<T>());
+    }
+
+    // 以值初始化的元素为初值
+    template<class InputIter>
+    typename iterator_traits<InputIter>::value_type reduce(InputIter first, InputIter last) {
+        return stl::reduce(first, last, typename iterator_traits<InputIter>::value_type());
+    }
+
+/*****************************************************************************************/
+// transform_reduce
+// 以 init 为初值，用 reduce_op 归约 transform_op(*first1, *first2) 的结果，缺省为点积
+// 一元版本归约 unary_op(*first) 的结果
+/*****************************************************************************************/
+    template<class InputIter1, class InputIter2, class T, class BinaryOperation1, class BinaryOperation2>
+    T unchecked_transform_reduce(InputIter1 first1, InputIter1 last1, InputIter2 first2, T init,
+                                 BinaryOperation1 &reduce_op, BinaryOperation2 &transform_op) {
+        for (; first1 != last1; ++first1, ++first2) init = reduce_op(init, transform_op(*first1, *first2));
+        return init;
+    }
+
+    // 浮点数的指针求点积时调用向量化的版本
+    template<class Tp1, class Tp2, class T>
+    typename std::enable_if<std::is_same<typename std::remove_const<Tp1>::type, T>::value &&
+                            std::is_same<typename std::remove_const<Tp2>::type, T>::value &&
+                            std::is_floating_point<T>::value && simd_element<T>::value, T>::type
+    unchecked_transform_reduce(Tp1 *first1, Tp1 *last1, Tp2 *first2, T init,
+                               stl::plus<T> &, stl::multiplies<T> &) {
+        return stl::simd_dot(static_cast<const T *>(first1), static_cast<const T *>(first2),
+                             static_cast<size_t>(last1 - first1), init);
+    }
+
+    template<class InputIter1, class InputIter2, class T, class BinaryOperation1, class BinaryOperation2>
+    T transform_reduce(InputIter1 first1, InputIter1 last1, InputIter2 first2, T init,
+                       BinaryOperation1 reduce_op, BinaryOperation2 transform_op) {
+        return stl::unchecked_transform_reduce(first1, last1, first2, init, reduce_op, transform_op);
+    }
+
+    template<class InputIter1, class InputIter2, class T>
+    T transform_reduce(InputIter1 first1, InputIter1 last1, InputIter2 first2, T init) {
+        return stl::transform_reduce(first1, last1, first2, init, stl::plus<T>(), stl::multiplies<T>());
+    }
+
+    template<class InputIter, class T, class BinaryOperation, class UnaryOperation>
+    T transform_reduce(InputIter first, InputIter last, T init, BinaryOperation reduce_op, UnaryOperation unary_op) {
+        for (; first != last; ++first) init = reduce_op(init, unary_op(*first));
+        return init;
+    }
+
+/*****************************************************************************************/
+// inclusive_scan
+// 把前缀和写到 result 开始的位置，第 i 个结果为 init 与前 i + 1 个元素的和(没有 init 时只是元素的和)，
+// 返回写入的尾后位置。缺省使用 stl::plus，binary_op 需要满足结合律，result 可以等于 first
+/*****************************************************************************************/
+    template<class InputIter, class OutputIter, class BinaryOperation, class T>
+    OutputIter unchecked_inclusive_scan(InputIter first, InputIter last, OutputIter result,
+                                        BinaryOperation &binary_op, T init) {
+        for (; first != last; ++first, ++result) {
+            init = binary_op(init, *first);
+            *result = init;
+        }
+        return result;
+    }
+
+    // 算术类型的指针求和时调用向量化的版本
+    template<class Tp, class T>
+    typename std::enable_if<std::is_same<typename std::remove_const<Tp>::type, T>::value &&
+                            simd_element<T>::value && !std::is_same<T, bool>::value, T *>::type
+    unchecked_inclusive_scan(Tp *first, Tp *last, T *result, stl::plus<T> &, T init) {
+        return stl::simd_inclusive_scan(static_cast<const T *>(first), static_cast<const T *>(last), result, init);
+    }
+
+    template<class InputIter, class OutputIter, class BinaryOperation, class T>
+    OutputIter inclusive_scan(InputIter first, InputIter last, OutputIter result, BinaryOperation binary_op, T init) {
+        return stl::unchecked_inclusive_scan(first, last, result, binary_op, init);
+    }
+
+    // 没有 init 时，第一个结果就是第一个元素
+    template<class InputIter, class OutputIter, class BinaryOperation>
+    OutputIter inclusive_scan(InputIter first, InputIter last, OutputIter result, BinaryOperation binary_op) {
+        if (first == last) return result;
+        typename iterator_traits<InputIter>::value_type init = *first;
+        *result = init;
+        return stl::unchecked_inclusive_scan(++first, last, ++result, binary_op, init);
+    }
+
+    template<class InputIter, class OutputIter>
+    OutputIter inclusive_scan(InputIter first, InputIter last, OutputIter result) {
+        return stl::inclusive_scan(first, last, result, stl::plus<typename iterator_traits<InputIter>::value_type>());
+    }
+
+/*****************************************************************************************/
+// exclusive_scan
+// 把前缀和写到 result 开始的位置，第 i 个结果为 init 与前 i 个元素的和，返回写入的尾后位置
+// 缺省使用 stl::plus，binary_op 需要满足结合律，result 可以等于 first
+/*****************************************************************************************/
+    template<class InputIter, class OutputIter, class T, class BinaryOperation>
+    OutputIter unchecked_exclusive_scan(InputIter first, InputIter last, OutputIter result, T init,
+                                        BinaryOperation &binary_op) {
+        for (; first != last; ++first, ++result) {
+            // 先读出当前元素，result 等于 first 时写入会覆盖它
+            T next = binary_op(init, *first);
+            *result = init;
+            init = stl::move(next);
+        }
+        return result;
+    }
+
+    // 算术类型的指针求和时调用向量化的版本
+    template<class Tp, class T>
+    typename std::enable_if<std::is_same<typename std::remove_const<Tp>::type, T>::value &&
+                            simd_element<T>::value && !std::is_same<T, bool>::value, T *>::type
+    unchecked_exclusive_scan(Tp *first, Tp *last, T *result, T init, stl::plus<T> &) {
+        return stl::simd_exclusive_scan(static_cast<const T *>(first), static_cast<const T *>(last), result, init);
+    }
+
+    template<class InputIter, class OutputIter, class T, class BinaryOperation>
+    OutputIter exclusive_scan(InputIter first, InputIter last, OutputIter result, T init, BinaryOperation binary_op) {
+        return stl::unchecked_exclusive_scan(first, last, result, init, binary_op);
+    }
+
+    template<class InputIter, class OutputIter, class T>
+    OutputIter exclusive_scan(InputIter first, InputIter last, OutputIter result, T init) {
+        return stl::exclusive_scan(first, last, result, init, stl::plus<T>());
+    }
+
+/*****************************************************************************************/
+// histogram
+// 统计[first, last)中落在各个桶中的元素个数，返回长度为 bins 的计数
+// bin_of(x) 为元素 x 所在的桶，转换为 size_t 后不小于 bins 的元素不计入；不给出 bin_of 时整数元素以自身的值为桶号
+/*****************************************************************************************/
+    // 以元素的值为桶号，负数转换后很大，不会计入
+    template<class T>
+    struct histogram_identity {
+        size_t operator()(const T &x) const { return static_cast<size_t>(x); }
+    };
+
+    // 把计数累加到 counts 上，使用 4 组计数时需要在最后调用 flush
+    template<class BinOp>
+    class histogram_counter {
+    private:
+        // 每组计数为 uint32_t，每计入这么多个元素合并一次，不会溢出
+        static constexpr size_t kFlushSize = size_t(1) << 30;
+
+        size_t *counts_;
+        size_t bins_;
+        BinOp &bin_of_;
+        size_t pending_;        // 4 组计数中尚未合并的元素个数，每组的计数都不超过它
+        bool split_;
+        uint32_t sub_[4 * (HISTOGRAM_SPLIT_BINS + 1)];   // 每组多一个桶，计入范围外的元素，省去判断
+
+    public:
+        histogram_counter(size_t *counts, size_t bins, BinOp &bin_of)
+                : counts_(counts), bins_(bins), bin_of_(bin_of), pending_(0), split_(bins <= HISTOGRAM_SPLIT_BINS) {
+            if (split_) std::memset(sub_, 0, 4 * (bins_ + 1) * sizeof(uint32_t));
+        }
+
+        template<class InputIter>
+        void add(InputIter first, InputIter last) {
+            add_dispatch(first, last, is_random_access_iterator<InputIter>());
+        }
+
+        void flush() {
+            if (!split_ || pending_ == 0) return;
+            const size_t stride = bins_ + 1;
+            for (size_t b = 0; b < bins_; ++b) {
+                counts_[b] += static_cast<size_t>(sub_[b]) + sub_[stride + b] + sub_[2 * stride + b] +
+                              sub_[3 * stride + b];
+            }
+            std::memset(sub_, 0, 4 * stride * sizeof(uint32_t));
+            pending_ = 0;
+        }
+
+    private:
+        size_t bin(size_t b) const noexcept { return b < bins_ ? b : bins_; }
+
+        template<class InputIter>
+        void add_dispatch(InputIter first, InputIter last, m_false_type) {
+            for (; first != last; ++first) {
+                const size_t b = static_cast<size_t>(bin_of_(*first));
+                if (b < bins_) ++counts_[b];
+            }
+        }
+
+        template<class RandomIter>
+        void add_dispatch(RandomIter first, RandomIter last, m_true_type) {
+            if (!split_) {
+                add_dispatch(first, last, m_false_type());
+                return;
+            }
+            const size_t stride = bins_ + 1;
+            uint32_t *const s0 = sub_, *const s1 = sub_ + stride, *const s2 = sub_ + 2 * stride,
+                    *const s3 = sub_ + 3 * stride;
+            while (last - first >= 4) {
+                if (pending_ + 4 > kFlushSize) flush();
+                const size_t len = static_cast<size_t>(last - first) & ~size_t(3);
+                const size_t room = (kFlushSize - pending_) & ~size_t(3);
+                const size_t step = len < room ? len : room;
+                const RandomIter stop = first + static_cast<decltype(last - first)>(step);
+                for (; first != stop; first += 4) {
+                    ++s0[bin(static_cast<size_t>(bin_of_(first[0])))];
+                    ++s1[bin(static_cast<size_t>(bin_of_(first[1])))];
+                    ++s2[bin(static_cast<size_t>(bin_of_(first[2])))];
+                    ++s3[bin(static_cast<size_t>(bin_of_(first[3])))];
+                }
+                pending_ += step;
+            }
+            if (pending_ + 4 > kFlushSize) flush();
+            for (; first != last; ++first, ++pending_) ++s0[bin(static_cast<size_t>(bin_of_(*first)))];
+        }
+    };
+
+    template<class InputIter, class BinOp>
+    stl::vector<size_t> histogram(InputIter first, InputIter last, size_t bins, BinOp bin_of) {
+        stl::vector<size_t> counts(bins, 0);
+        histogram_counter<BinOp> counter(counts.data(), bins, bin_of);
+        counter.add(first, last);
+        counter.flush();
+        return counts;
+    }
+
+    template<class InputIter>
+    stl::vector<size_t> histogram(InputIter first, InputIter last, size_t bins) {
+        typedef typename iterator_traits<InputIter>::value_type value_type;
+        static_assert(std::is_integral<value_type>::value, "histogram without bin_of requires integral elements");
+        return stl::histogram(first, last, bins, histogram_identity<value_type>());
+    }
+
+/*****************************************************************************************/
+// 接受执行策略的版本
+/*****************************************************************************************/
+    // 并行归约：各块的第一个元素由 first_value(lo, offset) 得到初值，其余元素由 fold(lo, hi, offset, acc) 归约，
+    // 最后按块的顺序用 op 合并到 init 上。threads 为实际使用的线程数
+    template<class RandomIter, class T, class BinaryOperation, class First, class Fold>
+    T numeric_parallel_reduce(RandomIter first, size_t n, size_t threads, T init, BinaryOperation &op,
+                              First first_value, Fold fold) {
+        const execution_chunks<RandomIter> chunks(first, n, threads * EXECUTION_CHUNKS_PER_THREAD);
+        const size_t count = chunks.count();
+        stl::vector<T> partial(count, init);
+        stl::vector<unsigned char> seeded(count, 0);
+        stl::parallel_run(count, threads, [&](size_t c) {
+            auto piece = [&](auto lo, auto hi, size_t offset) {
+                if (!seeded[c]) {
+                    partial[c] = first_value(lo, offset);
+                    seeded[c] = 1;
+                    ++lo;
+                    ++offset;
+                }
+                partial[c] = fold(lo, hi, offset, partial[c]);
+                return true;
+            };
+            chunks.for_each_piece(c, piece);
+        });
+        for (size_t c = 0; c < count; ++c) {
+            if (seeded[c]) init = op(init, partial[c]);
+        }
+        return init;
+    }
+
+    /// reduce
+
+    template<class InputIter, class T, class BinaryOperation>
+    T execution_reduce(size_t, InputIter first, InputIter last, T init, BinaryOperation &binary_op, m_false_type) {
+        return stl::unchecked_reduce(first, last, init, binary_op);
+    }
+
+    template<class RandomIter, class T, class BinaryOperation>
+    T execution_reduce(size_t threads, RandomIter first, RandomIter last, T init, BinaryOperation &binary_op,
+                       m_true_type) {
+        const size_t n = static_cast<size_t>(last - first);
+        threads = stl::parallel_thread_count(n, threads);
+        if (threads == 1) return stl::unchecked_reduce(first, last, init, binary_op);
+        return stl::numeric_parallel_reduce(
+                first, n, threads, init, binary_op,
+                [&](auto lo, size_t) { return T(*lo); },
+                [&](auto lo, auto hi, size_t, const T &acc) { return stl::reduce(lo, hi, acc, binary_op); });
+    }
+
+    template<class ExecutionPolicy, class ForwardIter, class T, class BinaryOperation>
+    execution_enable_if<ExecutionPolicy, T>
+    reduce(ExecutionPolicy &&policy, ForwardIter first, ForwardIter last, T init, BinaryOperation binary_op) {
+        return stl::execution_reduce(stl::execution_threads(policy), first, last, init, binary_op,
+                                     execution_random_access<ForwardIter>());
+    }
+
+    template<class ExecutionPolicy, class ForwardIter, class T>
+    execution_enable_if<ExecutionPolicy, T>
+    reduce(ExecutionPolicy &&policy, ForwardIter first, ForwardIter last, T init) {
+        return stl::reduce(policy, first, last, init, stl::plus<T>());
+    }
+
+    template<class ExecutionPolicy, class ForwardIter>
+    execution_enable_if<ExecutionPolicy, typename iterator_traits<ForwardIter>::value_type>
+    reduce(ExecutionPolicy &&policy, ForwardIter first, ForwardIter last) {
+        return stl::reduce(policy, first, last, typename iterator_traits<ForwardIter>::value_type());
+    }
+
+    /// transform_reduce
+
+    template<class InputIter1, class InputIter2, class T, class BinaryOperation1, class BinaryOperation2>
+    T execution_transform_reduce(size_t, InputIter1 first1, InputIter1 last1, InputIter2 first2, T init,
+                                 BinaryOperation1 &reduce_op, BinaryOperation2 &transform_op, m_false_type) {
+        return stl::unchecked_transform_reduce(first1, last1, first2, init, reduce_op, transform_op);
+    }
+
+    template<class RandomIter1, class RandomIter2, class T, class BinaryOperation1, class BinaryOperation2>
+    T execution_transform_reduce(size_t threads, RandomIter1 first1, RandomIter1 last1, RandomIter2 first2, T init,
+                                 BinaryOperation1 &reduce_op, BinaryOperation2 &transform_op, m_true_type) {
+        typedef typename iterator_traits<RandomIter2>::difference_type difference_type;
+        const size_t n = static_cast<size_t>(last1 - first1);
+        threads = stl::parallel_thread_count(n, threads);
+        if (threads == 1) return stl::unchecked_transform_reduce(first1, last1, first2, init, reduce_op, transform_op);
+        return stl::numeric_parallel_reduce(
+                first1, n, threads, init, reduce_op,
+                [&](auto lo, size_t offset) { return T(transform_op(*lo, first2[static_cast<difference_type>(offset)])); },
+                [&](auto lo, auto hi, size_t offset, const T &acc) {
+                    return stl::transform_reduce(lo, hi, first2 + static_cast<difference_type>(offset), acc,
+                                                 reduce_op, transform_op);
+                });
+    }
+
+    template<class ExecutionPolicy, class ForwardIter1, class ForwardIter2, class T,
+            class BinaryOperation1, class BinaryOperation2>
+    execution_enable_if<ExecutionPolicy, T>
+    transform_reduce(ExecutionPolicy &&policy, ForwardIter1 first1, ForwardIter1 last1, ForwardIter2 first2, T init,
+                     BinaryOperation1 reduce_op, BinaryOperation2 transform_op) {
+        return stl::execution_transform_reduce(stl::execution_threads(policy), first1, last1, first2, init,
+                                               reduce_op, transform_op,
+                                               execution_random_access<ForwardIter1, ForwardIter2>());
+    }
+
+    template<class ExecutionPolicy, class ForwardIter1, class ForwardIter2, class T>
+    execution_enable_if<ExecutionPolicy, T>
+    transform_reduce(ExecutionPolicy &&policy, ForwardIter1 first1, ForwardIter1 last1, ForwardIter2 first2, T init) {
+        return stl::transform_reduce(policy, first1, last1, first2, init, stl::plus<T>(), stl::multiplies<T>());
+    }
+
+    // 一元版本
+    template<class InputIter, class T, class BinaryOperation, class UnaryOperation>
+    T execution_transform_reduce(size_t, InputIter first, InputIter last, T init, BinaryOperation &reduce_op,
+                                 UnaryOperation &unary_op, m_false_type) {
+        return stl::transform_reduce(first, last, init, reduce_op, unary_op);
+    }
+
+    template<class RandomIter, class T, class BinaryOperation, class UnaryOperation>
+    T execution_transform_reduce(size_t threads, RandomIter first, RandomIter last, T init,
+                                 BinaryOperation &reduce_op, UnaryOperation &unary_op, m_true_type) {
+        const size_t n = static_cast<size_t>(last - first);
+        threads = stl::parallel_thread_count(n, threads);
+        if (threads == 1) return stl::transform_reduce(first, last, init, reduce_op, unary_op);
+        return stl::numeric_parallel_reduce(
+                first, n, threads, init, reduce_op,
+                [&](auto lo, size_t) { return T(unary_op(*lo)); },
+                [&](auto lo, auto hi, size_t, const T &acc) {
+                    return stl::transform_reduce(lo, hi, acc, reduce_op, unary_op);
+                });
+    }
+
+    template<class ExecutionPolicy, class ForwardIter, class T, class BinaryOperation, class UnaryOperation>
+    execution_enable_if<ExecutionPolicy, T>
+    transform_reduce(ExecutionPolicy &&policy, ForwardIter first, ForwardIter last, T init,
+                     BinaryOperation reduce_op, UnaryOperation unary_op) {
+        return stl::execution_transform_reduce(stl::execution_threads(policy), first, last, init, reduce_op,
+                                               unary_op, execution_random_access<ForwardIter>());
+    }
+
+    /// inclusive_scan / exclusive_scan
+
+    // 两遍的并行前缀和，threads 为实际使用的线程数。has_init 为 false 时只用于 inclusive，第一块没有初值
+    template<bool Inclusive, class RandomIter1, class RandomIter2, class T, class BinaryOperation>
+    RandomIter2 numeric_parallel_scan(RandomIter1 first, size_t n, RandomIter2 result, size_t threads,
+                                      BinaryOperation &binary_op, bool has_init, const T &init) {
+        typedef typename iterator_traits<RandomIter2>::difference_type difference_type;
+        const execution_chunks<RandomIter1> chunks(first, n, threads * EXECUTION_CHUNKS_PER_THREAD);
+        const size_t count = chunks.count();
+
+        // 第一遍：各块的和
+        stl::vector<T> carry(count, init);
+        stl::parallel_run(count, threads, [&](size_t c) {
+            bool seeded = false;
+            auto piece = [&](auto lo, auto hi, size_t) {
+                if (!seeded) {
+                    carry[c] = T(*lo);
+                    seeded = true;
+                    ++lo;
+                }
+                carry[c] = stl::accumulate(lo, hi, carry[c], binary_op);
+                return true;
+            };
+            chunks.for_each_piece(c, piece);
+        });
+        // 每块之前所有元素的和(加上 init)，第一块为 init
+        T sum = init;
+        for (size_t c = 0; c < count; ++c) {
+            T next = c == 0 && !has_init ? carry[c] : binary_op(sum, carry[c]);
+            carry[c] = sum;
+            sum = stl::move(next);
+        }
+
+        // 第二遍：以 carry[c] 为初值求每块的前缀和，块内的下一段以上一段的最后结果为初值
+        stl::parallel_run(count, threads, [&](size_t c) {
+            bool first_piece = true;
+            T acc = carry[c];
+            auto piece = [&](auto lo, auto hi, size_t offset) {
+                const RandomIter2 out = result + static_cast<difference_type>(offset);
+                const auto len = static_cast<difference_type>(hi - lo);
+                if (Inclusive) {
+                    if (c == 0 && first_piece && !has_init) stl::inclusive_scan(lo, hi, out, binary_op);
+                    else stl::inclusive_scan(lo, hi, out, binary_op, acc);
+                    acc = out[len - 1];
+                } else {
+                    // result 可能等于 first，先保存这一段的最后一个元素
+                    T last_value = T(*(hi - 1));
+                    stl::exclusive_scan(lo, hi, out, acc, binary_op);
+                    acc = binary_op(T(out[len - 1]), last_value);
+                }
+                first_piece = false;
+                return true;
+            };
+            chunks.for_each_piece(c, piece);
+        });
+        return result + static_cast<difference_type>(n);
+    }
+
+    template<class InputIter, class OutputIter, class BinaryOperation, class T>
+    OutputIter execution_inclusive_scan(size_t, InputIter first, InputIter last, OutputIter result,
+                                        BinaryOperation &binary_op, bool has_init, const T &init, m_false_type) {
+        return has_init ? stl::inclusive_scan(first, last, result, binary_op, init)
+                        : stl::inclusive_scan(first, last, result, binary_op);
+    }
+
+    template<class RandomIter1, class RandomIter2, class BinaryOperation, class T>
+    RandomIter2 execution_inclusive_scan(size_t threads, RandomIter1 first, RandomIter1 last, RandomIter2 result,
+                                         BinaryOperation &binary_op, bool has_init, const T &init, m_true_type) {
+        const size_t n = static_cast<size_t>(last - first);
+        threads = stl::parallel_thread_count(n, threads);
+        if (threads == 1) {
+            return has_init ? stl::inclusive_scan(first, last, result, binary_op, init)
+                            : stl::inclusive_scan(first, last, result, binary_op);
+        }
+        return stl::numeric_parallel_scan<true>(first, n, result, threads, binary_op, has_init, init);
+    }
+
+    template<class ExecutionPolicy, class ForwardIter1, class ForwardIter2, class BinaryOperation, class T>
+    execution_enable_if<ExecutionPolicy, ForwardIter2>
+    inclusive_scan(ExecutionPolicy &&policy, ForwardIter1 first, ForwardIter1 last, ForwardIter2 result,
+                   BinaryOperation binary_op, T init) {
+        return stl::execution_inclusive_scan(stl::execution_threads(policy), first, last, result, binary_op,
+                                             true, init, execution_random_access<ForwardIter1, ForwardIter2>());
+    }
+
+    template<class ExecutionPolicy, class ForwardIter1, class ForwardIter2, class BinaryOperation>
+    execution_enable_if<ExecutionPolicy, ForwardIter2>
+    inclusive_scan(ExecutionPolicy &&policy, ForwardIter1 first, ForwardIter1 last, ForwardIter2 result,
+                   BinaryOperation binary_op) {
+        if (first == last) return result;
+        // 没有 init 时各块的和为元素类型，init 的值不会被使用
+        const typename iterator_traits<ForwardIter1>::value_type unused = *first;
+        return stl::execution_inclusive_scan(stl::execution_threads(policy), first, last, result, binary_op,
+                                             false, unused, execution_random_access<ForwardIter1, ForwardIter2>());
+    }
+
+    template<class ExecutionPolicy, class ForwardIter1, class ForwardIter2>
+    execution_enable_if<ExecutionPolicy, ForwardIter2>
+    inclusive_scan(ExecutionPolicy &&policy, ForwardIter1 first, ForwardIter1 last, ForwardIter2 result) {
+        return stl::inclusive_scan(policy, first, last, result,
+                                   stl::plus<typename iterator_traits<ForwardIter1>::value_type>());
+    }
+
+    template<class InputIter, class OutputIter, class T, class BinaryOperation>
+    OutputIter execution_exclusive_scan(size_t, InputIter first, InputIter last, OutputIter result, T init,
+                                        BinaryOperation &binary_op, m_false_type) {
+        return stl::unchecked_exclusive_scan(first, last, result, init, binary_op);
+    }
+
+    template<class RandomIter1, class RandomIter2, class T, class BinaryOperation>
+    RandomIter2 execution_exclusive_scan(size_t threads, RandomIter1 first, RandomIter1 last, RandomIter2 result,
+                                         T init, BinaryOperation &binary_op, m_true_type) {
+        const size_t n = static_cast<size_t>(last - first);
+        threads = stl::parallel_thread_count(n, threads);
+        if (threads == 1) return stl::unchecked_exclusive_scan(first, last, result, init, binary_op);
+        return stl::numeric_parallel_scan<false>(first, n, result, threads, binary_op, true, init);
+    }
+
+    template<class ExecutionPolicy, class ForwardIter1, class ForwardIter2, class T, class BinaryOperation>
+    execution_enable_if<ExecutionPolicy, ForwardIter2>
+    exclusive_scan(ExecutionPolicy &&policy, ForwardIter1 first, ForwardIter1 last, ForwardIter2 result, T init,
+                   BinaryOperation binary_op) {
+        return stl::execution_exclusive_scan(stl::execution_threads(policy), first, last, result, init, binary_op,
+                                             execution_random_access<ForwardIter1, ForwardIter2>());
+    }
+
+    template<class ExecutionPolicy, class ForwardIter1, class ForwardIter2, class T>
+    execution_enable_if<ExecutionPolicy, ForwardIter2>
+    exclusive_scan(ExecutionPolicy &&policy, ForwardIter1 first, ForwardIter1 last, ForwardIter2 result, T init) {
+        return stl::exclusive_scan(policy, first, last, result, init, stl::plus<T>());
+    }
+
+    /// histogram
+
+    template<class InputIter, class BinOp>
+    void execution_histogram(size_t, InputIter first, InputIter last, size_t *counts, size_t bins, BinOp &bin_of,
+                             m_false_type) {
+        histogram_counter<BinOp> counter(counts, bins, bin_of);
+        counter.add(first, last);
+        counter.flush();
+    }
+
+    template<class RandomIter, class BinOp>
+    void execution_histogram(size_t threads, RandomIter first, RandomIter last, size_t *counts, size_t bins,
+                             BinOp &bin_of, m_true_type) {
+        const size_t n = static_cast<size_t>(last - first);
+        threads = stl::parallel_thread_count(n, threads);
+        if (threads == 1) {
+            execution_histogram(threads, first, last, counts, bins, bin_of, m_false_type());
+            return;
+        }
+        // 每个线程一段，第 0 段直接计入 counts，其余各段使用私有的计数
+        const execution_chunks<RandomIter> chunks(first, n, threads);
+        const size_t parts = chunks.count();
+        stl::vector<size_t> local((parts - 1) * bins, 0);
+        stl::parallel_run(parts, threads, [&](size_t c) {
+            histogram_counter<BinOp> counter(c == 0 ? counts : local.data() + (c - 1) * bins, bins, bin_of);
+            auto piece = [&](auto lo, auto hi, size_t) {
+                counter.add(lo, hi);
+                return true;
+            };
+            chunks.for_each_piece(c, piece);
+            counter.flush();
+        });
+        // 按桶分段合并
+        const size_t merge_threads = stl::parallel_thread_count(bins * (parts - 1), threads);
+        stl::parallel_run(merge_threads, merge_threads, [&](size_t t) {
+            const size_t lo = bins / merge_threads * t + bins % merge_threads * t / merge_threads;
+            const size_t hi = bins / merge_threads * (t + 1) + bins % merge_threads * (t + 1) / merge_threads;
+            for (size_t c = 1; c < parts; ++c) {
+                const size_t *src = local.data() + (c - 1) * bins;
+                for (size_t b = lo; b < hi; ++b) counts[b] += src[b];
+            }
+        });
+    }
+
+    template<class ExecutionPolicy, class ForwardIter, class BinOp>
+    execution_enable_if<ExecutionPolicy, stl::vector<size_t>>
+    histogram(ExecutionPolicy &&policy, ForwardIter first, ForwardIter last, size_t bins, BinOp bin_of) {
+        stl::vector<size_t> counts(bins, 0);
+        stl::execution_histogram(stl::execution_threads(policy), first, last, counts.data(), bins, bin_of,
+                                 execution_random_access<ForwardIter>());
+        return counts;
+    }
+
+    template<class ExecutionPolicy, class ForwardIter>
+    execution_enable_if<ExecutionPolicy, stl::vector<size_t>>
+    histogram(ExecutionPolicy &&policy, ForwardIter first, ForwardIter last, size_t bins) {
+        typedef typename iterator_traits<ForwardIter>::value_type value_type;
+        static_assert(std::is_integral<value_type>::value, "histogram without bin_of requires integral elements");
+        return stl::histogram(policy, first, last, bins, histogram_identity<value_type>());
+    }
+
+}   // namespace stl
+
+#endif //MYCPPSTL_NUMERIC_H
@@ -0,0 +1,365 @@
+#ifndef MYCPPSTL_PARALLEL_ALGO_H
+#define MYCPPSTL_PARALLEL_ALGO_H
+
+// 这个头文件包含多线程版本的算法，要求随机访问迭代器
+// parallel_merge         : 并行合并两个有序区间到另一段空间
+// parallel_inplace_merge : 并行合并相邻的两个有序区间
+// parallel_sort          : 并行排序
+// parallel_set_union        : 并行计算两个有序区间的并集
+// parallel_set_intersection : 并行计算两个有序区间的交集
+
+// notes:
+//
+// 参数 threads 为使用的线程数(包括调用线程)，为 0 时使用 std::thread::hardware_concurrency()，线程取自全局的线程池(见 thread_pool.h)
+// 每个线程至少分到 PARALLEL_GRAIN_SIZE 个元素，区间较小时会少用线程甚至退化为单线程版本
+//
+// parallel_merge 按输出位置把结果均分成若干段，用二分查找(merge path)确定每段分别从两个序列中取多少个元素，
+// 各段互不依赖，可以同时合并。合并是稳定的
+//
+// parallel_sort 先把区间均分成 threads 段，各自用 stl::sort 排序，再借助 temporary_buffer 两两合并，
+// 合并时在原区间与缓冲区之间来回搬运。缓冲区申请不到足够的空间时，改用旋转实现的原地合并，速度较慢但不需要额外空间
+//
+// parallel_set_union / parallel_set_intersection 同样用 merge path 把两个序列均分成若干段，再把每个分界移到
+// 分界处元素的 lower_bound，相等的元素总在同一段中，各段的结果拼起来与单线程版本完全相同。
+// 每段的输出长度事先不知道：各线程先用 set_intersection_size 统计本段的输出个数(并集为两段长度之和减去交集的大小)，
+// 求前缀和得到各段在 result 中的起点，再分别写到互不重叠的位置
+//
+// 异常保证：
+//   比较操作或元素的拷贝抛出异常时，所有线程结束后在调用线程中重新抛出第一个异常，此时区间处于有效但未指定的状态
+
+#include <cstddef>
+#include <thread>
+
+#include "algo.h"
+#include "memory.h"
+#include "set_algo.h"
+#include "thread_pool.h"
+#include "vector.h"
+
+namespace stl {
+
+// 每个线程至少处理的元素个数，元素太少时开线程得不偿失
+#ifndef PARALLEL_GRAIN_SIZE
+#define PARALLEL_GRAIN_SIZE 16384
+#endif
+
+    // 处理n个元素实际使用的线程数
+    inline size_t parallel_thread_count(size_t n, size_t threads) {
+        if (threads == 0) {
+            threads = std::thread::hardware_concurrency();
+            if (threads == 0) threads = 1;
+        }
+        const size_t most = n / PARALLEL_GRAIN_SIZE;
+        return threads < most ? threads : (most == 0 ? 1 : most);
+    }
+
+    // 用 threads 个线程(包括调用线程)执行 f(0), f(1), ..., f(count - 1)，线程取自 thread_pool::instance()
+    // 任务抛出的第一个异常在所有任务结束后重新抛出；线程不够时由已有的线程完成剩下的任务
+    template<class Func>
+    void parallel_run(size_t count, size_t threads, Func f) {
+        stl::thread_pool::instance().run(count, threads, f);
+    }
+
+    // 把[first, last)复制到 result，各线程分别复制一段
+    template<class RandomIter1, class RandomIter2>
+    void parallel_copy(RandomIter1 first, RandomIter1 last, RandomIter2 result, size_t threads) {
+        const auto n = last - first;
+        threads = parallel_thread_count(static_cast<size_t>(n), threads);
+        stl::parallel_run(threads, threads, [&](size_t t) {
+            const auto lo = static_cast<decltype(n)>(n * t / threads);
+            const auto hi = static_cast<decltype(n)>(n * (t + 1) / threads);
+            stl::copy(first + lo, first + hi, result + lo);
+        });
+    }
+
+/*****************************************************************************************/
+// parallel_merge
+// 将两个有序序列 S1 和 S2 合并到 result 开始的空间，返回一个迭代器指向最后一个元素的下一位置
+/*****************************************************************************************/
+    // merge path：合并结果的前 k 个元素中有多少个来自 S1
+    // 相等的元素 S1 在前，即满足 S1[i-1] <= S2[k-i] 且 S2[k-i-1] < S1[i] 的 i
+    template<class RandomIter1, class RandomIter2, class Distance, class Compared>
+    Distance merge_path(RandomIter1 first1, Distance len1, RandomIter2 first2, Distance len2,
+                        Distance k, Compared comp) {
+        Distance lo = k > len2 ? k - len2 : 0;
+        Distance hi = k < len1 ? k : len1;
+        while (lo < hi) {
+            const Distance mid = lo + (hi - lo) / 2;
+            if (comp(*(first2 + (k - mid - 1)), *(first1 + mid)))
+                hi = mid;
+            else
+                lo = mid + 1;
+        }
+        return lo;
+    }
+
+    template<class RandomIter1, class RandomIter2, class RandomIter3, class Compared>
+    RandomIter3 parallel_merge(RandomIter1 first1, RandomIter1 last1,
+                               RandomIter2 first2, RandomIter2 last2,
+                               RandomIter3 result, Compared comp, size_t threads = 0) {
+        typedef ptrdiff_t Distance;
+        const Distance len1 = last1 - first1;
+        const Distance len2 = last2 - first2;
+        const Distance n = len1 + len2;
+        threads = parallel_thread_count(static_cast<size_t>(n), threads);
+        if (threads <= 1)
+            return stl::merge(first1, last1, first2, last2, result, comp);
+
+        stl::parallel_run(threads, threads, [&](size_t t) {
+            const Distance k0 = n * static_cast<Distance>(t) / static_cast<Distance>(threads);
+            const Distance k1 = n * static_cast<Distance>(t + 1) / static_cast<Distance>(threads);
+            const Distance i0 = stl::merge_path(first1, len1, first2, len2, k0, comp);
+            const Distance i1 = stl::merge_path(first1, len1, first2, len2, k1, comp);
+            stl::merge(first1 + i0, first1 + i1, first2 + (k0 - i0), first2 + (k1 - i1),
+                       result + k0, comp);
+        });
+        return result + n;
+    }
+
+    template<class RandomIter1, class RandomIter2, class RandomIter3>
+    RandomIter3 parallel_merge(RandomIter1 first1, RandomIter1 last1,
+                               RandomIter2 first2, RandomIter2 last2, RandomIter3 result) {
+        typedef typename iterator_traits<RandomIter1>::value_type value_type;
+        return stl::parallel_merge(first1, last1, first2, last2, result, stl::less<value_type>());
+    }
+
+/*****************************************************************************************/
+// parallel_inplace_merge
+// 把[first, middle)和[middle, last)两个相邻的有序序列合并成一个有序序列
+/*****************************************************************************************/
+    // 没有缓冲区时的合并：在较长的一侧取中点，在另一侧二分找到对应位置，
+    // 旋转之后左右两部分互不相干，分别交给不同的线程继续合并
+    template<class RandomIter, class Distance, class Compared>
+    void parallel_merge_without_buffer(RandomIter first, RandomIter middle, RandomIter last,
+                                       Distance len1, Distance len2, Compared comp, size_t threads) {
+        if (len1 == 0 || len2 == 0) return;
+        if (len1 + len2 == 2) {
+            if (comp(*middle, *first)) stl::iter_swap(first, middle);
+            return;
+        }
+        RandomIter cut1, cut2;
+        Distance len11, len22;
+        stl::merge_split(first, middle, last, len1, len2, cut1, cut2, len11, len22, comp);
+        const RandomIter new_middle = stl::rotate(cut1, middle, cut2);
+        if (threads > 1 && static_cast<size_t>(len1 + len2) >= 2 * PARALLEL_GRAIN_SIZE) {
+            const size_t left_threads = threads / 2;
+            stl::parallel_run(2, 2, [&](size_t t) {
+                if (t == 0)
+                    stl::parallel_merge_without_buffer(first, cut1, new_middle, len11, len22, comp,
+                                                       left_threads);
+                else
+                    stl::parallel_merge_without_buffer(new_middle, cut2, last, len1 - len11, len2 - len22,
+                                                       comp, threads - left_threads);
+            });
+        } else {
+            stl::merge_without_buffer(first, cut1, new_middle, len11, len22, comp);
+            stl::merge_without_buffer(new_middle, cut2, last, len1 - len11, len2 - len22, comp);
+        }
+    }
+
+    template<class RandomIter, class Compared>
+    void parallel_inplace_merge(RandomIter first, RandomIter middle, RandomIter last,
+                                Compared comp, size_t threads = 0) {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        typedef ptrdiff_t Distance;
+        const Distance len1 = middle - first;
+        const Distance len2 = last - middle;
+        if (len1 == 0 || len2 == 0 || !comp(*middle, *(middle - 1))) return;
+
+        threads = parallel_thread_count(static_cast<size_t>(len1 + len2), threads);
+        // 整个区间搬到缓冲区，再合并回原区间
+        // 只搬左半部分是不够的：各线程同时写回时，靠后的段可能覆盖靠前的段还没读到的右半部分元素
+        temporary_buffer<RandomIter, value_type> buf(first, last);
+        if (buf.size() == len1 + len2) {
+            stl::parallel_copy(first, last, buf.begin(), threads);
+            stl::parallel_merge(buf.begin(), buf.begin() + len1, buf.begin() + len1, buf.end(),
+                                first, comp, threads);
+        } else {
+            stl::parallel_merge_without_buffer(first, middle, last, len1, len2, comp, threads);
+        }
+    }
+
+    template<class RandomIter>
+    void parallel_inplace_merge(RandomIter first, RandomIter middle, RandomIter last) {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        stl::parallel_inplace_merge(first, middle, last, stl::less<value_type>());
+    }
+
+/*****************************************************************************************/
+// parallel_sort
+// 将[first, last)内的元素以递增的方式排序，不保证稳定
+/*****************************************************************************************/
+    // 一轮合并：把 src 中以 bounds 分隔的有序段两两合并到 dst，段数为奇数时最后一段直接复制
+    template<class RandomIter1, class RandomIter2, class Compared>
+    void parallel_merge_round(RandomIter1 src, RandomIter2 dst, stl::vector<ptrdiff_t> &bounds,
+                              Compared comp, size_t threads) {
+        const size_t runs = bounds.size() - 1;
+        const size_t pairs = runs / 2;
+        const size_t sub_threads = threads / pairs > 0 ? threads / pairs : 1;
+        stl::parallel_run(pairs + runs % 2, threads, [&](size_t p) {
+            if (p == pairs) {
+                stl::copy(src + bounds[runs - 1], src + bounds[runs], dst + bounds[runs - 1]);
+                return;
+            }
+            const ptrdiff_t lo = bounds[2 * p], mid = bounds[2 * p + 1], hi = bounds[2 * p + 2];
+            stl::parallel_merge(src + lo, src + mid, src + mid, src + hi, dst + lo, comp, sub_threads);
+        });
+
+        stl::vector<ptrdiff_t> merged;
+        merged.reserve(pairs + 2);
+        for (size_t i = 0; i < runs; i += 2) merged.push_back(bounds[i]);
+        merged.push_back(bounds[runs]);
+        bounds.swap(merged);
+    }
+
+    template<class RandomIter, class Compared>
+    void parallel_sort(RandomIter first, RandomIter last, Compared comp, size_t threads = 0) {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        const ptrdiff_t n = last - first;
+        threads = parallel_thread_count(static_cast<size_t>(n), threads);
+        if (threads <= 1) {
+            stl::sort(first, last, comp);
+            return;
+        }
+
+        // 每个线程排序一段
+        stl::vector<ptrdiff_t> bounds;
+        bounds.reserve(threads + 1);
+        for (size_t t = 0; t <= threads; ++t)
+            bounds.push_back(n * static_cast<ptrdiff_t>(t) / static_cast<ptrdiff_t>(threads));
+        stl::parallel_run(threads, threads, [&](size_t t) {
+            stl::sort(first + bounds[t], first + bounds[t + 1], comp);
+        });
+
+        temporary_buffer<RandomIter, value_type> buf(first, last);
+        if (buf.size() == n) {
+            bool in_buffer = false;
+            while (bounds.size() > 2) {
+                if (in_buffer)
+                    stl::parallel_merge_round(buf.begin(), first, bounds, comp, threads);
+                else
+                    stl::parallel_merge_round(first, buf.begin(), bounds, comp, threads);
+                in_buffer = !in_buffer;
+            }
+            if (in_buffer)
+                stl::parallel_copy(buf.begin(), buf.end(), first, threads);
+        } else {
+            // 缓冲区不够，原地合并
+            while (bounds.size() > 2) {
+                const size_t runs = bounds.size() - 1;
+                const size_t pairs = runs / 2;
+                const size_t sub_threads = threads / pairs > 0 ? threads / pairs : 1;
+                stl::parallel_run(pairs, threads, [&](size_t p) {
+                    const ptrdiff_t lo = bounds[2 * p], mid = bounds[2 * p + 1], hi = bounds[2 * p + 2];
+                    stl::parallel_merge_without_buffer(first + lo, first + mid, first + hi,
+                                                       mid - lo, hi - mid, comp, sub_threads);
+                });
+                stl::vector<ptrdiff_t> merged;
+                merged.reserve(pairs + 2);
+                for (size_t i = 0; i < runs; i += 2) merged.push_back(bounds[i]);
+                merged.push_back(bounds[runs]);
+                bounds.swap(merged);
+            }
+        }
+    }
+
+    template<class RandomIter>
+    void parallel_sort(RandomIter first, RandomIter last) {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        stl::parallel_sort(first, last, stl::less<value_type>());
+    }
+
+/*****************************************************************************************/
+// parallel_set_union / parallel_set_intersection
+// 与 set_algo.h 中的 set_union / set_intersection 结果相同，返回一个迭代器指向输出结果的尾部
+/*****************************************************************************************/
+    // 把 S1、S2 各分成 parts 段，第 t 段为 [bound1[t], bound1[t + 1]) 与 [bound2[t], bound2[t + 1])
+    // 先按 merge path 均分合并后的位置，再把分界移到两个序列中第一个不小于分界处元素的位置
+    template<class RandomIter1, class RandomIter2, class Compared>
+    void parallel_set_bounds(RandomIter1 first1, ptrdiff_t len1, RandomIter2 first2, ptrdiff_t len2,
+                             size_t parts, Compared comp,
+                             stl::vector<ptrdiff_t> &bound1, stl::vector<ptrdiff_t> &bound2) {
+        const ptrdiff_t n = len1 + len2;
+        bound1.assign(parts + 1, 0);
+        bound2.assign(parts + 1, 0);
+        bound1[parts] = len1;
+        bound2[parts] = len2;
+        for (size_t t = 1; t < parts; ++t) {
+            const ptrdiff_t k = n * static_cast<ptrdiff_t>(t) / static_cast<ptrdiff_t>(parts);
+            const ptrdiff_t i = stl::merge_path(first1, len1, first2, len2, k, comp);
+            const ptrdiff_t j = k - i;
+            // 合并结果的第 k 个元素 v 不小于 S1[0, i) 与 S2[0, j) 中的元素，两个 lower_bound 都落在这两段之内
+            if (j == len2 || (i < len1 && !comp(*(first2 + j), *(first1 + i)))) {
+                bound1[t] = stl::lower_bound(first1, first1 + i, *(first1 + i), comp) - first1;
+                bound2[t] = stl::lower_bound(first2, first2 + j, *(first1 + i), comp) - first2;
+            } else {
+                bound1[t] = stl::lower_bound(first1, first1 + i, *(first2 + j), comp) - first1;
+                bound2[t] = stl::lower_bound(first2, first2 + j, *(first2 + j), comp) - first2;
+            }
+        }
+    }
+
+    template<class RandomIter1, class RandomIter2, class RandomIter3, class Compared>
+    RandomIter3 parallel_set_union(RandomIter1 first1, RandomIter1 last1,
+                                   RandomIter2 first2, RandomIter2 last2,
+                                   RandomIter3 result, Compared comp, size_t threads = 0) {
+        const ptrdiff_t len1 = last1 - first1;
+        const ptrdiff_t len2 = last2 - first2;
+        threads = parallel_thread_count(static_cast<size_t>(len1 + len2), threads);
+        if (threads <= 1)
+            return stl::set_union(first1, last1, first2, last2, result, comp);
+
+        stl::vector<ptrdiff_t> bound1, bound2, offset(threads + 1, 0);
+        stl::parallel_set_bounds(first1, len1, first2, len2, threads, comp, bound1, bound2);
+        stl::parallel_run(threads, threads, [&](size_t t) {
+            const size_t common = stl::set_intersection_size(first1 + bound1[t], first1 + bound1[t + 1],
+                                                             first2 + bound2[t], first2 + bound2[t + 1], comp);
+            offset[t + 1] = (bound1[t + 1] - bound1[t]) + (bound2[t + 1] - bound2[t]) - static_cast<ptrdiff_t>(common);
+        });
+        for (size_t t = 0; t < threads; ++t) offset[t + 1] += offset[t];
+        stl::parallel_run(threads, threads, [&](size_t t) {
+            stl::set_union(first1 + bound1[t], first1 + bound1[t + 1], first2 + bound2[t], first2 + bound2[t + 1],
+                           result + offset[t], comp);
+        });
+        return result + offset[threads];
+    }
+
+    template<class RandomIter1, class RandomIter2, class RandomIter3>
+    RandomIter3 parallel_set_union(RandomIter1 first1, RandomIter1 last1,
+                                   RandomIter2 first2, RandomIter2 last2, RandomIter3 result) {
+        return stl::parallel_set_union(first1, last1, first2, last2, result, stl::transparent_less());
+    }
+
+    template<class RandomIter1, class RandomIter2, class RandomIter3, class Compared>
+    RandomIter3 parallel_set_intersection(RandomIter1 first1, RandomIter1 last1,
+                                          RandomIter2 first2, RandomIter2 last2,
+                                          RandomIter3 result, Compared comp, size_t threads = 0) {
+        const ptrdiff_t len1 = last1 - first1;
+        const ptrdiff_t len2 = last2 - first2;
+        threads = parallel_thread_count(static_cast<size_t>(len1 + len2), threads);
+        if (threads <= 1)
+            return stl::set_intersection(first1, last1, first2, last2, result, comp);
+
+        stl::vector<ptrdiff_t> bound1, bound2, offset(threads + 1, 0);
+        stl::parallel_set_bounds(first1, len1, first2, len2, threads, comp, bound1, bound2);
+        stl::parallel_run(threads, threads, [&](size_t t) {
+            offset[t + 1] = static_cast<ptrdiff_t>(stl::set_intersection_size(
+                    first1 + bound1[t], first1 + bound1[t + 1], first2 + bound2[t], first2 + bound2[t + 1], comp));
+        });
+        for (size_t t = 0; t < threads; ++t) offset[t + 1] += offset[t];
+        stl::parallel_run(threads, threads, [&](size_t t) {
+            stl::set_intersection(first1 + bound1[t], first1 + bound1[t + 1],
+                                  first2 + bound2[t], first2 + bound2[t + 1], result + offset[t], comp);
+        });
+        return result + offset[threads];
+    }
+
+    template<class RandomIter1, class RandomIter2, class RandomIter3>
+    RandomIter3 parallel_set_intersection(RandomIter1 first1, RandomIter1 last1,
+                                          RandomIter2 first2, RandomIter2 last2, RandomIter3 result) {
+        return stl::parallel_set_intersection(first1, last1, first2, last2, result, stl::transparent_less());
+    }
+
+}   // namespace stl
+
+#endif //MYCPPSTL_PARALLEL_ALGO_H
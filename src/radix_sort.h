@@ -0,0 +1,302 @@
+#ifndef MYCPPSTL_RADIX_SORT_H
+#define MYCPPSTL_RADIX_SORT_H
+
+// 这个头文件包含基数排序，要求随机访问迭代器，排序是稳定的
+// lsd_radix_sort : 从最低字节开始排序，适用于定长的键：整数、浮点数
+// msd_radix_sort : 从最高字节(第一个字符)开始排序，适用于变长的键：字符串
+// radix_sort     : 根据键的类型选择上面两者之一
+//
+// 键由 key_fn(元素) 取得，默认为元素本身，例如按记录的某个整数字段排序：
+//   stl::radix_sort(first, last, [](const record &r) { return r.id; });
+
+// notes:
+//
+// lsd_radix_sort
+//   先扫描一遍，统计出每个字节的分布，之后每个字节一趟，在原区间与 temporary_buffer 之间来回搬运
+//   某个字节在所有键中都相同时(例如数值都较小时的高位字节)，这一趟直接跳过
+//   有符号整数把符号位取反，浮点数为负时把所有位取反、为正时只把符号位取反，
+//   变换后按无符号整数比较的结果与原来的大小关系一致(-0.0 排在 +0.0 之前，NaN 按符号排在两端)
+//
+// msd_radix_sort
+//   键需要提供 size() 和 operator[]，例如 std::string。按字符的无符号值比较，与 std::string 的 operator< 一致
+//   用一个显式的栈代替递归，桶中元素较少时改用插入排序
+//
+// 申请不到足够大的缓冲区时，退化为按键比较的 stl::stable_sort，结果仍然是稳定的
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "algo.h"
+#include "functional.h"
+#include "memory.h"
+#include "vector.h"
+
+namespace stl {
+
+    constexpr static size_t kRadixInsertionThreshold = 64;   // 小于该长度使用插入排序
+    constexpr static size_t kRadixBuckets = 256;             // 每个字节的取值个数
+
+/*****************************************************************************************/
+// radix_key_traits
+// 把键变换成无符号整数，变换后的大小关系与原来一致
+/*****************************************************************************************/
+    template<class Key, class = void>
+    struct radix_key_traits {
+    };
+
+    // 无符号整数：不需要变换
+    template<class Key>
+    struct radix_key_traits<Key, typename std::enable_if<
+            std::is_integral<Key>::value && std::is_unsigned<Key>::value>::type> {
+        typedef Key unsigned_type;
+
+        static unsigned_type encode(Key key) noexcept { return key; }
+    };
+
+    // 有符号整数：符号位取反
+    template<class Key>
+    struct radix_key_traits<Key, typename std::enable_if<
+            std::is_integral<Key>::value && std::is_signed<Key>::value>::type> {
+        typedef typename std::make_unsigned<Key>::type unsigned_type;
+
+        static unsigned_type encode(Key key) noexcept {
+            return static_cast<unsigned_type>(key) ^
+                   (static_cast<unsigned_type>(1) << (sizeof(Key) * 8 - 1));
+        }
+    };
+
+    // 浮点数：负数所有位取反，正数符号位取反
+    template<class Key, class Unsigned>
+    struct radix_float_traits {
+        typedef Unsigned unsigned_type;
+
+        static unsigned_type encode(Key key) noexcept {
+            unsigned_type bits;
+            std::memcpy(&bits, &key, sizeof(Key));
+            const unsigned_type sign = static_cast<unsigned_type>(1) << (sizeof(Key) * 8 - 1);
+            return (bits & sign) ? ~bits : (bits | sign);
+        }
+    };
+
+    template<>
+    struct radix_key_traits<float> : public radix_float_traits<float, uint32_t> {
+    };
+
+    template<>
+    struct radix_key_traits<double> : public radix_float_traits<double, uint64_t> {
+    };
+
+    // 按变换后的键比较，用于插入排序和退化时的 stl::stable_sort
+    template<class KeyFn>
+    struct radix_key_less {
+        KeyFn key_fn;
+
+        template<class T>
+        bool operator()(const T &a, const T &b) const {
+            typedef typename std::decay<decltype(key_fn(a))>::type key_type;
+            return radix_key_traits<key_type>::encode(key_fn(a)) <
+                   radix_key_traits<key_type>::encode(key_fn(b));
+        }
+    };
+
+/*****************************************************************************************/
+// lsd_radix_sort
+/*****************************************************************************************/
+    // 按第 shift / 8 个字节把[first, last)分配到 result 中，offsets 为每个桶的起始位置
+    template<class RandomIter1, class RandomIter2, class KeyFn>
+    void radix_scatter(RandomIter1 first, RandomIter1 last, RandomIter2 result,
+                       ptrdiff_t *offsets, size_t shift, KeyFn key_fn) {
+        typedef typename std::decay<decltype(key_fn(*first))>::type key_type;
+        for (; first != last; ++first) {
+            const size_t byte = (radix_key_traits<key_type>::encode(key_fn(*first)) >> shift) & 0xff;
+            *(result + offsets[byte]++) = stl::move(*first);
+        }
+    }
+
+    template<class RandomIter, class KeyFn>
+    void lsd_radix_sort(RandomIter first, RandomIter last, KeyFn key_fn) {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        typedef typename std::decay<decltype(key_fn(*first))>::type key_type;
+        typedef radix_key_traits<key_type> traits;
+        constexpr size_t passes = sizeof(typename traits::unsigned_type);
+
+        const ptrdiff_t n = last - first;
+        if (n < static_cast<ptrdiff_t>(kRadixInsertionThreshold)) {
+            stl::insertion_sort(first, last, radix_key_less<KeyFn>{key_fn});
+            return;
+        }
+        temporary_buffer<RandomIter, value_type> buf(first, last);
+        if (buf.size() != n) {
+            stl::stable_sort(first, last, radix_key_less<KeyFn>{key_fn});
+            return;
+        }
+
+        // 一次扫描统计所有字节的分布
+        ptrdiff_t counts[passes][kRadixBuckets] = {};
+        for (auto it = first; it != last; ++it) {
+            const auto key = traits::encode(key_fn(*it));
+            for (size_t p = 0; p < passes; ++p)
+                ++counts[p][(key >> (p * 8)) & 0xff];
+        }
+
+        const auto first_key = traits::encode(key_fn(*first));
+        bool in_buffer = false;
+        for (size_t p = 0; p < passes; ++p) {
+            // 这个字节在所有键中都相同，不需要这一趟
+            if (counts[p][(first_key >> (p * 8)) & 0xff] == n) continue;
+            ptrdiff_t offsets[kRadixBuckets];
+            ptrdiff_t sum = 0;
+            for (size_t b = 0; b < kRadixBuckets; ++b) {
+                offsets[b] = sum;
+                sum += counts[p][b];
+            }
+            if (in_buffer)
+                stl::radix_scatter(buf.begin(), buf.end(), first, offsets, p * 8, key_fn);
+            else
+                stl::radix_scatter(first, last, buf.begin(), offsets, p * 8, key_fn);
+            in_buffer = !in_buffer;
+        }
+        if (in_buffer)
+            stl::move(buf.begin(), buf.end(), first);
+    }
+
+    template<class RandomIter>
+    void lsd_radix_sort(RandomIter first, RandomIter last) {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        stl::lsd_radix_sort(first, last, stl::identity<value_type>());
+    }
+
+/*****************************************************************************************/
+// msd_radix_sort
+/*****************************************************************************************/
+    // 字符串第 depth 个字符所在的桶，字符串在此之前结束时为 0，否则为字符的无符号值加 1
+    template<class String>
+    size_t radix_char_bucket(const String &s, size_t depth) {
+        return depth < static_cast<size_t>(s.size())
+               ? static_cast<size_t>(static_cast<unsigned char>(s[depth])) + 1 : 0;
+    }
+
+    // 从第 depth 个字符开始按字典序比较，前 depth 个字符已知相同
+    template<class KeyFn>
+    struct radix_suffix_less {
+        KeyFn key_fn;
+        size_t depth;
+
+        template<class T>
+        bool operator()(const T &a, const T &b) const {
+            const auto &ka = key_fn(a);
+            const auto &kb = key_fn(b);
+            const size_t la = static_cast<size_t>(ka.size());
+            const size_t lb = static_cast<size_t>(kb.size());
+            for (size_t i = depth; i < la && i < lb; ++i) {
+                const auto ca = static_cast<unsigned char>(ka[i]);
+                const auto cb = static_cast<unsigned char>(kb[i]);
+                if (ca != cb) return ca < cb;
+            }
+            return la < lb;
+        }
+    };
+
+    // 待排序的一段：[lo, hi)，前 depth 个字符都相同
+    struct radix_task {
+        ptrdiff_t lo;
+        ptrdiff_t hi;
+        size_t depth;
+    };
+
+    template<class RandomIter, class KeyFn>
+    void msd_radix_sort(RandomIter first, RandomIter last, KeyFn key_fn) {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        const ptrdiff_t n = last - first;
+        if (n < static_cast<ptrdiff_t>(kRadixInsertionThreshold)) {
+            stl::insertion_sort(first, last, radix_suffix_less<KeyFn>{key_fn, 0});
+            return;
+        }
+        temporary_buffer<RandomIter, value_type> buf(first, last);
+        if (buf.size() != n) {
+            stl::stable_sort(first, last, radix_suffix_less<KeyFn>{key_fn, 0});
+            return;
+        }
+
+        stl::vector<radix_task> tasks;
+        tasks.push_back(radix_task{0, n, 0});
+        while (!tasks.empty()) {
+            const radix_task task = tasks.back();
+            tasks.pop_back();
+            const RandomIter lo = first + task.lo;
+            const RandomIter hi = first + task.hi;
+            if (task.hi - task.lo < static_cast<ptrdiff_t>(kRadixInsertionThreshold)) {
+                stl::insertion_sort(lo, hi, radix_suffix_less<KeyFn>{key_fn, task.depth});
+                continue;
+            }
+
+            ptrdiff_t counts[kRadixBuckets + 1] = {};
+            for (auto it = lo; it != hi; ++it)
+                ++counts[stl::radix_char_bucket(key_fn(*it), task.depth)];
+
+            // 所有字符串的这个字符都相同，不需要分配，直接比较下一个字符
+            const size_t first_bucket = stl::radix_char_bucket(key_fn(*lo), task.depth);
+            if (counts[first_bucket] == task.hi - task.lo) {
+                if (first_bucket != 0)
+                    tasks.push_back(radix_task{task.lo, task.hi, task.depth + 1});
+                continue;
+            }
+
+            ptrdiff_t offsets[kRadixBuckets + 1];
+            ptrdiff_t sum = 0;
+            for (size_t b = 0; b <= kRadixBuckets; ++b) {
+                offsets[b] = sum;
+                sum += counts[b];
+            }
+            const auto out = buf.begin() + task.lo;
+            for (auto it = lo; it != hi; ++it)
+                *(out + offsets[stl::radix_char_bucket(key_fn(*it), task.depth)]++) = stl::move(*it);
+            stl::move(out, out + (task.hi - task.lo), lo);
+
+            // 已经结束的字符串(桶 0)排在最前面，不需要继续排序
+            ptrdiff_t start = task.lo + counts[0];
+            for (size_t b = 1; b <= kRadixBuckets; ++b) {
+                if (counts[b] > 1)
+                    tasks.push_back(radix_task{start, start + counts[b], task.depth + 1});
+                start += counts[b];
+            }
+        }
+    }
+
+    template<class RandomIter>
+    void msd_radix_sort(RandomIter first, RandomIter last) {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        stl::msd_radix_sort(first, last, stl::identity<value_type>());
+    }
+
+/*****************************************************************************************/
+// radix_sort
+// 键为算术类型时使用 lsd_radix_sort，否则把键当作字符串，使用 msd_radix_sort
+/*****************************************************************************************/
+    template<class RandomIter, class KeyFn>
+    void radix_sort_dispatch(RandomIter first, RandomIter last, KeyFn key_fn, m_true_type) {
+        stl::lsd_radix_sort(first, last, key_fn);
+    }
+
+    template<class RandomIter, class KeyFn>
+    void radix_sort_dispatch(RandomIter first, RandomIter last, KeyFn key_fn, m_false_type) {
+        stl::msd_radix_sort(first, last, key_fn);
+    }
+
+    template<class RandomIter, class KeyFn>
+    void radix_sort(RandomIter first, RandomIter last, KeyFn key_fn) {
+        typedef typename std::decay<decltype(key_fn(*first))>::type key_type;
+        stl::radix_sort_dispatch(first, last, key_fn, m_bool_constant<std::is_arithmetic<key_type>::value>());
+    }
+
+    template<class RandomIter>
+    void radix_sort(RandomIter first, RandomIter last) {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        stl::radix_sort(first, last, stl::identity<value_type>());
+    }
+
+}   // namespace stl
+
+#endif //MYCPPSTL_RADIX_SORT_H
@@ -0,0 +1,222 @@
+#ifndef MYCPPSTL_RANDOM_H
+#define MYCPPSTL_RANDOM_H
+
+// 这个头文件包含快速的伪随机数引擎与有界随机数，供 shuffle / sample 等算法使用
+// splitmix64     : 64 位状态，主要用来把一个种子扩展成其他引擎的状态
+// wyrand         : 64 位状态，每次一次 64x64->128 位乘法，最快
+// xoshiro256pp   : 256 位状态的 xoshiro256++，周期 2^256 - 1，统计性质更好
+// random_bits64  : 从任意 UniformRandomBitGenerator 取得 64 个均匀的随机位
+// bounded_rand   : [0, range) 内均匀的随机数
+// bounded_rand2  : 用一个 64 位随机数生成两个有界随机数
+// random_unit    : (0, 1) 内均匀的随机浮点数
+// default_random_engine() : 当前线程的默认引擎，第一次使用时用 random_device、时间与线程地址播种
+
+// notes:
+//
+// 三个引擎都满足 UniformRandomBitGenerator 的要求(result_type, min(), max(), operator())，
+// 可以直接传给 std::uniform_int_distribution 等标准库设施；它们不是密码学安全的
+//
+// bounded_rand 使用 Lemire 的 nearly divisionless 方法：取 64 位随机数 x，x * range 的高 64 位就是结果，
+// 只有低 64 位小于 range 时才需要一次取模来判断是否落在多余的部分并重取，range 远小于 2^64 时几乎从不发生。
+// 与 rand() % n 相比既没有偏差，通常也没有除法
+//
+// 引擎的 result_type 不是 64 位，或者取值范围不是 2 的幂时，random_bits64 拼接多次输出，范围不是 2 的幂时丢弃多余的值
+
+#include <cstddef>
+#include <cstdint>
+#include <chrono>
+#include <limits>
+#include <random>
+#include <type_traits>
+
+#include "type_traits.h"
+
+namespace stl {
+
+    // 64x64->128 位无符号乘法，返回高 64 位，低 64 位写入 lo
+    inline uint64_t random_mul128(uint64_t x, uint64_t y, uint64_t &lo) noexcept {
+#ifdef __SIZEOF_INT128__
+        const unsigned __int128 m = static_cast<unsigned __int128>(x) * y;
+        lo = static_cast<uint64_t>(m);
+        return static_cast<uint64_t>(m >> 64);
+#else
+        const uint64_t x0 = x & 0xffffffffULL, x1 = x >> 32;
+        const uint64_t y0 = y & 0xffffffffULL, y1 = y >> 32;
+        const uint64_t p00 = x0 * y0, p01 = x0 * y1, p10 = x1 * y0, p11 = x1 * y1;
+        const uint64_t mid = (p00 >> 32) + (p01 & 0xffffffffULL) + (p10 & 0xffffffffULL);
+        lo = (mid << 32) | (p00 & 0xffffffffULL);
+        return p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+#endif
+    }
+
+/*****************************************************************************************/
+// 随机数引擎
+/*****************************************************************************************/
+    class splitmix64 {
+    public:
+        typedef uint64_t result_type;
+
+        explicit splitmix64(uint64_t seed = 0) noexcept: state_(seed) {}
+
+        static constexpr result_type min() noexcept { return 0; }
+
+        static constexpr result_type max() noexcept { return std::numeric_limits<uint64_t>::max(); }
+
+        result_type operator()() noexcept {
+            uint64_t z = (state_ += 0x9e3779b97f4a7c15ULL);
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            return z ^ (z >> 31);
+        }
+
+    private:
+        uint64_t state_;
+    };
+
+    class wyrand {
+    public:
+        typedef uint64_t result_type;
+
+        explicit wyrand(uint64_t seed = 0) noexcept: state_(seed) {}
+
+        static constexpr result_type min() noexcept { return 0; }
+
+        static constexpr result_type max() noexcept { return std::numeric_limits<uint64_t>::max(); }
+
+        result_type operator()() noexcept {
+            state_ += 0xa0761d6478bd642fULL;
+            uint64_t lo;
+            const uint64_t hi = random_mul128(state_, state_ ^ 0xe7037ed1a0b428dbULL, lo);
+            return hi ^ lo;
+        }
+
+    private:
+        uint64_t state_;
+    };
+
+    class xoshiro256pp {
+    public:
+        typedef uint64_t result_type;
+
+        // 用 splitmix64 把种子扩展成 256 位状态，保证状态不全为 0
+        explicit xoshiro256pp(uint64_t seed = 0) noexcept {
+            splitmix64 sm(seed);
+            for (auto &s : s_) s = sm();
+        }
+
+        static constexpr result_type min() noexcept { return 0; }
+
+        static constexpr result_type max() noexcept { return std::numeric_limits<uint64_t>::max(); }
+
+        result_type operator()() noexcept {
+            const uint64_t result = rotl(s_[0] + s_[3], 23) + s_[0];
+            const uint64_t t = s_[1] << 17;
+            s_[2] ^= s_[0];
+            s_[3] ^= s_[1];
+            s_[1] ^= s_[2];
+            s_[0] ^= s_[3];
+            s_[2] ^= t;
+            s_[3] = rotl(s_[3], 45);
+            return result;
+        }
+
+    private:
+        static uint64_t rotl(uint64_t x, int k) noexcept { return (x << k) | (x >> (64 - k)); }
+
+        uint64_t s_[4];
+    };
+
+/*****************************************************************************************/
+// random_bits64 / bounded_rand / random_unit
+/*****************************************************************************************/
+    // 引擎的输出恰好是 64 位均匀随机数
+    template<class URBG>
+    uint64_t random_bits64_dispatch(URBG &g, m_true_type) {
+        return static_cast<uint64_t>(g() - URBG::min());
+    }
+
+    // 拼接多次输出，每次取 2 的幂个值中的 bits 位，超出的值丢弃重取
+    template<class URBG>
+    uint64_t random_bits64_dispatch(URBG &g, m_false_type) {
+        // 每次取 floor(log2(max - min + 1)) 位，max - min + 1 不会溢出
+        const uint64_t span = static_cast<uint64_t>(URBG::max() - URBG::min()) + 1;
+        int bits = 0;
+        while ((span >> (bits + 1)) != 0) ++bits;
+        const uint64_t mask = (uint64_t(1) << bits) - 1;
+        uint64_t result = 0;
+        for (int got = 0; got < 64; got += bits) {
+            uint64_t x;
+            do {
+                x = static_cast<uint64_t>(g() - URBG::min());
+            } while (x > mask);
+            result = (result << bits) | x;
+        }
+        return result;
+    }
+
+    template<class URBG>
+    uint64_t random_bits64(URBG &g) {
+        typedef typename std::remove_reference<URBG>::type engine;
+        return stl::random_bits64_dispatch(
+                g, m_bool_constant<static_cast<uint64_t>(engine::max() - engine::min()) ==
+                                   std::numeric_limits<uint64_t>::max()>());
+    }
+
+    // [0, range) 内均匀的随机数，range 不能为 0
+    template<class URBG>
+    uint64_t bounded_rand(URBG &g, uint64_t range) {
+        uint64_t lo;
+        uint64_t hi = random_mul128(stl::random_bits64(g), range, lo);
+        if (lo < range) {
+            // 2^64 % range，低 64 位小于它的结果落在多余的部分
+            const uint64_t threshold = (0 - range) % range;
+            while (lo < threshold) hi = random_mul128(stl::random_bits64(g), range, lo);
+        }
+        return hi;
+    }
+
+    // 一次生成两个分别在 [0, range1) 与 [0, range2) 内均匀且相互独立的随机数，要求 range1 * range2 小于 2^64。
+    // x * range1 * range2 的高 64 位按 range2 进制拆成两位就是这两个数，拆分可以由两次乘法完成，
+    // 重取的条件与 bounded_rand(g, range1 * range2) 相同
+    template<class URBG>
+    void bounded_rand2(URBG &g, uint64_t range1, uint64_t range2, uint64_t &r1, uint64_t &r2) {
+        const uint64_t product = range1 * range2;
+        uint64_t lo1, lo2;
+        r1 = random_mul128(stl::random_bits64(g), range1, lo1);
+        r2 = random_mul128(lo1, range2, lo2);
+        if (lo2 < product) {
+            const uint64_t threshold = (0 - product) % product;
+            while (lo2 < threshold) {
+                r1 = random_mul128(stl::random_bits64(g), range1, lo1);
+                r2 = random_mul128(lo1, range2, lo2);
+            }
+        }
+    }
+
+    // (0, 1) 内均匀的随机 double，53 位精度，不会取到 0
+    template<class URBG>
+    double random_unit(URBG &g) {
+        return (static_cast<double>(stl::random_bits64(g) >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+    }
+
+    // 当前线程的默认引擎，每个线程各有一个，不需要加锁
+    inline wyrand &default_random_engine() {
+        thread_local wyrand engine([] {
+            uint64_t seed = static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+            int local;
+            seed ^= static_cast<uint64_t>(reinterpret_cast<uintptr_t>(&local));
+            try {
+                std::random_device rd;
+                seed ^= (static_cast<uint64_t>(rd()) << 32) ^ rd();
+            }
+            catch (...) {
+                // 没有可用的随机设备时只用时间与地址
+            }
+            return splitmix64(seed)();
+        }());
+        return engine;
+    }
+
+}   // namespace stl
+
+#endif //MYCPPSTL_RANDOM_H
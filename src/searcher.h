@@ -0,0 +1,245 @@
+#ifndef MYCPPSTL_SEARCHER_H
+#define MYCPPSTL_SEARCHER_H
+
+// 这个头文件包含子序列查找器，构造时对模式做预处理，之后可以在多段文本中查找，配合 stl::search(first, last, searcher) 使用
+// default_searcher              : 逐个位置比较
+// boyer_moore_horspool_searcher : Boyer-Moore-Horspool 算法，适合字母表较大、模式较长的情况
+// two_way_searcher              : Two-Way 算法，最坏情况也是线性时间，只需要常数的额外空间
+// simd_searcher                 : 向量化的首尾字节过滤，只用于单字节的整数类型
+//
+// 查找器的 operator()(first, last) 返回一对迭代器，表示第一个匹配的区间，没有找到时两者都为 last。
+// 查找器只保存模式的迭代器，模式需要在查找器使用期间保持有效
+
+// notes:
+//
+// boyer_moore_horspool_searcher
+//   窗口与模式对齐后先比较窗口的最后一个元素，之后窗口移动的距离由这个元素在模式中(除最后一个外)最靠后的出现位置决定，
+//   没有出现时移动 m。单字节的整数类型直接用字节值作为跳转表的下标；其他类型用哈希值的低 8 位，
+//   哈希值相同的元素共用一项，取其中最小的距离，这样只会少跳，不会漏掉匹配
+//
+// two_way_searcher
+//   Crochemore-Perrin 算法：把模式在临界位置分为左右两部分，先从左往右比较右半部分，失配时按已匹配的长度移动；
+//   右半部分匹配后再从右往左比较左半部分，失配时按模式的周期移动。临界位置由两种顺序下的最大后缀得出，
+//   需要元素支持 operator< 与 operator==。模式具有周期性时记住已经匹配的前缀，避免重复比较
+//
+// simd_searcher
+//   见 simd.h 中的 simd_search，模式只有一个字节时使用 memchr
+
+#include <cstddef>
+
+#include "algo.h"
+#include "functional.h"
+#include "simd.h"
+#include "utils.h"
+
+namespace stl {
+
+/*****************************************************************************************/
+// default_searcher
+/*****************************************************************************************/
+    template<class ForwardIter, class Compared = stl::transparent_equal>
+    class default_searcher {
+    private:
+        ForwardIter pfirst_;
+        ForwardIter plast_;
+        Compared comp_;
+
+    public:
+        default_searcher(ForwardIter pfirst, ForwardIter plast, Compared comp = Compared())
+                : pfirst_(pfirst), plast_(plast), comp_(comp) {}
+
+        template<class ForwardIter2>
+        stl::pair<ForwardIter2, ForwardIter2> operator()(ForwardIter2 first, ForwardIter2 last) const {
+            ForwardIter2 pos = stl::search(first, last, pfirst_, plast_, comp_);
+            if (pos == last) {
+                // 模式为空时匹配开头的空区间
+                return pfirst_ == plast_ ? stl::make_pair(first, first) : stl::make_pair(last, last);
+            }
+            ForwardIter2 end = pos;
+            stl::advance(end, stl::distance(pfirst_, plast_));
+            return stl::make_pair(pos, end);
+        }
+    };
+
+/*****************************************************************************************/
+// boyer_moore_horspool_searcher
+/*****************************************************************************************/
+    template<class RandomIter, class Hash = stl::hash<typename iterator_traits<RandomIter>::value_type>>
+    class boyer_moore_horspool_searcher {
+    public:
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        typedef typename iterator_traits<RandomIter>::difference_type difference_type;
+
+    private:
+        RandomIter pfirst_;
+        difference_type m_;
+        difference_type shift_[256];
+        Hash hash_;
+
+    public:
+        boyer_moore_horspool_searcher(RandomIter pfirst, RandomIter plast, Hash hash = Hash())
+                : pfirst_(pfirst), m_(plast - pfirst), hash_(hash) {
+            for (size_t c = 0; c < 256; ++c) shift_[c] = m_;
+            for (difference_type i = 0; i + 1 < m_; ++i) shift_[bucket(pfirst_[i])] = m_ - 1 - i;
+        }
+
+        template<class RandomIter2>
+        stl::pair<RandomIter2, RandomIter2> operator()(RandomIter2 first, RandomIter2 last) const {
+            if (m_ == 0) return stl::make_pair(first, first);
+            const auto n = last - first;
+            if (n < m_) return stl::make_pair(last, last);
+            const value_type &back = pfirst_[m_ - 1];
+            for (decltype(last - first) pos = 0; pos <= n - m_;) {
+                const auto &c = first[pos + m_ - 1];
+                if (c == back) {
+                    difference_type j = 0;
+                    while (j + 1 < m_ && first[pos + j] == pfirst_[j]) ++j;
+                    if (j + 1 == m_) return stl::make_pair(first + pos, first + pos + m_);
+                }
+                pos += shift_[bucket(c)];
+            }
+            return stl::make_pair(last, last);
+        }
+
+    private:
+        template<class U>
+        size_t bucket(const U &c) const {
+            return bucket_dispatch(c, m_bool_constant<std::is_integral<U>::value && sizeof(U) == 1>());
+        }
+
+        template<class U>
+        size_t bucket_dispatch(const U &c, m_true_type) const {
+            return static_cast<unsigned char>(c);
+        }
+
+        template<class U>
+        size_t bucket_dispatch(const U &c, m_false_type) const {
+            return hash_(c) & 255;
+        }
+    };
+
+/*****************************************************************************************/
+// two_way_searcher
+/*****************************************************************************************/
+    template<class RandomIter>
+    class two_way_searcher {
+    public:
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+
+    private:
+        RandomIter pfirst_;
+        size_t m_;
+        size_t suffix_;     // 临界位置，右半部分为[suffix, m)
+        size_t period_;     // 模式具有周期性时为模式的周期，否则为失配时移动的距离
+        bool periodic_;
+
+    public:
+        two_way_searcher(RandomIter pfirst, RandomIter plast)
+                : pfirst_(pfirst), m_(static_cast<size_t>(plast - pfirst)), suffix_(0), period_(1), periodic_(false) {
+            if (m_ == 0) return;
+            if (m_ < 3) {
+                // 模式只有一两个元素时，临界位置取最后一个元素之前
+                suffix_ = m_ - 1;
+                period_ = 1;
+            } else {
+                size_t period1, period2;
+                const size_t s1 = max_suffix(false, period1);
+                const size_t s2 = max_suffix(true, period2);
+                // 取两个最大后缀中较靠后的一个作为临界位置
+                if (s2 + 1 < s1 + 1) {
+                    suffix_ = s1 + 1;
+                    period_ = period1;
+                } else {
+                    suffix_ = s2 + 1;
+                    period_ = period2;
+                }
+            }
+            // 左半部分在右移一个周期后仍然匹配，说明 period_ 是整个模式的周期
+            periodic_ = suffix_ + period_ <= m_;
+            for (size_t i = 0; periodic_ && i < suffix_; ++i) {
+                periodic_ = pfirst_[i] == pfirst_[i + period_];
+            }
+            if (!periodic_) period_ = (suffix_ > m_ - suffix_ ? suffix_ : m_ - suffix_) + 1;
+        }
+
+        template<class RandomIter2>
+        stl::pair<RandomIter2, RandomIter2> operator()(RandomIter2 first, RandomIter2 last) const {
+            if (m_ == 0) return stl::make_pair(first, first);
+            const size_t n = static_cast<size_t>(last - first);
+            if (n < m_) return stl::make_pair(last, last);
+            const RandomIter p = pfirst_;
+            size_t memory = 0;      // 当前窗口开头已知匹配的元素个数，只在模式具有周期性时使用
+            for (size_t j = 0; j <= n - m_;) {
+                // 从左往右比较右半部分
+                size_t i = suffix_ > memory ? suffix_ : memory;
+                while (i < m_ && p[i] == first[j + i]) ++i;
+                if (i < m_) {
+                    j += i - suffix_ + 1;
+                    memory = 0;
+                    continue;
+                }
+                // 从右往左比较左半部分，i 为剩下未比较的元素个数
+                const size_t low = periodic_ ? memory : 0;
+                i = suffix_;
+                while (i > low && p[i - 1] == first[j + i - 1]) --i;
+                if (i <= low) return stl::make_pair(first + j, first + j + m_);
+                j += period_;
+                memory = periodic_ ? m_ - period_ : 0;
+            }
+            return stl::make_pair(last, last);
+        }
+
+    private:
+        // 模式在某种顺序下的最大后缀的起点减一(可能为 -1，即 size_t 的最大值)，period 为该后缀的周期
+        // reverse 为 false 时按 operator< 的顺序，为 true 时按相反的顺序
+        size_t max_suffix(bool reverse, size_t &period) const {
+            size_t ms = static_cast<size_t>(-1);
+            size_t j = 0, k = 1, p = 1;
+            while (j + k < m_) {
+                const value_type &a = pfirst_[j + k];
+                const value_type &b = pfirst_[ms + k];
+                if (reverse ? b < a : a < b) {
+                    j += k;
+                    k = 1;
+                    p = j - ms;
+                } else if (a == b) {
+                    if (k != p) {
+                        ++k;
+                    } else {
+                        j += p;
+                        k = 1;
+                    }
+                } else {
+                    ms = j++;
+                    k = p = 1;
+                }
+            }
+            period = p;
+            return ms;
+        }
+    };
+
+/*****************************************************************************************/
+// simd_searcher
+/*****************************************************************************************/
+    template<class T>
+    class simd_searcher {
+        static_assert(std::is_integral<T>::value && sizeof(T) == 1, "simd_searcher requires a byte type");
+
+    private:
+        const T *pfirst_;
+        const T *plast_;
+
+    public:
+        simd_searcher(const T *pfirst, const T *plast) : pfirst_(pfirst), plast_(plast) {}
+
+        stl::pair<const T *, const T *> operator()(const T *first, const T *last) const {
+            const T *pos = stl::simd_search(first, last, pfirst_, plast_);
+            if (pos == last && pfirst_ != plast_) return stl::make_pair(last, last);
+            return stl::make_pair(pos, pos + (plast_ - pfirst_));
+        }
+    };
+
+}   // namespace stl
+
+#endif //MYCPPSTL_SEARCHER_H
@@ -7,13 +7,36 @@
 
 
 // 这个头文件包含 set 的四种算法: union, intersection, difference, symmetric_difference
+// 以及只统计交集大小、不写出结果的 set_intersection_size
 // 所有函数都要求序列有序
 
+// notes:
+//
+// set_intersection / set_intersection_size 在两个区间都是随机访问迭代器、且一个区间的长度至少是另一个的
+// SET_GALLOP_RATIO 倍时，依次取较短区间中的元素，在较长区间中从当前位置起按 1、2、4、8 ... 的步长向后试探，
+// 越过目标后在最后一步内二分查找(galloping)，比较次数为 O(m log(n / m))，m 为较短区间的长度。
+// 长度相近时逐个合并更快
+//
+// 4 字节整数的指针区间(使用 operator< 的版本)长度相差不到 SET_SIMD_GALLOP_RATIO 倍时分块比较，见 simd.h 中的 simd_set_intersection
+//
+// 所有版本在有重复元素时的结果都与逐个合并相同：交集中每个值出现的次数是它在两个区间中出现次数的较小值，输出的是第一个区间中的元素
+
 #include "algobase.h"
+#include "functional.h"
 #include "iterator.h"
 
 namespace stl {
 
+// 一个区间的长度至少是另一个的这么多倍时，set_intersection 改用 galloping
+#ifndef SET_GALLOP_RATIO
+#define SET_GALLOP_RATIO 32
+#endif
+
+// 分块比较比逐个合并快得多，4 字节整数的指针区间在长度相差更多时才改用 galloping
+#ifndef SET_SIMD_GALLOP_RATIO
+#define SET_SIMD_GALLOP_RATIO 128
+#endif
+
 /*****************************************************************************************/
 // set_union
 // 计算 S1∪S2 的结果并保存到 result 中，返回一个迭代器指向输出结果的尾部
@@ -53,41 +76,179 @@ namespace stl {
             }
             ++result;
         }
-        stl::copy(first2, last2, stl::copy(first1, last1, result));
+        return stl::copy(first2, last2, stl::copy(first1, last1, result));
     }
 
 /*****************************************************************************************/
 // set_intersection
 // 计算 S1∩S2 的结果并保存到 result 中，返回一个迭代器指向输出结果的尾部
 /*****************************************************************************************/
-    template<class InputIter1, class InputIter2, class OutputIter>
-    OutputIter set_intersection(InputIter1 first1, InputIter1 last1,
+    // 交集中的元素依次写到 result
+    template<class OutputIter>
+    struct set_output_sink {
+        OutputIter result;
+
+        template<class Iter>
+        void operator()(const Iter &it) {
+            *result = *it;
+            ++result;
+        }
+    };
+
+    // 只统计交集中元素的个数
+    struct set_count_sink {
+        size_t count;
+
+        template<class Iter>
+        void operator()(const Iter &) { ++count; }
+    };
+
+    // 在有序区间[first, last)中找到第一个不小于 value 的位置，从 first 开始按 1、2、4 ... 的步长试探，再在最后一步内二分查找
+    // 结果与 first 相距 d 时只需要 O(log d) 次比较
+    template<class RandomIter, class T, class Compared>
+    RandomIter set_gallop(RandomIter first, RandomIter last, const T &value, Compared &comp) {
+        if (first == last || !comp(*first, value)) return first;
+        typedef typename iterator_traits<RandomIter>::difference_type difference_type;
+        // 循环中始终有 comp(*first, value) 为 true
+        difference_type step = 1;
+        while (step < last - first && comp(*(first + step), value)) {
+            first += step;
+            step <<= 1;
+        }
+        RandomIter hi = step < last - first ? first + step : last;
+        ++first;
+        while (first < hi) {
+            const RandomIter mid = first + (hi - first) / 2;
+            if (comp(*mid, value)) first = mid + 1;
+            else hi = mid;
+        }
+        return first;
+    }
+
+    // 逐个合并
+    template<class InputIter1, class InputIter2, class Sink, class Compared>
+    void set_intersection_merge(InputIter1 first1, InputIter1 last1,
                                 InputIter2 first2, InputIter2 last2,
-                                OutputIter result) {
+                                Sink &sink, Compared &comp) {
         while (first1 != last1 && first2 != last2) {
-            if (*first1 < *first2) ++first1;
-            else if (*first1 > *first2) ++first2;
+            if (comp(*first1, *first2)) ++first1;
+            else if (comp(*first2, *first1)) ++first2;
             else {
-                *result = *first1;
-                ++first1, ++first2, ++result;
+                sink(first1);
+                ++first1, ++first2;
+            }
+        }
+    }
+
+    // 第一个区间较短：逐个取它的元素，在第二个区间中 galloping
+    template<class RandomIter1, class RandomIter2, class Sink, class Compared>
+    void set_intersection_gallop2(RandomIter1 first1, RandomIter1 last1,
+                                  RandomIter2 first2, RandomIter2 last2,
+                                  Sink &sink, Compared &comp) {
+        for (; first1 != last1; ++first1) {
+            first2 = stl::set_gallop(first2, last2, *first1, comp);
+            if (first2 == last2) return;
+            if (!comp(*first1, *first2)) {
+                sink(first1);
+                ++first2;
+            }
+        }
+    }
+
+    // 第二个区间较短：逐个取它的元素，在第一个区间中 galloping
+    template<class RandomIter1, class RandomIter2, class Sink, class Compared>
+    void set_intersection_gallop1(RandomIter1 first1, RandomIter1 last1,
+                                  RandomIter2 first2, RandomIter2 last2,
+                                  Sink &sink, Compared &comp) {
+        for (; first2 != last2; ++first2) {
+            first1 = stl::set_gallop(first1, last1, *first2, comp);
+            if (first1 == last1) return;
+            if (!comp(*first2, *first1)) {
+                sink(first1);
+                ++first1;
             }
         }
-        return result;
+    }
+
+    template<class InputIter1, class InputIter2, class Sink, class Compared>
+    void set_intersection_dispatch(InputIter1 first1, InputIter1 last1,
+                                   InputIter2 first2, InputIter2 last2,
+                                   Sink &sink, Compared &comp,
+                                   input_iterator_tag, input_iterator_tag) {
+        stl::set_intersection_merge(first1, last1, first2, last2, sink, comp);
+    }
+
+    template<class RandomIter1, class RandomIter2, class Sink, class Compared>
+    void set_intersection_dispatch(RandomIter1 first1, RandomIter1 last1,
+                                   RandomIter2 first2, RandomIter2 last2,
+                                   Sink &sink, Compared &comp,
+                                   random_access_iterator_tag, random_access_iterator_tag) {
+        const size_t n1 = static_cast<size_t>(last1 - first1), n2 = static_cast<size_t>(last2 - first2);
+        if (n1 / SET_GALLOP_RATIO >= n2) stl::set_intersection_gallop1(first1, last1, first2, last2, sink, comp);
+        else if (n2 / SET_GALLOP_RATIO >= n1) stl::set_intersection_gallop2(first1, last1, first2, last2, sink, comp);
+        else stl::set_intersection_merge(first1, last1, first2, last2, sink, comp);
+    }
+
+    template<class InputIter1, class InputIter2, class Sink, class Compared>
+    void set_intersection_aux(InputIter1 first1, InputIter1 last1,
+                              InputIter2 first2, InputIter2 last2,
+                              Sink &sink, Compared &comp) {
+        stl::set_intersection_dispatch(first1, last1, first2, last2, sink, comp,
+                                       stl::iterator_category(first1), stl::iterator_category(first2));
+    }
+
+    // 4 字节整数的指针区间：长度相近时分块比较，见 simd.h 中的 simd_set_intersection
+    template<class Tp, class Up, class Sink>
+    typename std::enable_if<
+            std::is_integral<typename std::remove_const<Tp>::type>::value && sizeof(Tp) == 4 &&
+            std::is_same<typename std::remove_const<Tp>::type, typename std::remove_const<Up>::type>::value,
+            void>::type
+    set_intersection_aux(Tp *first1, Tp *last1, Up *first2, Up *last2, Sink &sink, transparent_less &comp) {
+        typedef typename std::remove_const<Tp>::type value_type;
+        const size_t n1 = static_cast<size_t>(last1 - first1), n2 = static_cast<size_t>(last2 - first2);
+        if (n1 / SET_SIMD_GALLOP_RATIO >= n2) stl::set_intersection_gallop1(first1, last1, first2, last2, sink, comp);
+        else if (n2 / SET_SIMD_GALLOP_RATIO >= n1) stl::set_intersection_gallop2(first1, last1, first2, last2, sink, comp);
+        else stl::simd_set_intersection<value_type>(first1, last1, first2, last2, sink);
+    }
+
+    template<class InputIter1, class InputIter2, class OutputIter>
+    OutputIter set_intersection(InputIter1 first1, InputIter1 last1,
+                                InputIter2 first2, InputIter2 last2,
+                                OutputIter result) {
+        set_output_sink<OutputIter> sink{result};
+        transparent_less comp;
+        stl::set_intersection_aux(first1, last1, first2, last2, sink, comp);
+        return sink.result;
     }
 
     template<class InputIter1, class InputIter2, class OutputIter, class Compare>
     OutputIter set_intersection(InputIter1 first1, InputIter1 last1,
                                 InputIter2 first2, InputIter2 last2,
                                 OutputIter result, Compare comp) {
-        while (first1 != last1 && first2 != last2) {
-            if (comp(*first1, *first2)) ++first1;
-            else if (comp(*first2, *first1)) ++first2;
-            else {
-                *result = *first1;
-                ++first1, ++first2, ++result;
-            }
-            return result;
-        }
+        set_output_sink<OutputIter> sink{result};
+        stl::set_intersection_aux(first1, last1, first2, last2, sink, comp);
+        return sink.result;
+    }
+
+/*****************************************************************************************/
+// set_intersection_size
+// 返回 S1∩S2 中元素的个数，不写出结果
+/*****************************************************************************************/
+    template<class InputIter1, class InputIter2>
+    size_t set_intersection_size(InputIter1 first1, InputIter1 last1,
+                                 InputIter2 first2, InputIter2 last2) {
+        set_count_sink sink{0};
+        transparent_less comp;
+        stl::set_intersection_aux(first1, last1, first2, last2, sink, comp);
+        return sink.count;
+    }
+
+    template<class InputIter1, class InputIter2, class Compare>
+    size_t set_intersection_size(InputIter1 first1, InputIter1 last1,
+                                 InputIter2 first2, InputIter2 last2, Compare comp) {
+        set_count_sink sink{0};
+        stl::set_intersection_aux(first1, last1, first2, last2, sink, comp);
+        return sink.count;
     }
 
 /*****************************************************************************************/
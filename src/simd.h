@@ -0,0 +1,1228 @@
+#ifndef MYCPPSTL_SIMD_H
+#define MYCPPSTL_SIMD_H
+
+// 这个头文件包含连续的算术类型区间上的向量化查找、计数、比较、填充、压缩、求和与前缀和，供 algobase.h / algo.h / numeric.h 中的指针特化版本使用
+// simd_find           : 找到第一个等于 value 的元素
+// simd_count          : 统计等于 value 的元素个数
+// simd_mismatch       : 找到两个区间第一处失配的下标
+// simd_equal          : 比较两个区间是否相等
+// simd_search         : 在字节序列中查找子序列
+// simd_fill           : 用 value 填充 n 个元素，适用于任何可平凡复制的类型
+// simd_copy_if        : 把满足谓词的元素拷贝到另一个区间
+// simd_remove_if      : 原地移除满足谓词的元素
+// simd_reduce_add     : 求和
+// simd_dot            : 浮点数的点积
+// simd_inclusive_scan : 前缀和，包含当前元素
+// simd_exclusive_scan : 前缀和，不包含当前元素
+// simd_swap_reversed  : 把一段与另一段的逆序交换，simd_reverse 用它原地反转
+// simd_reverse_copy   : 把区间逆序拷贝到另一个区间
+// simd_set_intersection : 两个有序的 4 字节整数区间的交集
+
+// notes:
+//
+// 在 x86-64 上使用 GCC / Clang 编译时，运行时检测 CPU 是否支持 AVX2：支持时每次处理 32 字节，否则用 SSE2 每次处理 16 字节，
+// AVX2 版本处理不完的部分交给 SSE2 版本，最后不足 16 字节的尾部元素逐个处理。其他平台或定义了 STL_NO_SIMD 时只有逐个比较的版本
+//
+// 每组元素比较后用 movemask 取得按字节的掩码，每个元素占 sizeof(T) 位，第一个置位的位置除以 sizeof(T) 就是元素的下标
+// 浮点数使用浮点比较指令，与 operator== 的语义一致：NaN 与任何值都不相等，+0.0 与 -0.0 相等
+//
+// 单字节的整数类型查找时直接调用 memchr，整数类型比较是否相等时直接调用 memcmp，它们在标准库中已经是向量化的
+//
+// simd_search 只用于单字节的整数类型：把模式的首字节和尾字节分别广播，与文本中相距 m - 1 的两组字节同时比较，
+// 两者都相等的位置才是候选，再用 memcmp 验证中间部分。首尾字节同时相等的位置很少，绝大多数数据只经过向量比较
+//
+// simd_fill 所有字节都相同的值(如 0)直接调用 memset；否则把 value 重复成周期性的样式，第一组非对齐写入，
+// 之后按向量宽度对齐整组写入，末尾一组与前面重叠，写入的地址与首地址的距离决定从样式的哪个字节开始。
+// 元素大小为 2、4、8 字节时样式是 8 字节的整数，直接广播到向量；其他大小(如 12 字节的结构体)的样式周期为
+// lcm(sizeof(T), 32) 字节，在栈上准备好后每个周期的几个向量依次写入
+//
+// simd_copy_if / simd_remove_if 对每个元素调用一次谓词(顺序与逐个处理时相同)，元素大小为 4 字节且支持 AVX2 时，
+// 把每 8 个元素的结果合成位掩码，查表得到排列，vpermd 把保留的元素移到向量的前部，一次写入，输出位置前进保留的个数。
+// 原地移除时输出位置不超过读取位置，可以整组写入；拷贝到另一个区间时只能写入保留的部分(vpmaskmov)，不会越过输出区间的末尾。
+// 其他情况下用无分支的标量版本：先写入再按谓词的结果前进，谓词的结果难以预测时避免了分支预测失败。
+// 8 字节的元素每个向量只有 4 个，排列的开销抵消了收益，实测标量版本更快
+//
+// simd_reduce_add / simd_dot 用几组互相独立的向量累加，最后再把各个通道加起来。整数的结果与逐个相加完全相同；
+// 浮点数改变了相加的顺序，舍入误差可能不同，只用于允许重新结合的 reduce / transform_reduce(见 numeric.h)
+//
+// simd_inclusive_scan / simd_exclusive_scan 只对 4、8 字节的元素向量化，用错位相加求出组内的前缀和，
+// 再加上前面所有元素的和。同样改变了浮点加法的顺序
+//
+// simd_swap_reversed / simd_reverse_copy 从两端(或从源区间的末尾)每次读入一个向量，在寄存器内把元素的次序反转后写回，
+// 元素只是搬动，结果与逐个交换完全相同。AVX2 用 vpshufb 反转 128 位的每一半中的字节(1、2 字节的元素)或 vpermd / vpermq
+// 反转 4、8 字节的元素，再交换两半；SSE2 没有字节重排指令，用 pshufd / pshuflw / pshufhw 与移位组合完成。
+// simd_reverse_copy 向结果区间顺序写入，读取方向与写入方向相反，硬件预取对两个方向都有效
+//
+// simd_set_intersection 每次从两个区间各取一块(AVX2 为 8 个元素，SSE2 为 4 个)，把其中一块依次轮转后与另一块比较，
+// 一次得到第一块中哪些元素在第二块中出现，按掩码输出。然后最大元素较小的那一块整块前进，另一块中不大于这个最大元素的部分
+// 也已经比较完，一起前进。相等的元素很少时(如倒排列表求交)绝大多数块只经过向量比较，没有难以预测的分支。
+// 块内有重复元素时按掩码输出会多算，这时逐个合并到有一侧离开当前的块，所以有重复元素时结果也与 set_intersection 相同
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "type_traits.h"
+
+#if !defined(STL_NO_SIMD) && (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define STL_SIMD 1
+#include <immintrin.h>
+// 只在运行时确认 CPU 支持后才会调用带有这个属性的函数
+#define STL_TARGET_AVX2 __attribute__((target("avx2,popcnt")))
+#endif
+
+// 告诉编译器指针所指的区间互不重叠，见 algo.h 中的 transform
+#if defined(__GNUC__) || defined(__clang__)
+#define STL_RESTRICT __restrict__
+#elif defined(_MSC_VER)
+#define STL_RESTRICT __restrict
+#else
+#define STL_RESTRICT
+#endif
+
+namespace stl {
+
+    // 元素类型 T 能否使用向量化的版本：非 volatile 的算术类型，大小为 1、2、4、8 字节(排除 long double)
+    template<class T>
+    struct simd_element : m_bool_constant<
+            std::is_arithmetic<typename std::remove_const<T>::type>::value && !std::is_volatile<T>::value &&
+            (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8)> {
+    };
+
+    // 在元素类型为 T 的区间中查找 U 类型的值时能否使用向量化的版本：
+    // 两者都是整数(值需要先转换为 T，见 algo.h 中的 find)，或者是相同的浮点类型
+    template<class T, class U>
+    struct simd_value : m_bool_constant<
+            simd_element<T>::value && std::is_arithmetic<U>::value &&
+            ((std::is_integral<typename std::remove_const<T>::type>::value && std::is_integral<U>::value) ||
+             std::is_same<typename std::remove_const<T>::type, typename std::remove_cv<U>::type>::value)> {
+    };
+
+    // 无分支的压缩：对[first, last)的每个元素调用一次 keep，结果为 true 的依次写到 out，返回写入的尾后位置
+    // InPlace 为 true 时 out 不超过 first，先写入再按 keep 的结果前进；否则先压缩到栈上的缓冲区，再拷贝保留的部分
+    template<bool InPlace, class T, class Keep>
+    T *simd_compact_scalar(const T *first, const T *last, T *out, Keep &keep) {
+        if (InPlace) {
+            for (; first != last; ++first) {
+                const T x = *first;
+                *out = x;
+                out += static_cast<bool>(keep(x));
+            }
+            return out;
+        }
+        T buf[64];
+        while (first != last) {
+            const size_t len = static_cast<size_t>(last - first) < 64 ? static_cast<size_t>(last - first) : 64;
+            size_t k = 0;
+            for (size_t i = 0; i < len; ++i) {
+                const T x = first[i];
+                buf[k] = x;
+                k += static_cast<bool>(keep(x));
+            }
+            std::memcpy(out, buf, k * sizeof(T));
+            out += k;
+            first += len;
+        }
+        return out;
+    }
+
+    // 谓词取反，用于 remove_if 保留不满足谓词的元素
+    template<class UnaryPredicate>
+    struct simd_not_pred {
+        UnaryPredicate &pred;
+
+        template<class T>
+        bool operator()(const T &x) const { return !pred(x); }
+    };
+
+
+    // 累加用的类型：整数在对应的无符号类型上累加，溢出时按模回绕，结果与逐个相加相同
+    template<class T>
+    struct simd_sum_type {
+        typedef typename std::conditional<std::is_integral<T>::value, std::make_unsigned<T>,
+                std::remove_cv<T>>::type::type type;
+    };
+
+    // 逐个求和
+    template<class T>
+    T simd_reduce_add_scalar(const T *first, const T *last, T init) {
+        typedef typename simd_sum_type<T>::type U;
+        U acc = static_cast<U>(init);
+        for (; first != last; ++first) acc = static_cast<U>(acc + static_cast<U>(*first));
+        return static_cast<T>(acc);
+    }
+
+    // 逐个求前缀和，Inclusive 为 true 时 result[i] 包含 first[i]，否则不包含；result 可以等于 first
+    template<bool Inclusive, class T>
+    T *simd_scan_scalar(const T *first, const T *last, T *result, T init) {
+        typedef typename simd_sum_type<T>::type U;
+        U acc = static_cast<U>(init);
+        for (; first != last; ++first, ++result) {
+            const U x = static_cast<U>(*first);
+            if (!Inclusive) *result = static_cast<T>(acc);
+            acc = static_cast<U>(acc + x);
+            if (Inclusive) *result = static_cast<T>(acc);
+        }
+        return result;
+    }
+
+    // 逐个交换 first[i] 与 last[-1 - i]，i < k
+    template<class T>
+    void simd_swap_reversed_scalar(T *first, T *last, size_t k) {
+        for (; k != 0; --k, ++first) {
+            --last;
+            const T tmp = *first;
+            *first = *last;
+            *last = tmp;
+        }
+    }
+
+#ifdef STL_SIMD
+
+    inline bool simd_has_avx2() noexcept {
+        static const bool has = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt");
+        return has;
+    }
+
+    // 按元素大小和是否为浮点数区分的向量操作：
+    //   splat : 把一个元素的位模式复制到每个通道
+    //   eq    : 逐个元素比较，相等的元素对应的字节全部置 1
+    //   add   : 逐个元素相加，整数按模回绕
+    //   mul   : 逐个元素相乘，只有浮点数有
+    template<size_t Size, bool Float>
+    struct simd_lane;
+
+    template<>
+    struct simd_lane<1, false> {
+        static __m128i splat(uint8_t x, __m128i) { return _mm_set1_epi8(static_cast<char>(x)); }
+
+        static __m128i eq(__m128i a, __m128i b) { return _mm_cmpeq_epi8(a, b); }
+
+        STL_TARGET_AVX2 static __m256i splat(uint8_t x, __m256i) { return _mm256_set1_epi8(static_cast<char>(x)); }
+
+        STL_TARGET_AVX2 static __m256i eq(__m256i a, __m256i b) { return _mm256_cmpeq_epi8(a, b); }
+
+        static __m128i add(__m128i a, __m128i b) { return _mm_add_epi8(a, b); }
+
+        STL_TARGET_AVX2 static __m256i add(__m256i a, __m256i b) { return _mm256_add_epi8(a, b); }
+    };
+
+    template<>
+    struct simd_lane<2, false> {
+        static __m128i splat(uint16_t x, __m128i) { return _mm_set1_epi16(static_cast<short>(x)); }
+
+        static __m128i eq(__m128i a, __m128i b) { return _mm_cmpeq_epi16(a, b); }
+
+        STL_TARGET_AVX2 static __m256i splat(uint16_t x, __m256i) { return _mm256_set1_epi16(static_cast<short>(x)); }
+
+        STL_TARGET_AVX2 static __m256i eq(__m256i a, __m256i b) { return _mm256_cmpeq_epi16(a, b); }
+
+        static __m128i add(__m128i a, __m128i b) { return _mm_add_epi16(a, b); }
+
+        STL_TARGET_AVX2 static __m256i add(__m256i a, __m256i b) { return _mm256_add_epi16(a, b); }
+    };
+
+    template<>
+    struct simd_lane<4, false> {
+        static __m128i splat(uint32_t x, __m128i) { return _mm_set1_epi32(static_cast<int>(x)); }
+
+        static __m128i eq(__m128i a, __m128i b) { return _mm_cmpeq_epi32(a, b); }
+
+        STL_TARGET_AVX2 static __m256i splat(uint32_t x, __m256i) { return _mm256_set1_epi32(static_cast<int>(x)); }
+
+        STL_TARGET_AVX2 static __m256i eq(__m256i a, __m256i b) { return _mm256_cmpeq_epi32(a, b); }
+
+        static __m128i add(__m128i a, __m128i b) { return _mm_add_epi32(a, b); }
+
+        STL_TARGET_AVX2 static __m256i add(__m256i a, __m256i b) { return _mm256_add_epi32(a, b); }
+    };
+
+    template<>
+    struct simd_lane<8, false> {
+        static __m128i splat(uint64_t x, __m128i) { return _mm_set1_epi64x(static_cast<long long>(x)); }
+
+        // SSE2 没有 64 位的比较，两个 32 位的半边都相等时才相等
+        static __m128i eq(__m128i a, __m128i b) {
+            const __m128i e = _mm_cmpeq_epi32(a, b);
+            return _mm_and_si128(e, _mm_shuffle_epi32(e, _MM_SHUFFLE(2, 3, 0, 1)));
+        }
+
+        STL_TARGET_AVX2 static __m256i splat(uint64_t x, __m256i) {
+            return _mm256_set1_epi64x(static_cast<long long>(x));
+        }
+
+        STL_TARGET_AVX2 static __m256i eq(__m256i a, __m256i b) { return _mm256_cmpeq_epi64(a, b); }
+
+        static __m128i add(__m128i a, __m128i b) { return _mm_add_epi64(a, b); }
+
+        STL_TARGET_AVX2 static __m256i add(__m256i a, __m256i b) { return _mm256_add_epi64(a, b); }
+    };
+
+    template<>
+    struct simd_lane<4, true> : simd_lane<4, false> {
+        using simd_lane<4, false>::splat;
+
+        static __m128i eq(__m128i a, __m128i b) {
+            return _mm_castps_si128(_mm_cmpeq_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)));
+        }
+
+        STL_TARGET_AVX2 static __m256i eq(__m256i a, __m256i b) {
+            return _mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b), _CMP_EQ_OQ));
+        }
+
+        static __m128i add(__m128i a, __m128i b) {
+            return _mm_castps_si128(_mm_add_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)));
+        }
+
+        static __m128i mul(__m128i a, __m128i b) {
+            return _mm_castps_si128(_mm_mul_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)));
+        }
+
+        STL_TARGET_AVX2 static __m256i add(__m256i a, __m256i b) {
+            return _mm256_castps_si256(_mm256_add_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b)));
+        }
+
+        STL_TARGET_AVX2 static __m256i mul(__m256i a, __m256i b) {
+            return _mm256_castps_si256(_mm256_mul_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b)));
+        }
+    };
+
+    template<>
+    struct simd_lane<8, true> : simd_lane<8, false> {
+        using simd_lane<8, false>::splat;
+
+        static __m128i eq(__m128i a, __m128i b) {
+            return _mm_castpd_si128(_mm_cmpeq_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b)));
+        }
+
+        STL_TARGET_AVX2 static __m256i eq(__m256i a, __m256i b) {
+            return _mm256_castpd_si256(_mm256_cmp_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b), _CMP_EQ_OQ));
+        }
+
+        static __m128i add(__m128i a, __m128i b) {
+            return _mm_castpd_si128(_mm_add_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b)));
+        }
+
+        static __m128i mul(__m128i a, __m128i b) {
+            return _mm_castpd_si128(_mm_mul_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b)));
+        }
+
+        STL_TARGET_AVX2 static __m256i add(__m256i a, __m256i b) {
+            return _mm256_castpd_si256(_mm256_add_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b)));
+        }
+
+        STL_TARGET_AVX2 static __m256i mul(__m256i a, __m256i b) {
+            return _mm256_castpd_si256(_mm256_mul_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b)));
+        }
+    };
+
+    // 与 T 大小相同的无符号整数，用来搬运 T 的位模式
+    template<class T>
+    struct simd_bits {
+        typedef typename std::conditional<sizeof(T) == 1, uint8_t,
+                typename std::conditional<sizeof(T) == 2, uint16_t,
+                        typename std::conditional<sizeof(T) == 4, uint32_t, uint64_t>::type>::type>::type type;
+
+        static type get(T value) {
+            type bits;
+            std::memcpy(&bits, &value, sizeof(T));
+            return bits;
+        }
+    };
+
+    template<class T>
+    using simd_lane_of = simd_lane<sizeof(T), std::is_floating_point<T>::value>;
+
+    /// SSE2 版本
+
+    template<class T>
+    const T *simd_find_sse2(const T *first, const T *last, T value) {
+        typedef simd_lane_of<T> lane;
+        const size_t step = 16 / sizeof(T);
+        const __m128i v = lane::splat(simd_bits<T>::get(value), __m128i());
+        for (; static_cast<size_t>(last - first) >= step; first += step) {
+            const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(first));
+            const unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(lane::eq(x, v)));
+            if (mask != 0) return first + __builtin_ctz(mask) / sizeof(T);
+        }
+        for (; first != last; ++first) if (*first == value) return first;
+        return first;
+    }
+
+    template<class T>
+    size_t simd_count_sse2(const T *first, const T *last, T value) {
+        typedef simd_lane_of<T> lane;
+        const size_t step = 16 / sizeof(T);
+        const __m128i v = lane::splat(simd_bits<T>::get(value), __m128i());
+        size_t bits = 0;
+        for (; static_cast<size_t>(last - first) >= step; first += step) {
+            const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(first));
+            bits += __builtin_popcount(static_cast<unsigned>(_mm_movemask_epi8(lane::eq(x, v))));
+        }
+        size_t n = bits / sizeof(T);
+        for (; first != last; ++first) if (*first == value) ++n;
+        return n;
+    }
+
+    template<class T>
+    size_t simd_mismatch_sse2(const T *first1, const T *first2, size_t n) {
+        typedef simd_lane_of<T> lane;
+        const size_t step = 16 / sizeof(T);
+        size_t i = 0;
+        for (; n - i >= step; i += step) {
+            const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(first1 + i));
+            const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(first2 + i));
+            const unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(lane::eq(a, b))) ^ 0xFFFFu;
+            if (mask != 0) return i + __builtin_ctz(mask) / sizeof(T);
+        }
+        for (; i != n; ++i) if (!(first1[i] == first2[i])) return i;
+        return n;
+    }
+
+    /// AVX2 版本
+
+    template<class T>
+    STL_TARGET_AVX2 const T *simd_find_avx2(const T *first, const T *last, T value) {
+        typedef simd_lane_of<T> lane;
+        const size_t step = 32 / sizeof(T);
+        const __m256i v = lane::splat(simd_bits<T>::get(value), __m256i());
+        // 每次检查两组，减少分支
+        for (; static_cast<size_t>(last - first) >= 2 * step; first += 2 * step) {
+            const __m256i x0 = lane::eq(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(first)), v);
+            const __m256i x1 = lane::eq(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(first + step)), v);
+            if (!_mm256_testz_si256(_mm256_or_si256(x0, x1), _mm256_or_si256(x0, x1))) {
+                const unsigned mask0 = static_cast<unsigned>(_mm256_movemask_epi8(x0));
+                if (mask0 != 0) return first + __builtin_ctz(mask0) / sizeof(T);
+                const unsigned mask1 = static_cast<unsigned>(_mm256_movemask_epi8(x1));
+                return first + step + __builtin_ctz(mask1) / sizeof(T);
+            }
+        }
+        if (static_cast<size_t>(last - first) >= step) {
+            const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first));
+            const unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(lane::eq(x, v)));
+            if (mask != 0) return first + __builtin_ctz(mask) / sizeof(T);
+            first += step;
+        }
+        return simd_find_sse2(first, last, value);
+    }
+
+    template<class T>
+    STL_TARGET_AVX2 size_t simd_count_avx2(const T *first, const T *last, T value) {
+        typedef simd_lane_of<T> lane;
+        const size_t step = 32 / sizeof(T);
+        const __m256i v = lane::splat(simd_bits<T>::get(value), __m256i());
+        size_t bits = 0;
+        for (; static_cast<size_t>(last - first) >= step; first += step) {
+            const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first));
+            bits += __builtin_popcount(static_cast<unsigned>(_mm256_movemask_epi8(lane::eq(x, v))));
+        }
+        return bits / sizeof(T) + simd_count_sse2(first, last, value);
+    }
+
+    template<class T>
+    STL_TARGET_AVX2 size_t simd_mismatch_avx2(const T *first1, const T *first2, size_t n) {
+        typedef simd_lane_of<T> lane;
+        const size_t step = 32 / sizeof(T);
+        size_t i = 0;
+        for (; n - i >= step; i += step) {
+            const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first1 + i));
+            const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first2 + i));
+            const unsigned mask = ~static_cast<unsigned>(_mm256_movemask_epi8(lane::eq(a, b)));
+            if (mask != 0) return i + __builtin_ctz(mask) / sizeof(T);
+        }
+        return i + simd_mismatch_sse2(first1 + i, first2 + i, n - i);
+    }
+
+    // 在[first, last)中查找 m 个字节的模式 p，要求 2 <= m <= last - first，返回首次出现的位置或 nullptr
+    // 中间部分的验证不涉及首尾字节，处理过的位置保存在 *pos 中，剩下的交给调用者逐个检查
+    template<class T>
+    const T *simd_search_sse2(const T *first, const T *last, const T *p, size_t m, const T **pos) {
+        typedef simd_lane<1, false> lane;
+        const __m128i head = lane::splat(static_cast<uint8_t>(p[0]), __m128i());
+        const __m128i tail = lane::splat(static_cast<uint8_t>(p[m - 1]), __m128i());
+        const T *end = last - (m - 1);     // 候选起点的尾后位置
+        for (; end - first >= 16; first += 16) {
+            const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(first));
+            const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(first + m - 1));
+            unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(
+                    _mm_and_si128(lane::eq(a, head), lane::eq(b, tail))));
+            for (; mask != 0; mask &= mask - 1) {
+                const T *cand = first + __builtin_ctz(mask);
+                if (std::memcmp(cand + 1, p + 1, m - 2) == 0) return cand;
+            }
+        }
+        *pos = first;
+        return nullptr;
+    }
+
+    template<class T>
+    STL_TARGET_AVX2 const T *simd_search_avx2(const T *first, const T *last, const T *p, size_t m, const T **pos) {
+        typedef simd_lane<1, false> lane;
+        const __m256i head = lane::splat(static_cast<uint8_t>(p[0]), __m256i());
+        const __m256i tail = lane::splat(static_cast<uint8_t>(p[m - 1]), __m256i());
+        const T *end = last - (m - 1);
+        for (; end - first >= 32; first += 32) {
+            const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first));
+            const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first + m - 1));
+            unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(
+                    _mm256_and_si256(lane::eq(a, head), lane::eq(b, tail))));
+            for (; mask != 0; mask &= mask - 1) {
+                const T *cand = first + __builtin_ctz(mask);
+                if (std::memcmp(cand + 1, p + 1, m - 2) == 0) return cand;
+            }
+        }
+        return simd_search_sse2(first, last, p, m, pos);
+    }
+
+    // 8 字节的 word 循环右移 k 个字节，得到从第 k 个字节开始的样式
+    inline uint64_t simd_rotate_word(uint64_t word, size_t k) {
+        return k == 0 ? word : (word >> (8 * k)) | (word << (64 - 8 * k));
+    }
+
+    // 把 n 字节(n >= 16)写为以 8 字节为周期的样式 word，元素大小为 2、4、8 字节时使用，向量直接在寄存器中生成
+    inline void simd_fill_word_sse2(char *p, size_t n, uint64_t word) {
+        char *const end = p + n;
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(p), _mm_set1_epi64x(static_cast<long long>(word)));
+        char *a = reinterpret_cast<char *>((reinterpret_cast<uintptr_t>(p) + 16) & ~uintptr_t(15));
+        const __m128i v = _mm_set1_epi64x(static_cast<long long>(simd_rotate_word(word, (a - p) % 8)));
+        for (; end - a >= 64; a += 64) {
+            _mm_store_si128(reinterpret_cast<__m128i *>(a), v);
+            _mm_store_si128(reinterpret_cast<__m128i *>(a + 16), v);
+            _mm_store_si128(reinterpret_cast<__m128i *>(a + 32), v);
+            _mm_store_si128(reinterpret_cast<__m128i *>(a + 48), v);
+        }
+        for (; end - a >= 16; a += 16) _mm_store_si128(reinterpret_cast<__m128i *>(a), v);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(end - 16),
+                         _mm_set1_epi64x(static_cast<long long>(simd_rotate_word(word, (n - 16) % 8))));
+    }
+
+    // n >= 32
+    STL_TARGET_AVX2 inline void simd_fill_word_avx2(char *p, size_t n, uint64_t word) {
+        char *const end = p + n;
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), _mm256_set1_epi64x(static_cast<long long>(word)));
+        char *a = reinterpret_cast<char *>((reinterpret_cast<uintptr_t>(p) + 32) & ~uintptr_t(31));
+        const __m256i v = _mm256_set1_epi64x(static_cast<long long>(simd_rotate_word(word, (a - p) % 8)));
+        for (; end - a >= 128; a += 128) {
+            _mm256_store_si256(reinterpret_cast<__m256i *>(a), v);
+            _mm256_store_si256(reinterpret_cast<__m256i *>(a + 32), v);
+            _mm256_store_si256(reinterpret_cast<__m256i *>(a + 64), v);
+            _mm256_store_si256(reinterpret_cast<__m256i *>(a + 96), v);
+        }
+        for (; end - a >= 32; a += 32) _mm256_store_si256(reinterpret_cast<__m256i *>(a), v);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(end - 32),
+                            _mm256_set1_epi64x(static_cast<long long>(simd_rotate_word(word, (n - 32) % 8))));
+    }
+
+    // 把 n 字节(n >= 32)写为以 Period 字节为周期的样式 pat，Period 是 32 的倍数，pat 的长度为 Period + 32。
+    // 每个周期的向量先读到寄存器中再循环写入(周期不超过 256 字节时)，循环中从 pat 读取会与之前大量的写入互相等待
+    template<size_t Period>
+    void simd_fill_bytes_sse2(char *p, size_t n, const char *pat) {
+        char *const end = p + n;
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(p), _mm_loadu_si128(reinterpret_cast<const __m128i *>(pat)));
+        char *a = reinterpret_cast<char *>((reinterpret_cast<uintptr_t>(p) + 16) & ~uintptr_t(15));
+        size_t phase = static_cast<size_t>(a - p) % Period;
+        if (Period <= 256) {
+            __m128i v[Period / 16];
+            for (size_t k = 0; k < Period / 16; ++k) {
+                v[k] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pat + (phase + 16 * k) % Period));
+            }
+            for (; static_cast<size_t>(end - a) >= Period; a += Period) {
+                for (size_t k = 0; k < Period / 16; ++k) _mm_store_si128(reinterpret_cast<__m128i *>(a + 16 * k), v[k]);
+            }
+        }
+        for (; end - a >= 16; a += 16) {
+            _mm_store_si128(reinterpret_cast<__m128i *>(a), _mm_loadu_si128(
+                    reinterpret_cast<const __m128i *>(pat + phase)));
+            phase = phase + 16 < Period ? phase + 16 : phase + 16 - Period;
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(end - 16), _mm_loadu_si128(
+                reinterpret_cast<const __m128i *>(pat + (n - 16) % Period)));
+    }
+
+    template<size_t Period>
+    STL_TARGET_AVX2 void simd_fill_bytes_avx2(char *p, size_t n, const char *pat) {
+        char *const end = p + n;
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pat)));
+        char *a = reinterpret_cast<char *>((reinterpret_cast<uintptr_t>(p) + 32) & ~uintptr_t(31));
+        size_t phase = static_cast<size_t>(a - p) % Period;
+        if (Period <= 256) {
+            __m256i v[Period / 32];
+            for (size_t k = 0; k < Period / 32; ++k) {
+                v[k] = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pat + (phase + 32 * k) % Period));
+            }
+            for (; static_cast<size_t>(end - a) >= Period; a += Period) {
+                for (size_t k = 0; k < Period / 32; ++k) _mm256_store_si256(reinterpret_cast<__m256i *>(a + 32 * k), v[k]);
+            }
+        }
+        for (; end - a >= 32; a += 32) {
+            _mm256_store_si256(reinterpret_cast<__m256i *>(a), _mm256_loadu_si256(
+                    reinterpret_cast<const __m256i *>(pat + phase)));
+            phase = phase + 32 < Period ? phase + 32 : phase + 32 - Period;
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(end - 32), _mm256_loadu_si256(
+                reinterpret_cast<const __m256i *>(pat + (n - 32) % Period)));
+    }
+
+    // 压缩用的排列表：第 mask 项的 8 个字节依次为 mask 中置位的下标，剩下的补 0
+    struct simd_compact_table {
+        uint64_t index[256];
+
+        simd_compact_table() {
+            for (unsigned mask = 0; mask < 256; ++mask) {
+                uint64_t x = 0;
+                unsigned k = 0;
+                for (unsigned i = 0; i < 8; ++i) {
+                    if (mask & (1u << i)) x |= static_cast<uint64_t>(i) << (8 * k++);
+                }
+                index[mask] = x;
+            }
+        }
+    };
+
+    inline const uint64_t *simd_compact_index() {
+        static const simd_compact_table table;
+        return table.index;
+    }
+
+    // 元素大小为 4 字节，每次处理 8 个元素
+    template<bool InPlace, class T, class Keep>
+    STL_TARGET_AVX2 T *simd_compact_avx2(const T *first, const T *last, T *out, Keep &keep) {
+        const uint64_t *table = simd_compact_index();
+        const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        for (; last - first >= 8; first += 8) {
+            unsigned mask = 0;
+            for (unsigned j = 0; j < 8; ++j) mask |= static_cast<unsigned>(static_cast<bool>(keep(first[j]))) << j;
+            const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first));
+            const __m256i index = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(table + mask)));
+            const __m256i y = _mm256_permutevar8x32_epi32(x, index);
+            const int kept = __builtin_popcount(mask);
+            if (InPlace) {
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(out), y);
+            } else {
+                const __m256i store = _mm256_cmpgt_epi32(_mm256_set1_epi32(kept), lanes);
+                _mm256_maskstore_epi32(reinterpret_cast<int *>(out), store, y);
+            }
+            out += kept;
+        }
+        return simd_compact_scalar<InPlace>(first, last, out, keep);
+    }
+
+    /// 求和、点积与前缀和
+
+    // 用 4 组向量累加器，各组之间没有依赖，浮点加法的延迟可以重叠；结束时把各个通道依次加到 init 上
+    template<class T>
+    T simd_reduce_add_sse2(const T *first, const T *last, T init) {
+        typedef simd_lane_of<T> lane;
+        const size_t step = 16 / sizeof(T);
+        __m128i a0 = _mm_setzero_si128(), a1 = a0, a2 = a0, a3 = a0;
+        for (; static_cast<size_t>(last - first) >= 4 * step; first += 4 * step) {
+            a0 = lane::add(a0, _mm_loadu_si128(reinterpret_cast<const __m128i *>(first)));
+            a1 = lane::add(a1, _mm_loadu_si128(reinterpret_cast<const __m128i *>(first + step)));
+            a2 = lane::add(a2, _mm_loadu_si128(reinterpret_cast<const __m128i *>(first + 2 * step)));
+            a3 = lane::add(a3, _mm_loadu_si128(reinterpret_cast<const __m128i *>(first + 3 * step)));
+        }
+        for (; static_cast<size_t>(last - first) >= step; first += step) {
+            a0 = lane::add(a0, _mm_loadu_si128(reinterpret_cast<const __m128i *>(first)));
+        }
+        T lanes[16 / sizeof(T)];
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(lanes), lane::add(lane::add(a0, a1), lane::add(a2, a3)));
+        init = simd_reduce_add_scalar(lanes, lanes + step, init);
+        return simd_reduce_add_scalar(first, last, init);
+    }
+
+    template<class T>
+    STL_TARGET_AVX2 T simd_reduce_add_avx2(const T *first, const T *last, T init) {
+        typedef simd_lane_of<T> lane;
+        const size_t step = 32 / sizeof(T);
+        __m256i a0 = _mm256_setzero_si256(), a1 = a0, a2 = a0, a3 = a0;
+        for (; static_cast<size_t>(last - first) >= 4 * step; first += 4 * step) {
+            a0 = lane::add(a0, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first)));
+            a1 = lane::add(a1, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first + step)));
+            a2 = lane::add(a2, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first + 2 * step)));
+            a3 = lane::add(a3, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first + 3 * step)));
+        }
+        for (; static_cast<size_t>(last - first) >= step; first += step) {
+            a0 = lane::add(a0, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first)));
+        }
+        T lanes[32 / sizeof(T)];
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes), lane::add(lane::add(a0, a1), lane::add(a2, a3)));
+        init = simd_reduce_add_scalar(lanes, lanes + step, init);
+        return simd_reduce_add_scalar(first, last, init);
+    }
+
+    // 浮点数的点积，乘法与加法分开进行(不使用 FMA)
+    template<class T>
+    T simd_dot_sse2(const T *first1, const T *first2, size_t n, T init) {
+        typedef simd_lane_of<T> lane;
+        const size_t step = 16 / sizeof(T);
+        __m128i a0 = _mm_setzero_si128(), a1 = a0;
+        size_t i = 0;
+        for (; i + 2 * step <= n; i += 2 * step) {
+            a0 = lane::add(a0, lane::mul(_mm_loadu_si128(reinterpret_cast<const __m128i *>(first1 + i)),
+                                         _mm_loadu_si128(reinterpret_cast<const __m128i *>(first2 + i))));
+            a1 = lane::add(a1, lane::mul(_mm_loadu_si128(reinterpret_cast<const __m128i *>(first1 + i + step)),
+                                         _mm_loadu_si128(reinterpret_cast<const __m128i *>(first2 + i + step))));
+        }
+        T lanes[16 / sizeof(T)];
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(lanes), lane::add(a0, a1));
+        for (size_t j = 0; j < step; ++j) init = init + lanes[j];
+        for (; i < n; ++i) init = init + first1[i] * first2[i];
+        return init;
+    }
+
+    template<class T>
+    STL_TARGET_AVX2 T simd_dot_avx2(const T *first1, const T *first2, size_t n, T init) {
+        typedef simd_lane_of<T> lane;
+        const size_t step = 32 / sizeof(T);
+        __m256i a0 = _mm256_setzero_si256(), a1 = a0;
+        size_t i = 0;
+        for (; i + 2 * step <= n; i += 2 * step) {
+            a0 = lane::add(a0, lane::mul(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(first1 + i)),
+                                         _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first2 + i))));
+            a1 = lane::add(a1, lane::mul(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(first1 + i + step)),
+                                         _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first2 + i + step))));
+        }
+        T lanes[32 / sizeof(T)];
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes), lane::add(a0, a1));
+        for (size_t j = 0; j < step; ++j) init = init + lanes[j];
+        for (; i < n; ++i) init = init + first1[i] * first2[i];
+        return init;
+    }
+
+    // 向量内的前缀和，元素大小为 4 或 8 字节：错开一个、两个通道后相加
+    template<class T>
+    __m128i simd_prefix_sse2(__m128i x) {
+        typedef simd_lane_of<T> lane;
+        x = lane::add(x, _mm_slli_si128(x, sizeof(T) == 4 ? 4 : 8));
+        if (sizeof(T) == 4) x = lane::add(x, _mm_slli_si128(x, 8));
+        return x;
+    }
+
+    // 把最后一个通道复制到每个通道
+    template<class T>
+    __m128i simd_broadcast_last_sse2(__m128i x) {
+        return sizeof(T) == 4 ? _mm_shuffle_epi32(x, _MM_SHUFFLE(3, 3, 3, 3))
+                              : _mm_shuffle_epi32(x, _MM_SHUFFLE(3, 2, 3, 2));
+    }
+
+    // 前缀和，元素大小为 4 或 8 字节。每组先求组内的前缀和，再加上之前所有元素的和(每个通道都是这个和)，
+    // 组与组之间只有一次加法的依赖。更宽的向量还要跨越 128 位的两半，依赖链更长，收益不大，所以只有 SSE2 版本
+    template<bool Inclusive, class T>
+    T *simd_scan_sse2(const T *first, const T *last, T *result, T init) {
+        typedef simd_lane_of<T> lane;
+        const size_t step = 16 / sizeof(T);
+        __m128i carry = lane::splat(simd_bits<T>::get(init), __m128i());
+        for (; static_cast<size_t>(last - first) >= step; first += step, result += step) {
+            const __m128i p = simd_prefix_sse2<T>(_mm_loadu_si128(reinterpret_cast<const __m128i *>(first)));
+            if (Inclusive) {
+                const __m128i x = lane::add(carry, p);
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(result), x);
+                carry = simd_broadcast_last_sse2<T>(x);
+            } else {
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(result),
+                                 lane::add(carry, _mm_slli_si128(p, sizeof(T) == 4 ? 4 : 8)));
+                carry = lane::add(carry, simd_broadcast_last_sse2<T>(p));
+            }
+        }
+        T lanes[16 / sizeof(T)];
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(lanes), carry);
+        return simd_scan_scalar<Inclusive>(first, last, result, lanes[0]);
+    }
+
+    /// 反转
+
+    // 反转向量中元素的次序
+    template<size_t Size>
+    __m128i simd_reverse_lanes_sse2(__m128i x) {
+        if (Size == 8) return _mm_shuffle_epi32(x, _MM_SHUFFLE(1, 0, 3, 2));
+        if (Size == 4) return _mm_shuffle_epi32(x, _MM_SHUFFLE(0, 1, 2, 3));
+        // 先反转每 64 位中的 4 个 16 位，再交换两个 64 位
+        x = _mm_shufflehi_epi16(_mm_shufflelo_epi16(x, _MM_SHUFFLE(0, 1, 2, 3)), _MM_SHUFFLE(0, 1, 2, 3));
+        x = _mm_shuffle_epi32(x, _MM_SHUFFLE(1, 0, 3, 2));
+        // 单字节的元素还要交换每 16 位中的两个字节
+        if (Size == 1) x = _mm_or_si128(_mm_slli_epi16(x, 8), _mm_srli_epi16(x, 8));
+        return x;
+    }
+
+    template<size_t Size>
+    STL_TARGET_AVX2 __m256i simd_reverse_lanes_avx2(__m256i x) {
+        if (Size == 8) return _mm256_permute4x64_epi64(x, _MM_SHUFFLE(0, 1, 2, 3));
+        if (Size == 4) return _mm256_permutevar8x32_epi32(x, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+        // vpshufb 只能在 128 位的每一半内部重排，反转后再交换两半
+        const __m256i index = Size == 2
+                              ? _mm256_setr_epi8(14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1,
+                                                 14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1)
+                              : _mm256_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
+                                                 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+        return _mm256_permute4x64_epi64(_mm256_shuffle_epi8(x, index), _MM_SHUFFLE(1, 0, 3, 2));
+    }
+
+    template<class T>
+    void simd_swap_reversed_sse2(T *first, T *last, size_t k) {
+        const size_t step = 16 / sizeof(T);
+        for (; k >= step; k -= step, first += step) {
+            last -= step;
+            const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(first));
+            const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(last));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(first), simd_reverse_lanes_sse2<sizeof(T)>(b));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(last), simd_reverse_lanes_sse2<sizeof(T)>(a));
+        }
+        simd_swap_reversed_scalar(first, last, k);
+    }
+
+    template<class T>
+    STL_TARGET_AVX2 void simd_swap_reversed_avx2(T *first, T *last, size_t k) {
+        const size_t step = 32 / sizeof(T);
+        for (; k >= step; k -= step, first += step) {
+            last -= step;
+            const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first));
+            const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(last));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(first), simd_reverse_lanes_avx2<sizeof(T)>(b));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(last), simd_reverse_lanes_avx2<sizeof(T)>(a));
+        }
+        simd_swap_reversed_sse2(first, last, k);
+    }
+
+    // 从 last 向前每次读入一组，反转后顺序写到 result
+    template<class T>
+    T *simd_reverse_copy_sse2(const T *first, const T *last, T *result) {
+        const size_t step = 16 / sizeof(T);
+        for (; static_cast<size_t>(last - first) >= step; result += step) {
+            last -= step;
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(result), simd_reverse_lanes_sse2<sizeof(T)>(
+                    _mm_loadu_si128(reinterpret_cast<const __m128i *>(last))));
+        }
+        while (first != last) *result++ = *--last;
+        return result;
+    }
+
+    template<class T>
+    STL_TARGET_AVX2 T *simd_reverse_copy_avx2(const T *first, const T *last, T *result) {
+        const size_t step = 32 / sizeof(T);
+        for (; static_cast<size_t>(last - first) >= step; result += step) {
+            last -= step;
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(result), simd_reverse_lanes_avx2<sizeof(T)>(
+                    _mm256_loadu_si256(reinterpret_cast<const __m256i *>(last))));
+        }
+        return simd_reverse_copy_sse2(first, last, result);
+    }
+
+    /// 有序集合的交集
+
+    // 有重复元素的块之间有相等的元素时逐个合并，直到有一侧离开当前的块。两侧按比较结果无分支地前进
+    template<class T, class Sink>
+    void simd_merge_blocks(const T *&first1, const T *&first2, size_t block, Sink &sink) {
+        const T *last1 = first1 + block, *last2 = first2 + block;
+        while (first1 != last1 && first2 != last2) {
+            const T a = *first1, b = *first2;
+            if (a == b) sink(first1);
+            first1 += !(b < a);
+            first2 += !(a < b);
+        }
+    }
+
+    // 对 mask 中每个置位的通道 i 调用 sink(first + i)
+    template<class T, class Sink>
+    void simd_emit_mask(const T *first, unsigned mask, Sink &sink) {
+        for (; mask != 0; mask &= mask - 1) sink(first + __builtin_ctz(mask));
+    }
+
+    // 无符号数翻转最高位后可以用有符号的比较
+    template<class T>
+    inline int simd_order_bias() { return std::is_signed<T>::value ? 0 : static_cast<int>(0x80000000u); }
+
+    // 两块中都没有重复元素时，第一块中与第二块某个元素相等的元素就是这两块的交集，直接按掩码输出。
+    // 之后最大元素较小的一块整块前进；另一块中不大于这个最大元素的元素已经比较过，不会再与之后的元素相等，也一起前进。
+    // 两块的最大元素相等时都整块前进。没有相等的元素时同样适用，只是不输出
+    template<class T, class Sink>
+    void simd_set_intersection_sse2(const T *&first1, const T *last1, const T *&first2, const T *last2, Sink &sink) {
+        const __m128i bias = _mm_set1_epi32(simd_order_bias<T>());
+        while (last1 - first1 >= 4 && last2 - first2 >= 4) {
+            const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(first1));
+            const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(first2));
+            const __m128i eq = _mm_or_si128(
+                    _mm_or_si128(_mm_cmpeq_epi32(a, b), _mm_cmpeq_epi32(a, _mm_shuffle_epi32(b, _MM_SHUFFLE(0, 3, 2, 1)))),
+                    _mm_or_si128(_mm_cmpeq_epi32(a, _mm_shuffle_epi32(b, _MM_SHUFFLE(1, 0, 3, 2))),
+                                 _mm_cmpeq_epi32(a, _mm_shuffle_epi32(b, _MM_SHUFFLE(2, 1, 0, 3)))));
+            const unsigned mask = static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(eq)));
+            if (mask != 0) {
+                // 相邻元素相等说明块内有重复
+                const __m128i dup = _mm_or_si128(_mm_cmpeq_epi32(a, _mm_shuffle_epi32(a, _MM_SHUFFLE(3, 3, 2, 1))),
+                                                 _mm_cmpeq_epi32(b, _mm_shuffle_epi32(b, _MM_SHUFFLE(3, 3, 2, 1))));
+                if ((_mm_movemask_ps(_mm_castsi128_ps(dup)) & 0x7) != 0) {
+                    simd_merge_blocks(first1, first2, 4, sink);
+                    continue;
+                }
+                simd_emit_mask(first1, mask, sink);
+            }
+            const T amax = first1[3], bmax = first2[3];
+            if (amax < bmax) {
+                // 另一块的首元素就大于这个最大元素时(长度悬殊时的常见情况)不必计数，前进的距离不依赖于读入的数据
+                if (!(amax < first2[0])) {
+                    const __m128i gt = _mm_cmpgt_epi32(_mm_xor_si128(b, bias),
+                                                       _mm_set1_epi32(static_cast<int>(amax) ^ simd_order_bias<T>()));
+                    first2 += 4 - __builtin_popcount(static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(gt))));
+                }
+                first1 += 4;
+            } else if (bmax < amax) {
+                if (!(bmax < first1[0])) {
+                    const __m128i gt = _mm_cmpgt_epi32(_mm_xor_si128(a, bias),
+                                                       _mm_set1_epi32(static_cast<int>(bmax) ^ simd_order_bias<T>()));
+                    first1 += 4 - __builtin_popcount(static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(gt))));
+                }
+                first2 += 4;
+            } else {
+                first1 += 4;
+                first2 += 4;
+            }
+        }
+    }
+
+    template<class T, class Sink>
+    STL_TARGET_AVX2 void simd_set_intersection_avx2(const T *&first1, const T *last1,
+                                                    const T *&first2, const T *last2, Sink &sink) {
+        const __m256i bias = _mm256_set1_epi32(simd_order_bias<T>());
+        const __m256i next = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 7);
+        while (last1 - first1 >= 8 && last2 - first2 >= 8) {
+            const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first1));
+            const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first2));
+            // 128 位的每一半内部轮转 0 ~ 3 次，再交换两半后同样轮转，8 种排列互不依赖
+            const __m256i c = _mm256_permute2x128_si256(b, b, 1);
+            const __m256i eq = _mm256_or_si256(
+                    _mm256_or_si256(
+                            _mm256_or_si256(_mm256_cmpeq_epi32(a, b),
+                                            _mm256_cmpeq_epi32(a, _mm256_shuffle_epi32(b, _MM_SHUFFLE(0, 3, 2, 1)))),
+                            _mm256_or_si256(_mm256_cmpeq_epi32(a, _mm256_shuffle_epi32(b, _MM_SHUFFLE(1, 0, 3, 2))),
+                                            _mm256_cmpeq_epi32(a, _mm256_shuffle_epi32(b, _MM_SHUFFLE(2, 1, 0, 3))))),
+                    _mm256_or_si256(
+                            _mm256_or_si256(_mm256_cmpeq_epi32(a, c),
+                                            _mm256_cmpeq_epi32(a, _mm256_shuffle_epi32(c, _MM_SHUFFLE(0, 3, 2, 1)))),
+                            _mm256_or_si256(_mm256_cmpeq_epi32(a, _mm256_shuffle_epi32(c, _MM_SHUFFLE(1, 0, 3, 2))),
+                                            _mm256_cmpeq_epi32(a, _mm256_shuffle_epi32(c, _MM_SHUFFLE(2, 1, 0, 3))))));
+            const unsigned mask = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(eq)));
+            if (mask != 0) {
+                const __m256i dup = _mm256_or_si256(
+                        _mm256_cmpeq_epi32(a, _mm256_permutevar8x32_epi32(a, next)),
+                        _mm256_cmpeq_epi32(b, _mm256_permutevar8x32_epi32(b, next)));
+                if ((_mm256_movemask_ps(_mm256_castsi256_ps(dup)) & 0x7f) != 0) {
+                    simd_merge_blocks(first1, first2, 8, sink);
+                    continue;
+                }
+                simd_emit_mask(first1, mask, sink);
+            }
+            const T amax = first1[7], bmax = first2[7];
+            if (amax < bmax) {
+                if (!(amax < first2[0])) {
+                    const __m256i gt = _mm256_cmpgt_epi32(_mm256_xor_si256(b, bias),
+                                                          _mm256_set1_epi32(static_cast<int>(amax) ^ simd_order_bias<T>()));
+                    first2 += 8 - __builtin_popcount(static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(gt))));
+                }
+                first1 += 8;
+            } else if (bmax < amax) {
+                if (!(bmax < first1[0])) {
+                    const __m256i gt = _mm256_cmpgt_epi32(_mm256_xor_si256(a, bias),
+                                                          _mm256_set1_epi32(static_cast<int>(bmax) ^ simd_order_bias<T>()));
+                    first1 += 8 - __builtin_popcount(static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(gt))));
+                }
+                first2 += 8;
+            } else {
+                first1 += 8;
+                first2 += 8;
+            }
+        }
+        simd_set_intersection_sse2(first1, last1, first2, last2, sink);
+    }
+
+#endif // STL_SIMD
+
+/*****************************************************************************************/
+// simd_find
+// 在[first, last)中找到第一个等于 value 的元素，没有则返回 last
+/*****************************************************************************************/
+    template<class T>
+    const T *simd_find(const T *first, const T *last, T value) {
+        if (std::is_integral<T>::value && sizeof(T) == 1) {
+            if (first == last) return last;
+            const void *p = std::memchr(first, static_cast<unsigned char>(value), last - first);
+            return p ? static_cast<const T *>(p) : last;
+        }
+#ifdef STL_SIMD
+        return simd_has_avx2() ? simd_find_avx2(first, last, value) : simd_find_sse2(first, last, value);
+#else
+        for (; first != last; ++first) if (*first == value) return first;
+        return first;
+#endif
+    }
+
+/*****************************************************************************************/
+// simd_count
+// 统计[first, last)中等于 value 的元素个数
+/*****************************************************************************************/
+    template<class T>
+    size_t simd_count(const T *first, const T *last, T value) {
+#ifdef STL_SIMD
+        return simd_has_avx2() ? simd_count_avx2(first, last, value) : simd_count_sse2(first, last, value);
+#else
+        size_t n = 0;
+        for (; first != last; ++first) if (*first == value) ++n;
+        return n;
+#endif
+    }
+
+/*****************************************************************************************/
+// simd_mismatch
+// 平行比较 first1、first2 开始的 n 个元素，返回第一处失配的下标，全部相等时返回 n
+/*****************************************************************************************/
+    template<class T>
+    size_t simd_mismatch(const T *first1, const T *first2, size_t n) {
+#ifdef STL_SIMD
+        return simd_has_avx2() ? simd_mismatch_avx2(first1, first2, n) : simd_mismatch_sse2(first1, first2, n);
+#else
+        size_t i = 0;
+        for (; i != n; ++i) if (!(first1[i] == first2[i])) break;
+        return i;
+#endif
+    }
+
+/*****************************************************************************************/
+// simd_equal
+// 比较 first1、first2 开始的 n 个元素是否全部相等
+/*****************************************************************************************/
+    template<class T>
+    bool simd_equal(const T *first1, const T *first2, size_t n) {
+        // 整数按位相等即相等；浮点数的 +0.0 与 -0.0、NaN 不能按位比较
+        if (std::is_integral<T>::value) {
+            return n == 0 || std::memcmp(first1, first2, n * sizeof(T)) == 0;
+        }
+        return simd_mismatch(first1, first2, n) == n;
+    }
+
+/*****************************************************************************************/
+// simd_search
+// 在[first, last)中查找[pfirst, plast)的首次出现点，没有则返回 last，只用于单字节的整数类型
+/*****************************************************************************************/
+    template<class T>
+    const T *simd_search(const T *first, const T *last, const T *pfirst, const T *plast) {
+        static_assert(std::is_integral<T>::value && sizeof(T) == 1, "simd_search requires a byte type");
+        const size_t m = static_cast<size_t>(plast - pfirst);
+        if (m == 0) return first;
+        if (static_cast<size_t>(last - first) < m) return last;
+        if (m == 1) return simd_find(first, last, *pfirst);
+#ifdef STL_SIMD
+        const T *found = simd_has_avx2() ? simd_search_avx2(first, last, pfirst, m, &first)
+                                         : simd_search_sse2(first, last, pfirst, m, &first);
+        if (found) return found;
+#endif
+        // 剩下不足一组的候选位置，先用 memchr 找首字节
+        const T *end = last - (m - 1);
+        while (first != end) {
+            first = simd_find(first, end, *pfirst);
+            if (first == end) break;
+            if (std::memcmp(first + 1, pfirst + 1, m - 1) == 0) return first;
+            ++first;
+        }
+        return last;
+    }
+
+/*****************************************************************************************/
+// simd_fill
+// 从 first 开始用 value 填充 n 个元素，T 需要可平凡复制，返回 first + n
+/*****************************************************************************************/
+    // 填充样式的周期：元素大小与 32 的最小公倍数
+    constexpr size_t simd_fill_period(size_t size) {
+        return size * 32 / ((size & (~size + 1)) < 32 ? (size & (~size + 1)) : 32);
+    }
+
+    // 至少 256 字节的区间
+    template<class T>
+    T *simd_fill_large(T *first, size_t n, const T &value) {
+        const size_t total = n * sizeof(T);
+        unsigned char bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        size_t i = 1;
+        while (i < sizeof(T) && bytes[i] == bytes[0]) ++i;
+        if (i == sizeof(T)) {
+            std::memset(first, bytes[0], total);
+            return first + n;
+        }
+#ifdef STL_SIMD
+        char *const p = reinterpret_cast<char *>(first);
+        if (sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8) {
+            uint64_t word = 0;
+            for (size_t k = 0; k < 8; k += sizeof(T)) std::memcpy(reinterpret_cast<char *>(&word) + k, bytes, sizeof(T));
+            if (simd_has_avx2()) simd_fill_word_avx2(p, total, word);
+            else simd_fill_word_sse2(p, total, word);
+            return first + n;
+        }
+        // 其他大小的样式在栈上准备，元素不超过 64 字节时样式不超过 2 KB。
+        // 读取刚写入的样式要等待之前所有的写入完成，区间较长时这点开销才可以忽略
+        if (sizeof(T) <= 64 && total >= 1024) {
+            constexpr size_t period = simd_fill_period(sizeof(T) <= 64 ? sizeof(T) : 1);
+            char pat[period + 32];
+            for (size_t k = 0; k < period + 32; k += sizeof(T)) {
+                std::memcpy(pat + k, bytes, period + 32 - k < sizeof(T) ? period + 32 - k : sizeof(T));
+            }
+            if (simd_has_avx2()) simd_fill_bytes_avx2<period>(p, total, pat);
+            else simd_fill_bytes_sse2<period>(p, total, pat);
+            return first + n;
+        }
+#endif
+        for (i = 0; i < n; ++i) first[i] = value;
+        return first + n;
+    }
+
+    template<class T>
+    T *simd_fill(T *first, size_t n, const T &value) {
+        static_assert(std::is_trivially_copyable<T>::value, "simd_fill requires a trivially copyable type");
+        // 区间较短时准备样式的开销不值得，逐个写入
+        if (n * sizeof(T) >= 256) return simd_fill_large(first, n, value);
+        const T v = value;
+        for (size_t i = 0; i < n; ++i) first[i] = v;
+        return first + n;
+    }
+
+/*****************************************************************************************/
+// simd_copy_if
+// 把[first, last)中令 pred 为 true 的元素依次拷贝到 result，返回写入的尾后位置，两个区间不能重叠
+/*****************************************************************************************/
+    template<class T, class UnaryPredicate>
+    T *simd_copy_if(const T *first, const T *last, T *result, UnaryPredicate pred) {
+#ifdef STL_SIMD
+        if (sizeof(T) == 4 && simd_has_avx2()) {
+            return simd_compact_avx2<false>(first, last, result, pred);
+        }
+#endif
+        return simd_compact_scalar<false>(first, last, result, pred);
+    }
+
+/*****************************************************************************************/
+// simd_remove_if
+// 移除[first, last)中令 pred 为 true 的元素，保留的元素依次移到前部，返回新的尾后位置
+/*****************************************************************************************/
+    template<class T, class UnaryPredicate>
+    T *simd_remove_if(T *first, T *last, UnaryPredicate pred) {
+        // 第一个要移除的元素之前不需要移动
+        while (first != last && !pred(*first)) ++first;
+        if (first == last) return last;
+        simd_not_pred<UnaryPredicate> keep{pred};
+        const T *next = first + 1;
+#ifdef STL_SIMD
+        if (sizeof(T) == 4 && simd_has_avx2()) {
+            return simd_compact_avx2<true>(next, static_cast<const T *>(last), first, keep);
+        }
+#endif
+        return simd_compact_scalar<true>(next, static_cast<const T *>(last), first, keep);
+    }
+
+/*****************************************************************************************/
+// simd_reduce_add
+// 返回 init 与[first, last)中所有元素的和，整数按模回绕；浮点数分组累加，舍入与逐个相加可能不同
+/*****************************************************************************************/
+    template<class T>
+    T simd_reduce_add(const T *first, const T *last, T init) {
+#ifdef STL_SIMD
+        return simd_has_avx2() ? simd_reduce_add_avx2(first, last, init) : simd_reduce_add_sse2(first, last, init);
+#else
+        return simd_reduce_add_scalar(first, last, init);
+#endif
+    }
+
+/*****************************************************************************************/
+// simd_dot
+// 返回 init 加上 first1、first2 开始的 n 对元素的乘积之和，只用于浮点数
+/*****************************************************************************************/
+    template<class T>
+    T simd_dot(const T *first1, const T *first2, size_t n, T init) {
+        static_assert(std::is_floating_point<T>::value, "simd_dot requires a floating point type");
+#ifdef STL_SIMD
+        return simd_has_avx2() ? simd_dot_avx2(first1, first2, n, init) : simd_dot_sse2(first1, first2, n, init);
+#else
+        for (size_t i = 0; i < n; ++i) init = init + first1[i] * first2[i];
+        return init;
+#endif
+    }
+
+/*****************************************************************************************/
+// simd_inclusive_scan / simd_exclusive_scan
+// 以 init 为初值求[first, last)的前缀和写到 result，返回写入的尾后位置，result 可以等于 first
+// inclusive 的第 i 个结果包含 first[i]，exclusive 不包含
+/*****************************************************************************************/
+    template<class T>
+    T *simd_inclusive_scan(const T *first, const T *last, T *result, T init) {
+#ifdef STL_SIMD
+        if (sizeof(T) == 4 || sizeof(T) == 8) return simd_scan_sse2<true>(first, last, result, init);
+#endif
+        return simd_scan_scalar<true>(first, last, result, init);
+    }
+
+    template<class T>
+    T *simd_exclusive_scan(const T *first, const T *last, T *result, T init) {
+#ifdef STL_SIMD
+        if (sizeof(T) == 4 || sizeof(T) == 8) return simd_scan_sse2<false>(first, last, result, init);
+#endif
+        return simd_scan_scalar<false>(first, last, result, init);
+    }
+
+/*****************************************************************************************/
+// simd_swap_reversed / simd_reverse
+// 交换 first[i] 与 last[-1 - i]，i < k，[first, first + k) 与[last - k, last)不能重叠；
+// k 取元素个数的一半时就是原地反转[first, last)
+/*****************************************************************************************/
+    template<class T>
+    void simd_swap_reversed(T *first, T *last, size_t k) {
+#ifdef STL_SIMD
+        if (simd_has_avx2()) simd_swap_reversed_avx2(first, last, k);
+        else simd_swap_reversed_sse2(first, last, k);
+#else
+        simd_swap_reversed_scalar(first, last, k);
+#endif
+    }
+
+    template<class T>
+    void simd_reverse(T *first, T *last) {
+        stl::simd_swap_reversed(first, last, static_cast<size_t>(last - first) / 2);
+    }
+
+/*****************************************************************************************/
+// simd_reverse_copy
+// 把[first, last)逆序拷贝到 result，返回写入的尾后位置，两个区间不能重叠
+/*****************************************************************************************/
+    template<class T>
+    T *simd_reverse_copy(const T *first, const T *last, T *result) {
+#ifdef STL_SIMD
+        return simd_has_avx2() ? simd_reverse_copy_avx2(first, last, result)
+                               : simd_reverse_copy_sse2(first, last, result);
+#else
+        while (first != last) *result++ = *--last;
+        return result;
+#endif
+    }
+
+/*****************************************************************************************/
+// simd_set_intersection
+// 求两个有序(按 operator<)的 4 字节整数区间的交集，对交集中的每个元素依次调用 sink(p)，p 指向它在第一个区间中的位置
+/*****************************************************************************************/
+    template<class T, class Sink>
+    void simd_set_intersection(const T *first1, const T *last1, const T *first2, const T *last2, Sink &sink) {
+        static_assert(std::is_integral<T>::value && sizeof(T) == 4, "simd_set_intersection requires 4-byte integers");
+#ifdef STL_SIMD
+        if (simd_has_avx2()) simd_set_intersection_avx2(first1, last1, first2, last2, sink);
+        else simd_set_intersection_sse2(first1, last1, first2, last2, sink);
+#endif
+        while (first1 != last1 && first2 != last2) {
+            if (*first1 < *first2) {
+                ++first1;
+            } else if (*first2 < *first1) {
+                ++first2;
+            } else {
+                sink(first1);
+                ++first1;
+                ++first2;
+            }
+        }
+    }
+
+}   // namespace stl
+
+#endif //MYCPPSTL_SIMD_H
@@ -0,0 +1,175 @@
+#ifndef MYCPPSTL_THREAD_POOL_H
+#define MYCPPSTL_THREAD_POOL_H
+
+// 这个头文件包含一个类 thread_pool，多线程算法共用的线程池
+// thread_pool::instance() : 全局的线程池，第一次使用时创建，程序结束时回收
+// run(count, threads, f)  : 用至多 threads 个线程(包括调用线程)执行 f(0), f(1), ..., f(count - 1)，全部完成后返回
+
+// notes:
+//
+// 工作线程按需创建，之后一直保留，避免每次调用算法都要创建、回收线程。
+// 空闲的工作线程不够时补足到 threads - 1 个，总数不超过 THREAD_POOL_MAX_WORKERS；
+// 创建线程失败或者已经达到上限时，由现有的线程(至少有调用线程)完成全部下标
+//
+// 一次 run 调用对应一个任务，各线程用原子变量领取下一个下标。调用线程自己也领取下标，
+// 下标领完后把任务从队列中移除，再等待仍在执行的工作线程退出。调用线程只等待已经开始执行的下标，
+// 因此 f 内部可以再次调用 run(嵌套的并行)，工作线程都在忙时由调用线程独自完成，不会死锁
+//
+// 异常：f 抛出的第一个异常在全部下标结束后在调用线程中重新抛出，其余下标照常执行
+
+#include <cstddef>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+#include "vector.h"
+
+namespace stl {
+
+// 线程池最多保留的工作线程数
+#ifndef THREAD_POOL_MAX_WORKERS
+#define THREAD_POOL_MAX_WORKERS 256
+#endif
+
+    class thread_pool {
+    private:
+        // 一次 run 调用：执行 call(func, 0), ..., call(func, count - 1)
+        struct job {
+            void (*call)(void *, size_t);
+            void *func;
+            size_t count;
+            size_t slots;                   // 还可以加入的工作线程数，由 mutex_ 保护
+            size_t active;                  // 正在执行的工作线程数，由 mutex_ 保护
+            std::atomic<size_t> next;       // 下一个未领取的下标
+            std::exception_ptr error;       // 第一个异常，由 error_mutex 保护
+            std::mutex error_mutex;
+        };
+
+        std::mutex mutex_;
+        std::condition_variable wake_;      // 有新的任务，或者线程池即将析构
+        std::condition_variable done_;      // 某个任务的工作线程全部退出
+        stl::vector<std::thread> workers_;
+        stl::vector<job *> jobs_;           // 还有空位的任务，先进先出
+        size_t idle_;                       // 没有在执行任务的工作线程数
+        bool stop_;
+
+    public:
+        thread_pool() : idle_(0), stop_(false) {}
+
+        thread_pool(const thread_pool &) = delete;
+
+        thread_pool &operator=(const thread_pool &) = delete;
+
+        ~thread_pool() {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stop_ = true;
+            }
+            wake_.notify_all();
+            for (auto &th : workers_) th.join();
+        }
+
+        static thread_pool &instance() {
+            static thread_pool pool;
+            return pool;
+        }
+
+        // 目前的工作线程数
+        size_t size() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return workers_.size();
+        }
+
+        template<class Func>
+        void run(size_t count, size_t threads, Func &f) {
+            if (threads > count) threads = count;
+            if (threads <= 1) {
+                for (size_t i = 0; i < count; ++i) f(i);
+                return;
+            }
+            job j;
+            j.call = &invoke<Func>;
+            j.func = static_cast<void *>(&f);
+            j.count = count;
+            j.slots = threads - 1;
+            j.active = 0;
+            j.next.store(0, std::memory_order_relaxed);
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                add_workers(threads - 1);
+                if (!workers_.empty()) jobs_.push_back(&j);
+            }
+            for (size_t t = 1; t < threads; ++t) wake_.notify_one();
+
+            work(j);
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                for (auto it = jobs_.begin(); it != jobs_.end(); ++it) {
+                    if (*it == &j) {
+                        jobs_.erase(it);
+                        break;
+                    }
+                }
+                done_.wait(lock, [&] { return j.active == 0; });
+            }
+            if (j.error) std::rethrow_exception(j.error);
+        }
+
+    private:
+        template<class Func>
+        static void invoke(void *func, size_t i) {
+            (*static_cast<Func *>(func))(i);
+        }
+
+        static void work(job &j) {
+            for (size_t i = j.next.fetch_add(1); i < j.count; i = j.next.fetch_add(1)) {
+                try {
+                    j.call(j.func, i);
+                }
+                catch (...) {
+                    std::lock_guard<std::mutex> lock(j.error_mutex);
+                    if (!j.error) j.error = std::current_exception();
+                }
+            }
+        }
+
+        // 空闲的工作线程不足 wanted 个时补足，调用时持有 mutex_
+        void add_workers(size_t wanted) {
+            while (idle_ < wanted && workers_.size() < THREAD_POOL_MAX_WORKERS) {
+                try {
+                    // 先留好位置，免得线程已经创建而 push_back 失败
+                    if (workers_.size() == workers_.capacity()) workers_.reserve(workers_.size() * 2 + 4);
+                    workers_.push_back(std::thread(&thread_pool::worker_loop, this));
+                }
+                catch (...) {
+                    // 线程资源不足，由已有的线程完成
+                    break;
+                }
+                ++idle_;
+            }
+        }
+
+        void worker_loop() {
+            std::unique_lock<std::mutex> lock(mutex_);
+            for (;;) {
+                wake_.wait(lock, [&] { return stop_ || !jobs_.empty(); });
+                if (jobs_.empty()) return;
+                job *j = jobs_.front();
+                if (--j->slots == 0) jobs_.erase(jobs_.begin());
+                ++j->active;
+                --idle_;
+                lock.unlock();
+                work(*j);
+                lock.lock();
+                ++idle_;
+                // 调用线程在 active 为 0 后才会返回，之后不能再访问 j
+                if (--j->active == 0) done_.notify_all();
+            }
+        }
+    };
+
+}   // namespace stl
+
+#endif //MYCPPSTL_THREAD_POOL_H
@@ -0,0 +1,123 @@
+#ifndef MYCPPSTL_TOP_K_H
+#define MYCPPSTL_TOP_K_H
+
+// 这个头文件包含一个模板类 top_k
+// top_k : 流式的 top-k 累加器，逐个接收元素，始终保留其中最大的 k 个
+
+// notes:
+//
+// 内部是一个大小不超过 k 的堆，堆顶是已保留元素中最小的一个(门槛)，用 heap_algo.h 中的 push_heap / pop_heap 维护
+//   * 未满 k 个时直接 push_heap
+//   * 已满时新元素只需与门槛比较一次，大于门槛才 pop_heap 淘汰门槛、再 push_heap 新元素
+// 元素个数 n 远大于 k 时绝大多数元素在第一次比较时就被淘汰，总代价接近 O(n)
+//
+// "最大" 由比较函数 comp 定义：comp 为 less 时保留最大的 k 个，为 greater 时保留最小的 k 个
+// 相等的元素不会挤掉已保留的元素，即相等时先到的优先
+
+#include <cstddef>
+
+#include "heap_algo.h"
+#include "algo.h"
+#include "functional.h"
+#include "vector.h"
+#include "iterator.h"
+
+namespace stl {
+
+    template<class T, class Compared = stl::less<T>>
+    class top_k {
+    public:
+        typedef T value_type;
+        typedef const T *const_iterator;
+        typedef const T &const_reference;
+        typedef size_t size_type;
+
+    private:
+        // 堆使用相反的比较方式，使堆顶为已保留元素中最小的一个
+        struct heap_compare {
+            Compared comp;
+
+            bool operator()(const T &a, const T &b) const { return comp(b, a); }
+        };
+
+        stl::vector<T> heap_;
+        size_type k_;
+        heap_compare heap_comp_;
+
+    public:
+        explicit top_k(size_type k, Compared comp = Compared())
+                : k_(k), heap_comp_{comp} {
+            heap_.reserve(k);
+        }
+
+    public:
+        /// 容量相关操作
+
+        size_type size() const noexcept { return heap_.size(); }
+
+        size_type k() const noexcept { return k_; }
+
+        bool empty() const noexcept { return heap_.empty(); }
+
+        bool full() const noexcept { return heap_.size() == k_; }
+
+        /// 访问元素相关操作
+
+        // 门槛：已保留元素中最小的一个，之后的元素必须大于它才能被保留，调用前需保证不为空
+        const_reference threshold() const { return heap_.front(); }
+
+        // 已保留的元素，按堆的顺序排列
+        const_iterator begin() const noexcept { return heap_.begin(); }
+
+        const_iterator end() const noexcept { return heap_.end(); }
+
+        // 按从大到小的顺序返回已保留的元素
+        stl::vector<T> sorted() const {
+            stl::vector<T> result(heap_);
+            stl::sort_heap(result.begin(), result.end(), heap_comp_);
+            return result;
+        }
+
+        /// 修改容器相关操作
+
+        // 返回 value 是否被保留
+        bool push(const value_type &value) {
+            if (heap_.size() < k_) {
+                heap_.push_back(value);
+                stl::push_heap(heap_.begin(), heap_.end(), heap_comp_);
+                return true;
+            }
+            if (k_ == 0 || !heap_comp_.comp(heap_.front(), value)) return false;
+            // 淘汰门槛：pop_heap 把它移到末尾，再用新元素替换
+            stl::pop_heap(heap_.begin(), heap_.end(), heap_comp_);
+            heap_.back() = value;
+            stl::push_heap(heap_.begin(), heap_.end(), heap_comp_);
+            return true;
+        }
+
+        bool push(value_type &&value) {
+            if (heap_.size() < k_) {
+                heap_.push_back(stl::move(value));
+                stl::push_heap(heap_.begin(), heap_.end(), heap_comp_);
+                return true;
+            }
+            if (k_ == 0 || !heap_comp_.comp(heap_.front(), value)) return false;
+            stl::pop_heap(heap_.begin(), heap_.end(), heap_comp_);
+            heap_.back() = stl::move(value);
+            stl::push_heap(heap_.begin(), heap_.end(), heap_comp_);
+            return true;
+        }
+
+        // 依次接收[first, last)中的元素，只需要 input iterator
+        template<class IIter, typename std::enable_if<
+                stl::is_input_iterator<IIter>::value, int>::type = 0>
+        void push(IIter first, IIter last) {
+            for (; first != last; ++first) push(*first);
+        }
+
+        void clear() { heap_.clear(); }
+    };
+
+}   // namespace stl
+
+#endif //MYCPPSTL_TOP_K_H
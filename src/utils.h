@@ -93,9 +93,7 @@ namespace stl {
                 typename = typename std::enable_if<
                         std::is_default_constructible<Other1>::value &&
                         std::is_default_constructible<Other2>::value, void>::type>
-        constexpr pair():first(), second() {
-            std::cout << "pair default construct" << std::endl;
-        }
+        constexpr pair():first(), second() {}
 
         // implicit constructiable for this type
         template<class U1 = Ty1, class U2 = Ty2,
@@ -105,9 +103,7 @@ namespace stl {
                         std::is_convertible<const U1 &, U1>::value &&
                         std::is_convertible<const U2 &, Ty2>::value, int>::type = 0>
 //                        std::is_convertible<const U2 &, U2>::value, void>::type>
-        constexpr pair(const Ty1 &a, const Ty2 &b):first(a), second(b) {
-            std::cout << "implicit constructiable for this type" << std::endl;
-        }
+        constexpr pair(const Ty1 &a, const Ty2 &b):first(a), second(b) {}
 
         // explicit constructible for this type
         template<class U1 = Ty1, class U2 = Ty2,
@@ -117,9 +113,7 @@ namespace stl {
                         (!std::is_convertible<const U1 &, Ty1>::value ||
                          !std::is_convertible<const U2 &, Ty2>::value), int>::type = 0>
         explicit constexpr pair(const Ty1 &a, const Ty2 &b)
-                : first(a), second(b) {
-            std::cout << "explicit constructible for this type" << std::endl;
-        }
+                : first(a), second(b) {}
 
         pair(const pair &rhs) = default;
 
@@ -134,9 +128,7 @@ namespace stl {
                         std::is_convertible<Other2 &&, Ty2>::value, int>::type = 0>
         constexpr pair(Other1 &&a, Other2 &&b)
                 : first(stl::forward<Other1>(a)),
-                  second(stl::forward<Other2>(b)) {
-            std::cout << "implicit constructiable for other type" << std::endl;
-        }
+                  second(stl::forward<Other2>(b)) {}
 
         // implicit constructiable for other pair
         template<class Other1, class Other2,
@@ -147,9 +139,7 @@ namespace stl {
                         std::is_convertible<const Other2 &, Ty2>::value, int>::type = 0>
         constexpr pair(const pair<Other1, Other2> &other)
                 : first(other.first),
-                  second(other.second) {
-            std::cout << "implicit constructiable for other pair" << std::endl;
-        }
+                  second(other.second) {}
 
         // explicit constructiable for other pair
         template<class Other1, class Other2,
@@ -357,6 +357,7 @@ namespace stl {
             stl::uninitialized_copy(rhs.begin() + size(), rhs.end(), end_);
             end_ = begin_ + len;
         }
+        return *this;
     }
 
     template<class T>
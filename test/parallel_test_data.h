@@ -0,0 +1,46 @@
+#ifndef MYCPPSTL_PARALLEL_TEST_DATA_H
+#define MYCPPSTL_PARALLEL_TEST_DATA_H
+
+// 并行算法测试共用的输入规模、线程数、deque 输入与只能前进的迭代器
+
+#include <cstddef>
+#include <vector>
+
+#include "deque.h"
+#include "iterator.h"
+#include "parallel_algo.h"
+
+// 元素个数要超过若干个 PARALLEL_GRAIN_SIZE，保证确实用到了多个线程
+static const size_t kParallelTestSize = 8 * PARALLEL_GRAIN_SIZE + 123;
+
+static const size_t kThreads[] = {1, 2, 3, 8};
+
+// d 的内容为 v，再在前面插入 77 个元素(-76, ..., -1, 0)，使 begin() 不在缓冲区的开头
+inline void fill_offset_deque(stl::deque<int> &d, const std::vector<int> &v) {
+    for (int x : v) d.push_back(x);
+    for (int i = 0; i < 77; ++i) d.push_front(-i);
+}
+
+// 只支持前进的迭代器，检查退化为顺序版本的情况
+struct forward_int_iter {
+    typedef stl::forward_iterator_tag iterator_category;
+    typedef int value_type;
+    typedef ptrdiff_t difference_type;
+    typedef int *pointer;
+    typedef int &reference;
+
+    int *p;
+
+    reference operator*() const { return *p; }
+
+    forward_int_iter &operator++() {
+        ++p;
+        return *this;
+    }
+
+    bool operator==(const forward_int_iter &rhs) const { return p == rhs.p; }
+
+    bool operator!=(const forward_int_iter &rhs) const { return p != rhs.p; }
+};
+
+#endif //MYCPPSTL_PARALLEL_TEST_DATA_H
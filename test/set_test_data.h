@@ -0,0 +1,35 @@
+#ifndef MYCPPSTL_SET_TEST_DATA_H
+#define MYCPPSTL_SET_TEST_DATA_H
+
+// 集合算法测试共用的有序随机输入，以及 std 的 set 算法算出的期望结果
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <vector>
+
+// 有序的随机序列，元素取自 [0, range)，allow_dup 为 false 时严格递增
+template<class T>
+std::vector<T> sorted_random(size_t n, uint64_t range, bool allow_dup, std::mt19937_64 &rng) {
+    std::vector<T> v(n);
+    for (auto &x : v) x = static_cast<T>(rng() % range);
+    std::sort(v.begin(), v.end());
+    if (!allow_dup) v.erase(std::unique(v.begin(), v.end()), v.end());
+    return v;
+}
+
+// 有序序列 a、b 的并集、交集与差集，有重复元素时与 std 的结果相同
+template<class T>
+struct set_expect {
+    std::vector<T> uni, inter, diff;
+
+    set_expect(const std::vector<T> &a, const std::vector<T> &b) {
+        std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(uni));
+        std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(inter));
+        std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(diff));
+    }
+};
+
+#endif //MYCPPSTL_SET_TEST_DATA_H
@@ -0,0 +1,558 @@
+#include <string>
+#include <algorithm>
+#include <vector>
+#include <random>
+
+#include "algo.h"
+#include "vector.h"
+#include "deque.h"
+#include "gtest/gtest.h"
+
+// 生成各种分布的测试数据
+class StlSortTest : public testing::Test {
+protected:
+    enum pattern {
+        kRandom, kSorted, kReversed, kOrganPipe, kFewUnique, kSawtooth, kPatternCount
+    };
+
+    static std::vector<int> make_input(pattern p, int n, std::mt19937 &rng) {
+        std::vector<int> a(n);
+        for (int i = 0; i < n; ++i) {
+            switch (p) {
+                case kRandom:
+                    a[i] = static_cast<int>(rng() % 1000000);
+                    break;
+                case kSorted:
+                    a[i] = i;
+                    break;
+                case kReversed:
+                    a[i] = n - i;
+                    break;
+                case kOrganPipe:
+                    a[i] = i < n / 2 ? i : n - i;
+                    break;
+                case kFewUnique:
+                    a[i] = static_cast<int>(rng() % 4);
+                    break;
+                default:
+                    a[i] = i % 97;
+                    break;
+            }
+        }
+        return a;
+    }
+
+    // 所有分布和一些长度的组合
+    template<class Func>
+    static void for_each_input(Func f) {
+        std::mt19937 rng(2023);
+        const int sizes[] = {0, 1, 2, 3, 10, 23, 24, 25, 100, 129, 1000, 5000};
+        for (int p = 0; p < kPatternCount; ++p)
+            for (int n : sizes)
+                f(make_input(static_cast<pattern>(p), n, rng));
+    }
+};
+
+TEST_F(StlSortTest, sort) {
+    for_each_input([](const std::vector<int> &input) {
+        std::vector<int> expect = input;
+        std::sort(expect.begin(), expect.end());
+
+        stl::vector<int> v(input.data(), input.data() + input.size());
+        stl::sort(v.begin(), v.end());
+        EXPECT_TRUE(std::equal(v.begin(), v.end(), expect.begin()));
+        EXPECT_TRUE(stl::is_sorted(v.begin(), v.end()));
+    });
+}
+
+TEST_F(StlSortTest, sort_comp) {
+    for_each_input([](const std::vector<int> &input) {
+        std::vector<int> expect = input;
+        std::sort(expect.begin(), expect.end(), std::greater<int>());
+
+        // 使用 stl::greater 时走无分支划分，使用 lambda 时走普通划分
+        stl::vector<int> v1(input.data(), input.data() + input.size());
+        stl::sort(v1.begin(), v1.end(), stl::greater<int>());
+        EXPECT_TRUE(std::equal(v1.begin(), v1.end(), expect.begin()));
+
+        stl::vector<int> v2(input.data(), input.data() + input.size());
+        stl::sort(v2.begin(), v2.end(), [](int a, int b) { return a > b; });
+        EXPECT_TRUE(std::equal(v2.begin(), v2.end(), expect.begin()));
+    });
+}
+
+TEST_F(StlSortTest, sort_string_deque) {
+    for_each_input([](const std::vector<int> &input) {
+        std::vector<std::string> expect;
+        for (int x : input) expect.push_back(std::to_string(x));
+        stl::deque<std::string> d;
+        d.append(expect.data(), expect.data() + expect.size());
+        std::sort(expect.begin(), expect.end());
+
+        stl::sort(d.begin(), d.end());
+        EXPECT_EQ(d.size(), expect.size());
+        EXPECT_TRUE(std::equal(expect.begin(), expect.end(), d.begin()));
+    });
+}
+
+// 按 key 比较，用 idx 检查稳定性
+struct KeyIdx {
+    int key;
+    int idx;
+
+    bool operator==(const KeyIdx &rhs) const { return key == rhs.key && idx == rhs.idx; }
+};
+
+struct KeyLess {
+    bool operator()(const KeyIdx &a, const KeyIdx &b) const { return a.key < b.key; }
+};
+
+static std::vector<KeyIdx> with_index(const std::vector<int> &input, int modulo) {
+    std::vector<KeyIdx> v;
+    for (size_t i = 0; i < input.size(); ++i) v.push_back(KeyIdx{input[i] % modulo, static_cast<int>(i)});
+    return v;
+}
+
+TEST_F(StlSortTest, stable_sort) {
+    for_each_input([](const std::vector<int> &input) {
+        // 取模制造大量相等的元素
+        std::vector<KeyIdx> expect = with_index(input, 50);
+        std::vector<KeyIdx> v = expect;
+        std::stable_sort(expect.begin(), expect.end(), KeyLess());
+        stl::stable_sort(v.data(), v.data() + v.size(), KeyLess());
+        EXPECT_EQ(v, expect);
+
+        std::vector<int> a = input;
+        std::vector<int> b = input;
+        std::sort(b.begin(), b.end());
+        stl::stable_sort(a.data(), a.data() + a.size());
+        EXPECT_EQ(a, b);
+    });
+}
+
+TEST(StlStableSortTest, natural_runs) {
+    // 基本有序：有序序列中随机交换少量元素，再拼接一段严格降序和一段重复的降序
+    std::mt19937 rng(7);
+    std::vector<int> input;
+    for (int i = 0; i < 100000; ++i) input.push_back(i);
+    for (int i = 0; i < 100; ++i) std::swap(input[rng() % input.size()], input[rng() % input.size()]);
+    for (int i = 5000; i > 0; --i) input.push_back(i);
+    for (int i = 5000; i > 0; --i) input.push_back(i / 3);
+
+    std::vector<KeyIdx> expect = with_index(input, 1 << 30);
+    std::vector<KeyIdx> v = expect;
+    std::stable_sort(expect.begin(), expect.end(), KeyLess());
+    stl::stable_sort(v.data(), v.data() + v.size(), KeyLess());
+    EXPECT_EQ(v, expect);
+
+    std::vector<std::string> s;
+    for (int x : input) s.push_back(std::to_string(x % 1000));
+    std::vector<std::string> expect_s = s;
+    std::stable_sort(expect_s.begin(), expect_s.end());
+    stl::stable_sort(s.data(), s.data() + s.size());
+    EXPECT_EQ(s, expect_s);
+}
+
+TEST(StlInplaceMergeTest, inplace_merge) {
+    std::mt19937 rng(11);
+    const int sizes[] = {0, 1, 2, 7, 100, 3000};
+    for (int n : sizes) {
+        for (int mid = 0; mid <= n; mid += (n / 5 > 0 ? n / 5 : 1)) {
+            std::vector<int> keys;
+            for (int i = 0; i < n; ++i) keys.push_back(static_cast<int>(rng() % 20));
+            std::vector<KeyIdx> input = with_index(keys, 20);
+            std::stable_sort(input.begin(), input.begin() + mid, KeyLess());
+            std::stable_sort(input.begin() + mid, input.end(), KeyLess());
+            std::vector<KeyIdx> expect = input;
+            std::inplace_merge(expect.begin(), expect.begin() + mid, expect.end(), KeyLess());
+
+            std::vector<KeyIdx> v = input;
+            stl::inplace_merge(v.data(), v.data() + mid, v.data() + n, KeyLess());
+            EXPECT_EQ(v, expect);
+
+            // 没有缓冲区
+            v = input;
+            stl::merge_without_buffer(v.data(), v.data() + mid, v.data() + n,
+                                      static_cast<ptrdiff_t>(mid), static_cast<ptrdiff_t>(n - mid), KeyLess());
+            EXPECT_EQ(v, expect);
+
+            // 缓冲区只有几个元素，需要拆分子问题
+            v = input;
+            KeyIdx small_buffer[3];
+            stl::merge_adaptive(v.data(), v.data() + mid, v.data() + n,
+                                static_cast<ptrdiff_t>(mid), static_cast<ptrdiff_t>(n - mid),
+                                small_buffer, static_cast<ptrdiff_t>(3), KeyLess());
+            EXPECT_EQ(v, expect);
+        }
+    }
+
+    // 非平凡的元素类型
+    stl::deque<std::string> d;
+    const char *words[] = {"b", "d", "f", "a", "c", "e", "g"};
+    d.append(words, words + 7);
+    stl::inplace_merge(d.begin(), d.begin() + 3, d.end());
+    const char *expect[] = {"a", "b", "c", "d", "e", "f", "g"};
+    EXPECT_TRUE(std::equal(expect, expect + 7, d.begin()));
+}
+
+TEST_F(StlSortTest, nth_element) {
+    for_each_input([](const std::vector<int> &input) {
+        if (input.empty()) return;
+        std::vector<int> expect = input;
+        std::sort(expect.begin(), expect.end());
+        const size_t n = input.size();
+        const size_t positions[] = {0, n / 3, n / 2, n - 1};
+        for (size_t pos : positions) {
+            stl::vector<int> v(input.data(), input.data() + n);
+            stl::nth_element(v.begin(), v.begin() + pos, v.end());
+            EXPECT_EQ(v[pos], expect[pos]);
+            for (size_t i = 0; i < pos; ++i) ASSERT_LE(v[i], v[pos]);
+            for (size_t i = pos + 1; i < n; ++i) ASSERT_GE(v[i], v[pos]);
+
+            stl::vector<int> w(input.data(), input.data() + n);
+            stl::nth_element(w.begin(), w.begin() + pos, w.end(), [](int a, int b) { return a > b; });
+            EXPECT_EQ(w[pos], expect[n - 1 - pos]);
+        }
+    });
+}
+
+TEST(StlNthElementTest, median_of_medians) {
+    // 直接测试保证线性的回退路径
+    std::mt19937 rng(5);
+    for (int n = 1; n < 3000; n = n * 3 + 1) {
+        std::vector<int> input;
+        for (int i = 0; i < n; ++i) input.push_back(static_cast<int>(rng() % (n / 2 + 1)));
+        std::vector<int> expect = input;
+        std::sort(expect.begin(), expect.end());
+        for (int pos = 0; pos < n; pos += n / 7 + 1) {
+            std::vector<int> v = input;
+            stl::median_of_medians_select(v.data(), v.data() + pos, v.data() + n, stl::less<int>());
+            EXPECT_EQ(v[pos], expect[pos]);
+            for (int i = 0; i < pos; ++i) ASSERT_LE(v[i], v[pos]);
+            for (int i = pos + 1; i < n; ++i) ASSERT_GE(v[i], v[pos]);
+        }
+    }
+}
+
+TEST_F(StlSortTest, partial_sort) {
+    for_each_input([](const std::vector<int> &input) {
+        std::vector<int> expect = input;
+        std::sort(expect.begin(), expect.end());
+        const size_t n = input.size();
+        const size_t ks[] = {0, 1, n / 20, n / 2, n};
+        for (size_t k : ks) {
+            if (k > n) continue;
+            stl::vector<int> v(input.data(), input.data() + n);
+            stl::partial_sort(v.begin(), v.begin() + k, v.end());
+            EXPECT_TRUE(std::equal(v.begin(), v.begin() + k, expect.begin()));
+            std::vector<int> rest(v.begin() + k, v.end());
+            std::sort(rest.begin(), rest.end());
+            EXPECT_TRUE(std::equal(rest.begin(), rest.end(), expect.begin() + k));
+
+            std::vector<std::string> s;
+            for (int x : input) s.push_back(std::to_string(x));
+            std::vector<std::string> expect_s = s;
+            std::sort(expect_s.begin(), expect_s.end());
+            stl::partial_sort(s.data(), s.data() + k, s.data() + n);
+            EXPECT_TRUE(std::equal(s.begin(), s.begin() + k, expect_s.begin()));
+        }
+    });
+}
+
+TEST(StlPartialSortTest, heap_path) {
+    // k 远小于 n 时使用堆
+    std::mt19937 rng(9);
+    std::vector<std::string> input;
+    for (int i = 0; i < 100000; ++i) input.push_back(std::to_string(rng() % 50000));
+    std::vector<std::string> expect = input;
+    std::sort(expect.begin(), expect.end());
+    const size_t ks[] = {1, 2, 7, 20};
+    for (size_t k : ks) {
+        std::vector<std::string> v = input;
+        stl::partial_sort(v.data(), v.data() + k, v.data() + v.size());
+        EXPECT_TRUE(std::equal(v.begin(), v.begin() + k, expect.begin()));
+    }
+}
+
+TEST(StlPartialSortCopyTest, partial_sort_copy) {
+    int a[] = {5, 9, 1, 7, 3, 8, 2, 6, 4, 0};
+    int out[4];
+    int *end = stl::partial_sort_copy(a, a + 10, out, out + 4);
+    EXPECT_EQ(end, out + 4);
+    const int expect[] = {0, 1, 2, 3};
+    EXPECT_TRUE(std::equal(out, out + 4, expect));
+
+    // 结果空间比输入大
+    int big[12];
+    end = stl::partial_sort_copy(a, a + 10, big, big + 12, stl::greater<int>());
+    EXPECT_EQ(end, big + 10);
+    EXPECT_EQ(big[0], 9);
+    EXPECT_EQ(big[9], 0);
+
+    EXPECT_EQ(stl::partial_sort_copy(a, a + 10, out, out), out);
+}
+
+TEST(StlHeapTest, heap_comp) {
+    int a[] = {5, 1, 9, 3, 7, 2, 8};
+    stl::make_heap(a, a + 7, stl::greater<int>());
+    EXPECT_EQ(a[0], 1);
+    stl::sort_heap(a, a + 7, stl::greater<int>());
+    const int expect[] = {9, 8, 7, 5, 3, 2, 1};
+    EXPECT_TRUE(std::equal(a, a + 7, expect));
+}
+
+// 统计拷贝的次数，调整堆时只应该移动元素
+struct heap_counted {
+    static int copies;
+    int key;
+
+    explicit heap_counted(int k = 0) : key(k) {}
+
+    heap_counted(const heap_counted &rhs) : key(rhs.key) { ++copies; }
+
+    heap_counted(heap_counted &&rhs) noexcept: key(rhs.key) {}
+
+    heap_counted &operator=(const heap_counted &rhs) {
+        key = rhs.key;
+        ++copies;
+        return *this;
+    }
+
+    heap_counted &operator=(heap_counted &&rhs) noexcept {
+        key = rhs.key;
+        return *this;
+    }
+
+    bool operator<(const heap_counted &rhs) const { return key < rhs.key; }
+};
+
+int heap_counted::copies = 0;
+
+TEST(StlHeapTest, no_copies) {
+    std::mt19937 rng(4);
+    std::vector<heap_counted> v;
+    for (int i = 0; i < 1000; ++i) v.push_back(heap_counted(static_cast<int>(rng() % 300)));
+    heap_counted::copies = 0;
+    stl::make_heap(v.data(), v.data() + v.size());
+    for (size_t i = 1; i <= v.size(); ++i) stl::push_heap(v.data(), v.data() + i);
+    stl::pop_heap(v.data(), v.data() + v.size());
+    stl::sort_heap(v.data(), v.data() + v.size());
+    stl::make_dary_heap<4>(v.data(), v.data() + v.size());
+    stl::push_dary_heap<4>(v.data(), v.data() + v.size());
+    stl::sort_dary_heap<4>(v.data(), v.data() + v.size());
+    EXPECT_EQ(heap_counted::copies, 0);
+    for (size_t i = 1; i < v.size(); ++i) EXPECT_FALSE(v[i] < v[i - 1]);
+}
+
+template<size_t D>
+void check_dary_heap(std::mt19937 &rng) {
+    for (size_t n : {0, 1, 2, 3, 5, 17, 100, 1000}) {
+        std::vector<int> v(n);
+        for (auto &x : v) x = static_cast<int>(rng() % (n + 1));
+        std::vector<int> expect = v;
+        std::sort(expect.begin(), expect.end());
+
+        // Floyd 建堆后逐个弹出
+        std::vector<int> a = v;
+        stl::make_dary_heap<D>(a.data(), a.data() + n);
+        EXPECT_TRUE(stl::is_dary_heap<D>(a.data(), a.data() + n));
+        for (size_t len = n; len > 1; --len) {
+            stl::pop_dary_heap<D>(a.data(), a.data() + len);
+            ASSERT_TRUE(stl::is_dary_heap<D>(a.data(), a.data() + len - 1));
+        }
+        EXPECT_EQ(a, expect);
+
+        // 逐个插入后排序
+        a = v;
+        for (size_t len = 1; len <= n; ++len) {
+            stl::push_dary_heap<D>(a.data(), a.data() + len);
+            ASSERT_TRUE(stl::is_dary_heap<D>(a.data(), a.data() + len));
+        }
+        stl::sort_dary_heap<D>(a.data(), a.data() + n);
+        EXPECT_EQ(a, expect);
+
+        // 小顶堆
+        a = v;
+        stl::make_dary_heap<D>(a.data(), a.data() + n, stl::greater<int>());
+        EXPECT_TRUE(stl::is_dary_heap<D>(a.data(), a.data() + n, stl::greater<int>()));
+        stl::sort_dary_heap<D>(a.data(), a.data() + n, stl::greater<int>());
+        EXPECT_TRUE(std::equal(a.begin(), a.end(), expect.rbegin()));
+    }
+}
+
+TEST(StlHeapTest, dary_heap) {
+    std::mt19937 rng(6);
+    check_dary_heap<2>(rng);
+    check_dary_heap<3>(rng);
+    check_dary_heap<4>(rng);
+    check_dary_heap<8>(rng);
+
+    // D = 2 时与二叉堆的布局相同
+    int a[] = {5, 1, 9, 3, 7, 2, 8};
+    stl::make_heap(a, a + 7);
+    EXPECT_TRUE(stl::is_dary_heap<2>(a, a + 7));
+    EXPECT_TRUE(stl::is_heap(a, a + 7));
+
+    // deque 的迭代器
+    stl::deque<std::string> d;
+    for (int i = 0; i < 300; ++i) d.push_back(std::to_string(rng() % 1000));
+    stl::make_dary_heap<4>(d.begin(), d.end());
+    EXPECT_TRUE(stl::is_dary_heap<4>(d.begin(), d.end()));
+    stl::sort_dary_heap<4>(d.begin(), d.end());
+    for (size_t i = 1; i < d.size(); ++i) EXPECT_FALSE(d[i] < d[i - 1]);
+}
+
+TEST(StlBinarySearchTest, bounds_and_equal_range) {
+    std::mt19937 rng(11);
+    for (size_t n = 0; n < 200; ++n) {
+        std::vector<int> v(n + 1);       // 多一个元素，避免空区间时 data() 为空
+        for (size_t i = 0; i < n; ++i) v[i] = static_cast<int>(rng() % (n / 3 + 1)) * 2;
+        std::sort(v.begin(), v.begin() + n);
+        const int *first = v.data(), *last = v.data() + n;
+        stl::deque<int> d(first, last);
+        for (int x = -1; x <= static_cast<int>(n) + 1; ++x) {
+            const int *lb = std::lower_bound(first, last, x), *ub = std::upper_bound(first, last, x);
+            EXPECT_EQ(stl::lower_bound(first, last, x), lb);
+            EXPECT_EQ(stl::upper_bound(first, last, x), ub);
+            EXPECT_EQ(stl::lower_bound(first, last, x, stl::less<int>()), lb);
+            EXPECT_EQ(stl::upper_bound(first, last, x, stl::less<int>()), ub);
+            const auto r = stl::equal_range(first, last, x);
+            EXPECT_EQ(r.first, lb);
+            EXPECT_EQ(r.second, ub);
+            const auto rc = stl::equal_range(first, last, x, stl::less<int>());
+            EXPECT_EQ(rc.first, lb);
+            EXPECT_EQ(rc.second, ub);
+            EXPECT_EQ(stl::binary_search(first, last, x), lb != ub);
+            // deque 的迭代器不是指针，不做预取
+            EXPECT_EQ(stl::lower_bound(d.begin(), d.end(), x) - d.begin(), lb - first);
+            EXPECT_EQ(stl::equal_range(d.begin(), d.end(), x).second - d.begin(), ub - first);
+        }
+    }
+}
+
+TEST(StlBinarySearchTest, equal_range_long_run) {
+    // 倍增查找右端时跨过很长的一段相等元素
+    std::vector<int> v(1000, 5);
+    for (int i = 0; i < 100; ++i) v[i] = 1;
+    for (int i = 900; i < 1000; ++i) v[i] = 9;
+    const auto r = stl::equal_range(v.data(), v.data() + 1000, 5);
+    EXPECT_EQ(r.first, v.data() + 100);
+    EXPECT_EQ(r.second, v.data() + 900);
+    const auto r2 = stl::equal_range(v.data(), v.data() + 1000, 9);
+    EXPECT_EQ(r2.first, v.data() + 900);
+    EXPECT_EQ(r2.second, v.data() + 1000);
+}
+
+TEST(StlBinarySearchTest, lower_bound_batch) {
+    std::mt19937 rng(12);
+    for (size_t n : {0, 1, 2, 7, 100, 1000}) {
+        std::vector<unsigned> table(n + 1);
+        for (size_t i = 0; i < n; ++i) table[i] = rng() % 5000;
+        std::sort(table.begin(), table.begin() + n);
+        const unsigned *first = table.data(), *last = table.data() + n;
+
+        // 查找个数不是批大小的整数倍
+        std::vector<unsigned> queries(1000 + n % 7);
+        for (auto &q : queries) q = rng() % 5100;
+        std::vector<const unsigned *> out(queries.size());
+        auto end = stl::lower_bound_batch(first, last, queries.data(), queries.data() + queries.size(),
+                                          out.data());
+        EXPECT_EQ(end, out.data() + out.size());
+        for (size_t i = 0; i < queries.size(); ++i) {
+            EXPECT_EQ(out[i], std::lower_bound(first, last, queries[i]));
+        }
+
+        stl::lower_bound_batch(first, last, queries.data(), queries.data() + queries.size(),
+                               out.data(), stl::less<unsigned>());
+        for (size_t i = 0; i < queries.size(); ++i) {
+            EXPECT_EQ(out[i], std::lower_bound(first, last, queries[i]));
+        }
+    }
+}
+
+// 只支持前进(以及后退)的迭代器，用来测试 rotate 的 forward / bidirectional 版本
+template<class Category>
+struct category_iter {
+    typedef Category iterator_category;
+    typedef int value_type;
+    typedef ptrdiff_t difference_type;
+    typedef int *pointer;
+    typedef int &reference;
+
+    int *p;
+
+    reference operator*() const { return *p; }
+
+    category_iter &operator++() {
+        ++p;
+        return *this;
+    }
+
+    category_iter operator++(int) { return category_iter{p++}; }
+
+    category_iter &operator--() {
+        --p;
+        return *this;
+    }
+
+    category_iter operator--(int) { return category_iter{p--}; }
+
+    bool operator==(const category_iter &rhs) const { return p == rhs.p; }
+
+    bool operator!=(const category_iter &rhs) const { return p != rhs.p; }
+};
+
+// 较大的元素，较短的一侧很快就放不进 rotate 的缓冲区
+struct BigElem {
+    int key;
+    char pad[96];
+};
+
+TEST(StlRotateTest, rotate) {
+    const size_t lengths[] = {1, 2, 3, 10, 64, 1000, 5003};
+    for (size_t n : lengths) {
+        std::vector<int> base(n);
+        for (size_t i = 0; i < n; ++i) base[i] = static_cast<int>(i);
+        std::vector<size_t> shifts = {0, 1, n / 3, n / 2, n - 1, n};
+        if (n > 600) shifts.push_back(600);   // 较短的一侧放不进缓冲区
+        for (size_t k : shifts) {
+            std::vector<int> expect = base;
+            std::rotate(expect.begin(), expect.begin() + k, expect.end());
+
+            std::vector<int> a = base;
+            EXPECT_EQ(stl::rotate(a.data(), a.data() + k, a.data() + n), a.data() + (n - k));
+            EXPECT_EQ(a, expect);
+
+            a = base;
+            typedef category_iter<stl::forward_iterator_tag> fwd;
+            EXPECT_EQ(stl::rotate(fwd{a.data()}, fwd{a.data() + k}, fwd{a.data() + n}).p, a.data() + (n - k));
+            EXPECT_EQ(a, expect);
+
+            a = base;
+            typedef category_iter<stl::bidirectional_iterator_tag> bidi;
+            EXPECT_EQ(stl::rotate(bidi{a.data()}, bidi{a.data() + k}, bidi{a.data() + n}).p, a.data() + (n - k));
+            EXPECT_EQ(a, expect);
+
+            stl::deque<int> d(base.data(), base.data() + n);
+            EXPECT_EQ(stl::rotate(d.begin(), d.begin() + k, d.end()) - d.begin(), static_cast<ptrdiff_t>(n - k));
+            EXPECT_TRUE(std::equal(d.begin(), d.end(), expect.begin()));
+
+            // 非 trivially copyable 类型，n / min(l, r) 较小时走 cycle leader
+            std::vector<std::string> strs(n);
+            for (size_t i = 0; i < n; ++i) strs[i] = std::to_string(base[i]);
+            stl::rotate(strs.data(), strs.data() + k, strs.data() + n);
+            for (size_t i = 0; i < n; ++i) ASSERT_EQ(strs[i], std::to_string(expect[i]));
+
+            std::vector<BigElem> big(n);
+            for (size_t i = 0; i < n; ++i) big[i].key = base[i];
+            EXPECT_EQ(stl::rotate(big.data(), big.data() + k, big.data() + n), big.data() + (n - k));
+            for (size_t i = 0; i < n; ++i) ASSERT_EQ(big[i].key, expect[i]);
+        }
+    }
+}
+
+int main() {
+
+    ::testing::InitGoogleTest();
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,93 @@
+#include <string>
+#include <thread>
+#include <atomic>
+#include <vector>
+
+#include "concurrent_vector.h"
+#include "gtest/gtest.h"
+
+TEST(StlConcurrentVectorTest, single_thread) {
+    stl::concurrent_vector<int> v;
+    EXPECT_TRUE(v.empty());
+    EXPECT_EQ(v.capacity(), stl::concurrent_vector<int>::first_segment_size);
+
+    // 跨越多个段
+    for (int i = 0; i < 10000; ++i) EXPECT_EQ(v.push_back(i), static_cast<size_t>(i));
+    EXPECT_EQ(v.size(), 10000);
+    for (int i = 0; i < 10000; ++i) EXPECT_EQ(v[i], i);
+    EXPECT_EQ(v.at(9999), 9999);
+    EXPECT_THROW(v.at(10000), std::out_of_range);
+
+    // 已有元素的地址不会改变
+    int *p = &v[5];
+    for (int i = 0; i < 100000; ++i) v.push_back(i);
+    EXPECT_EQ(p, &v[5]);
+}
+
+TEST(StlConcurrentVectorTest, reserve) {
+    stl::concurrent_vector<std::string> v;
+    v.reserve(1000);
+    EXPECT_GE(v.capacity(), 1000);
+    EXPECT_EQ(v.size(), 0);
+    for (int i = 0; i < 1000; ++i) v.emplace_back(std::to_string(i));
+    EXPECT_EQ(v[999], "999");
+}
+
+TEST(StlConcurrentVectorTest, concurrent_push_back) {
+    const int thread_count = 4;
+    const int per_thread = 50000;
+    stl::concurrent_vector<long> v;
+    std::vector<std::thread> threads;
+    std::atomic<int> mismatch(0);
+
+    for (int t = 0; t < thread_count; ++t) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < per_thread; ++i) {
+                const long value = static_cast<long>(t) * per_thread + i;
+                const size_t idx = v.push_back(value);
+                // push_back 返回后本线程立即可以读取
+                if (v[idx] != value) ++mismatch;
+            }
+        });
+    }
+    for (auto &th : threads) th.join();
+
+    EXPECT_EQ(mismatch.load(), 0);
+    EXPECT_EQ(v.size(), static_cast<size_t>(thread_count * per_thread));
+
+    // 每个值恰好出现一次
+    std::vector<char> seen(thread_count * per_thread, 0);
+    for (size_t i = 0; i < v.size(); ++i) ++seen[v[i]];
+    for (char c : seen) EXPECT_EQ(c, 1);
+}
+
+TEST(StlConcurrentVectorTest, concurrent_reader) {
+    stl::concurrent_vector<int> v;
+    std::atomic<size_t> published(0);
+    std::atomic<bool> done(false);
+    std::atomic<int> mismatch(0);
+
+    // 写线程写完一个元素后通过published把下标告诉读线程
+    std::thread writer([&] {
+        for (int i = 0; i < 100000; ++i) {
+            const size_t idx = v.push_back(i);
+            published.store(idx + 1, std::memory_order_release);
+        }
+        done = true;
+    });
+    std::thread reader([&] {
+        while (!done) {
+            const size_t n = published.load(std::memory_order_acquire);
+            if (n > 0 && v[n - 1] != static_cast<int>(n - 1)) ++mismatch;
+        }
+    });
+    writer.join();
+    reader.join();
+    EXPECT_EQ(mismatch.load(), 0);
+}
+
+int main() {
+
+    ::testing::InitGoogleTest();
+    return RUN_ALL_TESTS();
+}
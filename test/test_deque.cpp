@@ -0,0 +1,323 @@
+#include <algorithm>
+#include <string>
+
+#include "deque.h"
+#include "vector.h"
+#include "gtest/gtest.h"
+
+class StlDequeIntTest : public testing::Test {
+protected:
+    virtual void SetUp() {
+        // 长度超过一个缓冲区，保证会跨越多个缓冲区
+        bs = stl::deque<int>::buffer_size;
+        n = 3 * bs + 7;
+        for (int i = 0; i < static_cast<int>(n); ++i) v.push_back(i);
+    }
+
+    stl::deque<int> d;
+    stl::vector<int> v;
+    size_t bs;
+    size_t n;
+};
+
+TEST_F(StlDequeIntTest, append) {
+    d.push_back(-1);
+    d.append(v.begin(), v.end());
+    EXPECT_EQ(d.size(), n + 1);
+    EXPECT_EQ(d.front(), -1);
+    EXPECT_EQ(d.back(), static_cast<int>(n) - 1);
+    int expect = -1;
+    for (auto it = d.begin(); it != d.end(); ++it, ++expect) EXPECT_EQ(*it, expect);
+
+    // 空区间什么也不做
+    d.append(v.begin(), v.begin());
+    EXPECT_EQ(d.size(), n + 1);
+
+    // 恰好填满当前缓冲区
+    stl::deque<int> d2;
+    d2.append(v.begin(), v.begin() + bs);
+    EXPECT_EQ(d2.size(), bs);
+    d2.push_back(100);
+    EXPECT_EQ(d2.back(), 100);
+}
+
+TEST_F(StlDequeIntTest, prepend) {
+    d.push_back(-1);
+    d.prepend(v.begin(), v.end());
+    EXPECT_EQ(d.size(), n + 1);
+    EXPECT_EQ(d.front(), 0);
+    EXPECT_EQ(d.back(), -1);
+    int expect = 0;
+    for (auto it = d.begin(); it != d.end() - 1; ++it, ++expect) EXPECT_EQ(*it, expect);
+
+    d.prepend(v.begin(), v.begin() + 3);
+    EXPECT_EQ(d.size(), n + 4);
+    EXPECT_EQ(d.front(), 0);
+    EXPECT_EQ(*(d.begin() + 3), 0);
+}
+
+// 只能单次遍历的输入迭代器，用于测试input_iterator_tag版本
+class IntInputIter : public stl::iterator<stl::input_iterator_tag, int> {
+public:
+    explicit IntInputIter(const int *p) : p_(p) {}
+
+    const int &operator*() const { return *p_; }
+
+    IntInputIter &operator++() {
+        ++p_;
+        return *this;
+    }
+
+    bool operator==(const IntInputIter &rhs) const { return p_ == rhs.p_; }
+
+    bool operator!=(const IntInputIter &rhs) const { return p_ != rhs.p_; }
+
+private:
+    const int *p_;
+};
+
+TEST_F(StlDequeIntTest, input_iterator) {
+    int a[] = {1, 2, 3, 4, 5};
+    d.append(IntInputIter(a), IntInputIter(a + 5));
+    EXPECT_EQ(d.size(), 5);
+    EXPECT_EQ(d.back(), 5);
+
+    // input迭代器的prepend依然保持原有的顺序
+    int b[] = {-2, -1, 0};
+    d.prepend(IntInputIter(b), IntInputIter(b + 3));
+    EXPECT_EQ(d.size(), 8);
+    EXPECT_EQ(d.front(), -2);
+    EXPECT_EQ(*(d.begin() + 2), 0);
+}
+
+TEST_F(StlDequeIntTest, pop_n) {
+    d.append(v.begin(), v.end());
+
+    d.pop_front_n(0);
+    d.pop_back_n(0);
+    EXPECT_EQ(d.size(), n);
+
+    d.pop_front_n(3);
+    EXPECT_EQ(d.size(), n - 3);
+    EXPECT_EQ(d.front(), 3);
+
+    // 跨越多个缓冲区
+    d.pop_front_n(bs + 1);
+    EXPECT_EQ(d.front(), static_cast<int>(bs) + 4);
+
+    d.pop_back_n(bs + 2);
+    EXPECT_EQ(d.back(), static_cast<int>(n - bs) - 3);
+    EXPECT_EQ(d.size(), n - 2 * bs - 6);
+
+    d.pop_back_n(d.size());
+    EXPECT_TRUE(d.empty());
+
+    // 删除之后依然可以正常插入
+    d.append(v.begin(), v.end());
+    d.pop_front_n(d.size());
+    EXPECT_TRUE(d.empty());
+    d.push_front(1);
+    d.push_back(2);
+    EXPECT_EQ(d.front(), 1);
+    EXPECT_EQ(d.back(), 2);
+}
+
+TEST_F(StlDequeIntTest, reclaim) {
+    d.set_reclaim_policy(1, 4);
+    d.append(v.begin(), v.end());
+    EXPECT_EQ(d.back_spare_nodes(), 0);
+
+    // 未超过上限时，空出的缓冲区保留下来供之后复用
+    d.pop_back_n(bs);
+    EXPECT_EQ(d.back_spare_nodes(), 1);
+    d.pop_front_n(bs);
+    EXPECT_EQ(d.front_spare_nodes(), 1);
+    d.push_front(-1);
+    EXPECT_EQ(d.front_spare_nodes(), 0);
+    EXPECT_EQ(d.front(), -1);
+
+    // 超过上限时，一次性释放到下限
+    for (int i = 0; i < static_cast<int>(8 * bs); ++i) d.push_back(i);
+    d.pop_back_n(6 * bs);
+    EXPECT_EQ(d.back_spare_nodes(), 1);
+
+    // 显式回收
+    d.pop_back_n(2 * bs);
+    d.trim(0);
+    EXPECT_EQ(d.front_spare_nodes(), 0);
+    EXPECT_EQ(d.back_spare_nodes(), 0);
+
+    // clear之后空出的缓冲区同样按策略回收
+    stl::deque<int> d2;
+    d2.set_reclaim_policy(2, 100);
+    d2.append(v.begin(), v.end());
+    d2.clear();
+    EXPECT_TRUE(d2.empty());
+    EXPECT_EQ(d2.back_spare_nodes(), 3);
+    d2.set_reclaim_policy(0, 2);
+    EXPECT_EQ(d2.back_spare_nodes(), 0);
+}
+
+TEST_F(StlDequeIntTest, reverse) {
+    for (size_t i = 0; i < n; ++i) d.push_back(v[i]);
+    d.push_front(-1);   // 首元素不在缓冲区的开头
+    // 起止位置取缓冲区内部、缓冲区边界附近与整个区间
+    const size_t points[] = {0, 1, bs - 1, bs, bs + 1, 2 * bs + 3, n, n + 1};
+    for (size_t a : points) {
+        for (size_t b : points) {
+            if (a > b) continue;
+            stl::vector<int> expect;
+            for (size_t i = 0; i < d.size(); ++i) expect.push_back(d[i]);
+            std::reverse(expect.begin() + a, expect.begin() + b);
+            stl::reverse(d.begin() + a, d.begin() + b);
+            for (size_t i = 0; i < d.size(); ++i) ASSERT_EQ(d[i], expect[i]);
+        }
+    }
+}
+
+TEST_F(StlDequeIntTest, shrink_to_fit) {
+    // 峰值之后map也会被收缩，收缩后的deque依然可以正常使用
+    for (int i = 0; i < 100; ++i) d.append(v.begin(), v.end());
+    d.pop_front_n(50 * n);
+    d.pop_back_n(50 * n - 2);
+    d.shrink_to_fit();
+    EXPECT_EQ(d.size(), 2);
+    EXPECT_EQ(d.front_spare_nodes(), 0);
+    EXPECT_EQ(d.back_spare_nodes(), 0);
+    EXPECT_EQ(d.front(), 0);
+    EXPECT_EQ(d.back(), 1);
+
+    d.prepend(v.begin(), v.end());
+    d.append(v.begin(), v.end());
+    EXPECT_EQ(d.size(), 2 * n + 2);
+    EXPECT_EQ(d.front(), 0);
+    EXPECT_EQ(d.back(), static_cast<int>(n) - 1);
+    EXPECT_EQ(*(d.begin() + n), 0);
+    EXPECT_EQ(*(d.begin() + n + 1), 1);
+}
+
+TEST_F(StlDequeIntTest, random_access) {
+    d.append(v.begin(), v.end());
+    d.prepend(v.begin(), v.begin() + 5);
+    d.pop_front_n(2);
+    // d: 2 3 4 0 1 2 ... n-1
+    EXPECT_EQ(d.at_index(0), 2);
+    EXPECT_EQ(d[3], 0);
+    for (size_t i = 3; i < d.size(); ++i) EXPECT_EQ(d.at_index(i), static_cast<int>(i) - 3);
+
+    // 迭代器向前、向后跨越多个缓冲区
+    auto it = d.begin();
+    it += static_cast<ptrdiff_t>(2 * bs + 10);
+    EXPECT_EQ(*it, static_cast<int>(2 * bs + 7));
+    it -= static_cast<ptrdiff_t>(bs + 1);
+    EXPECT_EQ(*it, static_cast<int>(bs + 6));
+    EXPECT_EQ(it - d.begin(), static_cast<ptrdiff_t>(bs + 9));
+    EXPECT_EQ(*(it - static_cast<ptrdiff_t>(bs + 9)), 2);
+
+    // 从end()向后退，负的偏移覆盖缓冲区边界上的每一种情况
+    for (size_t i = 0; i < d.size(); ++i)
+        EXPECT_EQ(*(d.end() - static_cast<ptrdiff_t>(d.size() - i)), d.at_index(i));
+}
+
+TEST_F(StlDequeIntTest, reserve) {
+    d.set_reclaim_policy(0, 1);
+    d.push_back(0);
+    d.reserve_back(5 * bs);
+    EXPECT_EQ(d.back_spare_nodes(), 5);
+
+    // 预留之后插入不会再申请缓冲区，已有元素的地址也不会改变
+    int *first = &d.front();
+    for (int i = 1; i < static_cast<int>(5 * bs); ++i) d.push_back(i);
+    EXPECT_EQ(d.back_spare_nodes(), 0);
+    EXPECT_EQ(&d.front(), first);
+    EXPECT_EQ(d.back(), static_cast<int>(5 * bs) - 1);
+
+    // 预留的缓冲区不受回收策略影响
+    d.pop_back_n(5 * bs - 1);
+    EXPECT_EQ(d.back_spare_nodes(), 5);
+
+    d.reserve_front(2 * bs);
+    EXPECT_EQ(d.front_spare_nodes(), 2);
+    d.prepend(v.begin(), v.begin() + 2 * bs);
+    EXPECT_EQ(d.front_spare_nodes(), 0);
+    EXPECT_EQ(d.size(), 2 * bs + 1);
+    EXPECT_EQ(d.front(), 0);
+    EXPECT_EQ(d.back(), 0);
+
+    // trim之后预留被取消
+    d.trim(0);
+    EXPECT_EQ(d.back_spare_nodes(), 0);
+
+    // 只扩充map，不分配缓冲区
+    stl::deque<int> d2;
+    d2.reserve_back(100 * bs, false);
+    d2.reserve_front(100 * bs, false);
+    EXPECT_EQ(d2.back_spare_nodes(), 0);
+    EXPECT_EQ(d2.front_spare_nodes(), 0);
+    d2.append(v.begin(), v.end());
+    d2.prepend(v.begin(), v.end());
+    EXPECT_EQ(d2.size(), 2 * n);
+    EXPECT_EQ(d2.at_index(n), 0);
+}
+
+// 大小为12字节，缓冲区大小不是2的幂
+struct Point3 {
+    int x, y, z;
+};
+
+TEST(StlDequeTest, random_access_non_pow2) {
+    stl::deque<Point3> d;
+    const int n = 2000;
+    for (int i = 0; i < n; ++i) d.push_back(Point3{i, 0, 0});
+    for (int i = 1; i <= 100; ++i) d.push_front(Point3{-i, 0, 0});
+    for (int i = 0; i < n + 100; ++i) EXPECT_EQ(d.at_index(i).x, i - 100);
+
+    auto it = d.end();
+    it -= 1500;
+    EXPECT_EQ(it->x, n - 1500);
+    it += 700;
+    EXPECT_EQ(it->x, n - 800);
+}
+
+class StlDequeStringTest : public testing::Test {
+protected:
+    virtual void SetUp() {
+        for (int i = 0; i < 300; ++i) v.push_back(std::to_string(i));
+    }
+
+    stl::deque<std::string> d;
+    stl::vector<std::string> v;
+};
+
+TEST_F(StlDequeStringTest, append_prepend) {
+    d.append(v.begin(), v.begin() + 150);
+    d.prepend(v.begin() + 150, v.end());
+    EXPECT_EQ(d.size(), 300);
+    EXPECT_EQ(d.front(), "150");
+    EXPECT_EQ(d.back(), "149");
+    EXPECT_EQ(*(d.begin() + 149), "299");
+    EXPECT_EQ(*(d.begin() + 150), "0");
+}
+
+TEST_F(StlDequeStringTest, pop_n) {
+    d.append(v.begin(), v.end());
+    d.pop_front_n(100);
+    d.pop_back_n(100);
+    EXPECT_EQ(d.size(), 100);
+    EXPECT_EQ(d.front(), "100");
+    EXPECT_EQ(d.back(), "199");
+}
+
+TEST_F(StlDequeStringTest, reverse) {
+    for (size_t i = 0; i < v.size(); ++i) d.push_back(v[i]);
+    stl::reverse(d.begin() + 3, d.end());
+    EXPECT_EQ(d[0], "0");
+    EXPECT_EQ(d[2], "2");
+    for (size_t i = 3; i < v.size(); ++i) EXPECT_EQ(d[i], v[v.size() + 2 - i]);
+}
+
+int main() {
+
+    ::testing::InitGoogleTest();
+    return RUN_ALL_TESTS();
+}
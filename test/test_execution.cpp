@@ -0,0 +1,209 @@
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "deque.h"
+#include "execution.h"
+#include "thread_pool.h"
+#include "parallel_test_data.h"
+#include "gtest/gtest.h"
+
+class StlExecutionTest : public testing::Test {
+protected:
+    virtual void SetUp() {
+        n = kParallelTestSize;
+        std::mt19937 gen(41);
+        for (size_t i = 0; i < n; ++i) v.push_back(static_cast<int>(gen() % 100000));
+        fill_offset_deque(d, v);
+    }
+
+    std::vector<int> v;
+    stl::deque<int> d;
+    size_t n;
+};
+
+TEST_F(StlExecutionTest, for_each_transform) {
+    for (size_t t : kThreads) {
+        // 每个元素恰好被访问一次
+        std::vector<int> a = v;
+        stl::for_each(stl::execution::par(t), a.data(), a.data() + a.size(), [](int &x) { x += 1; });
+        for (size_t i = 0; i < n; ++i) ASSERT_EQ(a[i], v[i] + 1);
+
+        stl::deque<int> b = d;
+        stl::for_each(stl::execution::par_unseq(t), b.begin(), b.end(), [](int &x) { x *= 2; });
+        auto it = d.begin();
+        for (auto x : b) ASSERT_EQ(x, *it++ * 2);
+
+        std::vector<int> out(n);
+        EXPECT_EQ(stl::transform(stl::execution::par(t), v.data(), v.data() + n, out.data(),
+                                 [](int x) { return x * 3; }), out.data() + n);
+        for (size_t i = 0; i < n; ++i) ASSERT_EQ(out[i], v[i] * 3);
+
+        // 输入为 deque，输出为 vector；二元版本
+        std::vector<long long> sum(d.size());
+        stl::transform(stl::execution::par(t), d.begin(), d.end(), d.begin(), sum.data(),
+                       [](int x, int y) { return static_cast<long long>(x) + y; });
+        for (size_t i = 0; i < d.size(); ++i) ASSERT_EQ(sum[i], 2LL * d[i]);
+
+        // 原地变换
+        a = v;
+        stl::transform(stl::execution::par(t), a.data(), a.data() + a.size(), a.data(), [](int x) { return -x; });
+        for (size_t i = 0; i < n; ++i) ASSERT_EQ(a[i], -v[i]);
+    }
+}
+
+TEST_F(StlExecutionTest, count_find) {
+    auto even = [](int x) { return x % 2 == 0; };
+    const size_t expect_count = static_cast<size_t>(std::count_if(v.data(), v.data() + n, even));
+    for (size_t t : kThreads) {
+        EXPECT_EQ(stl::count_if(stl::execution::par(t), v.data(), v.data() + n, even), expect_count);
+        EXPECT_EQ(stl::count_if(stl::execution::par(t), d.begin(), d.end(), even),
+                  stl::count_if(d.begin(), d.end(), even));
+
+        // 匹配出现在不同的位置，每次都应返回第一个
+        const size_t positions[] = {0, 1, 5000, n / 3, n / 2 + 7, n - 1};
+        for (size_t pos : positions) {
+            std::vector<int> a(n, 0);
+            for (size_t i = pos; i < n; i += 1000) a[i] = 1;
+            auto is_one = [](int x) { return x == 1; };
+            EXPECT_EQ(stl::find_if(stl::execution::par(t), a.data(), a.data() + a.size(), is_one), a.data() + pos);
+            EXPECT_TRUE(stl::any_of(stl::execution::par(t), a.data(), a.data() + a.size(), is_one));
+            EXPECT_FALSE(stl::none_of(stl::execution::par(t), a.data(), a.data() + a.size(), is_one));
+            EXPECT_FALSE(stl::all_of(stl::execution::par(t), a.data(), a.data() + a.size(), [](int x) { return x == 0; }));
+
+            stl::deque<int> b(a.data(), a.data() + a.size());
+            b.push_front(0);
+            EXPECT_EQ(stl::find_if(stl::execution::par(t), b.begin(), b.end(), is_one) - b.begin(),
+                      static_cast<ptrdiff_t>(pos + 1));
+        }
+        // 没有匹配
+        EXPECT_EQ(stl::find_if(stl::execution::par(t), v.data(), v.data() + n, [](int x) { return x < 0; }),
+                  v.data() + n);
+        EXPECT_TRUE(stl::all_of(stl::execution::par(t), v.data(), v.data() + n, [](int x) { return x >= 0; }));
+        EXPECT_FALSE(stl::any_of(stl::execution::par(t), d.begin(), d.end(), [](int x) { return x > 100000; }));
+    }
+}
+
+TEST_F(StlExecutionTest, replace_generate) {
+    for (size_t t : kThreads) {
+        std::vector<int> a = v;
+        stl::replace_if(stl::execution::par(t), a.data(), a.data() + a.size(), [](int x) { return x < 50000; }, -1);
+        for (size_t i = 0; i < n; ++i) ASSERT_EQ(a[i], v[i] < 50000 ? -1 : v[i]);
+
+        stl::deque<int> b = d;
+        stl::replace_if(stl::execution::par(t), b.begin(), b.end(), [](int x) { return x < 0; }, 7);
+        EXPECT_EQ(stl::count(b.begin(), b.end(), 7), stl::count_if(d.begin(), d.end(), [](int x) {
+            return x < 0 || x == 7;
+        }));
+
+        // gen 被多个线程同时调用，这里用原子计数器，生成的值恰好是 0 到 n - 1 的一个排列
+        std::atomic<int> counter(0);
+        stl::generate(stl::execution::par(t), b.begin(), b.end(), [&] { return counter.fetch_add(1); });
+        std::vector<int> c;
+        for (int x : b) c.push_back(x);
+        std::sort(c.begin(), c.end());
+        for (size_t i = 0; i < c.size(); ++i) ASSERT_EQ(c[i], static_cast<int>(i));
+    }
+}
+
+TEST_F(StlExecutionTest, min_max_element) {
+    // 最小值与最大值各出现多次，应返回第一个
+    std::vector<int> a = v;
+    a[n / 5] = a[n / 2] = a[n - 3] = -5;
+    a[n / 7] = a[n / 3] = a[n - 1] = 200000;
+    stl::deque<int> b(a.data(), a.data() + a.size());
+    for (size_t t : kThreads) {
+        EXPECT_EQ(stl::min_element(stl::execution::par(t), a.data(), a.data() + a.size()), a.data() + n / 5);
+        EXPECT_EQ(stl::max_element(stl::execution::par(t), a.data(), a.data() + a.size()), a.data() + n / 7);
+        EXPECT_EQ(stl::min_element(stl::execution::par(t), b.begin(), b.end()) - b.begin(),
+                  static_cast<ptrdiff_t>(n / 5));
+        EXPECT_EQ(stl::max_element(stl::execution::par(t), b.begin(), b.end(), stl::greater<int>()) - b.begin(),
+                  static_cast<ptrdiff_t>(n / 5));
+        EXPECT_EQ(stl::min_element(stl::execution::par(t), v.data(), v.data() + n),
+                  std::min_element(v.data(), v.data() + n));
+        EXPECT_EQ(stl::max_element(stl::execution::par(t), v.data(), v.data() + n),
+                  std::max_element(v.data(), v.data() + n));
+    }
+    EXPECT_EQ(stl::min_element(stl::execution::par, a.data(), a.data()), a.data());
+}
+
+TEST_F(StlExecutionTest, shuffle) {
+    std::vector<int> sorted = v;
+    std::sort(sorted.begin(), sorted.end());
+    for (size_t t : kThreads) {
+        // 结果是原来元素的一个排列；相同的种子与线程数，结果相同
+        std::vector<int> a = v, b = v;
+        stl::wyrand g1(t), g2(t);
+        stl::shuffle(stl::execution::par(t), a.data(), a.data() + n, g1);
+        stl::shuffle(stl::execution::par(t), b.data(), b.data() + n, g2);
+        EXPECT_EQ(a, b);
+        EXPECT_NE(a, v);
+        std::sort(a.begin(), a.end());
+        EXPECT_EQ(a, sorted);
+
+        stl::deque<int> c = d;
+        stl::shuffle(stl::execution::par(t), c.begin(), c.end(), g1);
+        std::vector<int> x, y;
+        for (int e : c) x.push_back(e);
+        for (int e : d) y.push_back(e);
+        std::sort(x.begin(), x.end());
+        std::sort(y.begin(), y.end());
+        EXPECT_EQ(x, y);
+    }
+
+    // 原来在前 1/4 的元素，重排后在每个 1/4 中的个数大致相同
+    std::vector<int> a(n);
+    for (size_t i = 0; i < n; ++i) a[i] = static_cast<int>(i);
+    stl::xoshiro256pp g(3);
+    stl::shuffle(stl::execution::par(4), a.data(), a.data() + n, g);
+    size_t count[4] = {0, 0, 0, 0};
+    for (size_t i = 0; i < n; ++i) {
+        if (static_cast<size_t>(a[i]) < n / 4) ++count[i * 4 / n];
+    }
+    for (size_t c : count) EXPECT_NEAR(static_cast<double>(c), n / 16.0, 6 * std::sqrt(n / 16.0));
+}
+
+TEST(StlExecutionPolicyTest, sequential_fallback) {
+    int l[] = {5, 3, 8, 1, 9, 1};
+    forward_int_iter first{l}, last{l + 6};
+    EXPECT_EQ(stl::count_if(stl::execution::par, first, last, [](int x) { return x > 4; }), 3u);
+    EXPECT_EQ(stl::find_if(stl::execution::par, first, last, [](int x) { return x > 5; }).p, l + 2);
+    EXPECT_EQ(stl::min_element(stl::execution::par, first, last).p, l + 3);
+    EXPECT_EQ(stl::max_element(stl::execution::seq, first, last).p, l + 4);
+    stl::replace_if(stl::execution::par, first, last, [](int x) { return x == 1; }, 0);
+    EXPECT_EQ(std::count(l, l + 6, 0), 2);
+
+    std::vector<int> a = {1, 2, 3};
+    stl::for_each(stl::execution::seq, a.data(), a.data() + a.size(), [](int &x) { x *= 10; });
+    EXPECT_EQ(a, std::vector<int>({10, 20, 30}));
+    EXPECT_TRUE(stl::none_of(stl::execution::seq, a.data(), a.data() + a.size(), [](int x) { return x == 0; }));
+    EXPECT_TRUE((stl::is_execution_policy<stl::execution::parallel_policy>::value));
+    EXPECT_FALSE((stl::is_execution_policy<int>::value));
+}
+
+TEST(StlExecutionPolicyTest, exception) {
+    std::vector<int> a(4 * PARALLEL_GRAIN_SIZE, 0);
+    a[3 * PARALLEL_GRAIN_SIZE] = 1;
+    EXPECT_THROW(stl::for_each(stl::execution::par(4), a.data(), a.data() + a.size(), [](int x) {
+        if (x == 1) throw std::runtime_error("element failed");
+    }), std::runtime_error);
+}
+
+TEST(StlThreadPoolTest, nested_run) {
+    // 任务内部再次并行，工作线程都在忙时由调用线程独自完成
+    std::atomic<size_t> total(0);
+    stl::parallel_run(8, 4, [&](size_t) {
+        stl::parallel_run(100, 4, [&](size_t i) { total.fetch_add(i); });
+    });
+    EXPECT_EQ(total.load(), 8u * 4950u);
+    EXPECT_GE(stl::thread_pool::instance().size(), 3u);
+}
+
+int main() {
+
+    ::testing::InitGoogleTest();
+    return RUN_ALL_TESTS();
+}
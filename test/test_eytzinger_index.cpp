@@ -0,0 +1,60 @@
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "eytzinger_index.h"
+#include "gtest/gtest.h"
+
+TEST(StlEytzingerIndexTest, positions) {
+    std::mt19937 rng(21);
+    // 覆盖最后一层为空、半满、全满的各种树
+    for (size_t n = 0; n < 300; ++n) {
+        std::vector<int> v(n + 1);
+        for (size_t i = 0; i < n; ++i) v[i] = static_cast<int>(rng() % (n + 1)) * 2;
+        std::sort(v.begin(), v.begin() + n);
+        const int *first = v.data(), *last = v.data() + n;
+
+        stl::eytzinger_index<int> index(first, last);
+        EXPECT_EQ(index.size(), n);
+        for (int x = -1; x <= 2 * static_cast<int>(n) + 3; ++x) {
+            EXPECT_EQ(index.lower_bound(x), static_cast<size_t>(std::lower_bound(first, last, x) - first));
+            EXPECT_EQ(index.upper_bound(x), static_cast<size_t>(std::upper_bound(first, last, x) - first));
+            EXPECT_EQ(index.contains(x), std::binary_search(first, last, x));
+        }
+    }
+}
+
+TEST(StlEytzingerIndexTest, comp_and_strings) {
+    std::vector<std::string> v = {"pear", "kiwi", "fig", "date", "apple"};
+    stl::eytzinger_index<std::string, stl::greater<std::string>> index(v.data(), v.data() + v.size());
+    EXPECT_EQ(index.lower_bound("kiwi"), 1u);
+    EXPECT_EQ(index.upper_bound("kiwi"), 2u);
+    EXPECT_EQ(index.lower_bound("grape"), 2u);
+    EXPECT_EQ(index.lower_bound("a"), 5u);
+    EXPECT_TRUE(index.contains("date"));
+    EXPECT_FALSE(index.contains("plum"));
+
+    stl::eytzinger_index<int> empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(empty.lower_bound(3), 0u);
+    EXPECT_FALSE(empty.contains(3));
+}
+
+TEST(StlEytzingerIndexTest, large) {
+    std::vector<uint64_t> v;
+    for (uint64_t i = 0; i < 100000; ++i) v.push_back(i * 3);
+    stl::eytzinger_index<uint64_t> index(v.data(), v.data() + v.size());
+    std::mt19937_64 rng(22);
+    for (int i = 0; i < 100000; ++i) {
+        const uint64_t x = rng() % 300010;
+        EXPECT_EQ(index.lower_bound(x), static_cast<size_t>(std::lower_bound(v.begin(), v.end(), x) - v.begin()));
+    }
+}
+
+int main() {
+
+    ::testing::InitGoogleTest();
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,188 @@
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "inplace_set_algo.h"
+#include "functional.h"
+#include "set_test_data.h"
+#include "gtest/gtest.h"
+
+template<class T>
+static stl::vector<T> to_stl(const std::vector<T> &v) {
+    return stl::vector<T>(v.data(), v.data() + v.size());
+}
+
+template<class T>
+static std::vector<T> to_std(const stl::vector<T> &v) {
+    return std::vector<T>(v.begin(), v.end());
+}
+
+// 与 std 的 set 算法比较，range 较小时重复的元素很多
+template<class T>
+static void check_inplace(size_t n1, size_t n2, uint64_t range, std::mt19937_64 &rng) {
+    const std::vector<T> a = sorted_random<T>(n1, range, true, rng);
+    const std::vector<T> b = sorted_random<T>(n2, range, true, rng);
+    const set_expect<T> expect(a, b);
+
+    const stl::vector<T> other = to_stl(b);
+    stl::vector<T> v = to_stl(a);
+    stl::inplace_set_union(v, other);
+    EXPECT_EQ(to_std(v), expect.uni);
+    v = to_stl(a);
+    stl::inplace_set_intersection(v, other);
+    EXPECT_EQ(to_std(v), expect.inter);
+    v = to_stl(a);
+    stl::inplace_set_difference(v, other);
+    EXPECT_EQ(to_std(v), expect.diff);
+
+    v = to_stl(a);
+    stl::inplace_set_union(v, other, stl::less<T>());
+    EXPECT_EQ(to_std(v), expect.uni);
+    v = to_stl(a);
+    stl::inplace_set_intersection(v, other, stl::less<T>());
+    EXPECT_EQ(to_std(v), expect.inter);
+    v = to_stl(a);
+    stl::inplace_set_difference(v, other, stl::less<T>());
+    EXPECT_EQ(to_std(v), expect.diff);
+}
+
+TEST(StlInplaceSetTest, random) {
+    std::mt19937_64 rng(11);
+    const size_t sizes[] = {0, 1, 7, 100, 3000};
+    for (size_t n1 : sizes) {
+        for (size_t n2 : sizes) {
+            check_inplace<uint32_t>(n1, n2, 5, rng);
+            check_inplace<uint32_t>(n1, n2, 100000, rng);
+            check_inplace<int>(n1, n2, 3 * (n1 + n2) + 1, rng);
+            check_inplace<uint64_t>(n1, n2, 50, rng);
+        }
+    }
+    // 长度相差很多，交集与差集 galloping
+    check_inplace<uint32_t>(100000, 30, 1000000, rng);
+    check_inplace<int>(100000, 30, 1000000, rng);
+    check_inplace<uint32_t>(30, 100000, 1000000, rng);
+}
+
+TEST(StlInplaceSetTest, capacity) {
+    stl::vector<int> v, other;
+    for (int i = 0; i < 1000; i += 2) v.push_back(i);
+    for (int i = 0; i < 1000; i += 3) other.push_back(i);
+    v.reserve(2000);
+    const int *data = v.data();
+    stl::inplace_set_union(v, other);
+    EXPECT_EQ(v.data(), data);
+    EXPECT_EQ(v.size(), 667u);
+    EXPECT_TRUE(std::is_sorted(v.begin(), v.end()));
+
+    stl::inplace_set_intersection(v, other);
+    EXPECT_EQ(v.data(), data);
+    EXPECT_EQ(to_std(v), to_std(other));
+
+    stl::inplace_set_difference(v, other);
+    EXPECT_EQ(v.data(), data);
+    EXPECT_TRUE(v.empty());
+    EXPECT_EQ(v.capacity(), 2000u);
+
+    // 容量不够时只扩大一次
+    stl::vector<int> w(other);
+    stl::vector<int> odd;
+    for (int i = 1; i < 1000; i += 2) odd.push_back(i);
+    stl::inplace_set_union(w, odd);
+    EXPECT_EQ(w.size(), 667u);
+    EXPECT_TRUE(std::is_sorted(w.begin(), w.end()));
+
+    // 与自身运算
+    stl::inplace_set_union(w, w);
+    EXPECT_EQ(w.size(), 667u);
+    stl::inplace_set_intersection(w, w);
+    EXPECT_EQ(w.size(), 667u);
+    stl::inplace_set_difference(w, w);
+    EXPECT_TRUE(w.empty());
+}
+
+// 按 key 比较，用 from 区分元素来自哪个序列
+struct tagged {
+    int key;
+    int from;
+
+    bool operator==(const tagged &rhs) const { return key == rhs.key && from == rhs.from; }
+};
+
+struct tagged_less {
+    bool operator()(const tagged &a, const tagged &b) const { return a.key < b.key; }
+};
+
+TEST(StlInplaceSetTest, which_copy) {
+    // 相等的元素中保留哪一个与 std 相同
+    std::mt19937 gen(2);
+    for (int round = 0; round < 50; ++round) {
+        std::vector<tagged> a(gen() % 60), b(gen() % 60);
+        for (size_t i = 0; i < a.size(); ++i) a[i] = tagged{static_cast<int>(gen() % 8), static_cast<int>(i)};
+        for (size_t i = 0; i < b.size(); ++i) b[i] = tagged{static_cast<int>(gen() % 8), 1000 + static_cast<int>(i)};
+        std::stable_sort(a.begin(), a.end(), tagged_less());
+        std::stable_sort(b.begin(), b.end(), tagged_less());
+        std::vector<tagged> expect;
+        std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expect), tagged_less());
+        stl::vector<tagged> v = to_stl(a);
+        stl::inplace_set_union(v, to_stl(b), tagged_less());
+        EXPECT_EQ(to_std(v), expect);
+
+        expect.clear();
+        std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expect), tagged_less());
+        v = to_stl(a);
+        stl::inplace_set_intersection(v, to_stl(b), tagged_less());
+        EXPECT_EQ(to_std(v), expect);
+
+        expect.clear();
+        std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expect), tagged_less());
+        v = to_stl(a);
+        stl::inplace_set_difference(v, to_stl(b), tagged_less());
+        EXPECT_EQ(to_std(v), expect);
+    }
+}
+
+TEST(StlInplaceSetTest, string) {
+    std::mt19937 gen(9);
+    std::vector<std::string> a, b;
+    for (int i = 0; i < 500; ++i) a.push_back("key-" + std::to_string(gen() % 300) + "-padding-padding");
+    for (int i = 0; i < 20; ++i) b.push_back("key-" + std::to_string(gen() % 300) + "-padding-padding");
+    std::sort(a.begin(), a.end());
+    std::sort(b.begin(), b.end());
+    for (int round = 0; round < 2; ++round) {
+        std::vector<std::string> expect;
+        std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expect));
+        stl::vector<std::string> v = to_stl(a);
+        stl::inplace_set_union(v, to_stl(b));
+        EXPECT_EQ(to_std(v), expect);
+
+        expect.clear();
+        std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expect));
+        v = to_stl(a);
+        stl::inplace_set_difference(v, to_stl(b));
+        EXPECT_EQ(to_std(v), expect);
+
+        expect.clear();
+        std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expect));
+        v = to_stl(a);
+        stl::inplace_set_intersection(v, to_stl(b));
+        EXPECT_EQ(to_std(v), expect);
+        a.swap(b);
+    }
+
+    // 降序
+    stl::vector<std::string> v, other;
+    v.push_back("d"), v.push_back("b");
+    other.push_back("c"), other.push_back("b"), other.push_back("a");
+    stl::inplace_set_union(v, other, stl::greater<std::string>());
+    EXPECT_EQ(to_std(v), (std::vector<std::string>{"d", "c", "b", "a"}));
+}
+
+int main() {
+
+    ::testing::InitGoogleTest();
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,160 @@
+#include <algorithm>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "multiway_merge.h"
+#include "functional.h"
+#include "gtest/gtest.h"
+
+// k 路有序的随机序列，元素取自 [0, range)
+static stl::vector<stl::vector<int>> random_runs(size_t k, size_t max_len, int range, std::mt19937 &rng) {
+    stl::vector<stl::vector<int>> runs(k);
+    for (size_t i = 0; i < k; ++i) {
+        const size_t len = rng() % (max_len + 1);
+        std::vector<int> v(len);
+        for (auto &x : v) x = static_cast<int>(rng() % static_cast<unsigned>(range));
+        std::sort(v.begin(), v.end());
+        for (int x : v) runs[i].push_back(x);
+    }
+    return runs;
+}
+
+// 每个值在各路中出现次数的最大值或最小值
+static std::vector<int> expected_set(const stl::vector<stl::vector<int>> &runs, bool use_max) {
+    std::map<int, std::vector<size_t>> count;
+    for (size_t i = 0; i < runs.size(); ++i) {
+        for (int x : runs[i]) {
+            auto &c = count[x];
+            c.resize(runs.size(), 0);
+            ++c[i];
+        }
+    }
+    std::vector<int> result;
+    for (auto &kv : count) {
+        const size_t m = use_max ? *std::max_element(kv.second.begin(), kv.second.end())
+                                 : *std::min_element(kv.second.begin(), kv.second.end());
+        result.insert(result.end(), m, kv.first);
+    }
+    return result;
+}
+
+TEST(StlMultiwayMergeTest, random_runs) {
+    std::mt19937 rng(5);
+    for (size_t k : {0, 1, 2, 3, 5, 8, 17, 64}) {
+        for (int range : {10, 1000}) {
+            const auto runs = random_runs(k, 200, range, rng);
+            std::vector<int> all;
+            for (size_t i = 0; i < k; ++i) all.insert(all.end(), runs[i].begin(), runs[i].end());
+            std::sort(all.begin(), all.end());
+            std::vector<int> out(all.size() + 1);
+
+            int *end = stl::k_way_merge(runs.begin(), runs.end(), out.data());
+            EXPECT_EQ(std::vector<int>(out.data(), end), all);
+
+            std::vector<int> uniq(all);
+            uniq.erase(std::unique(uniq.begin(), uniq.end()), uniq.end());
+            end = stl::k_way_merge_unique(runs.begin(), runs.end(), out.data());
+            EXPECT_EQ(std::vector<int>(out.data(), end), uniq);
+
+            end = stl::multi_set_union(runs.begin(), runs.end(), out.data());
+            EXPECT_EQ(std::vector<int>(out.data(), end), expected_set(runs, true));
+
+            end = stl::multi_set_intersection(runs.begin(), runs.end(), out.data());
+            EXPECT_EQ(std::vector<int>(out.data(), end), k == 0 ? std::vector<int>() : expected_set(runs, false));
+        }
+    }
+}
+
+TEST(StlMultiwayMergeTest, intersection) {
+    // 较长的路大段地跳过
+    stl::vector<stl::vector<int>> runs(3);
+    for (int i = 0; i < 100000; ++i) runs[0].push_back(i);
+    for (int i = 0; i < 100000; i += 7) runs[1].push_back(i);
+    for (int i = 0; i < 100000; i += 1000) runs[2].push_back(i), runs[2].push_back(i);
+    std::vector<int> out(100);
+    int *end = stl::multi_set_intersection(runs.begin(), runs.end(), out.data());
+    std::vector<int> expect;
+    for (int i = 0; i < 100000; i += 7000) expect.push_back(i);
+    EXPECT_EQ(std::vector<int>(out.data(), end), expect);
+
+    // 有一路为空
+    runs[1].clear();
+    EXPECT_EQ(stl::multi_set_intersection(runs.begin(), runs.end(), out.data()), out.data());
+}
+
+// 只支持前向遍历的迭代器，multi_set_intersection 对它逐个前进
+struct forward_int_iter {
+    typedef stl::forward_iterator_tag iterator_category;
+    typedef int value_type;
+    typedef ptrdiff_t difference_type;
+    typedef const int *pointer;
+    typedef const int &reference;
+
+    const int *p;
+
+    reference operator*() const { return *p; }
+
+    forward_int_iter &operator++() {
+        ++p;
+        return *this;
+    }
+
+    bool operator==(const forward_int_iter &rhs) const { return p == rhs.p; }
+
+    bool operator!=(const forward_int_iter &rhs) const { return p != rhs.p; }
+};
+
+TEST(StlMultiwayMergeTest, pairs_and_comp) {
+    // 降序，各路以 stl::pair 给出
+    const int a[] = {9, 7, 5, 3, 1}, b[] = {8, 7, 6, 5}, c[] = {7, 5, 4};
+    std::vector<stl::pair<const int *, const int *>> runs = {
+            stl::make_pair(a, a + 5), stl::make_pair(b, b + 4), stl::make_pair(c, c + 3)};
+    std::vector<int> out(12);
+    int *end = stl::k_way_merge(runs.begin(), runs.end(), out.data(), stl::greater<int>());
+    EXPECT_EQ(std::vector<int>(out.data(), end), (std::vector<int>{9, 8, 7, 7, 7, 6, 5, 5, 5, 4, 3, 1}));
+    end = stl::multi_set_intersection(runs.begin(), runs.end(), out.data(), stl::greater<int>());
+    EXPECT_EQ(std::vector<int>(out.data(), end), (std::vector<int>{7, 5}));
+
+    std::vector<stl::pair<forward_int_iter, forward_int_iter>> fruns = {
+            stl::make_pair(forward_int_iter{a}, forward_int_iter{a + 5}),
+            stl::make_pair(forward_int_iter{c}, forward_int_iter{c + 3})};
+    end = stl::multi_set_intersection(fruns.begin(), fruns.end(), out.data(), stl::greater<int>());
+    EXPECT_EQ(std::vector<int>(out.data(), end), (std::vector<int>{7, 5}));
+    end = stl::multi_set_union(fruns.begin(), fruns.end(), out.data(), stl::greater<int>());
+    EXPECT_EQ(std::vector<int>(out.data(), end), (std::vector<int>{9, 7, 5, 4, 3, 1}));
+}
+
+TEST(StlMultiwayMergeTest, stable) {
+    // 相等的元素按所在路的次序输出，去重与交集保留编号最小的路中的元素
+    struct item {
+        int key, run;
+    };
+    auto less_key = [](const item &l, const item &r) { return l.key < r.key; };
+    stl::vector<stl::vector<item>> runs(4);
+    for (int r = 0; r < 4; ++r) {
+        for (int key = 0; key < 50; ++key) {
+            if ((key + r) % 3 != 0) runs[static_cast<size_t>(r)].push_back(item{key, r});
+            if (key % 10 == 0) runs[static_cast<size_t>(r)].push_back(item{key, r});
+        }
+    }
+    std::vector<item> out(1000);
+    item *end = stl::k_way_merge(runs.begin(), runs.end(), out.data(), less_key);
+    for (item *p = out.data() + 1; p < end; ++p) {
+        ASSERT_TRUE(p[-1].key < p->key || (p[-1].key == p->key && p[-1].run <= p->run));
+    }
+    end = stl::k_way_merge_unique(runs.begin(), runs.end(), out.data(), less_key);
+    ASSERT_EQ(end - out.data(), 50);
+    for (int key = 0; key < 50; ++key) {
+        EXPECT_EQ(out[static_cast<size_t>(key)].key, key);
+        EXPECT_EQ(out[static_cast<size_t>(key)].run, key % 3 == 0 && key % 10 != 0 ? 1 : 0);
+    }
+    end = stl::multi_set_intersection(runs.begin(), runs.end(), out.data(), less_key);
+    for (item *p = out.data(); p < end; ++p) EXPECT_EQ(p->run, 0);
+}
+
+int main() {
+
+    ::testing::InitGoogleTest();
+    return RUN_ALL_TESTS();
+}
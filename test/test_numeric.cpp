@@ -0,0 +1,261 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "deque.h"
+#include "numeric.h"
+#include "parallel_test_data.h"
+#include "gtest/gtest.h"
+
+class StlNumericTest : public testing::Test {
+protected:
+    virtual void SetUp() {
+        n = kParallelTestSize;
+        std::mt19937 gen(42);
+        for (size_t i = 0; i < n; ++i) {
+            v.push_back(static_cast<int>(gen() % 2001) - 1000);
+            f.push_back(static_cast<double>(gen() % 1000) / 64.0);
+        }
+        fill_offset_deque(d, v);
+    }
+
+    std::vector<int> v;
+    std::vector<double> f;
+    stl::deque<int> d;
+    size_t n;
+};
+
+// 各种长度，覆盖向量化版本的主循环与尾部
+static const size_t kLengths[] = {0, 1, 3, 4, 7, 8, 15, 16, 17, 31, 33, 64, 100, 1000};
+
+TEST_F(StlNumericTest, accumulate_reduce) {
+    const long long expect = std::accumulate(v.begin(), v.end(), 0LL);
+    EXPECT_EQ(stl::accumulate(v.data(), v.data() + n, 0LL), expect);
+    EXPECT_EQ(stl::accumulate(v.data(), v.data() + 5, 1LL, stl::multiplies<long long>()),
+              std::accumulate(v.begin(), v.begin() + 5, 1LL, std::multiplies<long long>()));
+
+    for (size_t len : kLengths) {
+        EXPECT_EQ(stl::reduce(v.data(), v.data() + len), std::accumulate(v.begin(), v.begin() + len, 0));
+        EXPECT_EQ(stl::reduce(v.data(), v.data() + len, 5), std::accumulate(v.begin(), v.begin() + len, 5));
+        std::vector<int8_t> c(v.begin(), v.begin() + len);
+        EXPECT_EQ(stl::reduce(c.data(), c.data() + len, int8_t(1)),
+                  static_cast<int8_t>(std::accumulate(c.begin(), c.end(), 1)));
+        std::vector<uint64_t> u(v.begin(), v.begin() + len);
+        EXPECT_EQ(stl::reduce(u.data(), u.data() + len, uint64_t(0)), std::accumulate(u.begin(), u.end(), uint64_t(0)));
+        const double fs = std::accumulate(f.begin(), f.begin() + len, 0.0);
+        EXPECT_NEAR(stl::reduce(f.data(), f.data() + len, 0.0), fs, 1e-9 * (1 + fs));
+    }
+    EXPECT_EQ(stl::reduce(v.data(), v.data() + n, 0LL), expect);
+    EXPECT_EQ(stl::reduce(d.begin(), d.end(), 0, stl::plus<int>()),
+              std::accumulate(d.begin(), d.end(), 0, std::plus<int>()));
+
+    for (size_t t : kThreads) {
+        EXPECT_EQ(stl::reduce(stl::execution::par(t), v.data(), v.data() + n, 0LL), expect);
+        EXPECT_EQ(stl::reduce(stl::execution::par(t), v.data(), v.data() + n), static_cast<int>(expect));
+        EXPECT_EQ(stl::reduce(stl::execution::par(t), d.begin(), d.end(), 3), stl::reduce(d.begin(), d.end(), 3));
+        EXPECT_EQ(stl::reduce(stl::execution::par(t), v.data(), v.data() + n, -2000,
+                              [](int a, int b) { return std::max(a, b); }), *std::max_element(v.begin(), v.end()));
+        const double fs = std::accumulate(f.begin(), f.end(), 0.0);
+        EXPECT_NEAR(stl::reduce(stl::execution::par(t), f.data(), f.data() + n, 0.0), fs, 1e-9 * fs);
+    }
+    EXPECT_EQ(stl::reduce(stl::execution::par, v.data(), v.data(), 7), 7);
+}
+
+TEST_F(StlNumericTest, transform_reduce) {
+    std::vector<double> g(f.rbegin(), f.rend());
+    for (size_t len : kLengths) {
+        const double expect = std::inner_product(f.begin(), f.begin() + len, g.begin(), 1.0);
+        EXPECT_NEAR(stl::transform_reduce(f.data(), f.data() + len, g.data(), 1.0), expect, 1e-9 * (1 + expect));
+        std::vector<float> a(f.begin(), f.begin() + len), b(g.begin(), g.begin() + len);
+        const double fexpect = std::inner_product(a.begin(), a.end(), b.begin(), 0.0);
+        EXPECT_NEAR(stl::transform_reduce(a.data(), a.data() + len, b.data(), 0.0f), fexpect, 1e-4 * (1 + fexpect));
+    }
+    const long long iexpect = std::inner_product(v.begin(), v.end(), v.rbegin(), 0LL);
+    std::vector<int> r(v.rbegin(), v.rend());
+    EXPECT_EQ(stl::transform_reduce(v.data(), v.data() + n, r.data(), 0LL, stl::plus<long long>(),
+                                    [](int x, int y) { return static_cast<long long>(x) * y; }), iexpect);
+    auto square = [](int x) { return static_cast<long long>(x) * x; };
+    long long squares = 0;
+    for (int x : v) squares += square(x);
+    EXPECT_EQ(stl::transform_reduce(v.data(), v.data() + n, 0LL, stl::plus<long long>(), square), squares);
+
+    for (size_t t : kThreads) {
+        const double expect = std::inner_product(f.begin(), f.end(), g.begin(), 0.0);
+        EXPECT_NEAR(stl::transform_reduce(stl::execution::par(t), f.data(), f.data() + n, g.data(), 0.0), expect,
+                    1e-9 * expect);
+        EXPECT_EQ(stl::transform_reduce(stl::execution::par(t), v.data(), v.data() + n, r.data(), 0LL,
+                                        stl::plus<long long>(),
+                                        [](int x, int y) { return static_cast<long long>(x) * y; }), iexpect);
+        EXPECT_EQ(stl::transform_reduce(stl::execution::par(t), v.data(), v.data() + n, 0LL,
+                                        stl::plus<long long>(), square), squares);
+        // 第二个区间为 deque
+        stl::deque<int> b(r.data(), r.data() + n);
+        b.push_front(0);
+        b.pop_front();
+        EXPECT_EQ(stl::transform_reduce(stl::execution::par(t), v.data(), v.data() + n, b.begin(), 0LL,
+                                        stl::plus<long long>(),
+                                        [](int x, int y) { return static_cast<long long>(x) * y; }), iexpect);
+    }
+}
+
+TEST_F(StlNumericTest, inclusive_scan) {
+    for (size_t len : kLengths) {
+        std::vector<int> expect(len), out(len);
+        std::partial_sum(v.begin(), v.begin() + len, expect.begin());
+        EXPECT_EQ(stl::inclusive_scan(v.data(), v.data() + len, out.data()), out.data() + len);
+        EXPECT_EQ(out, expect);
+
+        std::vector<long long> l(v.begin(), v.begin() + len), lexpect(len);
+        long long s = 10;
+        for (size_t i = 0; i < len; ++i) lexpect[i] = s += l[i];
+        stl::inclusive_scan(l.data(), l.data() + len, l.data(), stl::plus<long long>(), 10LL);   // 原地
+        EXPECT_EQ(l, lexpect);
+
+        std::vector<float> a(f.begin(), f.begin() + len), fout(len);
+        stl::inclusive_scan(a.data(), a.data() + len, fout.data());
+        float fs = 0;
+        for (size_t i = 0; i < len; ++i) {
+            fs += a[i];
+            ASSERT_NEAR(fout[i], fs, 1e-4 * (1 + fs));
+        }
+    }
+
+    std::vector<int> expect(n);
+    std::partial_sum(v.begin(), v.end(), expect.begin());
+    for (size_t t : kThreads) {
+        std::vector<int> out(n);
+        EXPECT_EQ(stl::inclusive_scan(stl::execution::par(t), v.data(), v.data() + n, out.data()), out.data() + n);
+        EXPECT_EQ(out, expect);
+
+        // 带初值，原地
+        std::vector<int> a = v;
+        stl::inclusive_scan(stl::execution::par(t), a.data(), a.data() + n, a.data(), stl::plus<int>(), 100);
+        for (size_t i = 0; i < n; ++i) ASSERT_EQ(a[i], expect[i] + 100);
+
+        // 不满足交换律的运算：取后一个元素
+        auto second = [](int, int y) { return y; };
+        stl::inclusive_scan(stl::execution::par(t), v.data(), v.data() + n, out.data(), second);
+        EXPECT_EQ(out, v);
+
+        // deque 原地
+        stl::deque<int> b = d;
+        stl::inclusive_scan(stl::execution::par(t), b.begin(), b.end(), b.begin());
+        int s = 0;
+        auto it = d.begin();
+        for (int x : b) ASSERT_EQ(x, s += *it++);
+    }
+}
+
+TEST_F(StlNumericTest, exclusive_scan) {
+    for (size_t len : kLengths) {
+        std::vector<int> expect(len), out(len);
+        int s = 5;
+        for (size_t i = 0; i < len; ++i) {
+            expect[i] = s;
+            s += v[i];
+        }
+        EXPECT_EQ(stl::exclusive_scan(v.data(), v.data() + len, out.data(), 5), out.data() + len);
+        EXPECT_EQ(out, expect);
+        out.assign(v.begin(), v.begin() + len);
+        stl::exclusive_scan(out.data(), out.data() + len, out.data(), 5);   // 原地
+        EXPECT_EQ(out, expect);
+
+        std::vector<double> a(f.begin(), f.begin() + len);
+        stl::exclusive_scan(a.data(), a.data() + len, a.data(), 0.5);
+        double fs = 0.5;
+        for (size_t i = 0; i < len; ++i) {
+            ASSERT_NEAR(a[i], fs, 1e-9 * (1 + fs));
+            fs += f[i];
+        }
+    }
+
+    std::vector<long long> expect(n);
+    long long s = -3;
+    for (size_t i = 0; i < n; ++i) {
+        expect[i] = s;
+        s += v[i];
+    }
+    for (size_t t : kThreads) {
+        std::vector<long long> out(n);
+        EXPECT_EQ(stl::exclusive_scan(stl::execution::par(t), v.data(), v.data() + n, out.data(), -3LL),
+                  out.data() + n);
+        EXPECT_EQ(out, expect);
+
+        std::vector<long long> a(v.begin(), v.end());
+        stl::exclusive_scan(stl::execution::par(t), a.data(), a.data() + n, a.data(), -3LL, stl::plus<long long>());
+        EXPECT_EQ(a, expect);
+
+        stl::deque<int> b = d;
+        stl::exclusive_scan(stl::execution::par(t), b.begin(), b.end(), b.begin(), 0);
+        int sum = 0;
+        auto it = d.begin();
+        for (int x : b) {
+            ASSERT_EQ(x, sum);
+            sum += *it++;
+        }
+    }
+}
+
+TEST_F(StlNumericTest, histogram) {
+    const size_t bins_list[] = {1, 7, 256, 2000, 5000};
+    for (size_t bins : bins_list) {
+        // 值为 [-1000, 1000]，负数与不小于 bins 的值不计入
+        std::vector<size_t> expect(bins, 0);
+        for (int x : v) {
+            if (x >= 0 && static_cast<size_t>(x) < bins) ++expect[static_cast<size_t>(x)];
+        }
+        auto h = stl::histogram(v.data(), v.data() + n, bins);
+        ASSERT_EQ(h.size(), bins);
+        EXPECT_TRUE(std::equal(h.begin(), h.end(), expect.begin()));
+
+        auto bin_of = [bins](int x) { return static_cast<size_t>(x + 1000) % (bins + 1); };
+        std::vector<size_t> expect2(bins, 0);
+        for (int x : v) {
+            if (bin_of(x) < bins) ++expect2[bin_of(x)];
+        }
+        for (size_t t : kThreads) {
+            h = stl::histogram(stl::execution::par(t), v.data(), v.data() + n, bins);
+            EXPECT_TRUE(std::equal(h.begin(), h.end(), expect.begin()));
+            h = stl::histogram(stl::execution::par(t), v.data(), v.data() + n, bins, bin_of);
+            EXPECT_TRUE(std::equal(h.begin(), h.end(), expect2.begin()));
+        }
+    }
+
+    stl::deque<uint8_t> b(v.data(), v.data() + n);
+    b.push_front(3);
+    std::vector<size_t> expect(256, 0);
+    for (uint8_t x : b) ++expect[x];
+    for (size_t t : kThreads) {
+        auto h = stl::histogram(stl::execution::par(t), b.begin(), b.end(), 256);
+        EXPECT_TRUE(std::equal(h.begin(), h.end(), expect.begin()));
+    }
+    EXPECT_EQ(stl::histogram(v.data(), v.data(), 3).size(), 3u);
+}
+
+TEST(StlNumericPolicyTest, sequential_fallback) {
+    int l[] = {5, 3, 8, 1, 9, 1};
+    forward_int_iter first{l}, last{l + 6};
+    EXPECT_EQ(stl::reduce(stl::execution::par, first, last), 27);
+    EXPECT_EQ(stl::transform_reduce(stl::execution::par, first, last, first, 0), 181);
+    auto h = stl::histogram(stl::execution::par, first, last, 4);
+    EXPECT_EQ(h[1], 2u);
+    EXPECT_EQ(h[3], 1u);
+
+    int out[6];
+    stl::inclusive_scan(stl::execution::par, first, last, out);
+    EXPECT_EQ(out[5], 27);
+    stl::exclusive_scan(stl::execution::seq, first, last, forward_int_iter{out}, 1);
+    EXPECT_EQ(out[0], 1);
+    EXPECT_EQ(out[5], 27);
+    stl::inclusive_scan(stl::execution::par, first, last, first);
+    EXPECT_EQ(l[5], 27);
+}
+
+int main() {
+
+    ::testing::InitGoogleTest();
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,190 @@
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "parallel_algo.h"
+#include "parallel_test_data.h"
+#include "set_test_data.h"
+#include "gtest/gtest.h"
+
+class StlParallelTest : public testing::Test {
+protected:
+    virtual void SetUp() {
+        n = kParallelTestSize;
+        std::mt19937 gen(42);
+        for (size_t i = 0; i < n; ++i) v.push_back(static_cast<int>(gen() % 100000));
+    }
+
+    std::vector<int> v;
+    size_t n;
+};
+
+TEST_F(StlParallelTest, parallel_sort) {
+    std::vector<int> expect = v;
+    std::sort(expect.begin(), expect.end());
+    const size_t threads[] = {1, 2, 3, 4, 7, 16};
+    for (size_t t : threads) {
+        std::vector<int> a = v;
+        stl::parallel_sort(a.data(), a.data() + a.size(), stl::less<int>(), t);
+        EXPECT_EQ(a, expect);
+    }
+
+    // 降序，以及已经有序的输入
+    std::vector<int> a = v;
+    stl::parallel_sort(a.data(), a.data() + a.size(), stl::greater<int>(), 4);
+    EXPECT_TRUE(std::is_sorted(a.rbegin(), a.rend()));
+    stl::parallel_sort(a.data(), a.data() + a.size(), stl::greater<int>(), 4);
+    EXPECT_TRUE(std::is_sorted(a.rbegin(), a.rend()));
+
+    // 很小的区间
+    std::vector<int> small = {3, 1, 2};
+    stl::parallel_sort(small.data(), small.data() + small.size());
+    EXPECT_EQ(small, std::vector<int>({1, 2, 3}));
+    stl::parallel_sort(small.data(), small.data());
+}
+
+TEST(StlParallelSortTest, string) {
+    std::vector<std::string> v;
+    std::mt19937 gen(7);
+    for (size_t i = 0; i < 4 * PARALLEL_GRAIN_SIZE; ++i) v.push_back(std::to_string(gen()));
+    std::vector<std::string> expect = v;
+    std::sort(expect.begin(), expect.end());
+    stl::parallel_sort(v.data(), v.data() + v.size(), stl::less<std::string>(), 4);
+    EXPECT_EQ(v, expect);
+}
+
+// 按key比较，用idx检查稳定性
+struct Item {
+    int key;
+    int idx;
+};
+
+struct ItemLess {
+    bool operator()(const Item &a, const Item &b) const { return a.key < b.key; }
+};
+
+TEST(StlParallelMergeTest, stable) {
+    std::mt19937 gen(1);
+    std::vector<Item> a, b;
+    for (int i = 0; i < static_cast<int>(3 * PARALLEL_GRAIN_SIZE); ++i) a.push_back(Item{static_cast<int>(gen() % 50), 0});
+    for (int i = 0; i < static_cast<int>(5 * PARALLEL_GRAIN_SIZE); ++i) b.push_back(Item{static_cast<int>(gen() % 50), 1});
+    std::stable_sort(a.begin(), a.end(), ItemLess());
+    std::stable_sort(b.begin(), b.end(), ItemLess());
+
+    std::vector<Item> out(a.size() + b.size());
+    Item *end = stl::parallel_merge(a.data(), a.data() + a.size(), b.data(), b.data() + b.size(),
+                                    out.data(), ItemLess(), 4);
+    EXPECT_EQ(end, out.data() + out.size());
+    for (size_t i = 1; i < out.size(); ++i) {
+        ASSERT_LE(out[i - 1].key, out[i].key);
+        // 相等的元素中来自第一个序列的在前
+        if (out[i - 1].key == out[i].key) {
+            EXPECT_LE(out[i - 1].idx, out[i].idx);
+        }
+    }
+}
+
+TEST_F(StlParallelTest, parallel_inplace_merge) {
+    const size_t mid = n / 3;
+    std::sort(v.begin(), v.begin() + mid);
+    std::sort(v.begin() + mid, v.end());
+    std::vector<int> expect = v;
+    std::inplace_merge(expect.begin(), expect.begin() + mid, expect.end());
+
+    std::vector<int> a = v;
+    stl::parallel_inplace_merge(a.data(), a.data() + mid, a.data() + a.size(), stl::less<int>(), 4);
+    EXPECT_EQ(a, expect);
+
+    // 没有缓冲区时的合并
+    a = v;
+    stl::parallel_merge_without_buffer(a.data(), a.data() + mid, a.data() + a.size(),
+                                       static_cast<ptrdiff_t>(mid), static_cast<ptrdiff_t>(n - mid),
+                                       stl::less<int>(), 4);
+    EXPECT_EQ(a, expect);
+
+    // 一侧为空
+    a = v;
+    stl::parallel_inplace_merge(a.data(), a.data(), a.data() + mid);
+    EXPECT_TRUE(std::is_sorted(a.begin(), a.begin() + mid));
+}
+
+// 与 std::set_union / std::set_intersection 的结果比较，range 较小时相等的元素很多，会跨过 merge path 的分界
+template<class T>
+void check_parallel_set(size_t n1, size_t n2, uint64_t range, std::mt19937_64 &rng) {
+    const std::vector<T> a = sorted_random<T>(n1, range, true, rng);
+    const std::vector<T> b = sorted_random<T>(n2, range, true, rng);
+    const set_expect<T> expect(a, b);
+
+    std::vector<T> out(n1 + n2);
+    const size_t threads[] = {1, 2, 3, 4, 7, 16};
+    for (size_t t : threads) {
+        T *end = stl::parallel_set_union(a.data(), a.data() + n1, b.data(), b.data() + n2, out.data(),
+                                         stl::less<T>(), t);
+        EXPECT_EQ(std::vector<T>(out.data(), end), expect.uni);
+        end = stl::parallel_set_intersection(a.data(), a.data() + n1, b.data(), b.data() + n2, out.data(),
+                                             stl::less<T>(), t);
+        EXPECT_EQ(std::vector<T>(out.data(), end), expect.inter);
+    }
+    T *end = stl::parallel_set_union(a.data(), a.data() + n1, b.data(), b.data() + n2, out.data());
+    EXPECT_EQ(std::vector<T>(out.data(), end), expect.uni);
+    end = stl::parallel_set_intersection(a.data(), a.data() + n1, b.data(), b.data() + n2, out.data());
+    EXPECT_EQ(std::vector<T>(out.data(), end), expect.inter);
+    // 默认比较在各段中可以使用分块比较
+    end = stl::parallel_set_intersection(a.data(), a.data() + n1, b.data(), b.data() + n2, out.data(),
+                                         stl::transparent_less(), 4);
+    EXPECT_EQ(std::vector<T>(out.data(), end), expect.inter);
+}
+
+TEST(StlParallelSetTest, union_and_intersection) {
+    std::mt19937_64 rng(3);
+    const size_t n = 6 * PARALLEL_GRAIN_SIZE;
+    check_parallel_set<uint32_t>(n, n, 4 * n, rng);
+    check_parallel_set<uint32_t>(n, n / 2, 50, rng);
+    check_parallel_set<uint32_t>(n / 5, n, 1000, rng);
+    check_parallel_set<int>(n, n + 17, 100000, rng);
+    check_parallel_set<uint64_t>(n, n, 3, rng);
+    check_parallel_set<uint32_t>(n, n, 1, rng);     // 所有元素都相等，只有一段非空
+    check_parallel_set<uint32_t>(0, n, 100, rng);
+
+    // 降序
+    std::vector<int> a(n), b(n);
+    for (size_t i = 0; i < n; ++i) a[i] = static_cast<int>(3 * (n - i)), b[i] = static_cast<int>(2 * (n - i));
+    std::vector<int> out(2 * n);
+    int *end = stl::parallel_set_intersection(a.data(), a.data() + n, b.data(), b.data() + n, out.data(),
+                                              stl::greater<int>(), 4);
+    ASSERT_EQ(static_cast<size_t>(end - out.data()), n / 3);
+    for (int *p = out.data(); p < end; ++p) EXPECT_EQ(*p % 6, 0);
+    EXPECT_TRUE(std::is_sorted(out.data(), end, std::greater<int>()));
+}
+
+TEST(StlParallelSortTest, buffer_above_int_max) {
+    // parallel_sort / parallel_inplace_merge 只有拿到与区间等长的 temporary_buffer 才合并到缓冲区，
+    // 超过 INT_MAX 字节的区间(2 亿多个 uint64_t)也要能拿到，否则退化为很慢的原地旋转合并。
+    // 用一块从未写入的内存充当区间：平凡类型的缓冲区不会被初始化，两块内存都不会真正占用物理页
+    const ptrdiff_t n = static_cast<ptrdiff_t>(INT_MAX / sizeof(uint64_t)) + 1000;
+    uint64_t *range = static_cast<uint64_t *>(std::malloc(static_cast<size_t>(n) * sizeof(uint64_t)));
+    if (range == nullptr) GTEST_SKIP() << "cannot reserve " << n << " uint64_t";
+    {
+        stl::temporary_buffer<uint64_t *, uint64_t> buf(range, range + n);
+        EXPECT_EQ(buf.size(), n);
+    }
+    std::free(range);
+}
+
+TEST(StlParallelRunTest, exception) {
+    EXPECT_THROW(stl::parallel_run(16, 4, [](size_t i) {
+        if (i == 5) throw std::runtime_error("task failed");
+    }), std::runtime_error);
+}
+
+int main() {
+
+    ::testing::InitGoogleTest();
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,148 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "radix_sort.h"
+#include "gtest/gtest.h"
+
+template<class T>
+std::vector<T> random_ints(size_t n, std::mt19937_64 &gen) {
+    std::vector<T> v;
+    for (size_t i = 0; i < n; ++i) v.push_back(static_cast<T>(gen()));
+    return v;
+}
+
+TEST(StlRadixSortTest, unsigned_int) {
+    std::mt19937_64 gen(1);
+    const size_t sizes[] = {0, 1, 10, 63, 64, 1000, 100000};
+    for (size_t n : sizes) {
+        auto v = random_ints<uint32_t>(n, gen);
+        auto expect = v;
+        std::sort(expect.begin(), expect.end());
+        stl::radix_sort(v.data(), v.data() + v.size());
+        EXPECT_EQ(v, expect);
+
+        auto w = random_ints<uint64_t>(n, gen);
+        auto expect_w = w;
+        std::sort(expect_w.begin(), expect_w.end());
+        stl::radix_sort(w.data(), w.data() + w.size());
+        EXPECT_EQ(w, expect_w);
+    }
+
+    // 只有最低字节不同，高位字节的趟数会被跳过
+    std::vector<uint64_t> small;
+    for (int i = 0; i < 1000; ++i) small.push_back(static_cast<uint64_t>(gen() % 200));
+    auto expect = small;
+    std::sort(expect.begin(), expect.end());
+    stl::radix_sort(small.data(), small.data() + small.size());
+    EXPECT_EQ(small, expect);
+}
+
+TEST(StlRadixSortTest, signed_int) {
+    std::mt19937_64 gen(2);
+    auto v = random_ints<int32_t>(5000, gen);
+    v.push_back(std::numeric_limits<int32_t>::min());
+    v.push_back(std::numeric_limits<int32_t>::max());
+    v.push_back(0);
+    v.push_back(-1);
+    auto expect = v;
+    std::sort(expect.begin(), expect.end());
+    stl::radix_sort(v.data(), v.data() + v.size());
+    EXPECT_EQ(v, expect);
+
+    auto c = random_ints<int8_t>(3000, gen);
+    auto expect_c = c;
+    std::sort(expect_c.begin(), expect_c.end());
+    stl::radix_sort(c.data(), c.data() + c.size());
+    EXPECT_EQ(c, expect_c);
+}
+
+TEST(StlRadixSortTest, floating_point) {
+    std::mt19937_64 gen(3);
+    std::uniform_real_distribution<double> dist(-1e6, 1e6);
+    std::vector<double> v;
+    for (int i = 0; i < 5000; ++i) v.push_back(dist(gen));
+    v.push_back(0.0);
+    v.push_back(-std::numeric_limits<double>::infinity());
+    v.push_back(std::numeric_limits<double>::infinity());
+    v.push_back(std::numeric_limits<double>::denorm_min());
+    v.push_back(-std::numeric_limits<double>::denorm_min());
+    auto expect = v;
+    std::sort(expect.begin(), expect.end());
+    stl::radix_sort(v.data(), v.data() + v.size());
+    EXPECT_EQ(v, expect);
+
+    std::vector<float> f;
+    for (int i = 0; i < 5000; ++i) f.push_back(static_cast<float>(dist(gen)));
+    auto expect_f = f;
+    std::sort(expect_f.begin(), expect_f.end());
+    stl::radix_sort(f.data(), f.data() + f.size());
+    EXPECT_EQ(f, expect_f);
+
+    // -0.0 排在 +0.0 之前
+    float z[] = {0.0f, -0.0f, 1.0f, -1.0f};
+    stl::lsd_radix_sort(z, z + 4);
+    EXPECT_EQ(z[0], -1.0f);
+    EXPECT_TRUE(std::signbit(z[1]));
+    EXPECT_FALSE(std::signbit(z[2]));
+    EXPECT_EQ(z[3], 1.0f);
+}
+
+struct Record {
+    int key;
+    int seq;
+    std::string payload;
+};
+
+TEST(StlRadixSortTest, key_extracted_stable) {
+    std::mt19937_64 gen(4);
+    std::vector<Record> v;
+    for (int i = 0; i < 3000; ++i)
+        v.push_back(Record{static_cast<int>(gen() % 100) - 50, i, std::to_string(i)});
+    auto expect = v;
+    std::stable_sort(expect.begin(), expect.end(),
+                     [](const Record &a, const Record &b) { return a.key < b.key; });
+    stl::radix_sort(v.data(), v.data() + v.size(), [](const Record &r) { return r.key; });
+    for (size_t i = 0; i < v.size(); ++i) {
+        EXPECT_EQ(v[i].key, expect[i].key);
+        EXPECT_EQ(v[i].seq, expect[i].seq);
+        EXPECT_EQ(v[i].payload, expect[i].payload);
+    }
+}
+
+TEST(StlRadixSortTest, string) {
+    std::mt19937_64 gen(5);
+    std::vector<std::string> v;
+    for (int i = 0; i < 5000; ++i) {
+        // 长度不同、公共前缀较长，并包含非ASCII字符
+        std::string s = (i % 3 == 0) ? "common_prefix_" : "";
+        const size_t len = gen() % 12;
+        for (size_t j = 0; j < len; ++j) s.push_back(static_cast<char>(gen() % 4 == 0 ? 0xE4 : 'a' + gen() % 3));
+        v.push_back(s);
+    }
+    v.push_back("");
+    v.push_back("");
+    auto expect = v;
+    std::sort(expect.begin(), expect.end());
+    stl::radix_sort(v.data(), v.data() + v.size());
+    EXPECT_EQ(v, expect);
+
+    // 按记录中的字符串字段排序，保持稳定
+    std::vector<Record> r;
+    for (int i = 0; i < 2000; ++i) r.push_back(Record{0, i, std::to_string(gen() % 50)});
+    auto expect_r = r;
+    std::stable_sort(expect_r.begin(), expect_r.end(),
+                     [](const Record &a, const Record &b) { return a.payload < b.payload; });
+    stl::radix_sort(r.data(), r.data() + r.size(), [](const Record &x) -> const std::string & { return x.payload; });
+    for (size_t i = 0; i < r.size(); ++i) EXPECT_EQ(r[i].seq, expect_r[i].seq);
+}
+
+int main() {
+
+    ::testing::InitGoogleTest();
+    return RUN_ALL_TESTS();
+}
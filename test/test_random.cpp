@@ -0,0 +1,211 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "algo.h"
+#include "deque.h"
+#include "random.h"
+#include "gtest/gtest.h"
+
+TEST(StlRandomTest, engines) {
+    // splitmix64 的参考输出
+    stl::splitmix64 sm(0);
+    EXPECT_EQ(sm(), 0xe220a8397b1dcdafULL);
+    EXPECT_EQ(sm(), 0x6e789e6aa1b965f4ULL);
+
+    // 相同的种子得到相同的序列，不同的种子得到不同的序列
+    stl::wyrand w1(7), w2(7), w3(8);
+    stl::xoshiro256pp x1(7), x2(7), x3(8);
+    bool w_differ = false, x_differ = false;
+    for (int i = 0; i < 100; ++i) {
+        const uint64_t a = w1(), b = x1();
+        EXPECT_EQ(a, w2());
+        EXPECT_EQ(b, x2());
+        w_differ |= a != w3();
+        x_differ |= b != x3();
+    }
+    EXPECT_TRUE(w_differ);
+    EXPECT_TRUE(x_differ);
+
+    // 满足 UniformRandomBitGenerator 的要求，可以用于标准库的分布
+    std::uniform_int_distribution<int> dist(1, 6);
+    for (int i = 0; i < 100; ++i) {
+        const int x = dist(w1);
+        EXPECT_TRUE(x >= 1 && x <= 6);
+    }
+}
+
+// 把 draws 个 [0, range) 内的随机数计入 range 个桶，检查每个桶的频率与期望值的偏差
+template<class URBG>
+static void check_uniform(URBG &g, uint64_t range, size_t draws) {
+    std::vector<size_t> count(range, 0);
+    for (size_t i = 0; i < draws; ++i) {
+        const uint64_t x = stl::bounded_rand(g, range);
+        ASSERT_LT(x, range);
+        ++count[x];
+    }
+    const double expect = static_cast<double>(draws) / static_cast<double>(range);
+    for (size_t c : count) EXPECT_NEAR(static_cast<double>(c), expect, 6 * std::sqrt(expect));
+}
+
+TEST(StlRandomTest, bounded_rand) {
+    stl::wyrand w(1);
+    stl::xoshiro256pp x(2);
+    std::mt19937 mt(3);          // 32 位输出，拼接两次
+    std::minstd_rand minstd(4);  // 范围不是 2 的幂，丢弃多余的值
+    check_uniform(w, 10, 100000);
+    check_uniform(x, 7, 70000);
+    check_uniform(mt, 13, 130000);
+    check_uniform(minstd, 6, 60000);
+    for (int i = 0; i < 100; ++i) EXPECT_EQ(stl::bounded_rand(w, 1), 0u);
+
+    // range 接近 2^64 时大约一半的结果需要重取
+    const uint64_t big = (uint64_t(1) << 63) + 12345;
+    size_t high = 0;
+    for (int i = 0; i < 1000; ++i) {
+        const uint64_t v = stl::bounded_rand(x, big);
+        EXPECT_LT(v, big);
+        high += v >= big / 2;
+    }
+    EXPECT_NEAR(static_cast<double>(high), 500.0, 100.0);
+
+    // 两个数各自均匀，组合起来也均匀
+    std::vector<size_t> pair_count(5 * 7, 0);
+    for (int i = 0; i < 70000; ++i) {
+        uint64_t a, b;
+        stl::bounded_rand2(mt, 5, 7, a, b);
+        ASSERT_LT(a, 5u);
+        ASSERT_LT(b, 7u);
+        ++pair_count[a * 7 + b];
+    }
+    for (size_t c : pair_count) EXPECT_NEAR(static_cast<double>(c), 2000.0, 6 * std::sqrt(2000.0));
+
+    double sum = 0;
+    for (int i = 0; i < 10000; ++i) {
+        const double u = stl::random_unit(mt);
+        ASSERT_TRUE(u > 0.0 && u < 1.0);
+        sum += u;
+    }
+    EXPECT_NEAR(sum / 10000, 0.5, 0.02);
+}
+
+TEST(StlShuffleTest, shuffle) {
+    for (size_t n : {0, 1, 2, 10, 1000, 100000}) {
+        std::vector<int> a(n);
+        for (size_t i = 0; i < n; ++i) a[i] = static_cast<int>(i);
+        std::vector<int> b = a;
+        stl::wyrand g1(5), g2(5);
+        stl::shuffle(a.data(), a.data() + n, g1);
+        stl::shuffle(b.data(), b.data() + n, g2);
+        EXPECT_EQ(a, b);    // 相同的种子，结果相同
+        std::sort(a.begin(), a.end());
+        for (size_t i = 0; i < n; ++i) ASSERT_EQ(a[i], static_cast<int>(i));
+    }
+
+    // 3 个元素的 6 种排列出现的次数大致相同
+    stl::xoshiro256pp g(9);
+    std::vector<size_t> count(6, 0);
+    for (int trial = 0; trial < 60000; ++trial) {
+        int p[3] = {0, 1, 2};
+        stl::shuffle(p, p + 3, g);
+        ++count[static_cast<size_t>(p[0] * 2 + (p[1] > p[2]))];
+    }
+    for (size_t c : count) EXPECT_NEAR(static_cast<double>(c), 10000.0, 600.0);
+
+    stl::deque<int> d;
+    for (int i = 0; i < 3000; ++i) d.push_back(i);
+    d.push_front(-1);
+    stl::shuffle(d.begin(), d.end(), std::mt19937_64(1));
+    std::vector<int> c;
+    for (int x : d) c.push_back(x);
+    std::sort(c.begin(), c.end());
+    for (size_t i = 0; i < c.size(); ++i) ASSERT_EQ(c[i], static_cast<int>(i) - 1);
+}
+
+TEST(StlShuffleTest, random_shuffle) {
+    std::vector<int> a(500);
+    for (int i = 0; i < 500; ++i) a[static_cast<size_t>(i)] = i;
+    std::vector<int> b = a;
+    stl::random_shuffle(b.data(), b.data() + b.size());
+    EXPECT_NE(a, b);
+    std::sort(b.begin(), b.end());
+    EXPECT_EQ(a, b);
+
+    // 自定义的 rand(n) 返回 [0, n)，第一个位置上各元素出现的次数大致相同
+    stl::wyrand g(3);
+    auto rand = [&](ptrdiff_t n) { return static_cast<ptrdiff_t>(stl::bounded_rand(g, static_cast<uint64_t>(n))); };
+    std::vector<size_t> count(4, 0);
+    for (int trial = 0; trial < 40000; ++trial) {
+        int p[4] = {0, 1, 2, 3};
+        stl::random_shuffle(p, p + 4, rand);
+        ++count[static_cast<size_t>(p[0])];
+    }
+    for (size_t c : count) EXPECT_NEAR(static_cast<double>(c), 10000.0, 600.0);
+}
+
+// 只支持单遍读取的迭代器，sample 对它使用蓄水池抽样
+struct input_int_iter {
+    typedef stl::input_iterator_tag iterator_category;
+    typedef int value_type;
+    typedef ptrdiff_t difference_type;
+    typedef const int *pointer;
+    typedef const int &reference;
+
+    const int *p;
+
+    reference operator*() const { return *p; }
+
+    input_int_iter &operator++() {
+        ++p;
+        return *this;
+    }
+
+    bool operator==(const input_int_iter &rhs) const { return p == rhs.p; }
+
+    bool operator!=(const input_int_iter &rhs) const { return p != rhs.p; }
+};
+
+TEST(StlSampleTest, sample) {
+    std::vector<int> pop(100);
+    for (int i = 0; i < 100; ++i) pop[static_cast<size_t>(i)] = i;
+    stl::wyrand g(11);
+
+    // 选择抽样：保持相对次序
+    std::vector<int> out(10);
+    EXPECT_EQ(stl::sample(pop.data(), pop.data() + 100, out.data(), 10, g), out.data() + 10);
+    EXPECT_TRUE(std::is_sorted(out.begin(), out.end()));
+    EXPECT_EQ(std::unique(out.begin(), out.end()), out.end());
+
+    // n 超过元素个数时全部选中
+    std::vector<int> all(150);
+    EXPECT_EQ(stl::sample(pop.data(), pop.data() + 100, all.data(), 150, g), all.data() + 100);
+    EXPECT_TRUE(std::equal(pop.begin(), pop.end(), all.begin()));
+    EXPECT_EQ(stl::sample(input_int_iter{pop.data()}, input_int_iter{pop.data() + 100}, all.data(), 150, g),
+              all.data() + 100);
+    EXPECT_EQ(stl::sample(pop.data(), pop.data() + 100, all.data(), 0, g), all.data());
+
+    // 每个元素被选中的概率都是 n / N
+    std::vector<size_t> hit_forward(100, 0), hit_input(100, 0);
+    const int trials = 20000;
+    for (int trial = 0; trial < trials; ++trial) {
+        stl::sample(pop.data(), pop.data() + 100, out.data(), 10, g);
+        for (int x : out) ++hit_forward[static_cast<size_t>(x)];
+        stl::sample(input_int_iter{pop.data()}, input_int_iter{pop.data() + 100}, out.data(), 10, g);
+        std::vector<int> s = out;
+        std::sort(s.begin(), s.end());
+        ASSERT_EQ(std::unique(s.begin(), s.end()), s.end());
+        for (int x : out) ++hit_input[static_cast<size_t>(x)];
+    }
+    for (size_t i = 0; i < 100; ++i) {
+        EXPECT_NEAR(static_cast<double>(hit_forward[i]), 2000.0, 250.0);
+        EXPECT_NEAR(static_cast<double>(hit_input[i]), 2000.0, 250.0);
+    }
+}
+
+int main() {
+
+    ::testing::InitGoogleTest();
+    return RUN_ALL_TESTS();
+}
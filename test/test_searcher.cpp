@@ -0,0 +1,135 @@
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "algo.h"
+#include "searcher.h"
+#include "gtest/gtest.h"
+
+// 小字母表的随机文本与模式，匹配和部分匹配都很多
+static std::string random_text(std::mt19937 &rng, size_t n, int alphabet) {
+    std::string s(n, 'a');
+    for (auto &c : s) c = static_cast<char>('a' + rng() % alphabet);
+    return s;
+}
+
+TEST(StlSearcherTest, searchers_agree_with_std) {
+    std::mt19937 rng(31);
+    for (int round = 0; round < 3000; ++round) {
+        const int alphabet = 1 + round % 4;
+        const std::string text = random_text(rng, rng() % 200, alphabet);
+        const std::string pat = random_text(rng, rng() % 9, alphabet);
+        const char *first = text.data(), *last = text.data() + text.size();
+        const char *pfirst = pat.data(), *plast = pat.data() + pat.size();
+        const char *expect = std::search(first, last, pfirst, plast);
+        const char *expect_end = expect == last && !pat.empty() ? last : expect + pat.size();
+
+        auto check = [&](std::pair<const char *, const char *> r) {
+            EXPECT_EQ(r.first, expect) << text << " / " << pat;
+            EXPECT_EQ(r.second, expect_end) << text << " / " << pat;
+        };
+        auto to_std = [](stl::pair<const char *, const char *> r) { return std::make_pair(r.first, r.second); };
+        check(to_std(stl::default_searcher<const char *>(pfirst, plast)(first, last)));
+        check(to_std(stl::boyer_moore_horspool_searcher<const char *>(pfirst, plast)(first, last)));
+        check(to_std(stl::two_way_searcher<const char *>(pfirst, plast)(first, last)));
+        check(to_std(stl::simd_searcher<char>(pfirst, plast)(first, last)));
+        EXPECT_EQ(stl::search(first, last, pfirst, plast), expect);
+        EXPECT_EQ(stl::search(first, last, stl::two_way_searcher<const char *>(pfirst, plast)), expect);
+
+        EXPECT_EQ(stl::find_end(first, last, pfirst, plast), std::find_end(first, last, pfirst, plast));
+    }
+}
+
+TEST(StlSearcherTest, long_patterns) {
+    // 周期性的模式与接近匹配的文本，覆盖 Two-Way 的 memory 分支以及 SIMD 过滤的整组候选
+    std::string text;
+    for (int i = 0; i < 2000; ++i) text += (i % 97 == 0) ? "abcabcabd" : "abcabcabc";
+    const std::string pats[] = {"abcabcabd", "abcabcabcabcabcabd", std::string(40, 'a'),
+                                "cabcabcabcabcabcabcabcabcabcabcabcabcabcabcabcabcabcabcabcabcab"};
+    const char *first = text.data(), *last = text.data() + text.size();
+    for (const std::string &pat : pats) {
+        const char *pfirst = pat.data(), *plast = pat.data() + pat.size();
+        const char *expect = std::search(first, last, pfirst, plast);
+        EXPECT_EQ(stl::search(first, last, pfirst, plast), expect);
+        EXPECT_EQ(stl::two_way_searcher<const char *>(pfirst, plast)(first, last).first, expect);
+        EXPECT_EQ(stl::boyer_moore_horspool_searcher<const char *>(pfirst, plast)(first, last).first, expect);
+        EXPECT_EQ(stl::find_end(first, last, pfirst, plast), std::find_end(first, last, pfirst, plast));
+    }
+}
+
+TEST(StlSearcherTest, non_byte_types) {
+    std::mt19937 rng(32);
+    for (int round = 0; round < 500; ++round) {
+        std::vector<int> text(rng() % 300), pat(1 + rng() % 6);
+        for (auto &x : text) x = static_cast<int>(rng() % 3) * 256;
+        for (auto &x : pat) x = static_cast<int>(rng() % 3) * 256;
+        text.push_back(0);
+        const int *first = text.data(), *last = text.data() + text.size() - 1;
+        const int *pfirst = pat.data(), *plast = pat.data() + pat.size();
+        const int *expect = std::search(first, last, pfirst, plast);
+        EXPECT_EQ(stl::search(first, last, pfirst, plast), expect);
+        // int 的哈希为原值，0、256、512 的低 8 位相同，共用一项跳转距离
+        EXPECT_EQ(stl::boyer_moore_horspool_searcher<const int *>(pfirst, plast)(first, last).first, expect);
+        EXPECT_EQ(stl::two_way_searcher<const int *>(pfirst, plast)(first, last).first, expect);
+        EXPECT_EQ(stl::find_end(first, last, pfirst, plast), std::find_end(first, last, pfirst, plast));
+        EXPECT_EQ(stl::find_end(first, last, pfirst, plast, std::equal_to<int>()),
+                  std::find_end(first, last, pfirst, plast));
+    }
+}
+
+// 只支持前进的迭代器，检查 forward iterator 版本
+struct forward_int_iter {
+    typedef stl::forward_iterator_tag iterator_category;
+    typedef int value_type;
+    typedef ptrdiff_t difference_type;
+    typedef const int *pointer;
+    typedef const int &reference;
+
+    const int *p;
+
+    reference operator*() const { return *p; }
+
+    forward_int_iter &operator++() {
+        ++p;
+        return *this;
+    }
+
+    bool operator==(const forward_int_iter &rhs) const { return p == rhs.p; }
+
+    bool operator!=(const forward_int_iter &rhs) const { return p != rhs.p; }
+};
+
+TEST(StlSearcherTest, forward_iterators) {
+    const int a[] = {1, 2, 3, 1, 2, 3, 4, 1, 2};
+    const int b[] = {1, 2};
+    forward_int_iter first{a}, last{a + 9}, pfirst{b}, plast{b + 2};
+    EXPECT_EQ(stl::search(first, last, pfirst, plast).p, a);
+    EXPECT_EQ(stl::find_end(first, last, pfirst, plast).p, a + 7);
+    EXPECT_EQ(stl::find_end(first, last, pfirst, pfirst).p, a + 9);
+    EXPECT_EQ(stl::search_n(first, last, 1, 4).p, a + 6);
+    EXPECT_EQ(stl::default_searcher<forward_int_iter>(pfirst, plast)(first, last).second.p, a + 2);
+}
+
+TEST(StlSearchNTest, search_n) {
+    std::mt19937 rng(33);
+    for (int round = 0; round < 2000; ++round) {
+        std::vector<int> v(rng() % 100 + 1);
+        for (auto &x : v) x = rng() % 4 == 0 ? 1 : 0;
+        const int *first = v.data(), *last = v.data() + v.size();
+        for (int n = 0; n < 6; ++n) {
+            EXPECT_EQ(stl::search_n(first, last, n, 0), std::search_n(first, last, n, 0));
+            EXPECT_EQ(stl::search_n(first, last, n, 1, std::equal_to<int>()), std::search_n(first, last, n, 1));
+        }
+    }
+    const std::string s = "aab  aaab   x";
+    EXPECT_EQ(stl::search_n(s.data(), s.data() + s.size(), 3, ' '), s.data() + 9);
+    EXPECT_EQ(stl::search_n(s.data(), s.data() + s.size(), 4, ' '), s.data() + s.size());
+}
+
+int main() {
+
+    ::testing::InitGoogleTest();
+    return RUN_ALL_TESTS();
+}
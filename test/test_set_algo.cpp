@@ -0,0 +1,159 @@
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <vector>
+
+#include "set_algo.h"
+#include "functional.h"
+#include "set_test_data.h"
+#include "gtest/gtest.h"
+
+// 只支持单遍读取的迭代器，set_intersection 对它逐个合并
+struct input_u32_iter {
+    typedef stl::input_iterator_tag iterator_category;
+    typedef uint32_t value_type;
+    typedef ptrdiff_t difference_type;
+    typedef const uint32_t *pointer;
+    typedef const uint32_t &reference;
+
+    const uint32_t *p;
+
+    reference operator*() const { return *p; }
+
+    input_u32_iter &operator++() {
+        ++p;
+        return *this;
+    }
+
+    bool operator==(const input_u32_iter &rhs) const { return p == rhs.p; }
+
+    bool operator!=(const input_u32_iter &rhs) const { return p != rhs.p; }
+};
+
+// 与 std::set_intersection 的结果比较，长度比覆盖逐个合并、分块比较与 galloping
+template<class T>
+void check_intersection(size_t n1, size_t n2, uint64_t range, bool allow_dup, std::mt19937_64 &rng) {
+    const std::vector<T> a = sorted_random<T>(n1, range, allow_dup, rng);
+    const std::vector<T> b = sorted_random<T>(n2, range, allow_dup, rng);
+    const std::vector<T> expect = set_expect<T>(a, b).inter;
+
+    std::vector<T> out(a.size() + 1);
+    const T *af = a.data(), *al = a.data() + a.size(), *bf = b.data(), *bl = b.data() + b.size();
+    T *end = stl::set_intersection(af, al, bf, bl, out.data());
+    ASSERT_EQ(static_cast<size_t>(end - out.data()), expect.size());
+    EXPECT_TRUE(std::equal(expect.begin(), expect.end(), out.data()));
+    EXPECT_EQ(stl::set_intersection_size(af, al, bf, bl), expect.size());
+    EXPECT_EQ(stl::set_intersection_size(bf, bl, af, al), expect.size());
+
+    // 带 comp 的版本不使用分块比较
+    end = stl::set_intersection(af, al, bf, bl, out.data(), stl::less<T>());
+    ASSERT_EQ(static_cast<size_t>(end - out.data()), expect.size());
+    EXPECT_TRUE(std::equal(expect.begin(), expect.end(), out.data()));
+    EXPECT_EQ(stl::set_intersection_size(bf, bl, af, al, stl::less<T>()), expect.size());
+}
+
+TEST(StlSetAlgoTest, set_intersection) {
+    std::mt19937_64 rng(17);
+    const size_t sizes[] = {0, 1, 3, 7, 8, 9, 31, 100, 1000, 5000};
+    for (size_t n1 : sizes) {
+        for (size_t n2 : sizes) {
+            check_intersection<uint32_t>(n1, n2, 4 * (n1 + n2) + 1, false, rng);
+            check_intersection<uint32_t>(n1, n2, (n1 + n2) / 4 + 1, true, rng);   // 大量重复
+            check_intersection<int>(n1, n2, 2 * (n1 + n2) + 1, false, rng);
+            check_intersection<uint64_t>(n1, n2, 2 * (n1 + n2) + 1, true, rng);
+        }
+    }
+    // 长度相差很多
+    check_intersection<uint32_t>(20, 200000, 1000000, false, rng);
+    check_intersection<uint32_t>(200000, 3, 1000000, false, rng);
+    check_intersection<uint32_t>(50, 100000, 30, true, rng);
+
+    // 有符号整数的顺序与无符号不同
+    std::vector<int> a = {-5, -3, -1, 0, 2, 4, 6, 8, 10}, b = {-3, -2, -1, 1, 2, 3, 8, 9, 10, 11};
+    std::vector<int> out(a.size());
+    int *end = stl::set_intersection(a.data(), a.data() + a.size(), b.data(), b.data() + b.size(), out.data());
+    EXPECT_EQ(std::vector<int>(out.data(), end), (std::vector<int>{-3, -1, 2, 8, 10}));
+    for (int trial = 0; trial < 20; ++trial) {
+        std::vector<int> c = sorted_random<int>(500, 2000, false, rng), d = sorted_random<int>(700, 2000, false, rng);
+        for (int &x : c) x -= 1000;
+        for (int &x : d) x -= 1000;
+        std::vector<int> expect;
+        std::set_intersection(c.begin(), c.end(), d.begin(), d.end(), std::back_inserter(expect));
+        std::vector<int> res(c.size());
+        end = stl::set_intersection(c.data(), c.data() + c.size(), d.data(), d.data() + d.size(), res.data());
+        EXPECT_EQ(std::vector<int>(res.data(), end), expect);
+    }
+}
+
+#ifdef STL_SIMD
+// 支持 AVX2 的机器上也检查 SSE2 版本的分块比较，剩下不足一块的部分逐个合并
+TEST(StlSetAlgoTest, set_intersection_sse2) {
+    std::mt19937_64 rng(23);
+    for (size_t n = 0; n < 300; n += 7) {
+        for (bool dup : {false, true}) {
+            const std::vector<uint32_t> a = sorted_random<uint32_t>(n, dup ? n / 3 + 1 : 3 * n + 1, dup, rng);
+            const std::vector<uint32_t> b = sorted_random<uint32_t>(n + 5, dup ? n / 3 + 1 : 3 * n + 1, dup, rng);
+            std::vector<uint32_t> expect;
+            std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expect));
+            std::vector<uint32_t> out(a.size() + 1);
+            stl::set_output_sink<uint32_t *> sink{out.data()};
+            const uint32_t *p1 = a.data(), *p2 = b.data();
+            stl::simd_set_intersection_sse2(p1, a.data() + a.size(), p2, b.data() + b.size(), sink);
+            uint32_t *end = stl::set_intersection(p1, a.data() + a.size(), p2, b.data() + b.size(), sink.result);
+            ASSERT_EQ(static_cast<size_t>(end - out.data()), expect.size());
+            EXPECT_TRUE(std::equal(expect.begin(), expect.end(), out.data()));
+        }
+    }
+}
+#endif
+
+TEST(StlSetAlgoTest, iterators_and_comp) {
+    std::vector<uint32_t> a = {1, 3, 5, 7, 9, 11}, b = {3, 4, 5, 6, 11};
+    std::vector<uint32_t> out(a.size());
+    auto end = stl::set_intersection(input_u32_iter{a.data()}, input_u32_iter{a.data() + a.size()},
+                                     input_u32_iter{b.data()}, input_u32_iter{b.data() + b.size()}, out.data());
+    EXPECT_EQ(std::vector<uint32_t>(out.data(), end), (std::vector<uint32_t>{3, 5, 11}));
+    EXPECT_EQ(stl::set_intersection_size(input_u32_iter{a.data()}, input_u32_iter{a.data() + a.size()},
+                                         b.data(), b.data() + b.size()), 3u);
+
+    // 降序
+    std::vector<uint32_t> c(a.rbegin(), a.rend()), d(b.rbegin(), b.rend());
+    end = stl::set_intersection(c.data(), c.data() + c.size(), d.data(), d.data() + d.size(), out.data(),
+                                stl::greater<uint32_t>());
+    EXPECT_EQ(std::vector<uint32_t>(out.data(), end), (std::vector<uint32_t>{11, 5, 3}));
+
+    // 输出取自第一个区间：按 key 比较的结构体
+    struct item {
+        int key, tag;
+    };
+    std::vector<item> x = {{1, 0}, {2, 0}, {4, 0}}, y;
+    for (int i = 0; i < 200; ++i) y.push_back(item{i, 1});
+    std::vector<item> z(3);
+    auto less_key = [](const item &l, const item &r) { return l.key < r.key; };
+    auto zend = stl::set_intersection(x.data(), x.data() + 3, y.data(), y.data() + y.size(), z.data(), less_key);
+    ASSERT_EQ(zend - z.data(), 3);
+    for (const item &it : z) EXPECT_EQ(it.tag, 0);
+    zend = stl::set_intersection(y.data(), y.data() + y.size(), x.data(), x.data() + 3, z.data(), less_key);
+    ASSERT_EQ(zend - z.data(), 3);
+    for (const item &it : z) EXPECT_EQ(it.tag, 1);
+}
+
+TEST(StlSetAlgoTest, other_set_algorithms) {
+    std::vector<int> a = {1, 2, 2, 4, 6}, b = {2, 3, 4, 4, 7};
+    std::vector<int> out(10);
+    int *end = stl::set_union(a.data(), a.data() + a.size(), b.data(), b.data() + b.size(), out.data(),
+                              stl::less<int>());
+    EXPECT_EQ(std::vector<int>(out.data(), end), (std::vector<int>{1, 2, 2, 3, 4, 4, 6, 7}));
+    end = stl::set_difference(a.data(), a.data() + a.size(), b.data(), b.data() + b.size(), out.data());
+    EXPECT_EQ(std::vector<int>(out.data(), end), (std::vector<int>{1, 2, 6}));
+    end = stl::set_symmetric_difference(a.data(), a.data() + a.size(), b.data(), b.data() + b.size(), out.data());
+    EXPECT_EQ(std::vector<int>(out.data(), end), (std::vector<int>{1, 2, 3, 4, 6, 7}));
+}
+
+int main() {
+
+    ::testing::InitGoogleTest();
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,332 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "algo.h"
+#include "simd.h"
+#include "vector.h"
+#include "gtest/gtest.h"
+
+// 用逐个比较的结果检查向量化的 find / count / mismatch / equal，覆盖各种长度以测试尾部的处理
+template<class T>
+void check_type() {
+    std::mt19937 rng(7);
+    for (size_t n = 0; n < 150; ++n) {
+        std::vector<T> v(n + 1);     // 多一个元素，避免空区间时 data() 为空
+        for (size_t i = 0; i < n; ++i) v[i] = static_cast<T>(rng() % 5);
+        const T *first = v.data(), *last = v.data() + n;
+
+        for (int x = 0; x < 6; ++x) {
+            const T value = static_cast<T>(x);
+            const T *expect = first;
+            size_t cnt = 0;
+            while (expect != last && !(*expect == value)) ++expect;
+            for (const T *p = first; p != last; ++p) if (*p == value) ++cnt;
+            EXPECT_EQ(stl::find(first, last, value), expect);
+            EXPECT_EQ(stl::count(first, last, value), cnt);
+#ifdef STL_SIMD
+            // 支持 AVX2 的机器上也检查 SSE2 版本
+            EXPECT_EQ(stl::simd_find_sse2(first, last, value), expect);
+            EXPECT_EQ(stl::simd_count_sse2(first, last, value), cnt);
+#endif
+        }
+
+        std::vector<T> w(v);
+        EXPECT_TRUE(stl::equal(first, last, w.data()));
+        EXPECT_EQ(stl::mismatch(first, last, w.data()).first, last);
+        for (size_t i = 0; i < n; ++i) {
+            w[i] = static_cast<T>(9);
+            const auto r = stl::mismatch(first, last, w.data());
+            EXPECT_EQ(r.first, first + i);
+            EXPECT_EQ(r.second, w.data() + i);
+            EXPECT_FALSE(stl::equal(first, last, w.data()));
+#ifdef STL_SIMD
+            EXPECT_EQ(stl::simd_mismatch_sse2(first, static_cast<const T *>(w.data()), n), i);
+#endif
+            w[i] = v[i];
+        }
+    }
+}
+
+TEST(StlSimdTest, all_types) {
+    check_type<char>();
+    check_type<signed char>();
+    check_type<unsigned char>();
+    check_type<short>();
+    check_type<uint16_t>();
+    check_type<int>();
+    check_type<unsigned>();
+    check_type<int64_t>();
+    check_type<uint64_t>();
+    check_type<float>();
+    check_type<double>();
+}
+
+TEST(StlSimdTest, mutable_and_const_pointers) {
+    stl::vector<int> v;
+    for (int i = 0; i < 100; ++i) v.push_back(i);
+    int *p = stl::find(v.begin(), v.end(), 77);
+    EXPECT_EQ(p, v.begin() + 77);
+    const stl::vector<int> &cv = v;
+    const int *cp = stl::find(cv.begin(), cv.end(), 77);
+    EXPECT_EQ(cp, cv.begin() + 77);
+    EXPECT_TRUE(stl::equal(v.begin(), v.end(), cv.begin()));
+    EXPECT_EQ(stl::count(cv.begin(), cv.end(), 101), 0u);
+}
+
+TEST(StlSimdTest, value_conversion) {
+    // 值无法用元素类型表示时，不会有元素与它相等
+    const char s[] = "hello, world";
+    EXPECT_EQ(stl::find(s, s + 12, 'w'), s + 7);
+    EXPECT_EQ(stl::find(s, s + 12, 'w' + 256), s + 12);
+    EXPECT_EQ(stl::count(s, s + 12, 'l'), 3u);
+
+    const unsigned char bytes[] = {0, 255, 1, 255};
+    EXPECT_EQ(stl::find(bytes, bytes + 4, -1), bytes + 4);
+    EXPECT_EQ(stl::find(bytes, bytes + 4, 255), bytes + 1);
+    EXPECT_EQ(stl::count(bytes, bytes + 4, 255L), 2u);
+
+    // 与 operator== 一致：有符号数与无符号数比较时先转换为无符号数
+    const unsigned u[] = {1, 2, 0xFFFFFFFFu, 3};
+    EXPECT_EQ(stl::find(u, u + 4, -1), u + 2);
+    const int i[] = {1, -1, 2, 3};
+    EXPECT_EQ(stl::find(i, i + 4, 0xFFFFFFFFu), i + 1);
+    EXPECT_EQ(stl::find(i, i + 4, static_cast<long long>(0xFFFFFFFFu)), i + 4);
+}
+
+TEST(StlSimdTest, floating_point) {
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    std::vector<double> v(40, 1.0);
+    v[20] = nan;
+    v[30] = -0.0;
+    EXPECT_EQ(stl::find(v.data(), v.data() + 40, nan), v.data() + 40);
+    EXPECT_EQ(stl::find(v.data(), v.data() + 40, 0.0), v.data() + 30);
+    EXPECT_EQ(stl::count(v.data(), v.data() + 40, 1.0), 38u);
+
+    // NaN 与自身也不相等，+0.0 与 -0.0 相等
+    std::vector<double> w(v);
+    w[30] = 0.0;
+    EXPECT_EQ(stl::mismatch(v.data(), v.data() + 40, w.data()).first, v.data() + 20);
+    EXPECT_FALSE(stl::equal(v.data(), v.data() + 40, w.data()));
+    EXPECT_TRUE(stl::equal(v.data() + 21, v.data() + 40, w.data() + 21));
+}
+
+TEST(StlSimdTest, find_if) {
+    stl::vector<int> v;
+    for (int i = 0; i < 103; ++i) v.push_back(i);
+    for (int x = 0; x <= 103; ++x) {
+        int *p = stl::find_if(v.begin(), v.end(), [x](int y) { return y >= x; });
+        EXPECT_EQ(p, v.begin() + x);
+    }
+}
+
+// 大小不是 2 的幂的可平凡复制类型，走成倍拷贝的填充
+struct rgb {
+    unsigned char r, g, b;
+};
+
+struct triple {
+    int x, y, z;
+};
+
+struct quad {
+    double a, b;
+};
+
+template<class T, class Same>
+void check_fill(const T &value, Same same) {
+    const T zero{};
+    for (size_t n = 0; n < 300; n += (n < 70 ? 1 : 37)) {
+        for (size_t offset = 0; offset < 3; ++offset) {
+            // 两端各多留一个元素，检查没有写出界
+            std::vector<T> v(n + offset + 2, zero);
+            T *first = v.data() + offset + 1;
+            EXPECT_EQ(stl::fill_n(first, n, value), first + n);
+            for (size_t i = 0; i < v.size(); ++i) {
+                const bool inside = i >= offset + 1 && i < offset + 1 + n;
+                EXPECT_TRUE(same(v[i], inside ? value : zero)) << n << " " << offset << " " << i;
+            }
+        }
+    }
+}
+
+TEST(StlSimdTest, fill) {
+    auto eq = [](auto a, auto b) { return a == b; };
+    check_fill<char>('x', eq);
+    check_fill<short>(static_cast<short>(0x1234), eq);
+    check_fill<int>(0x01020304, eq);
+    check_fill<int>(-1, eq);
+    check_fill<int64_t>(0x0102030405060708ll, eq);
+    check_fill<double>(3.5, eq);
+    check_fill<rgb>(rgb{1, 2, 3}, [](rgb a, rgb b) { return a.r == b.r && a.g == b.g && a.b == b.b; });
+    check_fill<triple>(triple{1, 2, 3}, [](triple a, triple b) { return a.x == b.x && a.y == b.y && a.z == b.z; });
+    check_fill<quad>(quad{1.5, 2.5}, [](quad a, quad b) { return a.a == b.a && a.b == b.b; });
+
+    // 值先转换为元素类型
+    stl::vector<int> v(10);
+    stl::fill(v.begin(), v.end(), 2.9);
+    EXPECT_EQ(stl::count(v.begin(), v.end(), 2), 10u);
+    std::vector<bool> expect(5, true);
+    bool b[5];
+    stl::fill_n(b, 5, 2);
+    EXPECT_TRUE(std::equal(b, b + 5, expect.begin()));
+    EXPECT_EQ(stl::fill_n(v.begin(), -3, 1), v.begin());
+
+#ifdef STL_SIMD
+    // 支持 AVX2 的机器上也检查 SSE2 版本，样式的第 k 个字节为 k 除以周期的余数
+    char pat[128];
+    for (int i = 0; i < 128; ++i) pat[i] = static_cast<char>(i % 96);
+    for (size_t n = 16; n < 400; ++n) {
+        for (size_t offset = 0; offset < 16; offset += 5) {
+            std::vector<char> buf(n + 32, -1);
+            auto check = [&](size_t period) {
+                for (size_t i = 0; i < buf.size(); ++i) {
+                    const bool inside = i >= offset && i < offset + n;
+                    EXPECT_EQ(buf[i], inside ? static_cast<char>((i - offset) % period) : -1);
+                }
+            };
+            stl::simd_fill_word_sse2(buf.data() + offset, n, 0x0706050403020100ull);
+            check(8);
+            stl::simd_fill_bytes_sse2<96>(buf.data() + offset, n, pat);
+            check(96);
+        }
+    }
+#endif
+}
+
+template<class T>
+void check_compaction() {
+    std::mt19937 rng(11);
+    for (size_t n = 0; n < 200; ++n) {
+        std::vector<T> v(n + 1);
+        for (size_t i = 0; i < n; ++i) v[i] = static_cast<T>(rng() % 10);
+        for (int t = 0; t <= 10; t += 3) {
+            const T limit = static_cast<T>(t);
+            auto pred = [limit](T x) { return x < limit; };
+            std::vector<T> expect, out(n + 1, static_cast<T>(99));
+            std::copy_if(v.begin(), v.begin() + n, std::back_inserter(expect), pred);
+            T *end = stl::copy_if(v.data(), v.data() + n, out.data(), pred);
+            ASSERT_EQ(static_cast<size_t>(end - out.data()), expect.size());
+            EXPECT_TRUE(std::equal(expect.begin(), expect.end(), out.data()));
+            // 输出区间末尾之后没有被写入
+            EXPECT_EQ(out[expect.size()], static_cast<T>(99));
+#ifdef STL_SIMD
+            EXPECT_EQ(stl::simd_compact_scalar<false>(static_cast<const T *>(v.data()), v.data() + n,
+                                                      out.data(), pred), end);
+#endif
+
+            std::vector<T> w(v), x(v);
+            T *removed = stl::remove_if(w.data(), w.data() + n, pred);
+            T *std_removed = std::remove_if(x.data(), x.data() + n, pred);
+            ASSERT_EQ(removed - w.data(), std_removed - x.data());
+            EXPECT_TRUE(std::equal(w.data(), removed, x.data()));
+        }
+    }
+}
+
+TEST(StlSimdTest, copy_if_remove_if) {
+    check_compaction<char>();
+    check_compaction<short>();
+    check_compaction<int>();
+    check_compaction<uint32_t>();
+    check_compaction<int64_t>();
+    check_compaction<float>();
+    check_compaction<double>();
+
+    // 每个元素恰好调用一次谓词
+    stl::vector<int> v;
+    for (int i = 0; i < 100; ++i) v.push_back(i);
+    int calls = 0;
+    int out[100];
+    EXPECT_EQ(stl::copy_if(v.begin(), v.end(), out, [&calls](int x) { ++calls; return x > 0; }) - out, 99);
+    EXPECT_EQ(calls, 100);
+    calls = 0;
+    EXPECT_EQ(stl::remove_if(v.begin(), v.end(), [&calls](int x) { ++calls; return x % 3 == 0; }), v.begin() + 66);
+    EXPECT_EQ(calls, 100);
+}
+
+TEST(StlSimdTest, transform) {
+    for (size_t n = 0; n < 70; ++n) {
+        std::vector<int> a(n + 8), b(n + 8);
+        for (size_t i = 0; i < a.size(); ++i) a[i] = static_cast<int>(i), b[i] = static_cast<int>(3 * i);
+        std::vector<double> out(n);
+        EXPECT_EQ(stl::transform(a.data(), a.data() + n, out.data(), [](int x) { return x * 0.5; }),
+                  out.data() + n);
+        for (size_t i = 0; i < n; ++i) EXPECT_EQ(out[i], a[i] * 0.5);
+
+        std::vector<int> sum(n);
+        stl::transform(a.data(), a.data() + n, b.data(), sum.data(), stl::plus<int>());
+        for (size_t i = 0; i < n; ++i) EXPECT_EQ(sum[i], 4 * static_cast<int>(i));
+
+        // 原地变换与部分重叠：与逐个处理的结果相同
+        std::vector<int> c(a), d(a);
+        stl::transform(c.data(), c.data() + n, c.data(), [](int x) { return x + 1; });
+        for (size_t i = 0; i < n; ++i) EXPECT_EQ(c[i], a[i] + 1);
+        stl::transform(d.data() + 1, d.data() + 1 + n, d.data(), [](int x) { return x * 2; });
+        std::vector<int> e(a);
+        std::transform(e.data() + 1, e.data() + 1 + n, e.data(), [](int x) { return x * 2; });
+        EXPECT_EQ(d, e);
+        stl::transform(d.data(), d.data() + n, d.data() + 1, d.data(), stl::plus<int>());
+        std::transform(e.data(), e.data() + n, e.data() + 1, e.data(), std::plus<int>());
+        EXPECT_EQ(d, e);
+    }
+}
+
+// reverse / reverse_copy 与逐个处理的结果相同，覆盖各种长度以测试两端相遇处与尾部的处理
+template<class T>
+void check_reverse() {
+    for (size_t n = 0; n < 150; ++n) {
+        std::vector<T> a(n + 1);
+        for (size_t i = 0; i < n; ++i) a[i] = static_cast<T>(i * 7 + 1);
+        std::vector<T> expect(a.begin(), a.begin() + static_cast<ptrdiff_t>(n));
+        std::reverse(expect.begin(), expect.end());
+
+        std::vector<T> b(a);
+        stl::reverse(b.data(), b.data() + n);
+        EXPECT_TRUE(std::equal(expect.begin(), expect.end(), b.begin()));
+        std::vector<T> out(n + 1);
+        const T *first = a.data();
+        EXPECT_EQ(stl::reverse_copy(first, first + n, out.data()), out.data() + n);
+        EXPECT_TRUE(std::equal(expect.begin(), expect.end(), out.begin()));
+#ifdef STL_SIMD
+        std::vector<T> c(a);
+        stl::simd_swap_reversed_sse2(c.data(), c.data() + n, n / 2);
+        EXPECT_TRUE(std::equal(expect.begin(), expect.end(), c.begin()));
+        std::fill(out.begin(), out.end(), T());
+        EXPECT_EQ(stl::simd_reverse_copy_sse2(first, first + n, out.data()), out.data() + n);
+        EXPECT_TRUE(std::equal(expect.begin(), expect.end(), out.begin()));
+#endif
+    }
+}
+
+TEST(StlSimdTest, reverse) {
+    check_reverse<char>();
+    check_reverse<uint8_t>();
+    check_reverse<short>();
+    check_reverse<int>();
+    check_reverse<uint32_t>();
+    check_reverse<int64_t>();
+    check_reverse<float>();
+    check_reverse<double>();
+
+    // vector::reverse 与部分重叠的 reverse_copy
+    stl::vector<int> v;
+    for (int i = 0; i < 100; ++i) v.push_back(i);
+    v.reverse();
+    for (int i = 0; i < 100; ++i) EXPECT_EQ(v[static_cast<size_t>(i)], 99 - i);
+    std::vector<int> w(100), e(100);
+    for (int i = 0; i < 100; ++i) w[static_cast<size_t>(i)] = e[static_cast<size_t>(i)] = i;
+    stl::reverse_copy(w.data(), w.data() + 60, w.data() + 40);
+    std::reverse_copy(e.data(), e.data() + 60, e.data() + 40);
+    EXPECT_EQ(w, e);
+}
+
+int main() {
+
+    ::testing::InitGoogleTest();
+    return RUN_ALL_TESTS();
+}
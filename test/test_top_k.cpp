@@ -0,0 +1,84 @@
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "top_k.h"
+#include "gtest/gtest.h"
+
+TEST(StlTopKTest, largest) {
+    std::mt19937 rng(3);
+    std::vector<int> input;
+    for (int i = 0; i < 10000; ++i) input.push_back(static_cast<int>(rng() % 100000));
+    std::vector<int> expect = input;
+    std::sort(expect.begin(), expect.end(), std::greater<int>());
+
+    const size_t ks[] = {1, 10, 1000, 10000, 20000};
+    for (size_t k : ks) {
+        stl::top_k<int> acc(k);
+        EXPECT_TRUE(acc.empty());
+        acc.push(input.data(), input.data() + input.size());
+        const size_t m = std::min(k, input.size());
+        EXPECT_EQ(acc.size(), m);
+        EXPECT_EQ(acc.full(), k <= input.size());
+        EXPECT_EQ(acc.threshold(), expect[m - 1]);
+
+        stl::vector<int> result = acc.sorted();
+        ASSERT_EQ(result.size(), m);
+        EXPECT_TRUE(std::equal(result.begin(), result.end(), expect.begin()));
+    }
+}
+
+TEST(StlTopKTest, smallest_and_push_result) {
+    // comp 为 greater 时保留最小的 k 个
+    stl::top_k<int, stl::greater<int>> acc(3);
+    EXPECT_TRUE(acc.push(5));
+    EXPECT_TRUE(acc.push(1));
+    EXPECT_TRUE(acc.push(4));
+    EXPECT_EQ(acc.threshold(), 5);
+    EXPECT_FALSE(acc.push(7));
+    EXPECT_FALSE(acc.push(5));     // 与门槛相等时不替换
+    EXPECT_TRUE(acc.push(2));
+    EXPECT_EQ(acc.threshold(), 4);
+
+    stl::vector<int> result = acc.sorted();
+    const int expect[] = {1, 2, 4};
+    EXPECT_TRUE(std::equal(result.begin(), result.end(), expect));
+
+    acc.clear();
+    EXPECT_TRUE(acc.empty());
+
+    stl::top_k<int> none(0);
+    EXPECT_FALSE(none.push(1));
+    EXPECT_TRUE(none.empty());
+}
+
+// 按分数排序的候选
+struct Candidate {
+    double score;
+    std::string id;
+};
+
+struct ScoreLess {
+    bool operator()(const Candidate &a, const Candidate &b) const { return a.score < b.score; }
+};
+
+TEST(StlTopKTest, records) {
+    stl::top_k<Candidate, ScoreLess> acc(2);
+    acc.push(Candidate{0.5, "a"});
+    acc.push(Candidate{0.9, "b"});
+    acc.push(Candidate{0.1, "c"});
+    Candidate d{0.7, "d"};
+    acc.push(stl::move(d));
+    stl::vector<Candidate> result = acc.sorted();
+    ASSERT_EQ(result.size(), 2);
+    EXPECT_EQ(result[0].id, "b");
+    EXPECT_EQ(result[1].id, "d");
+}
+
+int main() {
+
+    ::testing::InitGoogleTest();
+    return RUN_ALL_TESTS();
+}